@@ -132,6 +132,11 @@ namespace Mona {
 	}
 
 	void AnimationController::GetMatrixPalette(std::vector<glm::mat4>& outMatrixPalette) const
+	{
+		GetMatrixPalette(outMatrixPalette.data());
+	}
+
+	void AnimationController::GetMatrixPalette(glm::mat4* outMatrixPalette) const
 	{
 		
 		auto skeleton = m_animationClipPtr->GetSkeleton();
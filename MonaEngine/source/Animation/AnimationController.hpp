@@ -23,6 +23,10 @@ namespace Mona {
 		void SetPlayRate(float playrate) { m_playRate = playrate; }
 		float GetPlayRate() const { return m_playRate; }
 		void GetMatrixPalette(std::vector<glm::mat4>& outMatrixPalette) const;
+		/*
+		* Escribe la paleta de matrices a partir de outMatrixPalette, que debe tener espacio para JointCount() matrices.
+		*/
+		void GetMatrixPalette(glm::mat4* outMatrixPalette) const;
 		std::shared_ptr<AnimationClip> GetCurrentAnimation() const { return m_animationClipPtr;  }
 		JointPose GetJointModelPose(uint32_t jointIndex) const;
 	private:
@@ -2,6 +2,12 @@
 #include "../World/ComponentManager.hpp"
 namespace Mona {
 	void AnimationSystem::UpdateAllPoses(ComponentManager<SkeletalMeshComponent>& skeletalMeshDataManager, float timeStep) noexcept {
+		//Si hay un intervalo de actualizacion se acumula el tiempo y las poses avanzan todo el tiempo acumulado de una vez.
+		m_elapsedTime += timeStep;
+		if (m_elapsedTime < m_updateInterval)
+			return;
+		timeStep = m_elapsedTime;
+		m_elapsedTime = 0.0f;
 		//Se itera sobre todas las componentes de animacin, los animation controller son los responsables de la logica de
 		//actualizacin.
 		for (uint32_t i = 0; i < skeletalMeshDataManager.GetCount(); i++) {
@@ -7,6 +7,14 @@ namespace Mona {
 	public:
 		AnimationSystem() = default;
 		void UpdateAllPoses(ComponentManager<SkeletalMeshComponent>& skeletalMeshDataManager, float timeStep) noexcept;
+		/*
+		* Tiempo minimo (en segundos) entre dos actualizaciones de las poses, con cero se actualizan todos los frames.
+		*/
+		float GetUpdateInterval() const noexcept { return m_updateInterval; }
+		void SetUpdateInterval(float interval) noexcept { m_updateInterval = interval; }
+	private:
+		float m_updateInterval = 0.0f;
+		float m_elapsedTime = 0.0f;
 	};
 }
 #endif
\ No newline at end of file
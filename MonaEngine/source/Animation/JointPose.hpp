@@ -62,11 +62,16 @@ namespace Mona {
 			glm::mix(lhs.m_scale, rhs.m_scale, t));
 	}
 
+	/*
+	* Retorna traslacion * rotacion * escala. Las columnas se construyen directamente en lugar de multiplicar tres matrices
+	* completas, el resultado es el mismo.
+	*/
 	inline glm::mat4 JointPoseToMat4(const JointPose& pose) {
-		const glm::mat4 translationMatrix = glm::translate(glm::mat4(1.0f), pose.m_translation);
-		const glm::mat4 rotationMatrix = glm::toMat4(pose.m_rotation);
-		const glm::mat4 scaleMatrix = glm::scale(glm::mat4(1.0f), pose.m_scale);
-		return translationMatrix * rotationMatrix * scaleMatrix;
+		const glm::mat3 rotationMatrix = glm::mat3_cast(pose.m_rotation);
+		return glm::mat4(glm::vec4(rotationMatrix[0] * pose.m_scale.x, 0.0f),
+			glm::vec4(rotationMatrix[1] * pose.m_scale.y, 0.0f),
+			glm::vec4(rotationMatrix[2] * pose.m_scale.z, 0.0f),
+			glm::vec4(pose.m_translation, 1.0f));
 	}
 	
 }
@@ -1,7 +1,6 @@
 ﻿#include "Skeleton.hpp"
 #include <stack>
 #include "Skeleton.hpp"
-#include "../Rendering/Renderer.hpp"
 #include "../Core/Log.hpp"
 #include "../Core/AssimpTransformations.hpp"
 #include <assimp/Importer.hpp>
@@ -40,16 +39,6 @@ namespace Mona {
 
 		}
 
-		//Chequeo del tamanio del esqueleto a importar
-		if (Renderer::NUM_MAX_BONES < boneInfo.size())
-		{
-			MONA_LOG_ERROR("Skeleton Error: Skeleton at {0} has {1} bones while the engine can only support {2}",
-				filePath,
-				boneInfo.size(),
-				Renderer::NUM_MAX_BONES);
-			return;
-		}
-
 		//Se reserva la memoria necesaria
 		m_invBindPoseMatrices.reserve(boneInfo.size());
 		m_jointNames.reserve(boneInfo.size());
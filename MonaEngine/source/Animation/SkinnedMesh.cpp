@@ -1,12 +1,15 @@
 ﻿#include "SkinnedMesh.hpp"
 #include "../Core/Log.hpp"
 #include "../Core/AssimpTransformations.hpp"
+#include "../Rendering/MeshOptimizer.hpp"
+#include "../Rendering/RenderDevice.hpp"
 #include <glm/glm.hpp>
 #include <assimp/Importer.hpp>
 #include <assimp/postprocess.h>
 #include <vector>
 #include <stack>
 #include <glad/glad.h>
+#include <glm/gtc/packing.hpp>
 #include "Skeleton.hpp"
 #include <iostream>
 namespace Mona {
@@ -22,6 +25,17 @@ namespace Mona {
 
 	};
 
+	//Formato comprimido con que se sube cada vertice a la GPU.
+	struct PackedSkeletalMeshVertex {
+		glm::vec3 position;
+		uint32_t normal;
+		uint32_t tangent;
+		uint32_t uv;
+		uint8_t boneIds[4];
+		uint16_t boneWeights[4];
+	};
+	static_assert(sizeof(PackedSkeletalMeshVertex) == 36, "SkinnedMesh Error: Unexpected packed vertex layout.");
+
 	SkinnedMesh::~SkinnedMesh() {
 		if (m_vertexArrayID)
 			ClearData();
@@ -31,9 +45,10 @@ namespace Mona {
 		MONA_ASSERT(m_vertexArrayID, "SkinnedMesh Error: Trying to delete already deleted mesh");
 		MONA_ASSERT(m_vertexBufferID, "SkinnedMesh Error: Trying to delete already deleted mesh");
 		MONA_ASSERT(m_indexBufferID, "SkinnedMesh Error: Trying to delete already deleted mesh");
-		glDeleteBuffers(1, &m_vertexBufferID);
-		glDeleteBuffers(1, &m_indexBufferID);
-		glDeleteVertexArrays(1, &m_vertexArrayID);
+		RenderDevice& device = RenderDevice::GetInstance();
+		device.DeleteBuffer(m_vertexBufferID);
+		device.DeleteBuffer(m_indexBufferID);
+		device.DeleteVertexArray(m_vertexArrayID);
 		m_vertexArrayID = 0;
 	}
 
@@ -45,6 +60,7 @@ namespace Mona {
 		m_vertexBufferID(0),
 		m_indexBufferID(0),
 		m_indexBufferCount(0),
+		m_indexType(GL_UNSIGNED_INT),
 		m_skeletonPtr(skeleton)
 	{
 		MONA_ASSERT(skeleton != nullptr, "SkinnedMesh Error: Skeleton cannot be null");
@@ -167,6 +183,8 @@ namespace Mona {
 					const aiBone* bone = meshOBJ->mBones[i];
 					int32_t signIndex = skeleton->GetJointIndex(bone->mName.C_Str());
 					MONA_ASSERT(signIndex >= 0, "Skinned Error: Given skeleton incompatible with mesh being imported");
+					//Los indices de articulacion se suben a la GPU con 8 bits.
+					MONA_ASSERT(signIndex < 256, "SkinnedMesh Error: Engine only supports skinning with up to 256 joints.");
 					uint32_t index = static_cast<uint32_t>(signIndex);
 					for (uint32_t k = 0; k < bone->mNumWeights; k++)
 					{
@@ -225,31 +243,77 @@ namespace Mona {
 
 			}
 		}
-		//Comienza el paso de los datos en CPU a GPU usando OpenGL
+		//Con los pesos ya asignados se unen los vertices identicos (incluyendo su piel) y se reordenan triangulos y
+		//vertices para el cache post transformacion, el overdraw y la lectura de vertices.
+		uint32_t vertexCount = static_cast<uint32_t>(vertices.size());
+		const MeshOptimizationStatistics statistics = OptimizeMesh(vertices.data(), vertexCount, sizeof(SkeletalMeshVertex),
+			static_cast<uint32_t>(offsetof(SkeletalMeshVertex, position)), faces);
+		vertices.resize(vertexCount);
+		LogMeshOptimizationStatistics(filePath, statistics);
+
+		m_bounds = MeshBounds::FromPositions(vertices.data(), vertices.size(), sizeof(SkeletalMeshVertex));
+		m_jointBounds.resize(skeleton->JointCount());
+		for (const SkeletalMeshVertex& vertex : vertices) {
+			for (int k = 0; k < 4; k++) {
+				if (vertex.boneWeights[k] > 0.0f)
+					m_jointBounds[static_cast<uint32_t>(vertex.boneIds[k])].Extend(vertex.position);
+			}
+		}
+		//Los vertices se comprimen antes de subirlos a la GPU (36 bytes en vez de 88): normal y tangente con 10 bits con
+		//signo por componente y el signo de la bitangente en w, coordenadas de textura con flotantes de 16 bits, indices de
+		//articulacion de 8 bits y pesos normalizados de 16 bits.
+		std::vector<PackedSkeletalMeshVertex> packedVertices(vertices.size());
+		for (size_t i = 0; i < vertices.size(); i++) {
+			const SkeletalMeshVertex& vertex = vertices[i];
+			PackedSkeletalMeshVertex& packed = packedVertices[i];
+			const float bitangentSign = glm::dot(glm::cross(vertex.normal, vertex.tangent), vertex.bitangent) < 0.0f ? -1.0f : 1.0f;
+			packed.position = vertex.position;
+			packed.normal = glm::packSnorm3x10_1x2(glm::vec4(vertex.normal, 0.0f));
+			packed.tangent = glm::packSnorm3x10_1x2(glm::vec4(vertex.tangent, bitangentSign));
+			packed.uv = glm::packHalf2x16(vertex.uv);
+			//Los pesos se cuantizan de manera que sigan sumando uno, el error de redondeo se asigna al peso mayor.
+			int32_t weightSum = 0;
+			int largest = 0;
+			for (int k = 0; k < 4; k++) {
+				packed.boneIds[k] = static_cast<uint8_t>(vertex.boneIds[k]);
+				packed.boneWeights[k] = static_cast<uint16_t>(glm::round(glm::clamp(vertex.boneWeights[k], 0.0f, 1.0f) * 65535.0f));
+				weightSum += packed.boneWeights[k];
+				if (vertex.boneWeights[k] > vertex.boneWeights[largest])
+					largest = k;
+			}
+			packed.boneWeights[largest] = static_cast<uint16_t>(packed.boneWeights[largest] + (65535 - weightSum));
+		}
+
+		//Comienza el paso de los datos en CPU a GPU usando OpenGL. Con hasta 65536 vertices los indices usan 16 bits.
 		m_indexBufferCount = static_cast<uint32_t>(faces.size());
-		glGenVertexArrays(1, &m_vertexArrayID);
-		glBindVertexArray(m_vertexArrayID);
+		m_indexType = vertices.size() <= 65536 ? GL_UNSIGNED_SHORT : GL_UNSIGNED_INT;
+		RenderDevice& device = RenderDevice::GetInstance();
+		m_vertexBufferID = device.CreateBuffer(packedVertices.size() * sizeof(PackedSkeletalMeshVertex), packedVertices.data(), 0);
+		if (m_indexType == GL_UNSIGNED_SHORT) {
+			std::vector<uint16_t> shortFaces(faces.begin(), faces.end());
+			m_indexBufferID = device.CreateBuffer(shortFaces.size() * sizeof(uint16_t), shortFaces.data(), 0);
+		}
+		else {
+			m_indexBufferID = device.CreateBuffer(faces.size() * sizeof(unsigned int), faces.data(), 0);
+		}
+		m_vertexArrayID = device.CreateVertexArray();
+		device.SetVertexAttribute(m_vertexArrayID, 0, 3, GL_FLOAT, false, false, offsetof(PackedSkeletalMeshVertex, position), 0);
+		device.SetVertexAttribute(m_vertexArrayID, 1, 4, GL_INT_2_10_10_10_REV, true, false, offsetof(PackedSkeletalMeshVertex, normal), 0);
+		device.SetVertexAttribute(m_vertexArrayID, 2, 2, GL_HALF_FLOAT, false, false, offsetof(PackedSkeletalMeshVertex, uv), 0);
+		device.SetVertexAttribute(m_vertexArrayID, 3, 4, GL_INT_2_10_10_10_REV, true, false, offsetof(PackedSkeletalMeshVertex, tangent), 0);
+		device.SetVertexAttribute(m_vertexArrayID, 5, 4, GL_UNSIGNED_BYTE, false, true, offsetof(PackedSkeletalMeshVertex, boneIds), 0);
+		device.SetVertexAttribute(m_vertexArrayID, 6, 4, GL_UNSIGNED_SHORT, true, false, offsetof(PackedSkeletalMeshVertex, boneWeights), 0);
+		device.SetVertexBuffer(m_vertexArrayID, 0, m_vertexBufferID, 0, sizeof(PackedSkeletalMeshVertex));
+		device.SetElementBuffer(m_vertexArrayID, m_indexBufferID);
+	}
 
-		glGenBuffers(1, &m_vertexBufferID);
-		glGenBuffers(1, &m_indexBufferID);
-		glBindBuffer(GL_ARRAY_BUFFER, m_vertexBufferID);
-		glBufferData(GL_ARRAY_BUFFER, static_cast<unsigned int>(vertices.size()) * sizeof(SkeletalMeshVertex), vertices.data(), GL_STATIC_DRAW);
-		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_indexBufferID);
-		glBufferData(GL_ELEMENT_ARRAY_BUFFER, static_cast<unsigned int>(faces.size()) * sizeof(unsigned int), faces.data(), GL_STATIC_DRAW);
-		glEnableVertexAttribArray(0);
-		glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(SkeletalMeshVertex), (void*)offsetof(SkeletalMeshVertex, position));
-		glEnableVertexAttribArray(1);
-		glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, sizeof(SkeletalMeshVertex), (void*)offsetof(SkeletalMeshVertex, normal));
-		glEnableVertexAttribArray(2);
-		glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, sizeof(SkeletalMeshVertex), (void*)offsetof(SkeletalMeshVertex, uv));
-		glEnableVertexAttribArray(3);
-		glVertexAttribPointer(3, 3, GL_FLOAT, GL_FALSE, sizeof(SkeletalMeshVertex), (void*)offsetof(SkeletalMeshVertex, tangent));
-		glEnableVertexAttribArray(4);
-		glVertexAttribPointer(4, 3, GL_FLOAT, GL_FALSE, sizeof(SkeletalMeshVertex), (void*)offsetof(SkeletalMeshVertex, bitangent));
-		glEnableVertexAttribArray(5);
-		glVertexAttribPointer(5, 4, GL_FLOAT, GL_FALSE, sizeof(SkeletalMeshVertex), (void*)offsetof(SkeletalMeshVertex, boneIds));
-		glEnableVertexAttribArray(6);
-		glVertexAttribPointer(6, 4, GL_FLOAT, GL_FALSE, sizeof(SkeletalMeshVertex), (void*)offsetof(SkeletalMeshVertex, boneWeights));
+	BoundingBox SkinnedMesh::ComputePoseBounds(const glm::mat4* matrixPalette) const noexcept {
+		BoundingBox poseBounds;
+		for (size_t i = 0; i < m_jointBounds.size(); i++) {
+			if (!m_jointBounds[i].IsEmpty())
+				poseBounds.Extend(m_jointBounds[i].Transform(matrixPalette[i]));
+		}
+		return poseBounds;
 	}
 
 	SkinnedMesh::SkinnedMesh(std::shared_ptr<Skeleton> skeleton,
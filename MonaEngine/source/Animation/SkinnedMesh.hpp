@@ -4,7 +4,10 @@
 #include <cstdint>
 #include <memory>
 #include <string>
+#include <vector>
 #include <assimp/scene.h>
+#include <glm/glm.hpp>
+#include "../Rendering/BoundingVolume.hpp"
 namespace Mona {
 	class Skeleton;
 	class SkinnedMesh {
@@ -13,7 +16,21 @@ namespace Mona {
 		~SkinnedMesh();
 		uint32_t GetVertexArrayID() const noexcept { return m_vertexArrayID; }
 		uint32_t GetIndexBufferCount() const noexcept { return m_indexBufferCount; }
+		/*
+		* GL_UNSIGNED_SHORT si la malla tiene hasta 65536 vertices, GL_UNSIGNED_INT en caso contrario.
+		*/
+		uint32_t GetIndexType() const noexcept { return m_indexType; }
 		std::shared_ptr<Skeleton> GetSkeleton() const noexcept { return m_skeletonPtr; }
+		/*
+		* Volumenes envolventes de la malla en la pose de enlace (bind pose).
+		*/
+		const MeshBounds& GetBounds() const noexcept { return m_bounds; }
+		/*
+		* Retorna una caja, en el espacio del modelo, que contiene a la malla deformada por la paleta de matrices entregada.
+		* Cada vertice deformado es una combinacion convexa de sus posiciones transformadas por las articulaciones que lo
+		* influyen, por lo que la union de las cajas de cada articulacion transformadas por su matriz es conservadora.
+		*/
+		BoundingBox ComputePoseBounds(const glm::mat4* matrixPalette) const noexcept;
 	private:
 		SkinnedMesh(std::shared_ptr<Skeleton> skeleton,
 			const std::string& filePath,
@@ -28,6 +45,10 @@ namespace Mona {
 		uint32_t m_vertexBufferID;
 		uint32_t m_indexBufferID;
 		uint32_t m_indexBufferCount;
+		uint32_t m_indexType;
+		MeshBounds m_bounds;
+		//Caja de los vertices influenciados por cada articulacion, en la pose de enlace.
+		std::vector<BoundingBox> m_jointBounds;
 
 	public:
 		SkinnedMesh(std::shared_ptr<Skeleton> skeleton,
@@ -31,6 +31,7 @@ namespace Mona {
 
 		//Se crean una fuente de OpenAL por cada canal solicitado
 		m_channels = channels;
+		m_voiceLimit = channels;
 		m_openALSources.reserve(channels);
 		for (unsigned int i = 0; i < channels; i++) {
 			ALuint source = 0;
@@ -92,7 +93,7 @@ namespace Mona {
 				transformDataManager, listenerPosition);
 
 
-			if (std::distance(m_freeAudioSources.begin(), firstOutFreeSource) + firstOutAudioComponent <= m_openALSources.size()) {
+			if (std::distance(m_freeAudioSources.begin(), firstOutFreeSource) + firstOutAudioComponent <= m_voiceLimit) {
 				//Si descontando las fuentes recien descartadas los recursos de OpenAL son sufientes estos son asignados.
 				AssignOpenALSourceToFreeAudioSources(m_freeAudioSources.begin(), firstOutFreeSource);
 				AssignOpenALSourceToAudioSourceComponents(audioDataManager, transformDataManager, 0, firstOutAudioComponent);
@@ -107,7 +108,7 @@ namespace Mona {
 				//Una vez ordenadas tanto las fuentes libres como las unidas como componentes se procede a otorgar y quitar los recursos de OpenAL a estas
 				uint32_t firstToRemoveFreeSource = 0;
 				uint32_t firstToRemoveSourceComponent = 0;
-				uint32_t sourceCount = m_openALSources.size();
+				uint32_t sourceCount = m_voiceLimit;
 				for (int i = 0; i < static_cast<unsigned int>(AudioSourcePriority::PriorityCount); i++) {
 					if (sourceCount <= countAudioComponents[i]) {
 						firstToRemoveSourceComponent += sourceCount;
@@ -145,6 +146,10 @@ namespace Mona {
 		ALCALL(alListenerf(AL_GAIN, m_masterVolume));
 	}
 
+	void AudioSystem::SetVoiceLimit(uint32_t voiceLimit) noexcept {
+		m_voiceLimit = std::clamp(voiceLimit, 1u, m_channels);
+	}
+
 	void AudioSystem::PlayAudioClip3D(std::shared_ptr<AudioClip> audioClip,
 		const glm::vec3& position,
 		float volume,
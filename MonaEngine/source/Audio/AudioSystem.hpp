@@ -48,6 +48,18 @@ namespace Mona {
 		*/
 		void SetMasterVolume(float volume) noexcept;
 
+		/*
+		* Retorna la cantidad maxima de fuentes que pueden sonar simultaneamente, nunca mayor a la cantidad de canales solicitados al iniciar.
+		*/
+		uint32_t GetVoiceLimit() const noexcept { return m_voiceLimit; }
+
+		/*
+		* Ajusta la cantidad maxima de fuentes que pueden sonar simultaneamente. Si hay mas fuentes sonando, las de menor prioridad
+		* son silenciadas en la siguiente actualizacion del sistema.
+		*/
+		void SetVoiceLimit(uint32_t voiceLimit) noexcept;
+		uint32_t GetChannelCount() const noexcept { return m_channels; }
+
 		/*
 		* Crea una FreeAudioSource (fuente libre) la cual sera responsable de intertar reproducir el audioclip entregado con la posicin,
 		* volumen, tono, radio y prioridad tambien entregados. Esta funcion suele ser llamada por medio de la interfaz de la clase World, cuando
@@ -124,6 +136,7 @@ namespace Mona {
 		std::vector<OpenALSourceArrayEntry> m_openALSources;
 		uint32_t m_firstFreeOpenALSourceIndex;
 		uint32_t m_channels;
+		uint32_t m_voiceLimit = 0;
 		std::vector<FreeAudioSource> m_freeAudioSources;
 		float m_masterVolume;
 	};
@@ -0,0 +1,126 @@
+#include "FrameBudgetGovernor.hpp"
+#include "Config.hpp"
+#include "Log.hpp"
+#include <algorithm>
+namespace Mona {
+
+	void FrameBudgetGovernor::StartUp(const QualitySettings& baseSettings) noexcept {
+		Config& config = Config::GetInstance();
+		m_baseSettings = baseSettings;
+		m_enabled = config.getValueOrDefault<bool>("frame_budget_governor", false);
+		m_targetMilliseconds = config.getValueOrDefault<float>("frame_budget_target_milliseconds", 16.6f);
+		m_restoreThreshold = config.getValueOrDefault<float>("frame_budget_restore_threshold", 0.75f);
+		m_levels.fill(0);
+		m_degradedKnobs.reserve(GetQualityKnobCount() * s_maxLevel);
+	}
+
+	std::string_view FrameBudgetGovernor::GetKnobName(QualityKnob knob) noexcept {
+		switch (knob)
+		{
+		case QualityKnob::AnimationRate: return "AnimationRate";
+		case QualityKnob::PhysicsSubSteps: return "PhysicsSubSteps";
+		case QualityKnob::AudioVoices: return "AudioVoices";
+		case QualityKnob::RenderLOD: return "RenderLOD";
+		case QualityKnob::TickIntervals: return "TickIntervals";
+		default: return "Unknown";
+		}
+	}
+
+	FrameStage FrameBudgetGovernor::GetKnobStage(QualityKnob knob) noexcept {
+		switch (knob)
+		{
+		case QualityKnob::AnimationRate: return FrameStage::Animation;
+		case QualityKnob::PhysicsSubSteps: return FrameStage::Physics;
+		case QualityKnob::AudioVoices: return FrameStage::Audio;
+		case QualityKnob::RenderLOD: return FrameStage::Render;
+		default: return FrameStage::GameObjects;
+		}
+	}
+
+	QualitySettings FrameBudgetGovernor::GetCurrentSettings() const noexcept {
+		//Cada nivel de degradacion reduce aproximadamente a la mitad el costo asociado al parametro.
+		static constexpr float animationIntervals[s_maxLevel + 1] = { 0.0f, 1.0f / 60.0f, 1.0f / 30.0f, 1.0f / 15.0f };
+		static constexpr float voiceFractions[s_maxLevel + 1] = { 1.0f, 0.75f, 0.5f, 0.25f };
+		static constexpr float tickScales[s_maxLevel + 1] = { 1.0f, 1.5f, 2.0f, 3.0f };
+		QualitySettings settings = m_baseSettings;
+		const uint8_t animationLevel = GetLevel(QualityKnob::AnimationRate);
+		settings.animationUpdateInterval = std::max(m_baseSettings.animationUpdateInterval, animationIntervals[animationLevel]);
+		settings.physicsMaxSubSteps = std::max(1, m_baseSettings.physicsMaxSubSteps >> GetLevel(QualityKnob::PhysicsSubSteps));
+		settings.audioVoiceLimit = std::max(1u,
+			static_cast<uint32_t>(m_baseSettings.audioVoiceLimit * voiceFractions[GetLevel(QualityKnob::AudioVoices)]));
+		settings.renderLODBias = m_baseSettings.renderLODBias + static_cast<float>(GetLevel(QualityKnob::RenderLOD));
+		settings.tickIntervalScale = m_baseSettings.tickIntervalScale * tickScales[GetLevel(QualityKnob::TickIntervals)];
+		return settings;
+	}
+
+	bool FrameBudgetGovernor::Update(const FrameTimings& timings) noexcept {
+		if (!m_enabled)
+			return false;
+		//La etapa de presentacion se excluye ya que incluye la espera por sincronizacion vertical.
+		const float frameMilliseconds = timings.totalMilliseconds - timings.GetStageMilliseconds(FrameStage::Present);
+		m_smoothedMilliseconds += m_smoothingFactor * (frameMilliseconds - m_smoothedMilliseconds);
+		for (uint8_t i = 0; i < GetFrameStageCount(); i++) {
+			m_smoothedStageMilliseconds[i] += m_smoothingFactor * (timings.stageMilliseconds[i] - m_smoothedStageMilliseconds[i]);
+		}
+		if (m_cooldownCount > 0) {
+			m_cooldownCount--;
+			return false;
+		}
+		if (m_smoothedMilliseconds > m_targetMilliseconds) {
+			m_underBudgetCount = 0;
+			if (++m_overBudgetCount < m_degradeFrames)
+				return false;
+			m_overBudgetCount = 0;
+			return Degrade(timings);
+		}
+		m_overBudgetCount = 0;
+		if (m_smoothedMilliseconds < m_targetMilliseconds * m_restoreThreshold && !m_degradedKnobs.empty()) {
+			if (++m_underBudgetCount < m_restoreFrames)
+				return false;
+			m_underBudgetCount = 0;
+			return Restore();
+		}
+		m_underBudgetCount = 0;
+		return false;
+	}
+
+	bool FrameBudgetGovernor::Degrade(const FrameTimings& timings) noexcept {
+		//Se degrada el parametro asociado a la etapa con mayor tiempo promedio entre los que aun pueden degradarse.
+		int selectedKnob = -1;
+		float selectedMilliseconds = -1.0f;
+		for (uint8_t i = 0; i < GetQualityKnobCount(); i++) {
+			if (m_levels[i] >= s_maxLevel)
+				continue;
+			//Reducir pasos de simulacion no tiene efecto si ya se realiza un unico paso por frame.
+			if (static_cast<QualityKnob>(i) == QualityKnob::PhysicsSubSteps && (m_baseSettings.physicsMaxSubSteps >> m_levels[i]) <= 1)
+				continue;
+			const float stageMilliseconds = m_smoothedStageMilliseconds[static_cast<uint8_t>(GetKnobStage(static_cast<QualityKnob>(i)))];
+			if (stageMilliseconds > selectedMilliseconds) {
+				selectedKnob = i;
+				selectedMilliseconds = stageMilliseconds;
+			}
+		}
+		if (selectedKnob < 0)
+			return false;
+		const QualityKnob knob = static_cast<QualityKnob>(selectedKnob);
+		m_levels[selectedKnob]++;
+		m_degradedKnobs.push_back(knob);
+		m_cooldownCount = m_cooldownFrames;
+		MONA_LOG_INFO("FrameBudgetGovernor: Frame {0} averaging {1:.2f}ms over {2:.2f}ms target, {3} stage averaging {4:.2f}ms. Degrading {5} to level {6}",
+			timings.frameIndex, m_smoothedMilliseconds, m_targetMilliseconds, GetFrameStageName(GetKnobStage(knob)), selectedMilliseconds,
+			GetKnobName(knob), m_levels[selectedKnob]);
+		return true;
+	}
+
+	bool FrameBudgetGovernor::Restore() noexcept {
+		//Se restaura primero el ultimo parametro degradado.
+		const QualityKnob knob = m_degradedKnobs.back();
+		m_degradedKnobs.pop_back();
+		const uint8_t index = static_cast<uint8_t>(knob);
+		m_levels[index]--;
+		m_cooldownCount = m_cooldownFrames;
+		MONA_LOG_INFO("FrameBudgetGovernor: Averaging {0:.2f}ms under {1:.2f}ms target. Restoring {2} to level {3}",
+			m_smoothedMilliseconds, m_targetMilliseconds, GetKnobName(knob), m_levels[index]);
+		return true;
+	}
+}
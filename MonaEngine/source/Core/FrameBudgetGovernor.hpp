@@ -0,0 +1,89 @@
+#pragma once
+#ifndef FRAMEBUDGETGOVERNOR_HPP
+#define FRAMEBUDGETGOVERNOR_HPP
+#include <array>
+#include <vector>
+#include <cstdint>
+#include <string_view>
+#include "FrameTimings.hpp"
+namespace Mona {
+	/*
+	* Parametros de calidad que el motor puede degradar para mantener el tiempo por frame bajo el objetivo.
+	*/
+	enum class QualityKnob : uint8_t {
+		AnimationRate,
+		PhysicsSubSteps,
+		AudioVoices,
+		RenderLOD,
+		TickIntervals,
+		KnobCount
+	};
+
+	constexpr uint8_t GetQualityKnobCount() {
+		return static_cast<uint8_t>(QualityKnob::KnobCount);
+	}
+
+	/*
+	* Valores concretos de los parametros de calidad para un conjunto de niveles de degradacion. Cada nivel de PhysicsSubSteps
+	* divide a la mitad physicsMaxSubSteps sin bajar de un paso, por lo que ese parametro solo puede degradarse si la
+	* configuracion base usa mas de un paso por frame (physics_max_substeps en config.cfg, uno por defecto).
+	*/
+	struct QualitySettings {
+		float animationUpdateInterval = 0.0f;
+		int physicsMaxSubSteps = 1;
+		uint32_t audioVoiceLimit = 0;
+		float renderLODBias = 0.0f;
+		float tickIntervalScale = 1.0f;
+	};
+
+	/*
+	* Controlador que observa los tiempos de cada frame (World::GetLastFrameTimings) y ajusta el nivel de degradacion de cada
+	* parametro de calidad. Cuando el tiempo promedio supera el objetivo durante varios frames se degrada el parametro asociado
+	* a la etapa mas costosa; cuando el tiempo promedio queda bajo una fraccion del objetivo durante mas frames se restaura el
+	* ultimo parametro degradado. La diferencia entre ambos umbrales, la cantidad de frames requeridos y un periodo de espera luego
+	* de cada cambio evitan que los parametros oscilen. Cada ajuste se registra en el log.
+	*/
+	class FrameBudgetGovernor {
+	public:
+		static constexpr uint8_t s_maxLevel = 3;
+		FrameBudgetGovernor() = default;
+		/*
+		* baseSettings corresponde a la calidad maxima (nivel cero de todos los parametros).
+		*/
+		void StartUp(const QualitySettings& baseSettings) noexcept;
+		bool IsEnabled() const noexcept { return m_enabled; }
+		void SetEnabled(bool enabled) noexcept { m_enabled = enabled; }
+		float GetTargetMilliseconds() const noexcept { return m_targetMilliseconds; }
+		void SetTargetMilliseconds(float target) noexcept { m_targetMilliseconds = target; }
+		float GetSmoothedMilliseconds() const noexcept { return m_smoothedMilliseconds; }
+		uint8_t GetLevel(QualityKnob knob) const noexcept { return m_levels[static_cast<uint8_t>(knob)]; }
+
+		/*
+		* Incorpora los tiempos del ultimo frame. Retorna verdadero si cambio el nivel de algun parametro, en ese caso
+		* GetCurrentSettings entrega los nuevos valores que deben aplicarse.
+		*/
+		bool Update(const FrameTimings& timings) noexcept;
+		QualitySettings GetCurrentSettings() const noexcept;
+		static std::string_view GetKnobName(QualityKnob knob) noexcept;
+	private:
+		static FrameStage GetKnobStage(QualityKnob knob) noexcept;
+		bool Degrade(const FrameTimings& timings) noexcept;
+		bool Restore() noexcept;
+		QualitySettings m_baseSettings;
+		std::array<uint8_t, GetQualityKnobCount()> m_levels = {};
+		std::array<float, GetFrameStageCount()> m_smoothedStageMilliseconds = {};
+		std::vector<QualityKnob> m_degradedKnobs;
+		bool m_enabled = false;
+		float m_targetMilliseconds = 16.6f;
+		float m_restoreThreshold = 0.75f;
+		float m_smoothingFactor = 0.1f;
+		float m_smoothedMilliseconds = 0.0f;
+		uint32_t m_degradeFrames = 15;
+		uint32_t m_restoreFrames = 120;
+		uint32_t m_cooldownFrames = 30;
+		uint32_t m_overBudgetCount = 0;
+		uint32_t m_underBudgetCount = 0;
+		uint32_t m_cooldownCount = 0;
+	};
+}
+#endif
@@ -0,0 +1,53 @@
+#pragma once
+#ifndef FRAMETIMINGS_HPP
+#define FRAMETIMINGS_HPP
+#include <array>
+#include <cstdint>
+#include <string_view>
+namespace Mona {
+	/*
+	* Etapas en las que se divide cada iteracion del main loop del motor (ver World::Update).
+	*/
+	enum class FrameStage : uint8_t {
+		Input,
+		Physics,
+		Animation,
+		GameObjects,
+		Application,
+		Audio,
+		Render,
+		Present,
+		StageCount
+	};
+
+	constexpr uint8_t GetFrameStageCount() {
+		return static_cast<uint8_t>(FrameStage::StageCount);
+	}
+
+	constexpr std::string_view GetFrameStageName(FrameStage stage) {
+		switch (stage)
+		{
+		case FrameStage::Input: return "Input";
+		case FrameStage::Physics: return "Physics";
+		case FrameStage::Animation: return "Animation";
+		case FrameStage::GameObjects: return "GameObjects";
+		case FrameStage::Application: return "Application";
+		case FrameStage::Audio: return "Audio";
+		case FrameStage::Render: return "Render";
+		case FrameStage::Present: return "Present";
+		default: return "Unknown";
+		}
+	}
+
+	/*
+	* Tiempos medidos en CPU (en milisegundos) de cada etapa de un frame.
+	*/
+	struct FrameTimings {
+		uint64_t frameIndex = 0;
+		float timeStep = 0.0f;
+		float totalMilliseconds = 0.0f;
+		std::array<float, GetFrameStageCount()> stageMilliseconds = {};
+		float GetStageMilliseconds(FrameStage stage) const { return stageMilliseconds[static_cast<uint8_t>(stage)]; }
+	};
+}
+#endif
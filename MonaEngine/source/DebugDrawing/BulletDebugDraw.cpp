@@ -1,5 +1,6 @@
 #include "BulletDebugDraw.hpp"
 #include <glad/glad.h>
+#include "../Rendering/RenderDevice.hpp"
 namespace Mona {
 	void BulletDebugDraw::setDebugMode(int debugMode) {
 		m_bDrawWireframe = (debugMode & btIDebugDraw::DebugDrawModes::DBG_DrawWireframe);
@@ -13,17 +14,18 @@ namespace Mona {
 	}
 
 	void BulletDebugDraw::StartUp() noexcept {
-		glCreateVertexArrays(1, &VAO);
-		glLineWidth(3);
+		VAO = RenderDevice::GetInstance().CreateVertexArray();
+		RenderDevice::GetInstance().SetLineWidth(3);
 	}
 
 
 	void BulletDebugDraw::drawLine(const btVector3& from, const btVector3& to, const btVector3& color) {
-		glBindVertexArray(VAO);
-		glUniform3f(2, from.x(), from.y(), from.z());
-		glUniform3f(3, to.x(), to.y(), to.z());
-		glUniform3f(5, color.x(), color.y(), color.z());
-		glDrawArrays(GL_LINES, 0, 2);
+		RenderDevice& device = RenderDevice::GetInstance();
+		device.BindVertexArray(VAO);
+		device.SetUniform(2, glm::vec3(from.x(), from.y(), from.z()));
+		device.SetUniform(3, glm::vec3(to.x(), to.y(), to.z()));
+		device.SetUniform(5, glm::vec3(color.x(), color.y(), color.z()));
+		device.DrawArrays(GL_LINES, 0, 2);
 
 
 	}
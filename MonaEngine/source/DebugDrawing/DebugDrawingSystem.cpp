@@ -12,6 +12,7 @@
 #include <glm/gtc/type_ptr.hpp>
 #include "../PhysicsCollision/PhysicsCollisionSystem.hpp"
 #include "../Core/RootDirectory.hpp"
+#include "../Rendering/RenderDevice.hpp"
 void GLAPIENTRY MessageCallback(GLenum source,
 	GLenum type,
 	GLuint id,
@@ -27,11 +28,12 @@ void GLAPIENTRY MessageCallback(GLenum source,
 namespace Mona {
 
 
-	void DebugDrawingSystem::Draw(EventManager& eventManager, const glm::mat4& viewMatrix, const glm::mat4& projectionMatrix) noexcept {
+	void DebugDrawingSystem::Draw(EventManager& eventManager, const glm::mat4& viewMatrix, const glm::mat4& projectionMatrix,
+		const RenderStatistics& renderStatistics) noexcept {
 
-		glUseProgram(m_lineShader.GetProgramID());
-		glUniformMatrix4fv(0, 1, GL_FALSE, glm::value_ptr(projectionMatrix));
-		glUniformMatrix4fv(1, 1, GL_FALSE, glm::value_ptr(viewMatrix));
+		RenderDevice::GetInstance().UseProgram(m_lineShader.GetProgramID());
+		RenderDevice::GetInstance().SetUniform(0, projectionMatrix);
+		RenderDevice::GetInstance().SetUniform(1, viewMatrix);
 		m_physicsWorldPtr->debugDrawWorld();
 
 
@@ -47,10 +49,31 @@ namespace Mona {
 			ImGui::Checkbox("Draw Wireframe", &(m_bulletDebugDrawPtr->m_bDrawWireframe));
 			ImGui::Checkbox("Draw ContactPoints", &(m_bulletDebugDrawPtr->m_bDrawContactsPoints));
 			ImGui::Checkbox("Draw AABB", &(m_bulletDebugDrawPtr->m_bDrawAABB));
+			ImGui::Separator();
+			ImGui::Text("Render Statistics:");
+			ImGui::Text("Draw calls: %u, Triangles: %llu, Instances: %u", renderStatistics.drawCalls,
+				static_cast<unsigned long long>(renderStatistics.triangles), renderStatistics.instances);
+			ImGui::Text("Binds: %u programs, %u VAOs, %u textures", renderStatistics.programBinds,
+				renderStatistics.vertexArrayBinds, renderStatistics.textureBinds);
+			ImGui::Text("Uniforms: %u updates (%llu bytes)", renderStatistics.uniformUpdates,
+				static_cast<unsigned long long>(renderStatistics.uniformBytes));
+			ImGui::Text("Uploaded: UBO %llu bytes, SSBO %llu bytes, Indirect %llu bytes",
+				static_cast<unsigned long long>(renderStatistics.uniformBufferBytes),
+				static_cast<unsigned long long>(renderStatistics.storageBufferBytes),
+				static_cast<unsigned long long>(renderStatistics.indirectCommandBytes));
+			ImGui::Text("Objects: %u submitted", renderStatistics.submittedCount);
+			ImGui::Text("Culled: %u frustum, %u PVS, %u occluded, %u clusters", renderStatistics.frustumCulledCount,
+				renderStatistics.pvsCulledCount, renderStatistics.occludedCount, renderStatistics.clusterCulledObjectCount);
+			ImGui::Text("Skinning palettes: %u (%llu bytes)", renderStatistics.skinningPalettes,
+				static_cast<unsigned long long>(renderStatistics.skinningPaletteBytes));
+			ImGui::Text("Static meshes patched: %u, Draw lists reused: %s", renderStatistics.patchedStaticMeshCount,
+				renderStatistics.drawListsReused ? "yes" : "no");
+			ImGui::Text("Materials: %u, Merged materials: %u", renderStatistics.materialCount, renderStatistics.mergedMaterialCount);
 			ImGui::End();
 		}
 		eventManager.Publish(DebugGUIEvent());
 		ImGui::Render();
+		//ImGui restaura el estado de OpenGL que modifica, por lo que el estado guardado en RenderDevice sigue siendo valido.
 		ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
 	}
 	void DebugDrawingSystem::StartUp(PhysicsCollisionSystem* physicsSystemPtr) noexcept {
@@ -62,7 +85,7 @@ namespace Mona {
 		m_bulletDebugDrawPtr->setDebugMode(0);
 		m_physicsWorldPtr->setDebugDrawer(m_bulletDebugDrawPtr.get());
 
-		glEnable(GL_DEBUG_OUTPUT);
+		RenderDevice::GetInstance().Enable(GL_DEBUG_OUTPUT);
 		glDebugMessageCallback(MessageCallback, 0);
 		glDebugMessageControl(GL_DONT_CARE, GL_DONT_CARE, GL_DEBUG_SEVERITY_NOTIFICATION, 0, nullptr, GL_FALSE);
 
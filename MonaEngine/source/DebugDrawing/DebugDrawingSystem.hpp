@@ -3,6 +3,7 @@
 #define DEBUGDRAWINGSYSTEM_HPP
 #include "../Event/EventManager.hpp"
 #include "../Rendering/ShaderProgram.hpp"
+#include "../Rendering/RenderStatistics.hpp"
 #include "BulletDebugDraw.hpp"
 #include <glm/glm.hpp>
 #include <memory>
@@ -13,7 +14,8 @@ namespace Mona {
 	public:
 		DebugDrawingSystem() = default;
 		void StartUp(PhysicsCollisionSystem* physicsSystemPtr)  noexcept {}
-		void Draw(EventManager& eventManager, const glm::mat4& viewMatrix, const glm::mat4& projectionMatrix) noexcept {}
+		void Draw(EventManager& eventManager, const glm::mat4& viewMatrix, const glm::mat4& projectionMatrix,
+			const RenderStatistics& renderStatistics) noexcept {}
 		void ShutDown() noexcept{}
 	};
 }
@@ -27,7 +29,8 @@ namespace Mona {
 	public:
 		DebugDrawingSystem() = default;
 		void StartUp(PhysicsCollisionSystem* physicsSystemPtr)  noexcept;
-		void Draw(EventManager& eventManager, const glm::mat4& viewMatrix, const glm::mat4& projectionMatrix) noexcept;
+		void Draw(EventManager& eventManager, const glm::mat4& viewMatrix, const glm::mat4& projectionMatrix,
+			const RenderStatistics& renderStatistics) noexcept;
 		void ShutDown() noexcept;
 	private:
 		btDynamicsWorld* m_physicsWorldPtr = nullptr;
@@ -18,6 +18,13 @@ namespace Mona {
 		void StartMainLoop() noexcept {
 			m_world.StartMainLoop();
 		}
+		/*
+		* Reproduce la grabacion de input ubicada en recordingPath (ver la opcion input_recording_path del archivo de configuracion)
+		* y escribe los tiempos de cada etapa de cada frame en timingsPath. Retorna falso si alguno de los archivos no pudo ser abierto.
+		*/
+		bool StartReplay(const std::filesystem::path& recordingPath, const std::filesystem::path& timingsPath) noexcept {
+			return m_world.StartReplayLoop(recordingPath, timingsPath);
+		}
 	private:
 		World m_world;
 	};
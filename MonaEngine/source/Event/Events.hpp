@@ -12,6 +12,9 @@ namespace Mona
 	enum class EEventType : uint8_t {
 		WindowResizeEvent,
 		MouseScrollEvent,
+		KeyEvent,
+		MouseButtonEvent,
+		CursorPositionEvent,
 		GameObjectDestroyedEvent,
 		AplicationEndEvent,
 		DebugGUIEvent,
@@ -43,6 +46,29 @@ namespace Mona
 		static constexpr uint8_t eventIndex = GetEventIndex(EEventType::MouseScrollEvent);
 		double xOffset;
 		double yOffset;
+		double timestamp;
+	};
+
+	//Los eventos de input llevan el instante (en segundos, reloj monotono de alta resolucion) en que la ventana los recibio.
+	struct KeyEvent : public Event {
+		static constexpr uint8_t eventIndex = GetEventIndex(EEventType::KeyEvent);
+		int keycode;
+		int action;
+		double timestamp;
+	};
+
+	struct MouseButtonEvent : public Event {
+		static constexpr uint8_t eventIndex = GetEventIndex(EEventType::MouseButtonEvent);
+		int button;
+		int action;
+		double timestamp;
+	};
+
+	struct CursorPositionEvent : public Event {
+		static constexpr uint8_t eventIndex = GetEventIndex(EEventType::CursorPositionEvent);
+		double xPosition;
+		double yPosition;
+		double timestamp;
 	};
 
 	struct GameObjectDestroyedEvent : public Event {
@@ -71,6 +97,9 @@ namespace Mona
 	inline constexpr bool is_event = is_any<EventType,
 											WindowResizeEvent,
 											MouseScrollEvent,
+											KeyEvent,
+											MouseButtonEvent,
+											CursorPositionEvent,
 											GameObjectDestroyedEvent,
 											ApplicationEndEvent,
 											DebugGUIEvent,
@@ -8,7 +8,7 @@
 #include "../Event/EventManager.hpp"
 namespace Mona {
 	void PhysicsCollisionSystem::StepSimulation(float timeStep) noexcept {
-		m_worldPtr->stepSimulation(timeStep);	
+		m_worldPtr->stepSimulation(timeStep, m_maxSubSteps);	
 	}
 
 	void PhysicsCollisionSystem::AddRigidBody(RigidBodyComponent &rigidBody) noexcept {
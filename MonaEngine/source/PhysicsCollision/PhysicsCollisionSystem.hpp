@@ -38,6 +38,12 @@ namespace Mona {
 			ComponentManager<RigidBodyComponent>& rigidBodyDatamanager) const;
 
 		void StepSimulation(float timeStep) noexcept;
+		/*
+		* Cantidad maxima de pasos de largo fijo que puede realizar la simulacion en un frame para alcanzar el tiempo transcurrido.
+		* Con el valor por defecto de un paso FrameBudgetGovernor no tiene pasos que quitar y nunca degrada PhysicsSubSteps.
+		*/
+		int GetMaxSubSteps() const noexcept { return m_maxSubSteps; }
+		void SetMaxSubSteps(int maxSubSteps) noexcept { m_maxSubSteps = maxSubSteps < 1 ? 1 : maxSubSteps; }
 		void SubmitCollisionEvents(World& world,
 			EventManager& eventManager,
 			ComponentManager<RigidBodyComponent>& rigidBodyDatamanager) noexcept;
@@ -62,6 +68,8 @@ namespace Mona {
 		btCollisionDispatcher* m_dispatcherPtr;
 		btConstraintSolver* m_solverPtr;
 		btDynamicsWorld* m_worldPtr;
+		//Se lee desde physics_max_substeps en config.cfg.
+		int m_maxSubSteps = 1;
 
 
 		CollisionSet m_previousCollisionSet;
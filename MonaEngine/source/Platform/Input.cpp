@@ -3,50 +3,139 @@
 #include "../Core/Log.hpp"
 #include "../Event/EventManager.hpp"
 #include "../Event/Events.hpp"
+#include "../Core/Config.hpp"
+#include <chrono>
 #define GLFW_INCLUDE_NONE
 #include <GLFW/glfw3.h>
 namespace Mona
 {
 	class Input::InputImplementation {
 	public:
-		InputImplementation():m_windowHandle(nullptr), m_mouseWheelOffset(0.0,0.0) {}
+		InputImplementation():m_windowHandle(nullptr), m_latestMousePosition(0.0,0.0) {}
 		InputImplementation(const InputImplementation& input) = delete;
 		InputImplementation& operator=(const InputImplementation& input) = delete;
 		void StartUp(EventManager& eventManager) noexcept {
-			m_windowHandle = glfwGetCurrentContext();
-			MONA_ASSERT(m_windowHandle != NULL, "GLFW Error: Unable to find window");
+			m_startTime = std::chrono::steady_clock::now();
+			//Sin ventana (ver Window) no se reciben eventos y el estado del input solo cambia mediante reproducciones.
+			m_headless = Config::GetInstance().getValueOrDefault<bool>("headless_rendering", false);
+			if (!m_headless) {
+				m_windowHandle = glfwGetCurrentContext();
+				MONA_ASSERT(m_windowHandle != NULL, "GLFW Error: Unable to find window");
+			}
 			eventManager.Subscribe(m_mouseScrollSubscription, this, &Input::InputImplementation::OnMouseScroll);
+			eventManager.Subscribe(m_keySubscription, this, &Input::InputImplementation::OnKey);
+			eventManager.Subscribe(m_mouseButtonSubscription, this, &Input::InputImplementation::OnMouseButton);
+			eventManager.Subscribe(m_cursorPositionSubscription, this, &Input::InputImplementation::OnCursorPosition);
+			//La posicion inicial del cursor se consulta directamente, ya que GLFW solo notifica sus cambios.
+			if (!m_headless)
+				glfwGetCursorPos(m_windowHandle, &m_latestMousePosition.x, &m_latestMousePosition.y);
+			m_snapshot.m_mousePosition = m_latestMousePosition;
+			m_snapshot.m_timestamp = GetTime();
 		}
 
 		void ShutDown(EventManager& eventManager) noexcept {
 			eventManager.Unsubscribe(m_mouseScrollSubscription);
+			eventManager.Unsubscribe(m_keySubscription);
+			eventManager.Unsubscribe(m_mouseButtonSubscription);
+			eventManager.Unsubscribe(m_cursorPositionSubscription);
 		}
 		void Update() noexcept {
-			m_mouseWheelOffset.x = 0.0;
-			m_mouseWheelOffset.y = 0.0;
-			glfwPollEvents();
+			PollEvents();
+			//Los eventos recibidos desde el frame anterior (incluidos los recolectados por LateLatch) pasan a ser los eventos
+			//del frame actual y se aplican en orden de llegada sobre el estado anterior para construir la nueva instantanea.
+			m_frameEvents.swap(m_pendingEvents);
+			m_pendingEvents.clear();
+			m_snapshot.m_mouseWheelOffset = glm::dvec2(0.0, 0.0);
+			for (const InputEvent& e : m_frameEvents) {
+				ApplyEvent(m_snapshot, e);
+			}
+			m_snapshot.m_timestamp = GetTime();
+			m_snapshot.m_frameIndex += 1;
+		}
+		void LateLatch() noexcept {
+			PollEvents();
+		}
+		void ReplayUpdate(const InputSnapshot& snapshot) noexcept {
+			PollEvents();
+			m_pendingEvents.clear();
+			m_frameEvents.clear();
+			m_snapshot = snapshot;
+			m_latestMousePosition = snapshot.m_mousePosition;
+		}
+		void ReplayLateLatch(const glm::dvec2& latestMousePosition) noexcept {
+			m_latestMousePosition = latestMousePosition;
 		}
 		void OnMouseScroll(const MouseScrollEvent& e)
 		{
-			m_mouseWheelOffset = glm::dvec2(e.xOffset, e.yOffset);
+			m_pendingEvents.push_back({ InputEvent::Type::MouseScroll, -1, 0, glm::dvec2(e.xOffset, e.yOffset), e.timestamp });
+		}
+		void OnKey(const KeyEvent& e)
+		{
+			m_pendingEvents.push_back({ InputEvent::Type::Key, e.keycode, e.action, glm::dvec2(0.0, 0.0), e.timestamp });
+		}
+		void OnMouseButton(const MouseButtonEvent& e)
+		{
+			m_pendingEvents.push_back({ InputEvent::Type::MouseButton, e.button, e.action, glm::dvec2(0.0, 0.0), e.timestamp });
+		}
+		void OnCursorPosition(const CursorPositionEvent& e)
+		{
+			m_latestMousePosition = glm::dvec2(e.xPosition, e.yPosition);
+			m_pendingEvents.push_back({ InputEvent::Type::CursorPosition, -1, 0, m_latestMousePosition, e.timestamp });
+		}
+		static void ApplyEvent(InputSnapshot& snapshot, const InputEvent& e) noexcept {
+			switch (e.type)
+			{
+				case InputEvent::Type::Key:
+				{
+					//GLFW reporta teclas desconocidas con keycode -1
+					if (e.code >= 0 && e.code < InputSnapshot::NUM_KEYS)
+						snapshot.m_keys.set(e.code, e.action != GLFW_RELEASE);
+					return;
+				}
+				case InputEvent::Type::MouseButton:
+				{
+					if (e.code >= 0 && e.code < InputSnapshot::NUM_MOUSE_BUTTONS)
+						snapshot.m_mouseButtons.set(e.code, e.action != GLFW_RELEASE);
+					return;
+				}
+				case InputEvent::Type::CursorPosition:
+				{
+					snapshot.m_mousePosition = e.value;
+					return;
+				}
+				case InputEvent::Type::MouseScroll:
+				{
+					snapshot.m_mouseWheelOffset += e.value;
+					return;
+				}
+			}
 		}
 		inline bool IsKeyPressed(int keycode) const noexcept
 		{
-			return glfwGetKey(m_windowHandle, keycode) == GLFW_PRESS;
+			return m_snapshot.IsKeyPressed(keycode);
 		}
 		inline bool IsMouseButtonPressed(int button) const noexcept {
-			return glfwGetMouseButton(m_windowHandle, button) == GLFW_PRESS;
+			return m_snapshot.IsMouseButtonPressed(button);
 		}
 		inline glm::dvec2 GetMousePosition() const noexcept {
-			double x, y;
-			glfwGetCursorPos(m_windowHandle, &x, &y);
-			return glm::dvec2(x, y);
+			return m_snapshot.GetMousePosition();
 		}
 		inline glm::dvec2 GetMouseWheelOffset() const noexcept {
-			return m_mouseWheelOffset;
+			return m_snapshot.GetMouseWheelOffset();
+		}
+		inline glm::dvec2 GetLatestMousePosition() const noexcept {
+			return m_latestMousePosition;
+		}
+		const InputSnapshot& GetSnapshot() const noexcept {
+			return m_snapshot;
+		}
+		const std::vector<InputEvent>& GetFrameEvents() const noexcept {
+			return m_frameEvents;
 		}
 		void SetCursorType(CursorType type) noexcept
 		{
+			if (m_headless)
+				return;
 			switch (type)
 			{
 				case CursorType::Disabled: 
@@ -68,9 +157,26 @@ namespace Mona
 			}
 		}
 	private:
+		void PollEvents() noexcept {
+			if (!m_headless)
+				glfwPollEvents();
+		}
+		double GetTime() const noexcept {
+			if (!m_headless)
+				return glfwGetTime();
+			return std::chrono::duration<double>(std::chrono::steady_clock::now() - m_startTime).count();
+		}
 		GLFWwindow* m_windowHandle;
-		glm::dvec2 m_mouseWheelOffset;
+		bool m_headless = false;
+		std::chrono::steady_clock::time_point m_startTime;
+		InputSnapshot m_snapshot;
+		glm::dvec2 m_latestMousePosition;
+		std::vector<InputEvent> m_pendingEvents;
+		std::vector<InputEvent> m_frameEvents;
 		SubscriptionHandle m_mouseScrollSubscription;
+		SubscriptionHandle m_keySubscription;
+		SubscriptionHandle m_mouseButtonSubscription;
+		SubscriptionHandle m_cursorPositionSubscription;
 	};
 
 	Input::Input() : p_Impl(std::make_unique<InputImplementation>()) {}
@@ -106,6 +212,36 @@ namespace Mona
 		p_Impl->SetCursorType(type);
 	}
 
+	const InputSnapshot& Input::GetSnapshot() const noexcept
+	{
+		return p_Impl->GetSnapshot();
+	}
+
+	const std::vector<InputEvent>& Input::GetFrameEvents() const noexcept
+	{
+		return p_Impl->GetFrameEvents();
+	}
+
+	glm::dvec2 Input::GetLatestMousePosition() const noexcept
+	{
+		return p_Impl->GetLatestMousePosition();
+	}
+
+	void Input::LateLatch() noexcept
+	{
+		p_Impl->LateLatch();
+	}
+
+	void Input::ReplayUpdate(const InputSnapshot& snapshot) noexcept
+	{
+		p_Impl->ReplayUpdate(snapshot);
+	}
+
+	void Input::ReplayLateLatch(const glm::dvec2& latestMousePosition) noexcept
+	{
+		p_Impl->ReplayLateLatch(latestMousePosition);
+	}
+
 	void Input::StartUp(EventManager& eventManager) noexcept {
 		p_Impl->StartUp(eventManager);
 	}
@@ -3,11 +3,76 @@
 #define INPUT_HPP
 #include <glm/glm.hpp>
 #include <memory>
+#include <vector>
+#include <bitset>
+#include <cstdint>
+#include "KeyCodes.hpp"
 
 namespace Mona
 {
 	class World;
 	class EventManager;
+
+	/*
+	* Evento de teclado o mouse tal como fue recibido por la ventana, junto al instante (en segundos) de su llegada.
+	* code corresponde al keycode o boton del mouse y vale -1 para eventos de cursor y rueda, cuyos datos van en value.
+	*/
+	struct InputEvent {
+		enum class Type : uint8_t { Key, MouseButton, CursorPosition, MouseScroll };
+		Type type;
+		int code;
+		int action;
+		glm::dvec2 value;
+		double timestamp;
+	};
+
+	/*
+	* Estado inmutable de teclado y mouse. La clase Input construye una instancia al comienzo de cada frame aplicando en orden
+	* todos los eventos recibidos desde el frame anterior, de esta forma todas las consultas de un mismo frame son consistentes.
+	*/
+	class InputSnapshot {
+	public:
+		static constexpr int NUM_KEYS = MONA_KEY_LAST + 1;
+		static constexpr int NUM_MOUSE_BUTTONS = MONA_MOUSE_BUTTON_LAST + 1;
+		InputSnapshot() : m_mousePosition(0.0, 0.0), m_mouseWheelOffset(0.0, 0.0), m_timestamp(0.0), m_frameIndex(0) {}
+		InputSnapshot(const std::bitset<NUM_KEYS>& keys,
+			const std::bitset<NUM_MOUSE_BUTTONS>& mouseButtons,
+			const glm::dvec2& mousePosition,
+			const glm::dvec2& mouseWheelOffset,
+			double timestamp,
+			uint64_t frameIndex) :
+			m_keys(keys),
+			m_mouseButtons(mouseButtons),
+			m_mousePosition(mousePosition),
+			m_mouseWheelOffset(mouseWheelOffset),
+			m_timestamp(timestamp),
+			m_frameIndex(frameIndex)
+		{}
+		bool operator==(const InputSnapshot& other) const noexcept = default;
+		bool IsKeyPressed(int keycode) const noexcept {
+			return keycode >= 0 && keycode < NUM_KEYS && m_keys.test(keycode);
+		}
+		bool IsMouseButtonPressed(int button) const noexcept {
+			return button >= 0 && button < NUM_MOUSE_BUTTONS && m_mouseButtons.test(button);
+		}
+		const glm::dvec2& GetMousePosition() const noexcept { return m_mousePosition; }
+		const glm::dvec2& GetMouseWheelOffset() const noexcept { return m_mouseWheelOffset; }
+		/*
+		* Instante (en segundos) en que fue construida la instantanea.
+		*/
+		double GetTimestamp() const noexcept { return m_timestamp; }
+		uint64_t GetFrameIndex() const noexcept { return m_frameIndex; }
+	private:
+		friend class Input;
+		friend class InputRecording;
+		std::bitset<NUM_KEYS> m_keys;
+		std::bitset<NUM_MOUSE_BUTTONS> m_mouseButtons;
+		glm::dvec2 m_mousePosition;
+		glm::dvec2 m_mouseWheelOffset;
+		double m_timestamp;
+		uint64_t m_frameIndex;
+	};
+
 	/*
 	* La clase Input provee una interfaz que permite al usuario hacer consultas sobre distintos dispositivos(teclado y mouse).
 	* El motor internamente usa los metodos privados para actualizar cuando corresponda el estado de esta clase.
@@ -47,12 +112,41 @@ namespace Mona
 		* Ajusta el tipo de cursor al tipo entregado
 		*/
 		void SetCursorType(CursorType type) noexcept;
+
+		/*
+		* Retorna la instantanea del estado de los dispositivos para el frame actual. Los metodos de consulta anteriores leen de ella.
+		*/
+		const InputSnapshot& GetSnapshot() const noexcept;
+
+		/*
+		* Retorna, en orden de llegada, los eventos con los que se construyo la instantanea del frame actual.
+		*/
+		const std::vector<InputEvent>& GetFrameEvents() const noexcept;
+
+		/*
+		* Retorna la posicion del mouse mas reciente conocida por el motor. Puede ser mas nueva que la de la instantanea del frame
+		* cuando el motor recolecta eventos tardiamente justo antes de renderizar (ver World::SetCameraLateLatchHook).
+		*/
+		glm::dvec2 GetLatestMousePosition() const noexcept;
 	private:
 
 		/*
 		* Funcin llamada cada iteracin del motor para actualizar el estado de los eventos de input
 		*/
 		void Update() noexcept;
+		/*
+		* Recolecta los eventos pendientes sin modificar la instantanea del frame actual, estos se aplicaran en la siguiente llamada a Update.
+		*/
+		void LateLatch() noexcept;
+		/*
+		* Reemplaza la instantanea del frame actual por una grabada previamente (ver InputRecording). Los eventos recibidos
+		* desde la ventana se descartan para que la reproduccion sea determinista.
+		*/
+		void ReplayUpdate(const InputSnapshot& snapshot) noexcept;
+		/*
+		* Equivalente a LateLatch durante una reproduccion, reemplaza la posicion mas reciente del mouse por la grabada.
+		*/
+		void ReplayLateLatch(const glm::dvec2& latestMousePosition) noexcept;
 		void StartUp(EventManager& eventManager) noexcept;
 		void ShutDown(EventManager& eventManager) noexcept;
 		class InputImplementation;
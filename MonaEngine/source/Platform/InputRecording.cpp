@@ -0,0 +1,114 @@
+#include "InputRecording.hpp"
+#include "../Core/Log.hpp"
+#include <fstream>
+#include <cstring>
+namespace Mona {
+
+	template <typename T>
+	static void WriteValue(std::ofstream& out, const T& value) {
+		out.write(reinterpret_cast<const char*>(&value), sizeof(T));
+	}
+
+	template <typename T>
+	static bool ReadValue(std::ifstream& in, T& value) {
+		in.read(reinterpret_cast<char*>(&value), sizeof(T));
+		return static_cast<bool>(in);
+	}
+
+	void InputRecording::AddFrame(float timeStep, const InputSnapshot& snapshot, const glm::dvec2& lateLatchedMousePosition) {
+		m_frames.push_back({ timeStep, snapshot, lateLatchedMousePosition });
+	}
+
+	bool InputRecording::SaveToFile(const std::filesystem::path& filePath) const noexcept {
+		std::ofstream out(filePath, std::ios::binary);
+		if (!out.is_open()) {
+			MONA_LOG_ERROR("InputRecording Error: Failed to open file {0} for writing", filePath.string());
+			return false;
+		}
+		out.write(s_magic, sizeof(s_magic));
+		WriteValue(out, s_version);
+		WriteValue(out, static_cast<uint32_t>(m_frames.size()));
+		//Cada frame guarda: paso de tiempo, instante, posicion y rueda del mouse, botones como mascara de bits, la lista de
+		//teclas que cambiaron de estado respecto del frame anterior y la posicion tardia del mouse.
+		std::bitset<InputSnapshot::NUM_KEYS> previousKeys;
+		std::vector<uint16_t> changedKeys;
+		for (const Frame& frame : m_frames) {
+			const InputSnapshot& snapshot = frame.snapshot;
+			WriteValue(out, frame.timeStep);
+			WriteValue(out, snapshot.m_timestamp);
+			WriteValue(out, snapshot.m_mousePosition.x);
+			WriteValue(out, snapshot.m_mousePosition.y);
+			WriteValue(out, snapshot.m_mouseWheelOffset.x);
+			WriteValue(out, snapshot.m_mouseWheelOffset.y);
+			WriteValue(out, static_cast<uint8_t>(snapshot.m_mouseButtons.to_ulong()));
+			const auto keyChanges = snapshot.m_keys ^ previousKeys;
+			changedKeys.clear();
+			for (uint16_t key = 0; key < InputSnapshot::NUM_KEYS; key++) {
+				if (keyChanges.test(key))
+					changedKeys.push_back(key);
+			}
+			WriteValue(out, static_cast<uint16_t>(changedKeys.size()));
+			out.write(reinterpret_cast<const char*>(changedKeys.data()), changedKeys.size() * sizeof(uint16_t));
+			WriteValue(out, frame.lateLatchedMousePosition.x);
+			WriteValue(out, frame.lateLatchedMousePosition.y);
+			previousKeys = snapshot.m_keys;
+		}
+		return static_cast<bool>(out);
+	}
+
+	bool InputRecording::LoadFromFile(const std::filesystem::path& filePath) noexcept {
+		std::ifstream in(filePath, std::ios::binary);
+		if (!in.is_open()) {
+			MONA_LOG_ERROR("InputRecording Error: Failed to open file {0}", filePath.string());
+			return false;
+		}
+		char magic[4];
+		uint32_t version = 0;
+		uint32_t frameCount = 0;
+		in.read(magic, sizeof(magic));
+		if (!in || std::memcmp(magic, s_magic, sizeof(s_magic)) != 0 || !ReadValue(in, version) || version == 0 || version > s_version) {
+			MONA_LOG_ERROR("InputRecording Error: File {0} is not a valid input recording", filePath.string());
+			return false;
+		}
+		if (!ReadValue(in, frameCount))
+			return false;
+		std::vector<Frame> frames;
+		frames.reserve(frameCount);
+		std::bitset<InputSnapshot::NUM_KEYS> keys;
+		for (uint32_t i = 0; i < frameCount; i++) {
+			Frame frame;
+			InputSnapshot& snapshot = frame.snapshot;
+			uint8_t mouseButtons = 0;
+			uint16_t changedKeyCount = 0;
+			bool success = ReadValue(in, frame.timeStep) &&
+				ReadValue(in, snapshot.m_timestamp) &&
+				ReadValue(in, snapshot.m_mousePosition.x) &&
+				ReadValue(in, snapshot.m_mousePosition.y) &&
+				ReadValue(in, snapshot.m_mouseWheelOffset.x) &&
+				ReadValue(in, snapshot.m_mouseWheelOffset.y) &&
+				ReadValue(in, mouseButtons) &&
+				ReadValue(in, changedKeyCount);
+			for (uint16_t k = 0; success && k < changedKeyCount; k++) {
+				uint16_t key = 0;
+				success = ReadValue(in, key) && key < InputSnapshot::NUM_KEYS;
+				if (success)
+					keys.flip(key);
+			}
+			if (version >= 2) {
+				success = success && ReadValue(in, frame.lateLatchedMousePosition.x) && ReadValue(in, frame.lateLatchedMousePosition.y);
+			}
+			else
+				frame.lateLatchedMousePosition = snapshot.m_mousePosition;
+			if (!success) {
+				MONA_LOG_ERROR("InputRecording Error: Unexpected end of file {0} at frame {1}", filePath.string(), i);
+				return false;
+			}
+			snapshot.m_mouseButtons = std::bitset<InputSnapshot::NUM_MOUSE_BUTTONS>(mouseButtons);
+			snapshot.m_keys = keys;
+			snapshot.m_frameIndex = i + 1;
+			frames.push_back(frame);
+		}
+		m_frames = std::move(frames);
+		return true;
+	}
+}
@@ -0,0 +1,45 @@
+#pragma once
+#ifndef INPUTRECORDING_HPP
+#define INPUTRECORDING_HPP
+#include <vector>
+#include <filesystem>
+#include "Input.hpp"
+namespace Mona {
+	/*
+	* Secuencia de frames grabados desde una sesion interactiva: para cada frame se guarda el paso de tiempo usado por
+	* World::StartMainLoop, la instantanea de input del frame y la posicion del mouse recolectada justo antes de renderizar,
+	* que es la que recibe el ajuste tardio de la camara (ver World::SetCameraLateLatchHook). Al reproducirla el motor ejecuta exactamente la misma
+	* secuencia de frames, lo que permite comparar rendimiento y detectar regresiones de forma reproducible.
+	*/
+	class InputRecording {
+	public:
+		struct Frame {
+			float timeStep;
+			InputSnapshot snapshot;
+			glm::dvec2 lateLatchedMousePosition;
+		};
+		InputRecording() = default;
+		void AddFrame(float timeStep, const InputSnapshot& snapshot, const glm::dvec2& lateLatchedMousePosition);
+		void Clear() noexcept { m_frames.clear(); }
+		size_t GetFrameCount() const noexcept { return m_frames.size(); }
+		const Frame& GetFrame(size_t index) const noexcept { return m_frames[index]; }
+
+		/*
+		* Guarda la grabacion en un archivo binario compacto. Las teclas se codifican como la lista de teclas que cambiaron
+		* de estado respecto del frame anterior. Retorna falso si el archivo no pudo ser escrito.
+		*/
+		bool SaveToFile(const std::filesystem::path& filePath) const noexcept;
+
+		/*
+		* Reemplaza el contenido de la grabacion por el del archivo entregado. Retorna falso si el archivo no existe
+		* o no tiene el formato esperado. Los archivos de la version anterior no guardan la posicion tardia del mouse, se
+		* usa la de la instantanea.
+		*/
+		bool LoadFromFile(const std::filesystem::path& filePath) noexcept;
+	private:
+		static constexpr char s_magic[4] = { 'M','I','R','C' };
+		static constexpr uint32_t s_version = 2;
+		std::vector<Frame> m_frames;
+	};
+}
+#endif
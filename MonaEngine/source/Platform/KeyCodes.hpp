@@ -124,6 +124,7 @@
 #define MONA_KEY_RIGHT_ALT          346
 #define MONA_KEY_RIGHT_SUPER        347
 #define MONA_KEY_MENU               348
+#define MONA_KEY_LAST               MONA_KEY_MENU
 
 #define MONA_MOUSE_BUTTON_1         0
 #define MONA_MOUSE_BUTTON_2         1
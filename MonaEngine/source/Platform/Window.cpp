@@ -4,6 +4,7 @@
 #include "../Event/Events.hpp"
 #include "../Event/EventManager.hpp"
 #include <glad/glad.h>
+#include <algorithm>
 #define GLFW_INCLUDE_NONE
 #include <GLFW/glfw3.h>
 #ifndef _WINDOWS_
@@ -23,16 +24,28 @@ namespace Mona {
 		void StartUp(EventManager& eventManager) noexcept
 		{
 			MONA_ASSERT(m_windowHandle == nullptr, "Calling Window::StartUp for the second time!!!.");
+			Mona::Config& config = Config::GetInstance(); 
+			m_data.eventManager = &eventManager;
+			//Sin ventana ni contexto de OpenGL el renderer usa un backend de registro (ver RecordingRenderBackend), lo que
+			//permite ejecutar pruebas y mediciones en maquinas sin GPU. La ventana solo recuerda sus dimensiones.
+			m_headless = config.getValueOrDefault<bool>("headless_rendering", false);
+			if (m_headless) {
+				m_headlessSize = glm::ivec2(std::max(1, config.getValueOrDefault<int>("windowWidth", 1440)),
+					std::max(1, config.getValueOrDefault<int>("windowHeight", 810)));
+				return;
+			}
 			const int success = glfwInit();
 			MONA_ASSERT(success, "Could not initialize GLFW!");
 			glfwSetErrorCallback(GLFWErrorCallback);
-			Mona::Config& config = Config::GetInstance(); 
 			const int glVersionMajor = config.getValueOrDefault<int>("OpenGL_major_version", 4);
 			const int glVersionMinor = config.getValueOrDefault<int>("OpenGL_minor_version", 5);
 			auto windowTitle = config.getValueOrDefault<std::string>("windowTitle", "Default Title");
 			int windowWidth = config.getValueOrDefault<int>("windowWidth", 1440);
 			int windowHeight = config.getValueOrDefault<int>("windowHeight", 810);
 			bool fullScreen = config.getValueOrDefault<bool>("fullscreen", false);
+			//Una ventana oculta permite ejecutar reproducciones de input (ver World::StartReplayLoop) sin mostrar nada en pantalla.
+			bool hiddenWindow = config.getValueOrDefault<bool>("hidden_window", false);
+			glfwWindowHint(GLFW_VISIBLE, hiddenWindow ? GLFW_FALSE : GLFW_TRUE);
 			glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, glVersionMajor);
 			glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, glVersionMinor);
 			glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
@@ -46,7 +59,6 @@ namespace Mona {
 			m_windowHandle = glfwCreateWindow(windowWidth, windowHeight, windowTitle.c_str(), fullScreen? monitor : NULL, NULL);
 			glfwMakeContextCurrent(m_windowHandle);
 			glfwGetWindowPos(m_windowHandle, &m_oldWindowPos[0], &m_oldWindowPos[1]);
-			m_data.eventManager = &eventManager;
 			glfwSetWindowUserPointer(m_windowHandle, &m_data);
 			
 			//
@@ -64,6 +76,36 @@ namespace Mona {
 					MouseScrollEvent e;
 					e.xOffset = xOffset;
 					e.yOffset = yOffset;
+					e.timestamp = glfwGetTime();
+					(data.eventManager)->Publish(e);
+				});
+			//Los eventos de teclado y mouse se marcan con su instante de llegada para que Input los almacene
+			//en orden y construya con ellos una instantanea por frame.
+			glfwSetKeyCallback(m_windowHandle, [](GLFWwindow* window, int key, int, int action, int)
+				{
+					WindowData& data = *(WindowData*)glfwGetWindowUserPointer(window);
+					KeyEvent e;
+					e.keycode = key;
+					e.action = action;
+					e.timestamp = glfwGetTime();
+					(data.eventManager)->Publish(e);
+				});
+			glfwSetMouseButtonCallback(m_windowHandle, [](GLFWwindow* window, int button, int action, int)
+				{
+					WindowData& data = *(WindowData*)glfwGetWindowUserPointer(window);
+					MouseButtonEvent e;
+					e.button = button;
+					e.action = action;
+					e.timestamp = glfwGetTime();
+					(data.eventManager)->Publish(e);
+				});
+			glfwSetCursorPosCallback(m_windowHandle, [](GLFWwindow* window, double xPosition, double yPosition)
+				{
+					WindowData& data = *(WindowData*)glfwGetWindowUserPointer(window);
+					CursorPositionEvent e;
+					e.xPosition = xPosition;
+					e.yPosition = yPosition;
+					e.timestamp = glfwGetTime();
 					(data.eventManager)->Publish(e);
 				});
 			int status = gladLoadGLLoader((GLADloadproc)glfwGetProcAddress);
@@ -73,21 +115,27 @@ namespace Mona {
 		}
 		void ShutDown() noexcept
 		{
+			if (m_headless)
+				return;
 			MONA_ASSERT(m_windowHandle != nullptr, "Calling Window::ShutDown for the second time or without calling Window::Startup first.");
 			glfwDestroyWindow(m_windowHandle);
 			//glfwTerminate();
 		}
 		void Update() noexcept
 		{
+			if (m_headless)
+				return;
 			glfwSwapBuffers(m_windowHandle);		
 		}
 		bool IsFullScreen() const noexcept
 		{
+			if (m_headless)
+				return false;
 			return glfwGetWindowMonitor(m_windowHandle) != NULL;
 		}
 		void SetFullScreen(bool value) noexcept
 		{
-			if (value == IsFullScreen())
+			if (m_headless || value == IsFullScreen())
 				return;
 			if (value)
 			{
@@ -107,26 +155,43 @@ namespace Mona {
 		}
 		bool ShouldClose() const noexcept
 		{
+			if (m_headless)
+				return false;
 			return glfwWindowShouldClose(m_windowHandle);
 		}
 		void SetSwapInterval(int interval) noexcept
 		{
+			if (m_headless)
+				return;
 			glfwSwapInterval(interval);
 		}
 		glm::ivec2 GetWindowDimensions() const noexcept
 		{
+			if (m_headless)
+				return m_headlessSize;
 			int width, height;
 			glfwGetWindowSize(m_windowHandle, &width, &height);
 			return glm::ivec2(width,height);
 		}
 		glm::ivec2 GetWindowFrameBufferSize() const noexcept
 		{
+			if (m_headless)
+				return m_headlessSize;
 			int width, height;
 			glfwGetFramebufferSize(m_windowHandle, &width, &height);
 			return glm::ivec2(width, height);
 		}
 		void SetWindowDimensions(const glm::ivec2 &dimensions) noexcept
 		{
+			if (m_headless) {
+				//Se notifica el cambio de la misma forma que lo haria GLFW al cambiar el tamano del framebuffer.
+				m_headlessSize = dimensions;
+				WindowResizeEvent e;
+				e.width = dimensions.x;
+				e.height = dimensions.y;
+				m_data.eventManager->Publish(e);
+				return;
+			}
 			glfwSetWindowSize(m_windowHandle, dimensions.x, dimensions.y);
 		}
 		GLFWwindow* GetHandle() const {
@@ -138,6 +203,8 @@ namespace Mona {
 		};
 		GLFWwindow* m_windowHandle = nullptr;
 		WindowData m_data;
+		bool m_headless = false;
+		glm::ivec2 m_headlessSize = glm::ivec2(0, 0);
 		glm::ivec2 m_oldWindowPos = glm::vec2(0,0);
 	};
 
@@ -0,0 +1,79 @@
+#pragma once
+#ifndef BOUNDINGVOLUME_HPP
+#define BOUNDINGVOLUME_HPP
+#include <limits>
+#include <algorithm>
+#include <glm/glm.hpp>
+namespace Mona {
+	/*
+	* Caja alineada a los ejes definida por sus esquinas minima y maxima. Una caja recien construida esta vacia
+	* (minPoint > maxPoint) hasta que se le agrega un punto.
+	*/
+	struct BoundingBox {
+		glm::vec3 minPoint = glm::vec3(std::numeric_limits<float>::max());
+		glm::vec3 maxPoint = glm::vec3(std::numeric_limits<float>::lowest());
+
+		BoundingBox() = default;
+		BoundingBox(const glm::vec3& minimum, const glm::vec3& maximum) noexcept : minPoint(minimum), maxPoint(maximum) {}
+		bool IsEmpty() const noexcept { return minPoint.x > maxPoint.x || minPoint.y > maxPoint.y || minPoint.z > maxPoint.z; }
+		glm::vec3 GetCenter() const noexcept { return 0.5f * (minPoint + maxPoint); }
+		glm::vec3 GetExtents() const noexcept { return 0.5f * (maxPoint - minPoint); }
+		void Extend(const glm::vec3& point) noexcept {
+			minPoint = glm::min(minPoint, point);
+			maxPoint = glm::max(maxPoint, point);
+		}
+		void Extend(const BoundingBox& box) noexcept {
+			minPoint = glm::min(minPoint, box.minPoint);
+			maxPoint = glm::max(maxPoint, box.maxPoint);
+		}
+		/*
+		* Retorna la caja alineada a los ejes que contiene a esta caja luego de aplicarle la transformacion afin entregada.
+		* El centro se transforma como punto y las extensiones con el valor absoluto de la parte lineal de la matriz.
+		*/
+		BoundingBox Transform(const glm::mat4& matrix) const noexcept {
+			if (IsEmpty())
+				return BoundingBox();
+			const glm::vec3 center = glm::vec3(matrix * glm::vec4(GetCenter(), 1.0f));
+			const glm::mat3 absoluteLinear = glm::mat3(glm::abs(glm::vec3(matrix[0])),
+				glm::abs(glm::vec3(matrix[1])),
+				glm::abs(glm::vec3(matrix[2])));
+			const glm::vec3 extents = absoluteLinear * GetExtents();
+			return BoundingBox(center - extents, center + extents);
+		}
+	};
+
+	struct BoundingSphere {
+		glm::vec3 center = glm::vec3(0.0f);
+		float radius = 0.0f;
+	};
+
+	/*
+	* Volumenes envolventes de una malla en su espacio local, calculados al importarla.
+	*/
+	struct MeshBounds {
+		BoundingBox box;
+		BoundingSphere sphere;
+
+		/*
+		* Calcula la caja y una esfera centrada en ella a partir de las posiciones de los vertices. stride es la distancia
+		* en bytes entre posiciones consecutivas.
+		*/
+		static MeshBounds FromPositions(const void* firstPosition, size_t count, size_t stride) noexcept {
+			MeshBounds bounds;
+			const char* data = static_cast<const char*>(firstPosition);
+			for (size_t i = 0; i < count; i++)
+				bounds.box.Extend(*reinterpret_cast<const glm::vec3*>(data + i * stride));
+			if (bounds.box.IsEmpty())
+				return bounds;
+			bounds.sphere.center = bounds.box.GetCenter();
+			float radiusSquared = 0.0f;
+			for (size_t i = 0; i < count; i++) {
+				const glm::vec3 offset = *reinterpret_cast<const glm::vec3*>(data + i * stride) - bounds.sphere.center;
+				radiusSquared = std::max(radiusSquared, glm::dot(offset, offset));
+			}
+			bounds.sphere.radius = glm::sqrt(radiusSquared);
+			return bounds;
+		}
+	};
+}
+#endif
@@ -7,12 +7,12 @@ namespace Mona {
 	class DiffuseFlatMaterial : public Material {
 	public:
  
-		DiffuseFlatMaterial(const ShaderProgram& shaderProgram, bool isForSkinning) : Material(shaderProgram, isForSkinning), m_diffuseColor(glm::vec3(1.0f)) {}
-		virtual void SetMaterialUniforms(const glm::vec3& cameraPosition) {
-			glUniform3fv(ShaderProgram::DiffuseColorShaderLocation, 1, glm::value_ptr(m_diffuseColor));
+		DiffuseFlatMaterial(const ShaderProgram& shaderProgram, bool isForSkinning) : Material(shaderProgram, isForSkinning, MaterialType::DiffuseFlat), m_diffuseColor(glm::vec3(1.0f)) {}
+		void PackParameters(MaterialParameters& parameters, MaterialTextures&) const noexcept {
+			parameters.color = glm::vec4(m_diffuseColor, 1.0f);
 		}
 		const glm::vec3& GetDiffuseColor() const { return m_diffuseColor; }
-		void SetDiffuseColor(const glm::vec3& color) { m_diffuseColor = color; }
+		void SetDiffuseColor(const glm::vec3& color) { m_diffuseColor = color; OnParametersChanged(); }
 	private:
 		glm::vec3 m_diffuseColor;
 	};
@@ -11,19 +11,19 @@ namespace Mona {
 	class DiffuseTexturedMaterial : public Material {
 	public:
 
-		DiffuseTexturedMaterial(const ShaderProgram& shaderProgram, bool isForSkinning) : Material(shaderProgram, isForSkinning), m_diffuseTexture(nullptr), m_materialTint(glm::vec3(1.0f)) {
+		DiffuseTexturedMaterial(const ShaderProgram& shaderProgram, bool isForSkinning) : Material(shaderProgram, isForSkinning, MaterialType::DiffuseTextured), m_diffuseTexture(nullptr), m_materialTint(glm::vec3(1.0f)) {
 			//Dado que las ubicaiones de las texturas nunca cambian solo se configura al momento de construccin
-			glUseProgram(m_shaderID);
-			glUniform1i(ShaderProgram::DiffuseTextureSamplerShaderLocation, ShaderProgram::DiffuseTextureUnit);
+			RenderDevice::GetInstance().UseProgram(m_shaderID);
+			RenderDevice::GetInstance().SetUniform(ShaderProgram::DiffuseTextureSamplerShaderLocation, ShaderProgram::DiffuseTextureUnit);
 		}
 		const glm::vec3& GetMaterialTint() const { return m_materialTint; }
-		void SetMaterialTint(const glm::vec3& tint) { m_materialTint = tint; }
+		void SetMaterialTint(const glm::vec3& tint) { m_materialTint = tint; OnParametersChanged(); }
 		std::shared_ptr<Texture> GetDiffuseTexture() const { return m_diffuseTexture; }
-		void SetDiffuseTexture(std::shared_ptr<Texture> diffuseTexture) { m_diffuseTexture = diffuseTexture; }
-		virtual void SetMaterialUniforms(const glm::vec3& cameraPosition) {
+		void SetDiffuseTexture(std::shared_ptr<Texture> diffuseTexture) { m_diffuseTexture = diffuseTexture; OnParametersChanged(); }
+		void PackParameters(MaterialParameters& parameters, MaterialTextures& textures) const noexcept {
 			MONA_ASSERT(m_diffuseTexture != nullptr, "Material Error: Texture must be not nullptr for rendering to be posible");
-			glBindTextureUnit(ShaderProgram::DiffuseTextureUnit, m_diffuseTexture->GetID());
-			glUniform3fv(ShaderProgram::MaterialTintShaderLocation, 1, glm::value_ptr(m_materialTint));
+			parameters.color = glm::vec4(m_materialTint, 1.0f);
+			textures.Add(ShaderProgram::DiffuseTextureUnit, m_diffuseTexture->GetID());
 		}
 	private:
 		std::shared_ptr<Texture> m_diffuseTexture;
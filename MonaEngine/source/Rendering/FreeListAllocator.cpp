@@ -0,0 +1,68 @@
+#include "FreeListAllocator.hpp"
+#include "../Core/Log.hpp"
+#include <algorithm>
+namespace Mona {
+
+	void FreeListAllocator::Reset(uint32_t capacity) noexcept {
+		m_freeBlocks.clear();
+		if (capacity > 0)
+			m_freeBlocks.push_back({ 0, capacity });
+		m_capacity = capacity;
+		m_freeSize = capacity;
+	}
+
+	uint32_t FreeListAllocator::Allocate(uint32_t size) noexcept {
+		if (size == 0)
+			return 0;
+		//Se busca el bloque libre mas pequeno en que cabe el rango (best fit) para reducir la fragmentacion.
+		auto best = m_freeBlocks.end();
+		for (auto it = m_freeBlocks.begin(); it != m_freeBlocks.end(); ++it) {
+			if (it->size >= size && (best == m_freeBlocks.end() || it->size < best->size)) {
+				best = it;
+				if (best->size == size)
+					break;
+			}
+		}
+		if (best == m_freeBlocks.end())
+			return s_invalidOffset;
+		const uint32_t offset = best->offset;
+		if (best->size == size) {
+			m_freeBlocks.erase(best);
+		}
+		else {
+			best->offset += size;
+			best->size -= size;
+		}
+		m_freeSize -= size;
+		return offset;
+	}
+
+	void FreeListAllocator::Free(uint32_t offset, uint32_t size) noexcept {
+		if (size == 0)
+			return;
+		MONA_ASSERT(offset + size <= m_capacity, "FreeListAllocator Error: Range out of bounds.");
+		//Se inserta el bloque manteniendo el orden por posicion y luego se fusiona con el bloque anterior y el siguiente
+		//si son contiguos.
+		auto next = std::lower_bound(m_freeBlocks.begin(), m_freeBlocks.end(), offset,
+			[](const FreeBlock& block, uint32_t value) { return block.offset < value; });
+		MONA_ASSERT(next == m_freeBlocks.end() || offset + size <= next->offset, "FreeListAllocator Error: Freeing a free range.");
+		auto block = m_freeBlocks.insert(next, { offset, size });
+		if (block + 1 != m_freeBlocks.end() && block->offset + block->size == (block + 1)->offset) {
+			block->size += (block + 1)->size;
+			m_freeBlocks.erase(block + 1);
+		}
+		if (block != m_freeBlocks.begin() && (block - 1)->offset + (block - 1)->size == block->offset) {
+			(block - 1)->size += block->size;
+			m_freeBlocks.erase(block);
+		}
+		m_freeSize += size;
+	}
+
+	void FreeListAllocator::Grow(uint32_t newCapacity) noexcept {
+		if (newCapacity <= m_capacity)
+			return;
+		const uint32_t oldCapacity = m_capacity;
+		m_capacity = newCapacity;
+		Free(oldCapacity, newCapacity - oldCapacity);
+	}
+}
@@ -0,0 +1,45 @@
+#pragma once
+#ifndef FREELISTALLOCATOR_HPP
+#define FREELISTALLOCATOR_HPP
+#include <vector>
+#include <cstdint>
+namespace Mona {
+	/*
+	* Administra los rangos libres de un espacio lineal de capacidad fija (por ejemplo los vertices de un buffer de OpenGL).
+	* Los bloques libres se mantienen ordenados por posicion, las asignaciones usan el bloque libre mas pequeno que las
+	* contenga y al liberar un rango este se fusiona con sus vecinos. El allocator no guarda los rangos asignados, quien
+	* asigna es responsable de recordar posicion y tamano para liberarlos.
+	*/
+	class FreeListAllocator {
+	public:
+		static constexpr uint32_t s_invalidOffset = UINT32_MAX;
+		FreeListAllocator() = default;
+		/*
+		* Deja todo el espacio [0, capacity) libre.
+		*/
+		void Reset(uint32_t capacity) noexcept;
+		/*
+		* Retorna la posicion del rango asignado o s_invalidOffset si ningun bloque libre tiene el tamano suficiente. Un
+		* rango de tamano cero siempre se asigna en la posicion cero sin consumir espacio.
+		*/
+		uint32_t Allocate(uint32_t size) noexcept;
+		void Free(uint32_t offset, uint32_t size) noexcept;
+		/*
+		* Agrega al final el espacio [capacity, newCapacity) como libre.
+		*/
+		void Grow(uint32_t newCapacity) noexcept;
+		uint32_t GetCapacity() const noexcept { return m_capacity; }
+		uint32_t GetFreeSize() const noexcept { return m_freeSize; }
+		uint32_t GetUsedSize() const noexcept { return m_capacity - m_freeSize; }
+		uint32_t GetFreeBlockCount() const noexcept { return static_cast<uint32_t>(m_freeBlocks.size()); }
+	private:
+		struct FreeBlock {
+			uint32_t offset;
+			uint32_t size;
+		};
+		std::vector<FreeBlock> m_freeBlocks;
+		uint32_t m_capacity = 0;
+		uint32_t m_freeSize = 0;
+	};
+}
+#endif
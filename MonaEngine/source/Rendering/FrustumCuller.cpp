@@ -0,0 +1,136 @@
+#include "FrustumCuller.hpp"
+#include <algorithm>
+#include <cmath>
+#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+#define MONA_FRUSTUM_CULLER_SSE
+#include <xmmintrin.h>
+#endif
+namespace Mona {
+
+	Frustum Frustum::FromViewProjection(const glm::mat4& viewProjectionMatrix) noexcept {
+		//Metodo de Gribb y Hartmann: cada plano es la suma o diferencia de la cuarta fila de la matriz con alguna de las
+		//otras tres. glm almacena las matrices por columnas, por lo que la fila i corresponde a m[*][i].
+		const glm::mat4& m = viewProjectionMatrix;
+		const glm::vec4 row0(m[0][0], m[1][0], m[2][0], m[3][0]);
+		const glm::vec4 row1(m[0][1], m[1][1], m[2][1], m[3][1]);
+		const glm::vec4 row2(m[0][2], m[1][2], m[2][2], m[3][2]);
+		const glm::vec4 row3(m[0][3], m[1][3], m[2][3], m[3][3]);
+		Frustum frustum;
+		frustum.planes = { row3 + row0, row3 - row0, row3 + row1, row3 - row1, row3 + row2, row3 - row2 };
+		for (glm::vec4& plane : frustum.planes) {
+			const float length = glm::length(glm::vec3(plane));
+			if (length > 0.0f)
+				plane /= length;
+		}
+		return frustum;
+	}
+
+	void FrustumCuller::Reserve(uint32_t count) {
+		//Se reserva espacio adicional para completar el ultimo grupo de cuatro cajas.
+		const size_t paddedCount = (static_cast<size_t>(count) + 3) & ~static_cast<size_t>(3);
+		m_centerX.reserve(paddedCount);
+		m_centerY.reserve(paddedCount);
+		m_centerZ.reserve(paddedCount);
+		m_extentX.reserve(paddedCount);
+		m_extentY.reserve(paddedCount);
+		m_extentZ.reserve(paddedCount);
+		m_visible.reserve(paddedCount);
+	}
+
+	void FrustumCuller::Clear() noexcept {
+		m_count = 0;
+		m_centerX.clear();
+		m_centerY.clear();
+		m_centerZ.clear();
+		m_extentX.clear();
+		m_extentY.clear();
+		m_extentZ.clear();
+		m_visible.clear();
+	}
+
+	void FrustumCuller::Truncate(uint32_t count) noexcept {
+		//Tambien se descarta el relleno agregado por Cull, de manera que AddBox vuelva a agregar al final.
+		m_count = std::min(m_count, count);
+		m_centerX.resize(m_count);
+		m_centerY.resize(m_count);
+		m_centerZ.resize(m_count);
+		m_extentX.resize(m_count);
+		m_extentY.resize(m_count);
+		m_extentZ.resize(m_count);
+		m_visible.resize(m_count);
+	}
+
+	uint32_t FrustumCuller::AddBox(const BoundingBox& box) {
+		m_centerX.push_back(0.0f);
+		m_centerY.push_back(0.0f);
+		m_centerZ.push_back(0.0f);
+		m_extentX.push_back(0.0f);
+		m_extentY.push_back(0.0f);
+		m_extentZ.push_back(0.0f);
+		SetBox(m_count, box);
+		return m_count++;
+	}
+
+	void FrustumCuller::SetBox(uint32_t index, const BoundingBox& box) noexcept {
+		//Una caja vacia (por ejemplo de una malla que no pudo cargarse) nunca se descarta.
+		const glm::vec3 center = box.IsEmpty() ? glm::vec3(0.0f) : box.GetCenter();
+		const glm::vec3 extents = box.IsEmpty() ? glm::vec3(1e30f) : box.GetExtents();
+		m_centerX[index] = center.x;
+		m_centerY[index] = center.y;
+		m_centerZ[index] = center.z;
+		m_extentX[index] = extents.x;
+		m_extentY[index] = extents.y;
+		m_extentZ[index] = extents.z;
+	}
+
+	uint32_t FrustumCuller::Cull(const Frustum& frustum) noexcept {
+		const size_t paddedCount = (static_cast<size_t>(m_count) + 3) & ~static_cast<size_t>(3);
+		m_centerX.resize(paddedCount, 0.0f);
+		m_centerY.resize(paddedCount, 0.0f);
+		m_centerZ.resize(paddedCount, 0.0f);
+		m_extentX.resize(paddedCount, 0.0f);
+		m_extentY.resize(paddedCount, 0.0f);
+		m_extentZ.resize(paddedCount, 0.0f);
+		m_visible.resize(paddedCount);
+		//Una caja esta fuera del frustum si para algun plano la distancia con signo de su centro mas su radio proyectado
+		//(suma de las extensiones ponderadas por el valor absoluto de la normal) es negativa.
+#ifdef MONA_FRUSTUM_CULLER_SSE
+		const __m128 zero = _mm_setzero_ps();
+		for (size_t i = 0; i < paddedCount; i += 4) {
+			const __m128 centerX = _mm_loadu_ps(&m_centerX[i]);
+			const __m128 centerY = _mm_loadu_ps(&m_centerY[i]);
+			const __m128 centerZ = _mm_loadu_ps(&m_centerZ[i]);
+			const __m128 extentX = _mm_loadu_ps(&m_extentX[i]);
+			const __m128 extentY = _mm_loadu_ps(&m_extentY[i]);
+			const __m128 extentZ = _mm_loadu_ps(&m_extentZ[i]);
+			__m128 outside = _mm_setzero_ps();
+			for (const glm::vec4& plane : frustum.planes) {
+				__m128 distance = _mm_add_ps(_mm_mul_ps(centerX, _mm_set1_ps(plane.x)), _mm_mul_ps(centerY, _mm_set1_ps(plane.y)));
+				distance = _mm_add_ps(distance, _mm_add_ps(_mm_mul_ps(centerZ, _mm_set1_ps(plane.z)), _mm_set1_ps(plane.w)));
+				__m128 radius = _mm_add_ps(_mm_mul_ps(extentX, _mm_set1_ps(std::abs(plane.x))), _mm_mul_ps(extentY, _mm_set1_ps(std::abs(plane.y))));
+				radius = _mm_add_ps(radius, _mm_mul_ps(extentZ, _mm_set1_ps(std::abs(plane.z))));
+				outside = _mm_or_ps(outside, _mm_cmplt_ps(_mm_add_ps(distance, radius), zero));
+			}
+			const int outsideMask = _mm_movemask_ps(outside);
+			m_visible[i] = (outsideMask & 1) == 0;
+			m_visible[i + 1] = (outsideMask & 2) == 0;
+			m_visible[i + 2] = (outsideMask & 4) == 0;
+			m_visible[i + 3] = (outsideMask & 8) == 0;
+		}
+#else
+		for (size_t i = 0; i < paddedCount; i++) {
+			bool outside = false;
+			for (const glm::vec4& plane : frustum.planes) {
+				const float distance = m_centerX[i] * plane.x + m_centerY[i] * plane.y + m_centerZ[i] * plane.z + plane.w;
+				const float radius = m_extentX[i] * std::abs(plane.x) + m_extentY[i] * std::abs(plane.y) + m_extentZ[i] * std::abs(plane.z);
+				outside = outside || distance + radius < 0.0f;
+			}
+			m_visible[i] = !outside;
+		}
+#endif
+		uint32_t visibleCount = 0;
+		for (uint32_t i = 0; i < m_count; i++)
+			visibleCount += m_visible[i];
+		return visibleCount;
+	}
+}
@@ -0,0 +1,65 @@
+#pragma once
+#ifndef FRUSTUMCULLER_HPP
+#define FRUSTUMCULLER_HPP
+#include <array>
+#include <vector>
+#include <cstdint>
+#include <glm/glm.hpp>
+#include "BoundingVolume.hpp"
+namespace Mona {
+	/*
+	* Seis planos (izquierdo, derecho, inferior, superior, cercano y lejano) extraidos de una matriz de vista y proyeccion.
+	* Cada plano se guarda como (normal, distancia) con la normal apuntando hacia el interior del volumen de vision.
+	*/
+	struct Frustum {
+		std::array<glm::vec4, 6> planes;
+		static Frustum FromViewProjection(const glm::mat4& viewProjectionMatrix) noexcept;
+	};
+
+	/*
+	* Acumula cajas en espacio de mundo y las prueba contra un frustum. Las cajas se almacenan como centro y extensiones en
+	* arreglos separados por componente, de manera que con SSE se prueban cuatro cajas a la vez contra cada plano. En
+	* plataformas sin SSE se usa una version escalar equivalente. Las cajas pueden mantenerse entre frames, actualizando
+	* con SetBox solo las que cambian y descartando con Truncate las que se agregan cada frame.
+	*/
+	class FrustumCuller {
+	public:
+		FrustumCuller() = default;
+		void Reserve(uint32_t count);
+		void Clear() noexcept;
+		/*
+		* Agrega una caja y retorna su indice, el mismo que debe usarse con IsVisible luego de llamar a Cull.
+		*/
+		uint32_t AddBox(const BoundingBox& box);
+		void SetBox(uint32_t index, const BoundingBox& box) noexcept;
+		/*
+		* Conserva solo las primeras count cajas.
+		*/
+		void Truncate(uint32_t count) noexcept;
+		/*
+		* Calcula la visibilidad de todas las cajas agregadas. Retorna la cantidad de cajas visibles.
+		*/
+		uint32_t Cull(const Frustum& frustum) noexcept;
+		bool IsVisible(uint32_t index) const noexcept { return m_visible[index] != 0; }
+		/*
+		* Permite que pruebas posteriores (por ejemplo de oclusion) descarten cajas que pasaron la prueba del frustum.
+		*/
+		void SetVisible(uint32_t index, bool visible) noexcept { m_visible[index] = visible; }
+		BoundingBox GetBox(uint32_t index) const noexcept {
+			const glm::vec3 center(m_centerX[index], m_centerY[index], m_centerZ[index]);
+			const glm::vec3 extents(m_extentX[index], m_extentY[index], m_extentZ[index]);
+			return BoundingBox(center - extents, center + extents);
+		}
+		uint32_t GetCount() const noexcept { return m_count; }
+	private:
+		uint32_t m_count = 0;
+		std::vector<float> m_centerX;
+		std::vector<float> m_centerY;
+		std::vector<float> m_centerZ;
+		std::vector<float> m_extentX;
+		std::vector<float> m_extentY;
+		std::vector<float> m_extentZ;
+		std::vector<uint8_t> m_visible;
+	};
+}
+#endif
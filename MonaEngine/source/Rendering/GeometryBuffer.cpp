@@ -0,0 +1,223 @@
+#include "GeometryBuffer.hpp"
+#include "RenderDevice.hpp"
+#include "../Core/Log.hpp"
+#include <algorithm>
+namespace Mona {
+
+	void GeometryBuffer::StartUp(const VertexFormat& format, uint32_t vertexCapacity, uint32_t indexCapacity, GLenum indexType) noexcept {
+		MONA_ASSERT(m_vertexArrayID == 0, "GeometryBuffer Error: Calling StartUp for the second time.");
+		MONA_ASSERT(!format.streamStrides.empty() && format.streamStrides.size() <= s_maxStreamCount, "GeometryBuffer Error: Invalid stream count.");
+		MONA_ASSERT(indexType == GL_UNSIGNED_SHORT || indexType == GL_UNSIGNED_INT, "GeometryBuffer Error: Invalid index type.");
+		m_format = format;
+		m_indexType = indexType;
+		m_vertexBufferIDs.assign(m_format.streamStrides.size(), 0);
+		RenderDevice& device = RenderDevice::GetInstance();
+		m_vertexArrayID = device.CreateVertexArray();
+		m_positionVertexArrayID = device.CreateVertexArray();
+		for (const VertexAttribute& attribute : m_format.attributes) {
+			MONA_ASSERT(attribute.stream < m_format.streamStrides.size(), "GeometryBuffer Error: Attribute with invalid stream.");
+			device.SetVertexAttribute(m_vertexArrayID, attribute.location, attribute.componentCount, attribute.type, attribute.normalized, false,
+				attribute.offset, attribute.stream);
+			if (attribute.stream == 0) {
+				device.SetVertexAttribute(m_positionVertexArrayID, attribute.location, attribute.componentCount, attribute.type, attribute.normalized,
+					false, attribute.offset, 0);
+			}
+		}
+		m_vertexAllocator.Reset(0);
+		m_indexAllocator.Reset(0);
+		Reallocate(std::max(vertexCapacity, 1u), std::max(indexCapacity, 1u));
+	}
+
+	void GeometryBuffer::ShutDown() noexcept {
+		RenderDevice& device = RenderDevice::GetInstance();
+		for (GLuint vertexBufferID : m_vertexBufferIDs)
+			device.DeleteBuffer(vertexBufferID);
+		device.DeleteBuffer(m_indexBufferID);
+		device.DeleteVertexArray(m_vertexArrayID);
+		device.DeleteVertexArray(m_positionVertexArrayID);
+		m_vertexBufferIDs.clear();
+		m_indexBufferID = 0;
+		m_vertexArrayID = 0;
+		m_positionVertexArrayID = 0;
+		m_ranges.clear();
+		m_isAlive.clear();
+		m_freeHandles.clear();
+	}
+
+	GeometryBuffer::GeometryHandle GeometryBuffer::Allocate(const void* const* streams, uint32_t vertexCount, const uint32_t* indices, uint32_t indexCount) noexcept {
+		MONA_ASSERT(m_vertexArrayID != 0, "GeometryBuffer Error: Allocating before StartUp.");
+		MONA_ASSERT(m_indexType == GL_UNSIGNED_INT || vertexCount <= 65536, "GeometryBuffer Error: Too many vertices for 16 bit indices.");
+		uint32_t vertexOffset = m_vertexAllocator.Allocate(vertexCount);
+		uint32_t indexOffset = m_indexAllocator.Allocate(indexCount);
+		if (vertexOffset == FreeListAllocator::s_invalidOffset || indexOffset == FreeListAllocator::s_invalidOffset) {
+			//Se deshace la asignacion que si tuvo exito y se recrean los buffers. Si el espacio libre total alcanza basta con
+			//compactar, en caso contrario se duplica la capacidad.
+			if (vertexOffset != FreeListAllocator::s_invalidOffset)
+				m_vertexAllocator.Free(vertexOffset, vertexCount);
+			if (indexOffset != FreeListAllocator::s_invalidOffset)
+				m_indexAllocator.Free(indexOffset, indexCount);
+			uint32_t vertexCapacity = m_vertexAllocator.GetCapacity();
+			if (m_vertexAllocator.GetFreeSize() < vertexCount)
+				vertexCapacity = std::max(2 * vertexCapacity, m_vertexAllocator.GetUsedSize() + vertexCount);
+			uint32_t indexCapacity = m_indexAllocator.GetCapacity();
+			if (m_indexAllocator.GetFreeSize() < indexCount)
+				indexCapacity = std::max(2 * indexCapacity, m_indexAllocator.GetUsedSize() + indexCount);
+			Reallocate(vertexCapacity, indexCapacity);
+			vertexOffset = m_vertexAllocator.Allocate(vertexCount);
+			indexOffset = m_indexAllocator.Allocate(indexCount);
+			MONA_ASSERT(vertexOffset != FreeListAllocator::s_invalidOffset && indexOffset != FreeListAllocator::s_invalidOffset,
+				"GeometryBuffer Error: Failed to allocate geometry after reallocation.");
+		}
+		RenderDevice& device = RenderDevice::GetInstance();
+		if (vertexCount > 0) {
+			for (size_t stream = 0; stream < m_vertexBufferIDs.size(); stream++) {
+				const uint32_t stride = m_format.streamStrides[stream];
+				device.BufferSubData(m_vertexBufferIDs[stream], static_cast<size_t>(vertexOffset) * stride,
+					static_cast<size_t>(vertexCount) * stride, streams[stream]);
+			}
+		}
+		if (indexCount > 0) {
+			const size_t indexByteOffset = static_cast<size_t>(indexOffset) * GetIndexSize();
+			if (m_indexType == GL_UNSIGNED_SHORT) {
+				std::vector<uint16_t> shortIndices(indices, indices + indexCount);
+				device.BufferSubData(m_indexBufferID, indexByteOffset, static_cast<size_t>(indexCount) * sizeof(uint16_t), shortIndices.data());
+			}
+			else {
+				device.BufferSubData(m_indexBufferID, indexByteOffset, static_cast<size_t>(indexCount) * sizeof(uint32_t), indices);
+			}
+		}
+
+		GeometryHandle handle;
+		if (!m_freeHandles.empty()) {
+			handle = m_freeHandles.back();
+			m_freeHandles.pop_back();
+		}
+		else {
+			handle = static_cast<GeometryHandle>(m_ranges.size());
+			m_ranges.emplace_back();
+			m_isAlive.push_back(false);
+		}
+		GeometryRange& range = m_ranges[handle];
+		range.firstIndex = indexOffset;
+		range.indexCount = indexCount;
+		range.baseVertex = static_cast<int32_t>(vertexOffset);
+		range.vertexCount = vertexCount;
+		m_isAlive[handle] = true;
+		return handle;
+	}
+
+	void GeometryBuffer::ReadVertices(GeometryHandle handle, uint32_t stream, void* destination) const noexcept {
+		MONA_ASSERT(handle < m_ranges.size() && m_isAlive[handle], "GeometryBuffer Error: Reading an invalid handle.");
+		const GeometryRange& range = m_ranges[handle];
+		const uint32_t stride = m_format.streamStrides[stream];
+		if (range.vertexCount > 0) {
+			RenderDevice::GetInstance().GetBufferSubData(m_vertexBufferIDs[stream], static_cast<size_t>(range.baseVertex) * stride,
+				static_cast<size_t>(range.vertexCount) * stride, destination);
+		}
+	}
+
+	void GeometryBuffer::ReadIndices(GeometryHandle handle, uint32_t first, uint32_t count, uint32_t* destination) const noexcept {
+		MONA_ASSERT(handle < m_ranges.size() && m_isAlive[handle], "GeometryBuffer Error: Reading an invalid handle.");
+		const GeometryRange& range = m_ranges[handle];
+		MONA_ASSERT(first + count <= range.indexCount, "GeometryBuffer Error: Index range out of bounds.");
+		if (count == 0)
+			return;
+		RenderDevice& device = RenderDevice::GetInstance();
+		const size_t indexByteOffset = static_cast<size_t>(range.firstIndex + first) * GetIndexSize();
+		if (m_indexType == GL_UNSIGNED_SHORT) {
+			std::vector<uint16_t> shortIndices(count);
+			device.GetBufferSubData(m_indexBufferID, indexByteOffset, static_cast<size_t>(count) * sizeof(uint16_t), shortIndices.data());
+			std::copy(shortIndices.begin(), shortIndices.end(), destination);
+		}
+		else {
+			device.GetBufferSubData(m_indexBufferID, indexByteOffset, static_cast<size_t>(count) * sizeof(uint32_t), destination);
+		}
+	}
+
+	void GeometryBuffer::Free(GeometryHandle handle) noexcept {
+		MONA_ASSERT(handle < m_ranges.size() && m_isAlive[handle], "GeometryBuffer Error: Freeing an invalid handle.");
+		GeometryRange& range = m_ranges[handle];
+		m_vertexAllocator.Free(static_cast<uint32_t>(range.baseVertex), range.vertexCount);
+		m_indexAllocator.Free(range.firstIndex, range.indexCount);
+		range = GeometryRange();
+		m_isAlive[handle] = false;
+		m_freeHandles.push_back(handle);
+	}
+
+	void GeometryBuffer::Compact() noexcept {
+		if (m_vertexAllocator.GetFreeBlockCount() <= 1 && m_indexAllocator.GetFreeBlockCount() <= 1)
+			return;
+		Reallocate(m_vertexAllocator.GetCapacity(), m_indexAllocator.GetCapacity());
+	}
+
+	void GeometryBuffer::BindInstanceBuffer(uint32_t location, GLuint bufferID) noexcept {
+		RenderDevice& device = RenderDevice::GetInstance();
+		for (GLuint vertexArrayID : { m_vertexArrayID, m_positionVertexArrayID }) {
+			device.SetVertexAttribute(vertexArrayID, location, 1, GL_UNSIGNED_INT, false, true, 0, s_instanceBindingIndex);
+			device.SetVertexBindingDivisor(vertexArrayID, s_instanceBindingIndex, 1);
+			device.SetVertexBuffer(vertexArrayID, s_instanceBindingIndex, bufferID, 0, sizeof(uint32_t));
+		}
+	}
+
+	void GeometryBuffer::Reallocate(uint32_t vertexCapacity, uint32_t indexCapacity) noexcept {
+		const size_t streamCount = m_vertexBufferIDs.size();
+		const uint32_t indexSize = GetIndexSize();
+		RenderDevice& device = RenderDevice::GetInstance();
+		std::vector<GLuint> vertexBuffers(streamCount);
+		for (size_t stream = 0; stream < streamCount; stream++)
+			vertexBuffers[stream] = device.CreateBuffer(static_cast<size_t>(vertexCapacity) * m_format.streamStrides[stream], nullptr, GL_DYNAMIC_STORAGE_BIT);
+		GLuint indexBuffer = device.CreateBuffer(static_cast<size_t>(indexCapacity) * indexSize, nullptr, GL_DYNAMIC_STORAGE_BIT);
+
+		//Las mallas vivas se copian una tras otra al inicio de los nuevos buffers, conservando su orden. Los indices son
+		//relativos al primer vertice de cada malla, por lo que no es necesario modificarlos.
+		std::vector<GeometryHandle> liveHandles;
+		for (GeometryHandle handle = 0; handle < m_ranges.size(); handle++) {
+			if (m_isAlive[handle])
+				liveHandles.push_back(handle);
+		}
+		uint32_t vertexOffset = 0;
+		std::sort(liveHandles.begin(), liveHandles.end(),
+			[this](GeometryHandle a, GeometryHandle b) { return m_ranges[a].baseVertex < m_ranges[b].baseVertex; });
+		for (GeometryHandle handle : liveHandles) {
+			GeometryRange& range = m_ranges[handle];
+			for (size_t stream = 0; range.vertexCount > 0 && stream < streamCount; stream++) {
+				const uint32_t stride = m_format.streamStrides[stream];
+				device.CopyBufferSubData(m_vertexBufferIDs[stream], vertexBuffers[stream], static_cast<size_t>(range.baseVertex) * stride,
+					static_cast<size_t>(vertexOffset) * stride, static_cast<size_t>(range.vertexCount) * stride);
+			}
+			range.baseVertex = static_cast<int32_t>(vertexOffset);
+			vertexOffset += range.vertexCount;
+		}
+		uint32_t indexOffset = 0;
+		std::sort(liveHandles.begin(), liveHandles.end(),
+			[this](GeometryHandle a, GeometryHandle b) { return m_ranges[a].firstIndex < m_ranges[b].firstIndex; });
+		for (GeometryHandle handle : liveHandles) {
+			GeometryRange& range = m_ranges[handle];
+			if (range.indexCount > 0)
+				device.CopyBufferSubData(m_indexBufferID, indexBuffer, static_cast<size_t>(range.firstIndex) * indexSize,
+					static_cast<size_t>(indexOffset) * indexSize, static_cast<size_t>(range.indexCount) * indexSize);
+			range.firstIndex = indexOffset;
+			indexOffset += range.indexCount;
+		}
+
+		for (size_t stream = 0; stream < streamCount; stream++) {
+			if (m_vertexBufferIDs[stream] != 0)
+				device.DeleteBuffer(m_vertexBufferIDs[stream]);
+			m_vertexBufferIDs[stream] = vertexBuffers[stream];
+			device.SetVertexBuffer(m_vertexArrayID, static_cast<uint32_t>(stream), vertexBuffers[stream], 0, m_format.streamStrides[stream]);
+		}
+		if (m_indexBufferID != 0)
+			device.DeleteBuffer(m_indexBufferID);
+		m_indexBufferID = indexBuffer;
+		device.SetVertexBuffer(m_positionVertexArrayID, 0, m_vertexBufferIDs[0], 0, m_format.streamStrides[0]);
+		device.SetElementBuffer(m_vertexArrayID, m_indexBufferID);
+		device.SetElementBuffer(m_positionVertexArrayID, m_indexBufferID);
+
+		//Todo el espacio ocupado queda como un unico bloque al inicio.
+		m_vertexAllocator.Reset(vertexCapacity);
+		m_vertexAllocator.Allocate(vertexOffset);
+		m_indexAllocator.Reset(indexCapacity);
+		m_indexAllocator.Allocate(indexOffset);
+		m_version++;
+	}
+}
@@ -0,0 +1,120 @@
+#pragma once
+#ifndef GEOMETRYBUFFER_HPP
+#define GEOMETRYBUFFER_HPP
+#include <vector>
+#include <cstdint>
+#include <glad/glad.h>
+#include "FreeListAllocator.hpp"
+namespace Mona {
+	/*
+	* Atributo de un vertice: posicion del atributo en el shader, cantidad y tipo de sus componentes, desplazamiento en
+	* bytes dentro del vertice y flujo (stream) del que se lee.
+	*/
+	struct VertexAttribute {
+		uint32_t location;
+		int32_t componentCount;
+		GLenum type;
+		bool normalized;
+		uint32_t offset;
+		uint32_t stream = 0;
+	};
+
+	/*
+	* Los vertices pueden repartirse en varios flujos, cada uno en su propio buffer y con su propio tamano por vertice. Por
+	* convencion el flujo cero contiene solo posiciones, de manera que los pases que solo escriben profundidad leen la
+	* menor cantidad de memoria posible.
+	*/
+	struct VertexFormat {
+		std::vector<uint32_t> streamStrides;
+		std::vector<VertexAttribute> attributes;
+	};
+
+	/*
+	* Ubicacion de la geometria de una malla dentro de los buffers compartidos. Los indices de la malla son relativos a su
+	* primer vertice, por lo que baseVertex debe sumarse al dibujar (por ejemplo en DrawElementsIndirectCommand).
+	*/
+	struct GeometryRange {
+		uint32_t firstIndex = 0;
+		uint32_t indexCount = 0;
+		int32_t baseVertex = 0;
+		uint32_t vertexCount = 0;
+	};
+
+	/*
+	* Buffers de vertices (uno por flujo) e indices compartidos por todas las mallas de un mismo formato de vertice, junto al
+	* VAO que los describe y a un segundo VAO que solo lee el flujo de posiciones. Los indices se guardan con 16 o 32 bits
+	* segun el tipo entregado en StartUp. Cada malla recibe un rango de los buffers administrado por un FreeListAllocator. Cuando no
+	* queda un bloque libre suficientemente grande los buffers se vuelven a crear, compactando las mallas vivas al inicio y
+	* duplicando la capacidad si el espacio libre total tampoco alcanza. Las mallas se identifican por un handle estable,
+	* por lo que su rango debe consultarse con GetRange en vez de guardarse.
+	*/
+	class GeometryBuffer {
+	public:
+		using GeometryHandle = uint32_t;
+		static constexpr GeometryHandle s_invalidHandle = UINT32_MAX;
+		//Los flujos de vertices usan los indices de enlace del VAO desde cero, el atributo por instancia usa el ultimo.
+		static constexpr uint32_t s_maxStreamCount = 4;
+		static constexpr uint32_t s_instanceBindingIndex = s_maxStreamCount;
+		GeometryBuffer() = default;
+		GeometryBuffer(const GeometryBuffer&) = delete;
+		GeometryBuffer& operator=(const GeometryBuffer&) = delete;
+		/*
+		* indexType puede ser GL_UNSIGNED_SHORT o GL_UNSIGNED_INT. Como los indices de cada malla son relativos a su primer
+		* vertice, con indices de 16 bits se aceptan mallas de hasta 65536 vertices.
+		*/
+		void StartUp(const VertexFormat& format, uint32_t vertexCapacity, uint32_t indexCapacity, GLenum indexType = GL_UNSIGNED_INT) noexcept;
+		void ShutDown() noexcept;
+		/*
+		* Copia los vertices e indices entregados a los buffers compartidos. streams debe tener un puntero por flujo, con los
+		* vertices en el formato entregado en StartUp. Los indices se convierten al tipo del buffer.
+		*/
+		GeometryHandle Allocate(const void* const* streams, uint32_t vertexCount, const uint32_t* indices, uint32_t indexCount) noexcept;
+		void Free(GeometryHandle handle) noexcept;
+		const GeometryRange& GetRange(GeometryHandle handle) const noexcept { return m_ranges[handle]; }
+		/*
+		* Copian desde la GPU los vertices de un flujo de la malla (con el formato de ese flujo) y count indices a partir de
+		* first, relativo al rango de la malla, convertidos a 32 bits. Detienen a la CPU hasta que la GPU termina de usar los
+		* buffers, por lo que no deben usarse en cada frame.
+		*/
+		void ReadVertices(GeometryHandle handle, uint32_t stream, void* destination) const noexcept;
+		void ReadIndices(GeometryHandle handle, uint32_t first, uint32_t count, uint32_t* destination) const noexcept;
+		/*
+		* Mueve todas las mallas vivas al inicio de los buffers eliminando los espacios libres entre ellas.
+		*/
+		void Compact() noexcept;
+		/*
+		* Agrega a ambos VAO un atributo entero sin signo por instancia en la posicion location, leido desde bufferID. Con
+		* divisor uno el valor de la instancia i de un comando indirecto es bufferID[baseInstance + i].
+		*/
+		void BindInstanceBuffer(uint32_t location, GLuint bufferID) noexcept;
+		GLuint GetVertexArrayID() const noexcept { return m_vertexArrayID; }
+		/*
+		* VAO con solo los atributos del flujo cero (posiciones) y los mismos indices, para pases de solo profundidad.
+		*/
+		GLuint GetPositionVertexArrayID() const noexcept { return m_positionVertexArrayID; }
+		GLenum GetIndexType() const noexcept { return m_indexType; }
+		uint32_t GetIndexSize() const noexcept { return m_indexType == GL_UNSIGNED_SHORT ? 2 : 4; }
+		uint32_t GetVertexCapacity() const noexcept { return m_vertexAllocator.GetCapacity(); }
+		uint32_t GetIndexCapacity() const noexcept { return m_indexAllocator.GetCapacity(); }
+		/*
+		* Aumenta cada vez que los buffers se vuelven a crear (al crecer o compactarse), ya que en ese caso los rangos de las
+		* mallas vivas pueden cambiar. Los datos de dibujo calculados con rangos anteriores dejan de ser validos.
+		*/
+		uint32_t GetVersion() const noexcept { return m_version; }
+	private:
+		void Reallocate(uint32_t vertexCapacity, uint32_t indexCapacity) noexcept;
+		VertexFormat m_format;
+		GLuint m_vertexArrayID = 0;
+		GLuint m_positionVertexArrayID = 0;
+		std::vector<GLuint> m_vertexBufferIDs;
+		GLuint m_indexBufferID = 0;
+		GLenum m_indexType = GL_UNSIGNED_INT;
+		FreeListAllocator m_vertexAllocator;
+		FreeListAllocator m_indexAllocator;
+		std::vector<GeometryRange> m_ranges;
+		std::vector<bool> m_isAlive;
+		std::vector<GeometryHandle> m_freeHandles;
+		uint32_t m_version = 0;
+	};
+}
+#endif
@@ -0,0 +1,214 @@
+#include "LightClusterGrid.hpp"
+#include <array>
+#include <cmath>
+#include <future>
+#include <limits>
+#include <algorithm>
+#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+#define MONA_LIGHT_CLUSTER_SSE
+#include <xmmintrin.h>
+#endif
+namespace Mona {
+	//Cantidad minima de pruebas luz-cluster a partir de la cual se reparte el trabajo entre varios hilos.
+	static constexpr size_t s_minTestsPerJob = 32768;
+
+	//Puntero a los datos de cuatro clusters consecutivos, almacenados por componente.
+	struct ClusterGroupData {
+		const float* minX; const float* minY; const float* minZ;
+		const float* maxX; const float* maxY; const float* maxZ;
+		const float* centerX; const float* centerY; const float* centerZ; const float* radius;
+	};
+
+#ifdef MONA_LIGHT_CLUSTER_SSE
+	//Retorna una mascara de 4 bits con los clusters cuya caja intersecta la esfera entregada.
+	static int TestSphere(const ClusterGroupData& group, const glm::vec3& center, float radius) noexcept {
+		const __m128 zero = _mm_setzero_ps();
+		const __m128 cx = _mm_set1_ps(center.x);
+		const __m128 cy = _mm_set1_ps(center.y);
+		const __m128 cz = _mm_set1_ps(center.z);
+		//Distancia del centro de la esfera al punto mas cercano de cada caja.
+		const __m128 dx = _mm_max_ps(_mm_max_ps(_mm_sub_ps(_mm_loadu_ps(group.minX), cx), zero), _mm_sub_ps(cx, _mm_loadu_ps(group.maxX)));
+		const __m128 dy = _mm_max_ps(_mm_max_ps(_mm_sub_ps(_mm_loadu_ps(group.minY), cy), zero), _mm_sub_ps(cy, _mm_loadu_ps(group.maxY)));
+		const __m128 dz = _mm_max_ps(_mm_max_ps(_mm_sub_ps(_mm_loadu_ps(group.minZ), cz), zero), _mm_sub_ps(cz, _mm_loadu_ps(group.maxZ)));
+		const __m128 distanceSquared = _mm_add_ps(_mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy)), _mm_mul_ps(dz, dz));
+		return _mm_movemask_ps(_mm_cmple_ps(distanceSquared, _mm_set1_ps(radius * radius)));
+	}
+
+	//Retorna una mascara de 4 bits con los clusters cuya esfera envolvente no queda completamente fuera del cono.
+	static int TestCone(const ClusterGroupData& group, const ClusterSpotLight& light) noexcept {
+		const __m128 vx = _mm_sub_ps(_mm_loadu_ps(group.centerX), _mm_set1_ps(light.position.x));
+		const __m128 vy = _mm_sub_ps(_mm_loadu_ps(group.centerY), _mm_set1_ps(light.position.y));
+		const __m128 vz = _mm_sub_ps(_mm_loadu_ps(group.centerZ), _mm_set1_ps(light.position.z));
+		const __m128 radius = _mm_loadu_ps(group.radius);
+		const __m128 lengthSquared = _mm_add_ps(_mm_add_ps(_mm_mul_ps(vx, vx), _mm_mul_ps(vy, vy)), _mm_mul_ps(vz, vz));
+		const __m128 axialLength = _mm_add_ps(_mm_add_ps(_mm_mul_ps(vx, _mm_set1_ps(light.direction.x)),
+			_mm_mul_ps(vy, _mm_set1_ps(light.direction.y))), _mm_mul_ps(vz, _mm_set1_ps(light.direction.z)));
+		const __m128 radialLength = _mm_sqrt_ps(_mm_max_ps(_mm_sub_ps(lengthSquared, _mm_mul_ps(axialLength, axialLength)), _mm_setzero_ps()));
+		const __m128 closestDistance = _mm_sub_ps(_mm_mul_ps(radialLength, _mm_set1_ps(light.cosAngle)),
+			_mm_mul_ps(axialLength, _mm_set1_ps(light.sinAngle)));
+		__m128 outside = _mm_cmpgt_ps(closestDistance, radius);
+		outside = _mm_or_ps(outside, _mm_cmpgt_ps(axialLength, _mm_add_ps(radius, _mm_set1_ps(light.range))));
+		outside = _mm_or_ps(outside, _mm_cmplt_ps(axialLength, _mm_sub_ps(_mm_setzero_ps(), radius)));
+		return ~_mm_movemask_ps(outside) & 0xF;
+	}
+#else
+	static int TestSphere(const ClusterGroupData& group, const glm::vec3& center, float radius) noexcept {
+		int mask = 0;
+		for (int k = 0; k < 4; k++) {
+			const float dx = std::max(std::max(group.minX[k] - center.x, 0.0f), center.x - group.maxX[k]);
+			const float dy = std::max(std::max(group.minY[k] - center.y, 0.0f), center.y - group.maxY[k]);
+			const float dz = std::max(std::max(group.minZ[k] - center.z, 0.0f), center.z - group.maxZ[k]);
+			if (dx * dx + dy * dy + dz * dz <= radius * radius)
+				mask |= 1 << k;
+		}
+		return mask;
+	}
+
+	static int TestCone(const ClusterGroupData& group, const ClusterSpotLight& light) noexcept {
+		int mask = 0;
+		for (int k = 0; k < 4; k++) {
+			const glm::vec3 v = glm::vec3(group.centerX[k], group.centerY[k], group.centerZ[k]) - light.position;
+			const float axialLength = glm::dot(v, light.direction);
+			const float radialLength = std::sqrt(std::max(glm::dot(v, v) - axialLength * axialLength, 0.0f));
+			const float closestDistance = radialLength * light.cosAngle - axialLength * light.sinAngle;
+			const bool outside = closestDistance > group.radius[k] || axialLength > group.radius[k] + light.range ||
+				axialLength < -group.radius[k];
+			if (!outside)
+				mask |= 1 << k;
+		}
+		return mask;
+	}
+#endif
+
+	void LightClusterGrid::StartUp(uint32_t jobCount) noexcept {
+		m_jobCount = std::max(1u, jobCount);
+		m_jobOutputs.resize(m_jobCount);
+		for (std::vector<float>* data : { &m_minX, &m_minY, &m_minZ, &m_maxX, &m_maxY, &m_maxZ, &m_centerX, &m_centerY, &m_centerZ, &m_radius })
+			data->resize(s_clusterCount, 0.0f);
+		m_clusters.reserve(s_clusterCount);
+	}
+
+	void LightClusterGrid::UpdateBounds(float fieldOfViewRadians, float aspectRatio, float zNear, float zFar) noexcept {
+		const glm::vec4 projectionParameters(fieldOfViewRadians, aspectRatio, zNear, zFar);
+		if (projectionParameters == m_projectionParameters)
+			return;
+		m_projectionParameters = projectionParameters;
+		//Las rebanadas se distribuyen exponencialmente: la rebanada k cubre las profundidades [n(f/n)^(k/Z), n(f/n)^((k+1)/Z)].
+		const float logDepthRatio = std::log(zFar / zNear);
+		m_depthSliceParameters = glm::vec2(s_gridZ / logDepthRatio, -static_cast<float>(s_gridZ) * std::log(zNear) / logDepthRatio);
+		const float tanHalfFov = std::tan(0.5f * fieldOfViewRadians);
+		//La camara mira hacia -z, un punto a profundidad d con coordenadas normalizadas (x,y) esta en
+		//(x * d * tanHalfFov * aspectRatio, y * d * tanHalfFov, -d).
+		for (uint32_t z = 0; z < s_gridZ; z++) {
+			const float nearDepth = zNear * std::pow(zFar / zNear, static_cast<float>(z) / s_gridZ);
+			const float farDepth = zNear * std::pow(zFar / zNear, static_cast<float>(z + 1) / s_gridZ);
+			for (uint32_t y = 0; y < s_gridY; y++) {
+				const float ndcY0 = -1.0f + 2.0f * y / s_gridY;
+				const float ndcY1 = -1.0f + 2.0f * (y + 1) / s_gridY;
+				for (uint32_t x = 0; x < s_gridX; x++) {
+					const float ndcX0 = -1.0f + 2.0f * x / s_gridX;
+					const float ndcX1 = -1.0f + 2.0f * (x + 1) / s_gridX;
+					glm::vec3 minPoint(std::numeric_limits<float>::max());
+					glm::vec3 maxPoint(std::numeric_limits<float>::lowest());
+					for (float depth : { nearDepth, farDepth }) {
+						for (float ndcX : { ndcX0, ndcX1 }) {
+							for (float ndcY : { ndcY0, ndcY1 }) {
+								const glm::vec3 corner(ndcX * depth * tanHalfFov * aspectRatio, ndcY * depth * tanHalfFov, -depth);
+								minPoint = glm::min(minPoint, corner);
+								maxPoint = glm::max(maxPoint, corner);
+							}
+						}
+					}
+					const uint32_t index = x + s_gridX * (y + s_gridY * z);
+					m_minX[index] = minPoint.x;
+					m_minY[index] = minPoint.y;
+					m_minZ[index] = minPoint.z;
+					m_maxX[index] = maxPoint.x;
+					m_maxY[index] = maxPoint.y;
+					m_maxZ[index] = maxPoint.z;
+					const glm::vec3 center = 0.5f * (minPoint + maxPoint);
+					m_centerX[index] = center.x;
+					m_centerY[index] = center.y;
+					m_centerZ[index] = center.z;
+					m_radius[index] = glm::length(maxPoint - center);
+				}
+			}
+		}
+	}
+
+	void LightClusterGrid::BuildRange(uint32_t firstCluster, uint32_t lastCluster, const std::vector<ClusterPointLight>& pointLights,
+		const std::vector<ClusterSpotLight>& spotLights, JobOutput& output) const noexcept {
+		output.clusters.clear();
+		output.lightIndices.clear();
+		std::array<std::array<uint32_t, s_maxLightsPerCluster>, 4> pointLists;
+		std::array<std::array<uint32_t, s_maxLightsPerCluster>, 4> spotLists;
+		std::array<uint32_t, 4> pointCounts;
+		std::array<uint32_t, 4> spotCounts;
+		for (uint32_t c = firstCluster; c < lastCluster; c += 4) {
+			const ClusterGroupData group = { &m_minX[c], &m_minY[c], &m_minZ[c], &m_maxX[c], &m_maxY[c], &m_maxZ[c],
+				&m_centerX[c], &m_centerY[c], &m_centerZ[c], &m_radius[c] };
+			pointCounts.fill(0);
+			spotCounts.fill(0);
+			for (uint32_t i = 0; i < pointLights.size(); i++) {
+				const int mask = TestSphere(group, pointLights[i].position, pointLights[i].radius);
+				for (int k = 0; mask != 0 && k < 4; k++) {
+					if ((mask & (1 << k)) && pointCounts[k] < s_maxLightsPerCluster)
+						pointLists[k][pointCounts[k]++] = i;
+				}
+			}
+			for (uint32_t i = 0; i < spotLights.size(); i++) {
+				//Primero se prueba la esfera que contiene al cono y luego el cono mismo.
+				int mask = TestSphere(group, spotLights[i].position, spotLights[i].range);
+				if (mask != 0)
+					mask &= TestCone(group, spotLights[i]);
+				for (int k = 0; mask != 0 && k < 4; k++) {
+					if ((mask & (1 << k)) && spotCounts[k] < s_maxLightsPerCluster)
+						spotLists[k][spotCounts[k]++] = i;
+				}
+			}
+			for (int k = 0; k < 4; k++) {
+				ClusterLightRange range;
+				range.pointOffset = static_cast<uint32_t>(output.lightIndices.size());
+				range.pointCount = pointCounts[k];
+				output.lightIndices.insert(output.lightIndices.end(), pointLists[k].begin(), pointLists[k].begin() + pointCounts[k]);
+				range.spotOffset = static_cast<uint32_t>(output.lightIndices.size());
+				range.spotCount = spotCounts[k];
+				output.lightIndices.insert(output.lightIndices.end(), spotLists[k].begin(), spotLists[k].begin() + spotCounts[k]);
+				output.clusters.push_back(range);
+			}
+		}
+	}
+
+	void LightClusterGrid::Build(const std::vector<ClusterPointLight>& pointLights, const std::vector<ClusterSpotLight>& spotLights) noexcept {
+		//Los clusters se reparten entre los trabajos en bloques de rebanadas completas, el primer bloque se procesa en el
+		//hilo actual mientras los demas se procesan en paralelo.
+		const size_t testCount = (pointLights.size() + spotLights.size()) * s_clusterCount;
+		const uint32_t jobCount = std::clamp(static_cast<uint32_t>(testCount / s_minTestsPerJob), 1u, m_jobCount);
+		const uint32_t slicesPerJob = (s_gridZ + jobCount - 1) / jobCount;
+		const uint32_t clustersPerSlice = s_gridX * s_gridY;
+		std::vector<std::future<void>> jobs;
+		jobs.reserve(jobCount);
+		for (uint32_t j = 1; j < jobCount; j++) {
+			const uint32_t firstCluster = std::min(j * slicesPerJob, s_gridZ) * clustersPerSlice;
+			const uint32_t lastCluster = std::min((j + 1) * slicesPerJob, s_gridZ) * clustersPerSlice;
+			jobs.push_back(std::async(std::launch::async, [this, firstCluster, lastCluster, &pointLights, &spotLights, j]() {
+				BuildRange(firstCluster, lastCluster, pointLights, spotLights, m_jobOutputs[j]);
+				}));
+		}
+		BuildRange(0, std::min(slicesPerJob, s_gridZ) * clustersPerSlice, pointLights, spotLights, m_jobOutputs[0]);
+		for (std::future<void>& job : jobs)
+			job.wait();
+
+		m_clusters.clear();
+		m_lightIndices.clear();
+		for (uint32_t j = 0; j < jobCount; j++) {
+			const uint32_t baseOffset = static_cast<uint32_t>(m_lightIndices.size());
+			for (ClusterLightRange range : m_jobOutputs[j].clusters) {
+				range.pointOffset += baseOffset;
+				range.spotOffset += baseOffset;
+				m_clusters.push_back(range);
+			}
+			m_lightIndices.insert(m_lightIndices.end(), m_jobOutputs[j].lightIndices.begin(), m_jobOutputs[j].lightIndices.end());
+		}
+	}
+}
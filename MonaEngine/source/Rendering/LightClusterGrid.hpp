@@ -0,0 +1,86 @@
+#pragma once
+#ifndef LIGHTCLUSTERGRID_HPP
+#define LIGHTCLUSTERGRID_HPP
+#include <vector>
+#include <cstdint>
+#include <glm/glm.hpp>
+namespace Mona {
+	/*
+	* Luz puntual expresada en el espacio de la camara, usada para asignar luces a los clusters.
+	*/
+	struct ClusterPointLight {
+		glm::vec3 position;
+		float radius;
+	};
+
+	/*
+	* Luz tipo spotlight expresada en el espacio de la camara. La luz se aproxima por un cono con vertice en position,
+	* eje direction (normalizado), largo range y semiangulo cuyo seno y coseno son sinAngle y cosAngle.
+	*/
+	struct ClusterSpotLight {
+		glm::vec3 position;
+		float range;
+		glm::vec3 direction;
+		float cosAngle;
+		float sinAngle;
+	};
+
+	/*
+	* Rango de luces asignadas a un cluster dentro de la lista de indices de luces. Se sube a la GPU tal cual como uvec4.
+	*/
+	struct ClusterLightRange {
+		uint32_t pointOffset;
+		uint32_t pointCount;
+		uint32_t spotOffset;
+		uint32_t spotCount;
+	};
+
+	/*
+	* Grilla de clusters (froxels) que divide el volumen de vision de la camara en s_gridX x s_gridY celdas en pantalla y
+	* s_gridZ rebanadas de profundidad distribuidas exponencialmente entre el plano cercano y el lejano. Build asigna a
+	* cada cluster la lista de luces que lo intersectan, probando cuatro clusters a la vez con SSE y repartiendo las
+	* rebanadas entre varios hilos cuando la cantidad de pruebas lo justifica. Cada cluster guarda a lo mas
+	* s_maxLightsPerCluster luces de cada tipo, lo que acota el costo de iluminacion por pixel.
+	*/
+	class LightClusterGrid {
+	public:
+		static constexpr uint32_t s_gridX = 16;
+		static constexpr uint32_t s_gridY = 9;
+		static constexpr uint32_t s_gridZ = 24;
+		static constexpr uint32_t s_clusterCount = s_gridX * s_gridY * s_gridZ;
+		static constexpr uint32_t s_maxLightsPerCluster = 64;
+		static_assert(s_clusterCount % 4 == 0, "LightClusterGrid Error: Cluster count must be a multiple of four.");
+
+		LightClusterGrid() = default;
+		void StartUp(uint32_t jobCount) noexcept;
+		/*
+		* Recalcula las cajas de los clusters en espacio de camara si cambiaron los parametros de la proyeccion.
+		*/
+		void UpdateBounds(float fieldOfViewRadians, float aspectRatio, float zNear, float zFar) noexcept;
+		void Build(const std::vector<ClusterPointLight>& pointLights, const std::vector<ClusterSpotLight>& spotLights) noexcept;
+		const std::vector<ClusterLightRange>& GetClusters() const noexcept { return m_clusters; }
+		const std::vector<uint32_t>& GetLightIndices() const noexcept { return m_lightIndices; }
+		/*
+		* Retorna (escala, sesgo) tales que la rebanada de un punto a profundidad d es floor(log(d) * escala + sesgo).
+		*/
+		glm::vec2 GetDepthSliceParameters() const noexcept { return m_depthSliceParameters; }
+	private:
+		struct JobOutput {
+			std::vector<ClusterLightRange> clusters;
+			std::vector<uint32_t> lightIndices;
+		};
+		void BuildRange(uint32_t firstCluster, uint32_t lastCluster, const std::vector<ClusterPointLight>& pointLights,
+			const std::vector<ClusterSpotLight>& spotLights, JobOutput& output) const noexcept;
+		uint32_t m_jobCount = 1;
+		glm::vec4 m_projectionParameters = glm::vec4(0.0f);
+		glm::vec2 m_depthSliceParameters = glm::vec2(0.0f);
+		//Cajas y esferas envolventes de cada cluster en espacio de camara, almacenadas por componente.
+		std::vector<float> m_minX, m_minY, m_minZ;
+		std::vector<float> m_maxX, m_maxY, m_maxZ;
+		std::vector<float> m_centerX, m_centerY, m_centerZ, m_radius;
+		std::vector<JobOutput> m_jobOutputs;
+		std::vector<ClusterLightRange> m_clusters;
+		std::vector<uint32_t> m_lightIndices;
+	};
+}
+#endif
@@ -1,10 +1,13 @@
 #pragma once
 #ifndef MATERIAL_HPP
 #define MATERIAL_HPP
+#include <array>
+#include <cstdint>
 #include <glm/glm.hpp>
 #include <glm/gtc/type_ptr.hpp>
 #include <glad/glad.h>
 #include "ShaderProgram.hpp"
+#include "RenderDevice.hpp"
 namespace Mona {
 	enum class MaterialType {
 		UnlitFlat,
@@ -16,30 +19,69 @@ namespace Mona {
 		MaterialTypeCount
 	};
 
+	/*
+	* Parametros de un material tal como se guardan en la tabla de materiales (ver MaterialTable), debe coincidir con el
+	* layout std430 de MaterialData en los shaders. color corresponde al color, albedo o tinte segun el tipo de material y
+	* factors a la metalicidad, rugosidad y oclusion ambiental de los materiales PBR sin texturas.
+	*/
+	struct MaterialParameters {
+		glm::vec4 color = glm::vec4(1.0f);
+		glm::vec4 factors = glm::vec4(0.0f);
+	};
+
+	/*
+	* Texturas de un material junto a la unidad de textura en que se enlaza cada una.
+	*/
+	struct MaterialTextures {
+		static constexpr uint32_t s_maxTextures = 5;
+		std::array<uint32_t, s_maxTextures> units = {};
+		std::array<uint32_t, s_maxTextures> textureIDs = {};
+		uint32_t count = 0;
+		void Add(uint32_t unit, uint32_t textureID) noexcept {
+			units[count] = unit;
+			textureIDs[count] = textureID;
+			count++;
+		}
+	};
+
+	/*
+	* Cada tipo de material define un metodo no virtual PackParameters(MaterialParameters&, MaterialTextures&) que escribe
+	* sus parametros y texturas. El renderer lo llama segun GetType al construir la tabla de materiales, por lo que dibujar
+	* no requiere llamados virtuales. Los metodos que modifican parametros deben llamar a OnParametersChanged.
+	*/
 	class Material {
 	public:
-		Material(const ShaderProgram& shaderProgram, bool isForSkinning) : m_shaderID(shaderProgram.GetProgramID()), m_isForSkinning(isForSkinning) {}
+		friend class Renderer;
+		friend class MaterialTable;
+		Material(const ShaderProgram& shaderProgram, bool isForSkinning, MaterialType type) :
+			m_isForSkinning(isForSkinning),
+			m_shaderID(shaderProgram.GetProgramID()),
+			m_type(type),
+			m_shaderIndex(0),
+			m_materialID(s_nextMaterialID++) {}
 		virtual ~Material() = default;
-		void SetUniforms(const glm::mat4& perspectiveMatrix,
-			const glm::mat4& viewMatrix,
-			const glm::mat4& modelMatrix,
-			const glm::vec3& cameraPosition) {
-
-			//Se Configura la informacin compartida por todos los materiales (Matrices y posicion camara).
-			glUseProgram(m_shaderID);
-			const glm::mat4 mvpMatrix = perspectiveMatrix * viewMatrix * modelMatrix;
-			const glm::mat4 modelInverseTransposeMatrix = glm::transpose(glm::inverse(modelMatrix));
-			glUniformMatrix4fv(ShaderProgram::MvpMatrixShaderLocation, 1, GL_FALSE, glm::value_ptr(mvpMatrix));
-			glUniformMatrix4fv(ShaderProgram::ModelMatrixShaderLocation, 1, GL_FALSE, glm::value_ptr(modelMatrix));
-			glUniformMatrix4fv(ShaderProgram::ModelInverseTransposeMatrixShaderLocation, 1, GL_FALSE, glm::value_ptr(modelInverseTransposeMatrix));
-			//Llamado a funcin virtual que implemental los materiales.
-			SetMaterialUniforms(cameraPosition);
-		}
-		virtual void SetMaterialUniforms(const glm::vec3& cameraPosition) = 0;
 		bool IsForSkinning() const { return m_isForSkinning; }
+		uint32_t GetShaderID() const { return m_shaderID; }
+		MaterialType GetType() const { return m_type; }
+		/*
+		* Identificador unico del material. Los materiales distintos con iguales parametros se agrupan igualmente al dibujar.
+		*/
+		uint32_t GetMaterialID() const { return m_materialID; }
 	protected:
+		void OnParametersChanged() noexcept { s_parametersVersion++; }
 		bool m_isForSkinning;
 		uint32_t m_shaderID;
+	private:
+		MaterialType m_type;
+		//Indice del programa dentro de los shaders del renderer, asignado por Renderer::CreateMaterial.
+		uint8_t m_shaderIndex;
+		uint32_t m_materialID;
+		//Entrada de la tabla de materiales asignada al material y generacion de la tabla en que se asigno.
+		uint32_t m_tableIndex = 0;
+		uint32_t m_tableGeneration = 0;
+		static inline uint32_t s_nextMaterialID = 0;
+		//Aumenta cada vez que cambian los parametros de cualquier material, invalida la tabla de materiales del renderer.
+		static inline uint32_t s_parametersVersion = 0;
 	};
 }
 #endif
\ No newline at end of file
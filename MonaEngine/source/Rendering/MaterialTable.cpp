@@ -0,0 +1,101 @@
+#include "MaterialTable.hpp"
+#include <cstring>
+#include "UnlitFlatMaterial.hpp"
+#include "UnlitTexturedMaterial.hpp"
+#include "DiffuseFlatMaterial.hpp"
+#include "DiffuseTexturedMaterial.hpp"
+#include "PBRFlatMaterial.hpp"
+#include "PBRTexturedMaterial.hpp"
+namespace Mona {
+
+	template <typename MaterialClass>
+	static void PackParameters(const Material& material, MaterialParameters& parameters, MaterialTextures& textures) noexcept {
+		static_cast<const MaterialClass&>(material).PackParameters(parameters, textures);
+	}
+
+	void MaterialTable::Clear() noexcept {
+		m_indices.clear();
+		m_parameters.clear();
+		m_textures.clear();
+		m_mergedCount = 0;
+		m_generation = s_nextGeneration++;
+	}
+
+	uint32_t MaterialTable::Resolve(Material& material) noexcept {
+		if (material.m_tableGeneration == m_generation)
+			return material.m_tableIndex;
+		MaterialParameters parameters;
+		MaterialTextures textures;
+		PackMaterial(material, parameters, textures);
+		const auto [it, inserted] = m_indices.try_emplace(MakeKey(material.m_shaderIndex, parameters, textures), GetCount());
+		if (inserted) {
+			m_parameters.push_back(parameters);
+			m_textures.push_back(textures);
+		}
+		else
+			m_mergedCount++;
+		material.m_tableIndex = it->second;
+		material.m_tableGeneration = m_generation;
+		return it->second;
+	}
+
+	void MaterialTable::PackMaterial(const Material& material, MaterialParameters& parameters, MaterialTextures& textures) noexcept {
+		switch (material.GetType())
+		{
+		case MaterialType::UnlitFlat:
+			PackParameters<UnlitFlatMaterial>(material, parameters, textures);
+			break;
+		case MaterialType::UnlitTextured:
+			PackParameters<UnlitTexturedMaterial>(material, parameters, textures);
+			break;
+		case MaterialType::DiffuseFlat:
+			PackParameters<DiffuseFlatMaterial>(material, parameters, textures);
+			break;
+		case MaterialType::DiffuseTextured:
+			PackParameters<DiffuseTexturedMaterial>(material, parameters, textures);
+			break;
+		case MaterialType::PBRFlat:
+			PackParameters<PBRFlatMaterial>(material, parameters, textures);
+			break;
+		case MaterialType::PBRTextured:
+			PackParameters<PBRTexturedMaterial>(material, parameters, textures);
+			break;
+		default:
+			break;
+		}
+	}
+
+	MaterialTable::Key MaterialTable::MakeKey(const Material& material) noexcept {
+		MaterialParameters parameters;
+		MaterialTextures textures;
+		PackMaterial(material, parameters, textures);
+		return MakeKey(material.m_shaderIndex, parameters, textures);
+	}
+
+	bool MaterialTable::SharesTextures(uint32_t first, uint32_t second) const noexcept {
+		if (first == second)
+			return true;
+		const MaterialTextures& firstTextures = m_textures[first];
+		const MaterialTextures& secondTextures = m_textures[second];
+		if (firstTextures.count != secondTextures.count)
+			return false;
+		for (uint32_t i = 0; i < firstTextures.count; i++) {
+			if (firstTextures.units[i] != secondTextures.units[i] || firstTextures.textureIDs[i] != secondTextures.textureIDs[i])
+				return false;
+		}
+		return true;
+	}
+
+	MaterialTable::Key MaterialTable::MakeKey(uint8_t shaderIndex, const MaterialParameters& parameters, const MaterialTextures& textures) noexcept {
+		static_assert(sizeof(MaterialParameters) == 8 * sizeof(uint32_t), "MaterialParameters must not have padding");
+		Key key = {};
+		key[0] = shaderIndex;
+		std::memcpy(&key[1], &parameters, sizeof(MaterialParameters));
+		key[9] = textures.count;
+		for (uint32_t i = 0; i < textures.count; i++) {
+			key[10 + 2 * i] = textures.units[i];
+			key[11 + 2 * i] = textures.textureIDs[i];
+		}
+		return key;
+	}
+}
@@ -0,0 +1,57 @@
+#pragma once
+#ifndef MATERIALTABLE_HPP
+#define MATERIALTABLE_HPP
+#include <array>
+#include <cstdint>
+#include <map>
+#include <vector>
+#include "Material.hpp"
+namespace Mona {
+	/*
+	* Tabla con los parametros de los materiales dibujados en un frame, se sube completa a un buffer que los shaders indexan
+	* con el materialIndex de los datos por objeto. Los materiales que usan el mismo programa y tienen iguales parametros y
+	* texturas comparten una entrada, por lo que se ordenan y dibujan como un unico material. Los parametros se obtienen con
+	* el PackParameters del tipo concreto de cada material (ver Material), sin llamados virtuales. El renderer vacia la tabla
+	* cada vez que reconstruye la cola de render.
+	*/
+	class MaterialTable {
+	public:
+		//Programa, parametros y texturas de una entrada, los flotantes se comparan por su representacion binaria.
+		using Key = std::array<uint32_t, 10 + 2 * MaterialTextures::s_maxTextures>;
+		MaterialTable() = default;
+		void Clear() noexcept;
+		/*
+		* Retorna la entrada del material, agregandola si ningun material resuelto desde el ultimo Clear tiene sus mismos
+		* parametros. Resolver nuevamente un material ya resuelto no vuelve a leer sus parametros.
+		*/
+		uint32_t Resolve(Material& material) noexcept;
+		uint32_t GetCount() const noexcept { return static_cast<uint32_t>(m_parameters.size()); }
+		/*
+		* Cantidad de materiales resueltos desde el ultimo Clear que reutilizaron la entrada de otro material.
+		*/
+		uint32_t GetMergedCount() const noexcept { return m_mergedCount; }
+		const std::vector<MaterialParameters>& GetParameters() const noexcept { return m_parameters; }
+		const MaterialTextures& GetTextures(uint32_t index) const noexcept { return m_textures[index]; }
+		/*
+		* Indica si dos entradas enlazan las mismas texturas en las mismas unidades, en cuyo caso pueden dibujarse con un
+		* mismo llamado aunque sus parametros difieran.
+		*/
+		bool SharesTextures(uint32_t first, uint32_t second) const noexcept;
+		/*
+		* Llave con la que Resolve agrupa los materiales, dos materiales con la misma llave se dibujan como uno solo.
+		*/
+		static Key MakeKey(const Material& material) noexcept;
+	private:
+		static void PackMaterial(const Material& material, MaterialParameters& parameters, MaterialTextures& textures) noexcept;
+		static Key MakeKey(uint8_t shaderIndex, const MaterialParameters& parameters, const MaterialTextures& textures) noexcept;
+		std::map<Key, uint32_t> m_indices;
+		std::vector<MaterialParameters> m_parameters;
+		std::vector<MaterialTextures> m_textures;
+		uint32_t m_mergedCount = 0;
+		//Las generaciones son unicas entre todas las tablas, de manera que un material compartido entre dos renderers
+		//nunca confunde la entrada que le asigno uno con la del otro.
+		uint32_t m_generation = s_nextGeneration++;
+		static inline uint32_t s_nextGeneration = 1;
+	};
+}
+#endif
@@ -1,16 +1,24 @@
 #include "Mesh.hpp"
+#include "MeshManager.hpp"
 
 #include "../Core/Log.hpp"
 #include "../Core/AssimpTransformations.hpp"
+#include "MeshOptimizer.hpp"
+#include "MeshSimplifier.hpp"
+#include "MeshClusters.hpp"
 #include <glm/glm.hpp>
 #include <assimp/Importer.hpp>
 #include <assimp/postprocess.h>
 #include <vector>
+#include <algorithm>
 #include <stack>
 #include <glad/glad.h>
+#include <glm/gtc/packing.hpp>
+#include <cstddef>
 #include <iostream>
 namespace Mona {
 
+	//Vertice con precision completa, usado al cargar o construir la malla antes de comprimirla.
 	struct MeshVertex {
 		glm::vec3 position;
 		glm::vec3 normal;
@@ -18,26 +26,128 @@ namespace Mona {
 		glm::vec3 tangent;
 		glm::vec3 bitangent;
 	};
+	//Las primitivas se construyen como arreglos de 14 flotantes por vertice con el mismo orden que MeshVertex.
+	static_assert(sizeof(MeshVertex) == 14 * sizeof(float), "Mesh Error: Unexpected vertex layout.");
+
+	//Atributos comprimidos que acompanan a cada posicion en la GPU. La normal y la tangente usan 10 bits con signo por
+	//componente (GL_INT_2_10_10_10_REV), el componente w de la tangente guarda el signo de la bitangente, que el shader
+	//reconstruye como cross(normal, tangent) * w. Las coordenadas de textura usan flotantes de 16 bits.
+	struct PackedMeshAttributes {
+		uint32_t normal;
+		uint32_t tangent;
+		uint32_t uv;
+	};
 	
+	VertexFormat Mesh::GetVertexFormat() noexcept {
+		//El flujo cero contiene solo posiciones (12 bytes por vertice) y el flujo uno los atributos comprimidos (12 bytes
+		//por vertice), en vez de los 56 bytes de MeshVertex.
+		VertexFormat format;
+		format.streamStrides = { sizeof(glm::vec3), sizeof(PackedMeshAttributes) };
+		format.attributes = {
+			{ 0, 3, GL_FLOAT, false, 0, 0 },
+			{ 1, 4, GL_INT_2_10_10_10_REV, true, static_cast<uint32_t>(offsetof(PackedMeshAttributes, normal)), 1 },
+			{ 2, 2, GL_HALF_FLOAT, false, static_cast<uint32_t>(offsetof(PackedMeshAttributes, uv)), 1 },
+			{ 3, 4, GL_INT_2_10_10_10_REV, true, static_cast<uint32_t>(offsetof(PackedMeshAttributes, tangent)), 1 }
+		};
+		return format;
+	}
+
+	void Mesh::SetGeometry(StaticGeometryBuffers& geometryBuffers, const MeshVertex* vertices, uint32_t vertexCount,
+		const uint32_t* indices, uint32_t indexCount) noexcept {
+		m_bounds = MeshBounds::FromPositions(vertices, vertexCount, sizeof(MeshVertex));
+		//Cada nivel de detalle busca la mitad de los triangulos del anterior simplificando siempre la geometria original,
+		//de manera que el error medido es respecto a la superficie original. Se deja de generar niveles cuando la
+		//simplificacion ya no reduce la cantidad de triangulos en forma significativa (por ejemplo cuando los vertices
+		//restantes estan en bordes o costuras).
+		std::vector<uint32_t> lodIndices(indices, indices + indexCount);
+		m_lods[0] = { 0, indexCount, 0.0f };
+		m_lodCount = 1;
+		const float radius = m_bounds.sphere.radius;
+		if (radius > 0.0f) {
+			const std::vector<uint32_t> originalIndices = lodIndices;
+			std::vector<uint32_t> simplifiedIndices;
+			while (m_lodCount < s_maxLODCount) {
+				const MeshLOD& previous = m_lods[m_lodCount - 1];
+				const uint32_t targetIndexCount = previous.indexCount / 6 * 3;
+				const float error = SimplifyMesh(simplifiedIndices, originalIndices, vertices, vertexCount, sizeof(MeshVertex),
+					static_cast<uint32_t>(offsetof(MeshVertex, position)), targetIndexCount, s_maxLODError * radius);
+				const uint32_t simplifiedIndexCount = static_cast<uint32_t>(simplifiedIndices.size());
+				if (simplifiedIndexCount == 0 || simplifiedIndexCount > previous.indexCount * 4 / 5)
+					break;
+				OptimizeVertexCache(simplifiedIndices, vertexCount, nullptr);
+				m_lods[m_lodCount] = { static_cast<uint32_t>(lodIndices.size()), simplifiedIndexCount,
+					std::max(previous.error, error / radius) };
+				lodIndices.insert(lodIndices.end(), simplifiedIndices.begin(), simplifiedIndices.end());
+				m_lodCount++;
+			}
+		}
+
+		//Los triangulos del nivel cero se reparten en grupos contiguos que el renderer descarta por separado. Las mallas que
+		//caben en un unico grupo no se dividen.
+		m_clusters.clear();
+		if (indexCount / 3 > MAX_CLUSTER_TRIANGLES) {
+			std::vector<uint32_t> clusterIndices(lodIndices.begin(), lodIndices.begin() + indexCount);
+			BuildMeshClusters(m_clusters, clusterIndices, vertices, vertexCount, sizeof(MeshVertex),
+				static_cast<uint32_t>(offsetof(MeshVertex, position)));
+			std::copy(clusterIndices.begin(), clusterIndices.end(), lodIndices.begin());
+		}
+
+		std::vector<glm::vec3> positions(vertexCount);
+		std::vector<PackedMeshAttributes> attributes(vertexCount);
+		for (uint32_t i = 0; i < vertexCount; i++) {
+			const MeshVertex& vertex = vertices[i];
+			const float bitangentSign = glm::dot(glm::cross(vertex.normal, vertex.tangent), vertex.bitangent) < 0.0f ? -1.0f : 1.0f;
+			positions[i] = vertex.position;
+			attributes[i].normal = glm::packSnorm3x10_1x2(glm::vec4(vertex.normal, 0.0f));
+			attributes[i].tangent = glm::packSnorm3x10_1x2(glm::vec4(vertex.tangent, bitangentSign));
+			attributes[i].uv = glm::packHalf2x16(vertex.uv);
+		}
+		m_geometryBufferIndex = vertexCount <= 65536 ? 0 : 1;
+		m_geometryBuffer = &geometryBuffers[m_geometryBufferIndex];
+		const void* streams[] = { positions.data(), attributes.data() };
+		m_geometryHandle = m_geometryBuffer->Allocate(streams, vertexCount, lodIndices.data(), static_cast<uint32_t>(lodIndices.size()));
+		//Se conserva una copia del nivel cero para rasterizar la malla como oclusor o unirla a un lote estatico sin leerla
+		//desde la GPU durante el frame.
+		const MeshManager& meshManager = MeshManager::GetInstance();
+		m_occluderGeometry.reset();
+		m_batchAttributes.clear();
+		if (meshManager.KeepsOccluderGeometry() || meshManager.KeepsStaticBatchGeometry()) {
+			m_occluderGeometry = std::make_unique<MeshOccluderGeometry>();
+			m_occluderGeometry->positions = std::move(positions);
+			m_occluderGeometry->indices.assign(lodIndices.begin(), lodIndices.begin() + indexCount);
+		}
+		if (meshManager.KeepsStaticBatchGeometry())
+			m_batchAttributes = std::move(attributes);
+	}
+
+	const MeshOccluderGeometry& Mesh::GetOccluderGeometry() noexcept {
+		if (m_occluderGeometry == nullptr) {
+			//Solo ocurre si la malla se cargo sin conservar su geometria en CPU (occlusion_culling desactivado), en ese caso
+			//se lee una unica vez desde los buffers compartidos. El flujo cero contiene solo posiciones.
+			m_occluderGeometry = std::make_unique<MeshOccluderGeometry>();
+			m_occluderGeometry->positions.resize(GetGeometryRange().vertexCount);
+			m_occluderGeometry->indices.resize(m_lods[0].indexCount);
+			m_geometryBuffer->ReadVertices(m_geometryHandle, 0, m_occluderGeometry->positions.data());
+			m_geometryBuffer->ReadIndices(m_geometryHandle, m_lods[0].indexOffset, m_lods[0].indexCount, m_occluderGeometry->indices.data());
+		}
+		return *m_occluderGeometry;
+	}
+
 	Mesh::~Mesh() {
-		if (m_vertexArrayID)
+		if (m_geometryHandle != GeometryBuffer::s_invalidHandle)
 			ClearData();
 	}
 	void Mesh::ClearData() noexcept {
-		MONA_ASSERT(m_vertexArrayID, "Mesh Error: Trying to delete already deleted mesh");
-		MONA_ASSERT(m_vertexBufferID, "Mesh Error: Trying to delete already deleted mesh");
-		MONA_ASSERT(m_indexBufferID, "Mesh Error: Trying to delete already deleted mesh");
-		glDeleteBuffers(1, &m_vertexBufferID);
-		glDeleteBuffers(1, &m_indexBufferID);
-		glDeleteVertexArrays(1, &m_vertexArrayID);
-		m_vertexArrayID = 0;
+		MONA_ASSERT(m_geometryHandle != GeometryBuffer::s_invalidHandle, "Mesh Error: Trying to delete already deleted mesh");
+		m_geometryBuffer->Free(m_geometryHandle);
+		m_geometryHandle = GeometryBuffer::s_invalidHandle;
 	}
-	
-	Mesh::Mesh(const std::string& filePath, bool flipUVs) :
-		m_vertexArrayID(0),
-		m_vertexBufferID(0),
-		m_indexBufferID(0),
-		m_indexBufferCount(0)
+
+	Mesh::Mesh(StaticGeometryBuffers& geometryBuffers, const std::string& filePath, bool flipUVs) :
+		m_geometryBuffer(&geometryBuffers[0]),
+		m_geometryHandle(GeometryBuffer::s_invalidHandle),
+		m_geometryBufferIndex(0),
+		m_lodCount(1)
 	{
 		Assimp::Importer importer;
 		unsigned int postProcessFlags = flipUVs ? aiProcess_FlipUVs : 0;
@@ -47,8 +157,9 @@ namespace Mona {
 
 
 		if (!scene) {
-			//En caso de fallar la carga se envia un mensaje de error.
+			//En caso de fallar la carga se envia un mensaje de error y la malla queda sin geometria.
 			MONA_LOG_ERROR("Mesh Error: Failed to open file with path {0}", filePath);
+			SetGeometry(geometryBuffers, nullptr, 0, nullptr, 0);
 			return;
 		}
 
@@ -131,65 +242,122 @@ namespace Mona {
 			}
 		}
 
-		//Comienza el paso de los datos en CPU a GPU usando OpenGL
-		m_indexBufferCount = static_cast<uint32_t>(faces.size());
-		glGenVertexArrays(1, &m_vertexArrayID);
-		glBindVertexArray(m_vertexArrayID);
-
-		glGenBuffers(1, &m_vertexBufferID);
-		glGenBuffers(1, &m_indexBufferID);
-		glBindBuffer(GL_ARRAY_BUFFER, m_vertexBufferID);
-		glBufferData(GL_ARRAY_BUFFER, static_cast<unsigned int>(vertices.size()) * sizeof(MeshVertex), vertices.data(), GL_STATIC_DRAW);
-		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_indexBufferID);
-		glBufferData(GL_ELEMENT_ARRAY_BUFFER, static_cast<unsigned int>(faces.size()) * sizeof(unsigned int), faces.data(), GL_STATIC_DRAW);
-		//Un vertice de la malla se ve como
-		// v = {pos_x, pos_y, pos_z, normal_x, normal_y, normal_z, uv_u, uv_v, tangent_x, tangent_y, tangent_z}
-		glEnableVertexAttribArray(0);
-		glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(MeshVertex), (void*)offsetof(MeshVertex, position));
-		glEnableVertexAttribArray(1);
-		glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, sizeof(MeshVertex), (void*)offsetof(MeshVertex, normal));
-		glEnableVertexAttribArray(2);
-		glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, sizeof(MeshVertex), (void*)offsetof(MeshVertex, uv));
-		glEnableVertexAttribArray(3);
-		glVertexAttribPointer(3, 3, GL_FLOAT, GL_FALSE, sizeof(MeshVertex), (void*)offsetof(MeshVertex, tangent));
-		glEnableVertexAttribArray(4);
-		glVertexAttribPointer(4, 3, GL_FLOAT, GL_FALSE, sizeof(MeshVertex), (void*)offsetof(MeshVertex, bitangent));
-		
+		//Los vertices importados se repiten por cada cara y siguen el orden del grafo de la escena. Se unen los vertices
+		//identicos y se reordenan triangulos y vertices para el cache post transformacion, el overdraw y la lectura.
+		uint32_t vertexCount = static_cast<uint32_t>(vertices.size());
+		const MeshOptimizationStatistics statistics = OptimizeMesh(vertices.data(), vertexCount, sizeof(MeshVertex),
+			static_cast<uint32_t>(offsetof(MeshVertex, position)), faces);
+		vertices.resize(vertexCount);
+		LogMeshOptimizationStatistics(filePath, statistics);
+
+		//Los datos se comprimen y copian a los buffers compartidos por todas las mallas estaticas.
+		SetGeometry(geometryBuffers, vertices.data(), static_cast<uint32_t>(vertices.size()),
+			faces.data(), static_cast<uint32_t>(faces.size()));
+	}
+
+	Mesh::Mesh(StaticGeometryBuffers& geometryBuffers, const std::vector<StaticBatchPart>& parts) :
+		m_geometryBuffer(&geometryBuffers[0]),
+		m_geometryHandle(GeometryBuffer::s_invalidHandle),
+		m_geometryBufferIndex(0),
+		m_lodCount(1)
+	{
+		auto safeNormalize = [](const glm::vec3& v) {
+			const float length = glm::length(v);
+			return length > 0.0f ? v / length : v;
+		};
+		std::vector<MeshVertex> vertices;
+		std::vector<uint32_t> indices;
+		std::vector<glm::vec3> readPositions;
+		std::vector<PackedMeshAttributes> readAttributes;
+		std::vector<uint32_t> readIndices;
+		for (const StaticBatchPart& part : parts) {
+			const Mesh& mesh = *part.mesh;
+			if (mesh.m_geometryHandle == GeometryBuffer::s_invalidHandle)
+				continue;
+			const uint32_t vertexCount = mesh.GetGeometryRange().vertexCount;
+			const uint32_t partIndexCount = mesh.m_lods[0].indexCount;
+			const glm::vec3* positions = nullptr;
+			const PackedMeshAttributes* attributes = nullptr;
+			const uint32_t* partIndices = nullptr;
+			if (mesh.m_occluderGeometry != nullptr && mesh.m_batchAttributes.size() == vertexCount) {
+				positions = mesh.m_occluderGeometry->positions.data();
+				attributes = mesh.m_batchAttributes.data();
+				partIndices = mesh.m_occluderGeometry->indices.data();
+			}
+			else {
+				//Solo ocurre con mallas cargadas sin conservar su geometria en CPU (static_batching desactivado).
+				readPositions.resize(vertexCount);
+				readAttributes.resize(vertexCount);
+				readIndices.resize(partIndexCount);
+				mesh.m_geometryBuffer->ReadVertices(mesh.m_geometryHandle, 0, readPositions.data());
+				mesh.m_geometryBuffer->ReadVertices(mesh.m_geometryHandle, 1, readAttributes.data());
+				mesh.m_geometryBuffer->ReadIndices(mesh.m_geometryHandle, mesh.m_lods[0].indexOffset, partIndexCount, readIndices.data());
+				positions = readPositions.data();
+				attributes = readAttributes.data();
+				partIndices = readIndices.data();
+			}
+			//Las normales se transforman con la inversa traspuesta. Si la matriz invierte la orientacion se invierte el orden
+			//de los vertices de cada triangulo para conservar el sentido de sus caras.
+			const glm::mat3 linear(part.modelMatrix);
+			const glm::mat3 normalMatrix = glm::transpose(glm::inverse(linear));
+			const bool mirrored = glm::determinant(linear) < 0.0f;
+			const uint32_t baseVertex = static_cast<uint32_t>(vertices.size());
+			for (uint32_t i = 0; i < vertexCount; i++) {
+				const glm::vec4 normal = glm::unpackSnorm3x10_1x2(attributes[i].normal);
+				const glm::vec4 tangent = glm::unpackSnorm3x10_1x2(attributes[i].tangent);
+				MeshVertex vertex;
+				vertex.position = glm::vec3(part.modelMatrix * glm::vec4(positions[i], 1.0f));
+				vertex.normal = safeNormalize(normalMatrix * glm::vec3(normal));
+				vertex.uv = glm::unpackHalf2x16(attributes[i].uv);
+				vertex.tangent = safeNormalize(linear * glm::vec3(tangent));
+				vertex.bitangent = safeNormalize(linear * (glm::cross(glm::vec3(normal), glm::vec3(tangent)) * tangent.w));
+				vertices.push_back(vertex);
+			}
+			for (uint32_t i = 0; i < partIndexCount; i += 3) {
+				indices.push_back(baseVertex + partIndices[i]);
+				indices.push_back(baseVertex + partIndices[i + (mirrored ? 2 : 1)]);
+				indices.push_back(baseVertex + partIndices[i + (mirrored ? 1 : 2)]);
+			}
+		}
+		SetGeometry(geometryBuffers, vertices.data(), static_cast<uint32_t>(vertices.size()), indices.data(), static_cast<uint32_t>(indices.size()));
+		//Los lotes no se usan como oclusores ni se unen a otros lotes, por lo que no necesitan su copia en CPU.
+		m_occluderGeometry.reset();
+		m_batchAttributes = std::vector<PackedMeshAttributes>();
 	}
 
-	Mesh::Mesh(PrimitiveType type) :
-		m_vertexArrayID(0),
-		m_vertexBufferID(0),
-		m_indexBufferID(0),
-		m_indexBufferCount(0)
+	Mesh::Mesh(StaticGeometryBuffers& geometryBuffers, PrimitiveType type) :
+		m_geometryBuffer(&geometryBuffers[0]),
+		m_geometryHandle(GeometryBuffer::s_invalidHandle),
+		m_geometryBufferIndex(0),
+		m_lodCount(1)
 	{
 		switch (type)
 		{
 			case Mona::Mesh::PrimitiveType::Plane:
 			{
-				CreatePlane();
+				CreatePlane(geometryBuffers);
 				break;
 			}
 			case Mona::Mesh::PrimitiveType::Cube:
 			{
-				CreateCube();
+				CreateCube(geometryBuffers);
 				break;
 			}
 			case Mona::Mesh::PrimitiveType::Sphere:
 			{
-				CreateSphere();
+				CreateSphere(geometryBuffers);
 				break;
 			}
 			default:
 			{
 
-				CreateSphere();
+				CreateSphere(geometryBuffers);
 				break;
 			}
 		}
 	}
 
-	void Mesh::CreateCube() noexcept {
+	void Mesh::CreateCube(StaticGeometryBuffers& geometryBuffers) noexcept {
 		// Cada vertice tiene la siguiente forma
 		// v = {p_x, p_y, p_z, n_x, n_y, n_z, uv_u, uv_v, t_x, t_y, t_z, b_x, b_y, b_z};
 		float vertices[] = {
@@ -243,33 +411,10 @@ namespace Mona {
 			24,25,26,27,28,29,
 			30,31,32,33,34,35
 		};
-		unsigned int cubeVBO, cubeIBO, cubeVAO;
-		glGenVertexArrays(1, &cubeVAO);
-		glBindVertexArray(cubeVAO);
-
-		glGenBuffers(1, &cubeVBO);
-		glGenBuffers(1, &cubeIBO);
-		glBindBuffer(GL_ARRAY_BUFFER, cubeVBO);
-		glBufferData(GL_ARRAY_BUFFER, sizeof(vertices), vertices, GL_STATIC_DRAW);
-		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, cubeIBO);
-		glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(indices), indices, GL_STATIC_DRAW);
-		glEnableVertexAttribArray(0);
-		glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 14 * sizeof(float), (void*)0);
-		glEnableVertexAttribArray(1);
-		glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, 14 * sizeof(float), (void*)(3 * sizeof(float)));
-		glEnableVertexAttribArray(2);
-		glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, 14 * sizeof(float), (void*)(6 * sizeof(float)));
-		glEnableVertexAttribArray(3);
-		glVertexAttribPointer(3, 3, GL_FLOAT, GL_FALSE, 14 * sizeof(float), (void*)(8 * sizeof(float)));
-		glEnableVertexAttribArray(4);
-		glVertexAttribPointer(4, 3, GL_FLOAT, GL_FALSE, 14 * sizeof(float), (void*)(11 * sizeof(float)));
-		m_vertexArrayID = cubeVAO;
-		m_vertexBufferID = cubeVBO;
-		m_indexBufferID = cubeIBO;
-		m_indexBufferCount = 36;
+		SetGeometry(geometryBuffers, reinterpret_cast<const MeshVertex*>(vertices), 36, indices, 36);
 	}
 
-	void Mesh::CreatePlane() noexcept {
+	void Mesh::CreatePlane(StaticGeometryBuffers& geometryBuffers) noexcept {
 		// Cada vertice tiene la siguiente forma
 		// v = {p_x, p_y, p_z, n_x, n_y, n_z, uv_u, uv_v, t_x, t_y, t_z, b_x, b_y, b_z};
 		float planeVertices[] = {
@@ -286,33 +431,10 @@ namespace Mona {
 			0,1,2,3,4,5
 		};
 
-		unsigned int planeVBO, planeIBO, planeVAO;
-		glGenVertexArrays(1, &planeVAO);
-		glBindVertexArray(planeVAO);
-		glGenBuffers(1, &planeVBO);
-		glGenBuffers(1, &planeIBO);
-
-		glBindBuffer(GL_ARRAY_BUFFER, planeVBO);
-		glBufferData(GL_ARRAY_BUFFER, sizeof(planeVertices), planeVertices, GL_STATIC_DRAW);
-		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, planeIBO);
-		glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(planeIndices), planeIndices, GL_STATIC_DRAW);
-		glEnableVertexAttribArray(0);
-		glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 14 * sizeof(float), (void*)0);
-		glEnableVertexAttribArray(1);
-		glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, 14 * sizeof(float), (void*)(3 * sizeof(float)));
-		glEnableVertexAttribArray(2);
-		glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, 14 * sizeof(float), (void*)(6 * sizeof(float)));
-		glEnableVertexAttribArray(3);
-		glVertexAttribPointer(3, 3, GL_FLOAT, GL_FALSE, 14 * sizeof(float), (void*)(8 * sizeof(float)));
-		glEnableVertexAttribArray(4);
-		glVertexAttribPointer(4, 3, GL_FLOAT, GL_FALSE, 14 * sizeof(float), (void*)(11 * sizeof(float)));
-		m_vertexArrayID = planeVAO;
-		m_vertexBufferID = planeVBO;
-		m_indexBufferID = planeIBO;
-		m_indexBufferCount = 6;
+		SetGeometry(geometryBuffers, reinterpret_cast<const MeshVertex*>(planeVertices), 6, planeIndices, 6);
 	}
 
-	void Mesh::CreateSphere() noexcept {
+	void Mesh::CreateSphere(StaticGeometryBuffers& geometryBuffers) noexcept {
 		//Esta implementacin de la creacion procedural de la malla de una esfera
 		//esta basada en: http://www.songho.ca/opengl/gl_sphere.html
 
@@ -398,30 +520,8 @@ namespace Mona {
 				}
 			}
 		}
-		unsigned int sphereVBO, sphereIBO, sphereVAO;
-		glGenVertexArrays(1, &sphereVAO);
-		glBindVertexArray(sphereVAO);
-
-		glGenBuffers(1, &sphereVBO);
-		glGenBuffers(1, &sphereIBO);
-		glBindBuffer(GL_ARRAY_BUFFER, sphereVBO);
-		glBufferData(GL_ARRAY_BUFFER, static_cast<unsigned int>(vertices.size()) * sizeof(float), vertices.data(), GL_STATIC_DRAW);
-		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, sphereIBO);
-		glBufferData(GL_ELEMENT_ARRAY_BUFFER, static_cast<unsigned int>(indices.size()) * sizeof(unsigned int), indices.data(), GL_STATIC_DRAW);
-		glEnableVertexAttribArray(0);
-		glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 14 * sizeof(float), (void*)0);
-		glEnableVertexAttribArray(1);
-		glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, 14 * sizeof(float), (void*)(3 * sizeof(float)));
-		glEnableVertexAttribArray(2);
-		glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, 14 * sizeof(float), (void*)(6 * sizeof(float)));
-		glEnableVertexAttribArray(3);
-		glVertexAttribPointer(3, 3, GL_FLOAT, GL_FALSE, 14 * sizeof(float), (void*)(8 * sizeof(float)));
-		glEnableVertexAttribArray(4);
-		glVertexAttribPointer(4, 3, GL_FLOAT, GL_FALSE, 14 * sizeof(float), (void*)(11 * sizeof(float)));
-		m_vertexArrayID = sphereVAO;
-		m_vertexBufferID = sphereVBO;
-		m_indexBufferID = sphereIBO;
-		m_indexBufferCount = static_cast<uint32_t>(indices.size());
+		SetGeometry(geometryBuffers, reinterpret_cast<const MeshVertex*>(vertices.data()), static_cast<uint32_t>(vertices.size() / 14),
+			indices.data(), static_cast<uint32_t>(indices.size()));
 	}
 
 
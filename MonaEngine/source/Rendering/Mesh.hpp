@@ -3,9 +3,48 @@
 #define MESH_HPP
 #include <cstdint>
 #include <string>
+#include <array>
+#include <vector>
+#include <memory>
 #include <assimp/scene.h>
+#include "BoundingVolume.hpp"
+#include "GeometryBuffer.hpp"
+#include "MeshClusters.hpp"
 
 namespace Mona {
+	/*
+	* Las mallas estaticas se reparten en dos grupos de buffers compartidos: el primero usa indices de 16 bits y recibe las
+	* mallas de hasta 65536 vertices, el segundo usa indices de 32 bits y recibe el resto.
+	*/
+	using StaticGeometryBuffers = std::array<GeometryBuffer, 2>;
+	/*
+	* Nivel de detalle de una malla. Todos los niveles comparten los vertices de la malla y sus indices se ubican uno a
+	* continuacion del otro dentro del rango de la malla, a partir de indexOffset. error es la maxima distancia entre la
+	* superficie simplificada y la original, relativa al radio de la esfera envolvente de la malla, y crece con el nivel.
+	*/
+	struct MeshLOD {
+		uint32_t indexOffset = 0;
+		uint32_t indexCount = 0;
+		float error = 0.0f;
+	};
+	/*
+	* Copia en CPU de las posiciones y los indices del nivel de detalle cero de una malla, usada para rasterizarla como
+	* oclusor (ver OcclusionCuller).
+	*/
+	struct MeshOccluderGeometry {
+		std::vector<glm::vec3> positions;
+		std::vector<uint32_t> indices;
+	};
+	class Mesh;
+	/*
+	* Malla y matriz de modelo de una de las partes de un lote estatico (ver MeshManager::CreateStaticBatchMesh).
+	*/
+	struct StaticBatchPart {
+		Mesh* mesh;
+		glm::mat4 modelMatrix;
+	};
+	struct MeshVertex;
+	struct PackedMeshAttributes;
 	class Mesh {
 		friend class MeshManager;
 	public:
@@ -15,26 +54,84 @@ namespace Mona {
 			Sphere,
 			PrimitiveCount
 		};
+		static constexpr uint32_t s_maxLODCount = 5;
 		~Mesh();
-		uint32_t GetVertexArrayID() const noexcept { return m_vertexArrayID; }
-		uint32_t GetIndexBufferCount() const noexcept { return m_indexBufferCount; }
+		/*
+		* Las mallas estaticas comparten sus buffers y VAO, la geometria de esta malla corresponde al rango retornado por
+		* GetGeometryRange. El rango puede cambiar si los buffers compartidos se compactan, por lo que no debe guardarse.
+		*/
+		uint32_t GetVertexArrayID() const noexcept { return m_geometryBuffer->GetVertexArrayID(); }
+		/*
+		* VAO que solo lee posiciones, para pases de solo profundidad.
+		*/
+		uint32_t GetPositionVertexArrayID() const noexcept { return m_geometryBuffer->GetPositionVertexArrayID(); }
+		uint32_t GetIndexType() const noexcept { return m_geometryBuffer->GetIndexType(); }
+		uint32_t GetIndexBufferCount() const noexcept { return m_lods[0].indexCount; }
+		const GeometryRange& GetGeometryRange() const noexcept { return m_geometryBuffer->GetRange(m_geometryHandle); }
+		/*
+		* Identificador unico entre las mallas vivas, usado para agrupar objetos que comparten malla.
+		*/
+		uint32_t GetMeshID() const noexcept { return m_geometryHandle * 2 + m_geometryBufferIndex; }
+		/*
+		* Volumenes envolventes de la malla en su espacio local, usados para descartar objetos fuera del campo de vision.
+		*/
+		const MeshBounds& GetBounds() const noexcept { return m_bounds; }
+		/*
+		* Niveles de detalle generados al cargar la malla, el nivel cero corresponde a la geometria original.
+		*/
+		uint32_t GetLODCount() const noexcept { return m_lodCount; }
+		const MeshLOD& GetLOD(uint32_t level) const noexcept { return m_lods[level]; }
+		/*
+		* Grupos de triangulos del nivel de detalle cero, vacio si la malla cabe en un unico grupo. Sus rangos de indices
+		* cubren en orden todo el nivel cero.
+		*/
+		const std::vector<MeshCluster>& GetClusters() const noexcept { return m_clusters; }
+		/*
+		* Geometria usada al marcar la malla como oclusor o al calcular un conjunto de objetos potencialmente visibles. Se
+		* copia al cargar la malla si MeshManager::KeepsOccluderGeometry, en caso contrario la primera llamada la lee desde los
+		* buffers compartidos en la GPU.
+		*/
+		const MeshOccluderGeometry& GetOccluderGeometry() noexcept;
 		static aiMesh* cubeMeshData();
 		static aiMesh* sphereMeshData();
 
 	private:
-		Mesh(const std::string& filePath, bool flipUVs = false);
-		Mesh(PrimitiveType type);
+		Mesh(StaticGeometryBuffers& geometryBuffers, const std::string& filePath, bool flipUVs = false);
+		Mesh(StaticGeometryBuffers& geometryBuffers, PrimitiveType type);
+		/*
+		* Une la geometria del nivel de detalle cero de las partes, transformada a espacio de mundo, en una nueva malla. La
+		* geometria de las partes se toma de sus copias en CPU (ver MeshManager::KeepsStaticBatchGeometry), solo las partes
+		* cargadas sin copia se leen desde los buffers compartidos en la GPU. La nueva malla no conserva copia en CPU.
+		*/
+		Mesh(StaticGeometryBuffers& geometryBuffers, const std::vector<StaticBatchPart>& parts);
+		static VertexFormat GetVertexFormat() noexcept;
+		//Error maximo de un nivel de detalle relativo al radio de la malla, los niveles que lo superarian no se generan.
+		static constexpr float s_maxLODError = 0.25f;
 
 		void ClearData() noexcept;
-		void CreateSphere() noexcept;
-		void CreateCube() noexcept;
-		void CreatePlane() noexcept;
+		/*
+		* Calcula los volumenes envolventes, genera los niveles de detalle, divide el nivel cero en grupos, comprime los
+		* vertices al formato de GetVertexFormat y los copia junto a los indices de todos los niveles al buffer compartido que
+		* corresponde segun su cantidad.
+		*/
+		void SetGeometry(StaticGeometryBuffers& geometryBuffers, const MeshVertex* vertices, uint32_t vertexCount,
+			const uint32_t* indices, uint32_t indexCount) noexcept;
+		void CreateSphere(StaticGeometryBuffers& geometryBuffers) noexcept;
+		void CreateCube(StaticGeometryBuffers& geometryBuffers) noexcept;
+		void CreatePlane(StaticGeometryBuffers& geometryBuffers) noexcept;
 
 
-		uint32_t m_vertexArrayID;
-		uint32_t m_vertexBufferID;
-		uint32_t m_indexBufferID;
-		uint32_t m_indexBufferCount;
+		GeometryBuffer* m_geometryBuffer;
+		GeometryBuffer::GeometryHandle m_geometryHandle;
+		uint32_t m_geometryBufferIndex;
+		MeshBounds m_bounds;
+		std::array<MeshLOD, s_maxLODCount> m_lods;
+		uint32_t m_lodCount;
+		std::vector<MeshCluster> m_clusters;
+		std::unique_ptr<MeshOccluderGeometry> m_occluderGeometry;
+		//Atributos comprimidos del nivel cero, junto a las posiciones e indices de m_occluderGeometry permiten unir la malla
+		//a un lote estatico sin leerla desde la GPU. Vacio si no se conservan.
+		std::vector<PackedMeshAttributes> m_batchAttributes;
 	};
 }
 #endif
\ No newline at end of file
@@ -0,0 +1,222 @@
+#include "MeshClusters.hpp"
+#include <algorithm>
+#include <cstring>
+#include <cmath>
+#include <limits>
+#include <unordered_map>
+namespace Mona {
+
+	namespace {
+		constexpr uint32_t s_invalidIndex = UINT32_MAX;
+
+		const glm::vec3& GetPosition(const uint8_t* vertices, uint32_t vertexSize, uint32_t positionOffset, uint32_t vertex) noexcept {
+			return *reinterpret_cast<const glm::vec3*>(vertices + static_cast<size_t>(vertex) * vertexSize + positionOffset);
+		}
+
+		/*
+		* Una malla es cerrada si al unir los vertices con la misma posicion cada arista pertenece exactamente a dos
+		* triangulos. Las costuras de atributos (misma posicion con distinta normal o coordenada de textura) no abren la malla.
+		*/
+		bool IsClosedMesh(const std::vector<uint32_t>& indices, const uint8_t* vertices, uint32_t vertexCount, uint32_t vertexSize,
+			uint32_t positionOffset) noexcept {
+			struct PositionHash {
+				size_t operator()(const glm::vec3& p) const noexcept {
+					uint32_t bits[3];
+					std::memcpy(bits, &p, sizeof(bits));
+					return (static_cast<size_t>(bits[0]) * 73856093u) ^ (static_cast<size_t>(bits[1]) * 19349663u) ^
+						(static_cast<size_t>(bits[2]) * 83492791u);
+				}
+			};
+			struct PositionEqual {
+				bool operator()(const glm::vec3& a, const glm::vec3& b) const noexcept { return std::memcmp(&a, &b, sizeof(glm::vec3)) == 0; }
+			};
+			std::unordered_map<glm::vec3, uint32_t, PositionHash, PositionEqual> positionIDs;
+			positionIDs.reserve(vertexCount);
+			std::vector<uint32_t> remap(vertexCount);
+			for (uint32_t v = 0; v < vertexCount; v++) {
+				//Sumar cero convierte -0 en 0, que tienen distintos bits pero corresponden a la misma posicion.
+				const glm::vec3 position = GetPosition(vertices, vertexSize, positionOffset, v) + glm::vec3(0.0f);
+				remap[v] = positionIDs.emplace(position, static_cast<uint32_t>(positionIDs.size())).first->second;
+			}
+			std::unordered_map<uint64_t, uint32_t> edgeCounts;
+			edgeCounts.reserve(indices.size());
+			for (size_t t = 0; t < indices.size(); t += 3) {
+				for (uint32_t e = 0; e < 3; e++) {
+					const uint32_t a = remap[indices[t + e]];
+					const uint32_t b = remap[indices[t + (e + 1) % 3]];
+					if (a == b)
+						continue;
+					edgeCounts[(static_cast<uint64_t>(std::min(a, b)) << 32) | std::max(a, b)]++;
+				}
+			}
+			for (const auto& edge : edgeCounts) {
+				if (edge.second != 2)
+					return false;
+			}
+			return true;
+		}
+	}
+
+	void BuildMeshClusters(std::vector<MeshCluster>& clusters, std::vector<uint32_t>& indices, const void* vertices,
+		uint32_t vertexCount, uint32_t vertexSize, uint32_t positionOffset) noexcept {
+		clusters.clear();
+		const uint8_t* data = static_cast<const uint8_t*>(vertices);
+		const uint32_t triangleCount = static_cast<uint32_t>(indices.size() / 3);
+		if (triangleCount == 0)
+			return;
+
+		//Normal unitaria de cada triangulo, nula para triangulos degenerados.
+		std::vector<glm::vec3> normals(triangleCount);
+		for (uint32_t t = 0; t < triangleCount; t++) {
+			const glm::vec3& a = GetPosition(data, vertexSize, positionOffset, indices[3 * t]);
+			const glm::vec3& b = GetPosition(data, vertexSize, positionOffset, indices[3 * t + 1]);
+			const glm::vec3& c = GetPosition(data, vertexSize, positionOffset, indices[3 * t + 2]);
+			const glm::vec3 normal = glm::cross(b - a, c - a);
+			const float length = glm::length(normal);
+			normals[t] = length > 0.0f ? normal / length : glm::vec3(0.0f);
+		}
+
+		//Triangulos que usan cada vertice, guardados de forma compacta: los de v son
+		//adjacency[adjacencyOffsets[v], adjacencyOffsets[v + 1]).
+		std::vector<uint32_t> adjacencyOffsets(vertexCount + 1, 0);
+		for (uint32_t index : indices)
+			adjacencyOffsets[index + 1]++;
+		for (uint32_t v = 0; v < vertexCount; v++)
+			adjacencyOffsets[v + 1] += adjacencyOffsets[v];
+		std::vector<uint32_t> adjacency(indices.size());
+		std::vector<uint32_t> adjacencyFill(adjacencyOffsets.begin(), adjacencyOffsets.end() - 1);
+		for (uint32_t i = 0; i < static_cast<uint32_t>(indices.size()); i++)
+			adjacency[adjacencyFill[indices[i]]++] = i / 3;
+
+		//Cada grupo crece desde un triangulo semilla. Los candidatos son los triangulos sin asignar que comparten algun
+		//vertice con el grupo, las marcas por vertice y por triangulo evitan limpiar arreglos al comenzar cada grupo.
+		std::vector<uint32_t> triangleCluster(triangleCount, s_invalidIndex);
+		std::vector<uint32_t> vertexStamp(vertexCount, s_invalidIndex);
+		std::vector<uint32_t> candidateStamp(triangleCount, s_invalidIndex);
+		std::vector<uint32_t> candidates;
+		std::vector<uint32_t> clusterTriangleCounts;
+		uint32_t assignedCount = 0;
+		uint32_t seedCursor = 0;
+		while (assignedCount < triangleCount) {
+			const uint32_t clusterIndex = static_cast<uint32_t>(clusterTriangleCounts.size());
+			//La semilla se toma de la frontera del grupo anterior para que grupos consecutivos sean vecinos.
+			uint32_t seed = s_invalidIndex;
+			for (uint32_t candidate : candidates) {
+				if (triangleCluster[candidate] == s_invalidIndex) {
+					seed = candidate;
+					break;
+				}
+			}
+			if (seed == s_invalidIndex) {
+				while (triangleCluster[seedCursor] != s_invalidIndex)
+					seedCursor++;
+				seed = seedCursor;
+			}
+			candidates.clear();
+			uint32_t clusterTriangleCount = 0;
+			uint32_t clusterVertexCount = 0;
+			glm::vec3 normalSum(0.0f);
+			uint32_t next = seed;
+			while (next != s_invalidIndex) {
+				triangleCluster[next] = clusterIndex;
+				clusterTriangleCount++;
+				assignedCount++;
+				normalSum += normals[next];
+				for (uint32_t k = 0; k < 3; k++) {
+					const uint32_t vertex = indices[3 * next + k];
+					if (vertexStamp[vertex] == clusterIndex)
+						continue;
+					vertexStamp[vertex] = clusterIndex;
+					clusterVertexCount++;
+					for (uint32_t a = adjacencyOffsets[vertex]; a < adjacencyOffsets[vertex + 1]; a++) {
+						const uint32_t triangle = adjacency[a];
+						if (triangleCluster[triangle] == s_invalidIndex && candidateStamp[triangle] != clusterIndex) {
+							candidateStamp[triangle] = clusterIndex;
+							candidates.push_back(triangle);
+						}
+					}
+				}
+				if (clusterTriangleCount == MAX_CLUSTER_TRIANGLES)
+					break;
+				//Se elige el candidato que agrega menos vertices nuevos y cuya normal se aleja menos de la normal media del
+				//grupo, descartando de la lista los candidatos ya asignados.
+				const float normalLength = glm::length(normalSum);
+				const glm::vec3 averageNormal = normalLength > 0.0f ? normalSum / normalLength : glm::vec3(0.0f);
+				next = s_invalidIndex;
+				float bestScore = std::numeric_limits<float>::max();
+				size_t liveCount = 0;
+				for (size_t c = 0; c < candidates.size(); c++) {
+					const uint32_t triangle = candidates[c];
+					if (triangleCluster[triangle] != s_invalidIndex)
+						continue;
+					candidates[liveCount++] = triangle;
+					uint32_t newVertexCount = 0;
+					for (uint32_t k = 0; k < 3; k++)
+						newVertexCount += vertexStamp[indices[3 * triangle + k]] != clusterIndex ? 1 : 0;
+					if (clusterVertexCount + newVertexCount > MAX_CLUSTER_VERTICES)
+						continue;
+					const float score = static_cast<float>(newVertexCount) + 2.0f * (1.0f - glm::dot(averageNormal, normals[triangle]));
+					if (score < bestScore) {
+						bestScore = score;
+						next = triangle;
+					}
+				}
+				candidates.resize(liveCount);
+			}
+			clusterTriangleCounts.push_back(clusterTriangleCount);
+		}
+
+		//Los triangulos se ordenan por grupo conservando su orden original dentro de cada grupo.
+		const uint32_t clusterCount = static_cast<uint32_t>(clusterTriangleCounts.size());
+		std::vector<uint32_t> clusterOffsets(clusterCount + 1, 0);
+		for (uint32_t i = 0; i < clusterCount; i++)
+			clusterOffsets[i + 1] = clusterOffsets[i] + clusterTriangleCounts[i];
+		std::vector<uint32_t> sortedTriangles(triangleCount);
+		std::vector<uint32_t> clusterFill(clusterOffsets.begin(), clusterOffsets.end() - 1);
+		for (uint32_t t = 0; t < triangleCount; t++)
+			sortedTriangles[clusterFill[triangleCluster[t]]++] = t;
+
+		const bool closed = IsClosedMesh(indices, data, vertexCount, vertexSize, positionOffset);
+		std::vector<uint32_t> sortedIndices(indices.size());
+		clusters.resize(clusterCount);
+		for (uint32_t i = 0; i < clusterCount; i++) {
+			MeshCluster& cluster = clusters[i];
+			glm::vec3 minPoint(std::numeric_limits<float>::max());
+			glm::vec3 maxPoint(std::numeric_limits<float>::lowest());
+			glm::vec3 normalSum(0.0f);
+			for (uint32_t s = clusterOffsets[i]; s < clusterOffsets[i + 1]; s++) {
+				const uint32_t triangle = sortedTriangles[s];
+				for (uint32_t k = 0; k < 3; k++) {
+					const uint32_t vertex = indices[3 * triangle + k];
+					sortedIndices[3 * s + k] = vertex;
+					const glm::vec3& position = GetPosition(data, vertexSize, positionOffset, vertex);
+					minPoint = glm::min(minPoint, position);
+					maxPoint = glm::max(maxPoint, position);
+				}
+				normalSum += normals[triangle];
+			}
+			cluster.center = 0.5f * (minPoint + maxPoint);
+			cluster.radius = 0.0f;
+			for (uint32_t s = 3 * clusterOffsets[i]; s < 3 * clusterOffsets[i + 1]; s++) {
+				const glm::vec3& position = GetPosition(data, vertexSize, positionOffset, sortedIndices[s]);
+				cluster.radius = std::max(cluster.radius, glm::length(position - cluster.center));
+			}
+			cluster.indexOffset = 3 * clusterOffsets[i];
+			cluster.indexCount = 3 * clusterTriangleCounts[i];
+			//Todas las normales quedan dentro de un cono de angulo alpha alrededor de la normal media, con cos(alpha) igual
+			//al menor producto punto. Un grupo mira completamente hacia atras cuando la direccion hacia la camara forma mas
+			//de 90 + alpha grados con el eje, lo que se expresa con sin(alpha) (ver IsMeshClusterVisible). Los triangulos
+			//degenerados no se dibujan y no restringen el cono.
+			const float normalLength = glm::length(normalSum);
+			cluster.coneAxis = normalLength > 0.0f ? normalSum / normalLength : glm::vec3(0.0f, 0.0f, 1.0f);
+			float minimumDot = normalLength > 0.0f ? 1.0f : -1.0f;
+			for (uint32_t s = clusterOffsets[i]; s < clusterOffsets[i + 1]; s++) {
+				const glm::vec3& normal = normals[sortedTriangles[s]];
+				if (normal != glm::vec3(0.0f))
+					minimumDot = std::min(minimumDot, glm::dot(cluster.coneAxis, normal));
+			}
+			cluster.coneCutoff = closed && minimumDot > 0.0f ? std::sqrt(1.0f - minimumDot * minimumDot) : 1.0f;
+		}
+		indices.swap(sortedIndices);
+	}
+}
@@ -0,0 +1,56 @@
+#pragma once
+#ifndef MESHCLUSTERS_HPP
+#define MESHCLUSTERS_HPP
+#include <vector>
+#include <cstdint>
+#include <glm/glm.hpp>
+#include "FrustumCuller.hpp"
+namespace Mona {
+	/*
+	* Grupo de triangulos contiguos de una malla (meshlet) con sus volumenes en el espacio local de la malla. Los indices
+	* del grupo son [indexOffset, indexOffset + indexCount) dentro de los indices de la malla. Todas las normales de sus
+	* triangulos forman a lo mas un angulo alpha con coneAxis y coneCutoff es sin(alpha), o uno si el cono no permite
+	* descartar el grupo por mirar hacia atras.
+	*/
+	struct MeshCluster {
+		glm::vec3 center;
+		float radius;
+		glm::vec3 coneAxis;
+		float coneCutoff;
+		uint32_t indexOffset;
+		uint32_t indexCount;
+	};
+
+	//Limites de los grupos generados por BuildMeshClusters.
+	constexpr uint32_t MAX_CLUSTER_TRIANGLES = 128;
+	constexpr uint32_t MAX_CLUSTER_VERTICES = 128;
+
+	/*
+	* Reparte los triangulos en grupos de a lo mas MAX_CLUSTER_TRIANGLES triangulos y MAX_CLUSTER_VERTICES vertices. Cada
+	* grupo crece desde un triangulo agregando el triangulo vecino que agrega menos vertices nuevos y cuya normal se aleja
+	* menos de la del grupo. Los indices se reordenan para que cada grupo quede contiguo, conservando dentro de cada grupo
+	* el orden original de sus triangulos (y con ello la optimizacion para el cache de vertices). Si la malla no es cerrada
+	* (alguna arista entre posiciones no es compartida por exactamente dos triangulos) sus caras traseras pueden verse, por
+	* lo que los conos de todos los grupos se desactivan.
+	*/
+	void BuildMeshClusters(std::vector<MeshCluster>& clusters, std::vector<uint32_t>& indices, const void* vertices,
+		uint32_t vertexCount, uint32_t vertexSize, uint32_t positionOffset) noexcept;
+
+	/*
+	* Prueba un grupo contra un frustum y una posicion de camara expresados en el espacio local de su malla (por ejemplo
+	* con Frustum::FromViewProjection(viewProjectionMatrix * modelMatrix)). Un grupo es invisible si su esfera queda fuera
+	* de algun plano o si, con coneCulling, todos sus triangulos miran en sentido contrario a la camara.
+	*/
+	inline bool IsMeshClusterVisible(const MeshCluster& cluster, const Frustum& localFrustum, const glm::vec3& localCameraPosition,
+		bool coneCulling) noexcept {
+		for (const glm::vec4& plane : localFrustum.planes) {
+			if (glm::dot(glm::vec3(plane), cluster.center) + plane.w < -cluster.radius)
+				return false;
+		}
+		if (!coneCulling)
+			return true;
+		const glm::vec3 toCenter = cluster.center - localCameraPosition;
+		return glm::dot(toCenter, cluster.coneAxis) < cluster.coneCutoff * glm::length(toCenter) + cluster.radius;
+	}
+}
+#endif
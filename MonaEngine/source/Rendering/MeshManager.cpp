@@ -1,5 +1,7 @@
 #include "MeshManager.hpp"
 #include "../Animation/SkinnedMesh.hpp"
+#include "../Core/Config.hpp"
+#include <algorithm>
 namespace Mona {
 	
 	std::string PrimitiveEnumToString(Mesh::PrimitiveType type) {
@@ -28,7 +30,7 @@ namespace Mona {
 		{
 			return it->second;
 		}
-		Mesh* meshPtr = new Mesh(type);
+		Mesh* meshPtr = new Mesh(m_staticGeometryBuffers, type);
 		std::shared_ptr<Mesh> sharedPtr = std::shared_ptr<Mesh>(meshPtr);
 		//Antes de retornar la malla recien cargada, insertamos esta al mapa para que cargas futuras sean mucho mas rapidas.
 		m_meshMap.insert({ primName, sharedPtr });
@@ -43,7 +45,7 @@ namespace Mona {
 		if (it != m_meshMap.end()) {
 			return it->second;
 		}
-		Mesh* meshPtr = new Mesh(stringPath, flipUVs);
+		Mesh* meshPtr = new Mesh(m_staticGeometryBuffers, stringPath, flipUVs);
 		std::shared_ptr<Mesh> sharedPtr = std::shared_ptr<Mesh>(meshPtr);
 		//Antes de retornar la malla recien cargada, insertamos esta al mapa para que cargas futuras sean mucho mas rapidas.
 		m_meshMap.insert({ stringPath, sharedPtr });
@@ -51,6 +53,23 @@ namespace Mona {
 
 	}
 
+	std::shared_ptr<Mesh> MeshManager::CreateStaticBatchMesh(const std::vector<StaticBatchPart>& parts) noexcept {
+		return std::shared_ptr<Mesh>(new Mesh(m_staticGeometryBuffers, parts));
+	}
+
+	void MeshManager::StartUp() noexcept {
+		Config& config = Config::GetInstance();
+		const int vertexCapacity = config.getValueOrDefault<int>("expected_number_of_static_vertices", 1 << 18);
+		const int indexCapacity = config.getValueOrDefault<int>("expected_number_of_static_indices", 1 << 20);
+		m_keepOccluderGeometry = config.getValueOrDefault<int>("occlusion_culling", 1) != 0;
+		m_keepStaticBatchGeometry = config.getValueOrDefault<int>("static_batching", 1) != 0;
+		//Casi todas las mallas caben en el buffer con indices de 16 bits, el de 32 bits parte vacio y crece si es necesario.
+		const VertexFormat format = Mesh::GetVertexFormat();
+		m_staticGeometryBuffers[0].StartUp(format, static_cast<uint32_t>(std::max(1, vertexCapacity)),
+			static_cast<uint32_t>(std::max(1, indexCapacity)), GL_UNSIGNED_SHORT);
+		m_staticGeometryBuffers[1].StartUp(format, 1, 1, GL_UNSIGNED_INT);
+	}
+
 	void MeshManager::CleanUnusedMeshes() noexcept {
 		/*
 		* Elimina todos los punteros del mapa de mallas cuyo conteo de referencias es igual a uno,
@@ -65,6 +84,10 @@ namespace Mona {
 			}
 
 		}
+		//Las mallas eliminadas dejan espacios libres en los buffers compartidos, se compactan para que las cargas futuras
+		//no obliguen a crecer los buffers.
+		for (GeometryBuffer& geometryBuffer : m_staticGeometryBuffers)
+			geometryBuffer.Compact();
 
 
 		/*
@@ -91,6 +114,8 @@ namespace Mona {
 		}
 
 		m_meshMap.clear();
+		for (GeometryBuffer& geometryBuffer : m_staticGeometryBuffers)
+			geometryBuffer.ShutDown();
 	}
 
 	std::shared_ptr<SkinnedMesh> MeshManager::LoadSkinnedMesh(std::shared_ptr<Skeleton> skeleton,
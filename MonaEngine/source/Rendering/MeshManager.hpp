@@ -24,16 +24,51 @@ namespace Mona {
 		std::shared_ptr<SkinnedMesh> LoadSkinnedMesh(std::shared_ptr<Skeleton> skeleton, aiScene* scene,
 			const std::string& name,
 			bool flipUVs = false) noexcept;
+		/*
+		* Crea una malla con la geometria de todas las partes en espacio de mundo. La malla no se guarda en el mapa de mallas
+		* cargadas, por lo que se libera junto al ultimo puntero que la usa.
+		*/
+		std::shared_ptr<Mesh> CreateStaticBatchMesh(const std::vector<StaticBatchPart>& parts) noexcept;
 		void CleanUnusedMeshes() noexcept;
+		/*
+		* Buffers de vertices e indices compartidos por todas las mallas estaticas (ver StaticGeometryBuffers).
+		*/
+		const StaticGeometryBuffers& GetStaticGeometryBuffers() const noexcept { return m_staticGeometryBuffers; }
+		StaticGeometryBuffers& GetStaticGeometryBuffers() noexcept { return m_staticGeometryBuffers; }
+		/*
+		* Aumenta cada vez que alguno de los buffers estaticos mueve la geometria de sus mallas (ver GeometryBuffer::GetVersion).
+		*/
+		uint32_t GetStaticGeometryVersion() const noexcept {
+			uint32_t version = 0;
+			for (const GeometryBuffer& geometryBuffer : m_staticGeometryBuffers)
+				version += geometryBuffer.GetVersion();
+			return version;
+		}
+		/*
+		* Indica si las mallas estaticas conservan en CPU la geometria que usan como oclusores (ver Mesh::GetOccluderGeometry).
+		* Se activa junto a occlusion_culling en config.cfg y solo afecta a las mallas cargadas despues de cambiarlo.
+		*/
+		bool KeepsOccluderGeometry() const noexcept { return m_keepOccluderGeometry; }
+		void SetKeepOccluderGeometry(bool keep) noexcept { m_keepOccluderGeometry = keep; }
+		/*
+		* Indica si las mallas estaticas conservan en CPU su geometria para unirlas en lotes (ver CreateStaticBatchMesh) sin
+		* leerla desde la GPU. Se lee desde static_batching en config.cfg y solo afecta a las mallas cargadas despues de cambiarlo.
+		*/
+		bool KeepsStaticBatchGeometry() const noexcept { return m_keepStaticBatchGeometry; }
+		void SetKeepStaticBatchGeometry(bool keep) noexcept { m_keepStaticBatchGeometry = keep; }
 		static MeshManager& GetInstance() noexcept{
 			static MeshManager instance;
 			return instance;
 		}
 	private:
 		MeshManager() = default;
+		void StartUp() noexcept;
 		void ShutDown() noexcept;
 		MeshMap m_meshMap;
+		StaticGeometryBuffers m_staticGeometryBuffers;
 		SkinnedMeshMap m_skinnedMeshMap;
+		bool m_keepOccluderGeometry = true;
+		bool m_keepStaticBatchGeometry = true;
 
 	};
 }
@@ -0,0 +1,301 @@
+#include "MeshOptimizer.hpp"
+#include "../Core/Log.hpp"
+#include <glm/glm.hpp>
+#include <algorithm>
+#include <cstring>
+namespace Mona {
+
+	namespace {
+		constexpr uint32_t s_invalidIndex = UINT32_MAX;
+
+		//FNV-1a sobre los bytes del vertice.
+		uint32_t HashVertex(const uint8_t* vertex, uint32_t vertexSize) noexcept {
+			uint32_t hash = 2166136261u;
+			for (uint32_t i = 0; i < vertexSize; i++) {
+				hash ^= vertex[i];
+				hash *= 16777619u;
+			}
+			return hash;
+		}
+
+		/*
+		* Cache FIFO simulado con marcas de tiempo: un vertice esta en el cache si entro hace a lo mas VERTEX_CACHE_SIZE
+		* fallos. Reset invalida todo el contenido sin recorrer los vertices.
+		*/
+		class VertexCacheSimulator {
+		public:
+			VertexCacheSimulator(uint32_t vertexCount) : m_timestamps(vertexCount, 0), m_time(VERTEX_CACHE_SIZE + 1) {}
+			bool Access(uint32_t vertex) noexcept {
+				if (m_time - m_timestamps[vertex] <= VERTEX_CACHE_SIZE)
+					return false;
+				m_timestamps[vertex] = m_time++;
+				return true;
+			}
+			void Reset() noexcept { m_time += VERTEX_CACHE_SIZE + 1; }
+		private:
+			std::vector<uint32_t> m_timestamps;
+			uint32_t m_time;
+		};
+
+		const glm::vec3& GetPosition(const uint8_t* vertices, uint32_t vertexSize, uint32_t positionOffset, uint32_t vertex) noexcept {
+			return *reinterpret_cast<const glm::vec3*>(vertices + static_cast<size_t>(vertex) * vertexSize + positionOffset);
+		}
+	}
+
+	uint32_t WeldVertices(void* vertices, uint32_t vertexCount, uint32_t vertexSize, std::vector<uint32_t>& indices) noexcept {
+		uint8_t* data = static_cast<uint8_t*>(vertices);
+		//Tabla hash con direccionamiento abierto que guarda la posicion compactada de cada vertice unico. Como la
+		//posicion compactada nunca supera a la original, los vertices pueden moverse en el mismo arreglo.
+		uint32_t tableSize = 1;
+		while (tableSize < 2 * vertexCount)
+			tableSize *= 2;
+		std::vector<uint32_t> table(tableSize, s_invalidIndex);
+		std::vector<uint32_t> remap(vertexCount);
+		uint32_t uniqueCount = 0;
+		for (uint32_t v = 0; v < vertexCount; v++) {
+			const uint8_t* vertex = data + static_cast<size_t>(v) * vertexSize;
+			uint32_t slot = HashVertex(vertex, vertexSize) & (tableSize - 1);
+			while (table[slot] != s_invalidIndex &&
+				std::memcmp(data + static_cast<size_t>(table[slot]) * vertexSize, vertex, vertexSize) != 0)
+				slot = (slot + 1) & (tableSize - 1);
+			if (table[slot] == s_invalidIndex) {
+				if (uniqueCount != v)
+					std::memcpy(data + static_cast<size_t>(uniqueCount) * vertexSize, vertex, vertexSize);
+				table[slot] = uniqueCount++;
+			}
+			remap[v] = table[slot];
+		}
+		for (uint32_t& index : indices)
+			index = remap[index];
+		return uniqueCount;
+	}
+
+	void OptimizeVertexCache(std::vector<uint32_t>& indices, uint32_t vertexCount, std::vector<uint32_t>* clusters) noexcept {
+		const uint32_t triangleCount = static_cast<uint32_t>(indices.size() / 3);
+		if (clusters != nullptr)
+			clusters->clear();
+		if (triangleCount == 0)
+			return;
+		//Adyacencia vertice-triangulo en formato compacto: los triangulos del vertice v son
+		//adjacency[offsets[v]...offsets[v + 1]).
+		std::vector<uint32_t> liveTriangles(vertexCount, 0);
+		for (uint32_t index : indices)
+			liveTriangles[index]++;
+		std::vector<uint32_t> offsets(vertexCount + 1, 0);
+		for (uint32_t v = 0; v < vertexCount; v++)
+			offsets[v + 1] = offsets[v] + liveTriangles[v];
+		std::vector<uint32_t> adjacency(indices.size());
+		std::vector<uint32_t> fill(offsets.begin(), offsets.end() - 1);
+		for (uint32_t t = 0; t < triangleCount; t++) {
+			for (uint32_t k = 0; k < 3; k++)
+				adjacency[fill[indices[3 * t + k]]++] = t;
+		}
+
+		std::vector<uint32_t> output;
+		output.reserve(indices.size());
+		std::vector<bool> emitted(triangleCount, false);
+		std::vector<uint32_t> timestamps(vertexCount, 0);
+		std::vector<uint32_t> deadEnd;
+		std::vector<uint32_t> candidates;
+		uint32_t time = VERTEX_CACHE_SIZE + 1;
+		uint32_t cursor = 0;
+		uint32_t current = 0;
+		while (liveTriangles[current] == 0 && current + 1 < vertexCount)
+			current++;
+		bool startsCluster = true;
+		while (current != s_invalidIndex) {
+			if (startsCluster && clusters != nullptr)
+				clusters->push_back(static_cast<uint32_t>(output.size() / 3));
+			//Se emiten todos los triangulos pendientes del vertice actual.
+			candidates.clear();
+			for (uint32_t a = offsets[current]; a < offsets[current + 1]; a++) {
+				const uint32_t t = adjacency[a];
+				if (emitted[t])
+					continue;
+				emitted[t] = true;
+				for (uint32_t k = 0; k < 3; k++) {
+					const uint32_t v = indices[3 * t + k];
+					output.push_back(v);
+					deadEnd.push_back(v);
+					candidates.push_back(v);
+					liveTriangles[v]--;
+					if (time - timestamps[v] > VERTEX_CACHE_SIZE)
+						timestamps[v] = time++;
+				}
+			}
+			//El siguiente vertice es el vecino con triangulos pendientes que mas tiempo lleva en el cache, siempre que
+			//siga en el despues de emitir sus triangulos.
+			uint32_t best = s_invalidIndex;
+			int64_t bestPriority = -1;
+			for (uint32_t v : candidates) {
+				if (liveTriangles[v] == 0)
+					continue;
+				int64_t priority = 0;
+				if (time - timestamps[v] + 2 * liveTriangles[v] <= VERTEX_CACHE_SIZE)
+					priority = time - timestamps[v];
+				if (priority > bestPriority) {
+					bestPriority = priority;
+					best = v;
+				}
+			}
+			startsCluster = best == s_invalidIndex;
+			if (best == s_invalidIndex) {
+				//Callejon sin salida: se retoma desde los vertices emitidos recientemente y, si ninguno tiene triangulos
+				//pendientes, desde el siguiente vertice en orden.
+				while (!deadEnd.empty() && best == s_invalidIndex) {
+					const uint32_t v = deadEnd.back();
+					deadEnd.pop_back();
+					if (liveTriangles[v] > 0)
+						best = v;
+				}
+				while (best == s_invalidIndex && cursor < vertexCount) {
+					if (liveTriangles[cursor] > 0)
+						best = cursor;
+					cursor++;
+				}
+			}
+			current = best;
+		}
+		MONA_ASSERT(output.size() == indices.size(), "MeshOptimizer Error: Vertex cache optimization lost triangles.");
+		indices.swap(output);
+	}
+
+	void OptimizeOverdraw(std::vector<uint32_t>& indices, const std::vector<uint32_t>& clusters, const void* vertices,
+		uint32_t vertexCount, uint32_t vertexSize, uint32_t positionOffset, float threshold) noexcept {
+		const uint32_t triangleCount = static_cast<uint32_t>(indices.size() / 3);
+		if (triangleCount == 0 || clusters.empty())
+			return;
+		const uint8_t* data = static_cast<const uint8_t*>(vertices);
+		//Cada grupo se divide donde el ACMR acumulado de la parte actual no supera threshold veces el del grupo completo,
+		//de manera que reordenar las partes casi no afecta la eficiencia del cache.
+		std::vector<uint32_t> boundaries;
+		VertexCacheSimulator cache(vertexCount);
+		for (size_t c = 0; c < clusters.size(); c++) {
+			const uint32_t begin = clusters[c];
+			const uint32_t end = c + 1 < clusters.size() ? clusters[c + 1] : triangleCount;
+			cache.Reset();
+			uint32_t clusterMisses = 0;
+			for (uint32_t t = begin; t < end; t++) {
+				for (uint32_t k = 0; k < 3; k++)
+					clusterMisses += cache.Access(indices[3 * t + k]) ? 1 : 0;
+			}
+			const float clusterACMR = static_cast<float>(clusterMisses) / static_cast<float>(end - begin);
+			cache.Reset();
+			boundaries.push_back(begin);
+			uint32_t partStart = begin;
+			uint32_t partMisses = 0;
+			for (uint32_t t = begin; t < end; t++) {
+				for (uint32_t k = 0; k < 3; k++)
+					partMisses += cache.Access(indices[3 * t + k]) ? 1 : 0;
+				const float partACMR = static_cast<float>(partMisses) / static_cast<float>(t + 1 - partStart);
+				if (t + 1 < end && partACMR <= threshold * clusterACMR) {
+					boundaries.push_back(t + 1);
+					partStart = t + 1;
+					partMisses = 0;
+					cache.Reset();
+				}
+			}
+		}
+
+		//Centroide de la malla y, para cada parte, centroide y normal promedio ponderados por area.
+		glm::vec3 meshCentroid(0.0f);
+		float meshArea = 0.0f;
+		const uint32_t partCount = static_cast<uint32_t>(boundaries.size());
+		std::vector<float> sortKeys(partCount);
+		std::vector<glm::vec3> partCentroids(partCount, glm::vec3(0.0f));
+		std::vector<glm::vec3> partNormals(partCount, glm::vec3(0.0f));
+		for (uint32_t p = 0; p < partCount; p++) {
+			const uint32_t end = p + 1 < partCount ? boundaries[p + 1] : triangleCount;
+			float partArea = 0.0f;
+			for (uint32_t t = boundaries[p]; t < end; t++) {
+				const glm::vec3& a = GetPosition(data, vertexSize, positionOffset, indices[3 * t]);
+				const glm::vec3& b = GetPosition(data, vertexSize, positionOffset, indices[3 * t + 1]);
+				const glm::vec3& c = GetPosition(data, vertexSize, positionOffset, indices[3 * t + 2]);
+				const glm::vec3 areaNormal = glm::cross(b - a, c - a);
+				const float area = glm::length(areaNormal);
+				partCentroids[p] += (a + b + c) * (area / 3.0f);
+				partNormals[p] += areaNormal;
+				partArea += area;
+			}
+			meshCentroid += partCentroids[p];
+			meshArea += partArea;
+			if (partArea > 0.0f)
+				partCentroids[p] /= partArea;
+		}
+		if (meshArea > 0.0f)
+			meshCentroid /= meshArea;
+		for (uint32_t p = 0; p < partCount; p++) {
+			const float normalLength = glm::length(partNormals[p]);
+			sortKeys[p] = normalLength > 0.0f ? glm::dot(partCentroids[p] - meshCentroid, partNormals[p] / normalLength) : 0.0f;
+		}
+
+		std::vector<uint32_t> order(partCount);
+		for (uint32_t p = 0; p < partCount; p++)
+			order[p] = p;
+		std::stable_sort(order.begin(), order.end(), [&sortKeys](uint32_t a, uint32_t b) { return sortKeys[a] > sortKeys[b]; });
+		std::vector<uint32_t> output;
+		output.reserve(indices.size());
+		for (uint32_t p : order) {
+			const uint32_t end = p + 1 < partCount ? boundaries[p + 1] : triangleCount;
+			output.insert(output.end(), indices.begin() + 3 * static_cast<size_t>(boundaries[p]), indices.begin() + 3 * static_cast<size_t>(end));
+		}
+		indices.swap(output);
+	}
+
+	uint32_t OptimizeVertexFetch(void* vertices, uint32_t vertexCount, uint32_t vertexSize, std::vector<uint32_t>& indices) noexcept {
+		uint8_t* data = static_cast<uint8_t*>(vertices);
+		std::vector<uint32_t> remap(vertexCount, s_invalidIndex);
+		std::vector<uint8_t> reordered;
+		reordered.reserve(static_cast<size_t>(vertexCount) * vertexSize);
+		uint32_t nextVertex = 0;
+		for (uint32_t& index : indices) {
+			if (remap[index] == s_invalidIndex) {
+				remap[index] = nextVertex++;
+				const uint8_t* vertex = data + static_cast<size_t>(index) * vertexSize;
+				reordered.insert(reordered.end(), vertex, vertex + vertexSize);
+			}
+			index = remap[index];
+		}
+		if (!reordered.empty())
+			std::memcpy(data, reordered.data(), reordered.size());
+		return nextVertex;
+	}
+
+	uint32_t CountVertexCacheMisses(const std::vector<uint32_t>& indices, uint32_t vertexCount) noexcept {
+		VertexCacheSimulator cache(vertexCount);
+		uint32_t misses = 0;
+		for (uint32_t index : indices)
+			misses += cache.Access(index) ? 1 : 0;
+		return misses;
+	}
+
+	MeshOptimizationStatistics OptimizeMesh(void* vertices, uint32_t& vertexCount, uint32_t vertexSize, uint32_t positionOffset,
+		std::vector<uint32_t>& indices) noexcept {
+		MeshOptimizationStatistics statistics;
+		statistics.triangleCount = static_cast<uint32_t>(indices.size() / 3);
+		statistics.inputVertexCount = vertexCount;
+		if (statistics.triangleCount == 0 || vertexCount == 0)
+			return statistics;
+		const float inputMisses = static_cast<float>(CountVertexCacheMisses(indices, vertexCount));
+		statistics.inputACMR = inputMisses / statistics.triangleCount;
+		statistics.inputATVR = inputMisses / vertexCount;
+
+		vertexCount = WeldVertices(vertices, vertexCount, vertexSize, indices);
+		std::vector<uint32_t> clusters;
+		OptimizeVertexCache(indices, vertexCount, &clusters);
+		OptimizeOverdraw(indices, clusters, vertices, vertexCount, vertexSize, positionOffset, 1.05f);
+		vertexCount = OptimizeVertexFetch(vertices, vertexCount, vertexSize, indices);
+
+		const float misses = static_cast<float>(CountVertexCacheMisses(indices, vertexCount));
+		statistics.vertexCount = vertexCount;
+		statistics.ACMR = misses / statistics.triangleCount;
+		statistics.ATVR = vertexCount > 0 ? misses / vertexCount : 0.0f;
+		return statistics;
+	}
+
+	void LogMeshOptimizationStatistics(const std::string& name, const MeshOptimizationStatistics& statistics) noexcept {
+		MONA_LOG_INFO("MeshOptimizer Info: {0}: {1} triangles, vertices {2} -> {3}, ACMR {4:.3f} -> {5:.3f}, ATVR {6:.3f} -> {7:.3f}",
+			name, statistics.triangleCount, statistics.inputVertexCount, statistics.vertexCount,
+			statistics.inputACMR, statistics.ACMR, statistics.inputATVR, statistics.ATVR);
+	}
+}
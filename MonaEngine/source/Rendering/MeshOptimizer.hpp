@@ -0,0 +1,69 @@
+#pragma once
+#ifndef MESHOPTIMIZER_HPP
+#define MESHOPTIMIZER_HPP
+#include <vector>
+#include <string>
+#include <cstdint>
+namespace Mona {
+	/*
+	* Resultado de OptimizeMesh. ACMR (average cache miss ratio) es la cantidad de fallos de un cache FIFO de
+	* VERTEX_CACHE_SIZE vertices por triangulo y ATVR (average transformed vertex ratio) la cantidad de fallos por vertice.
+	* El ATVR optimo es uno, cada vertice se transforma una sola vez.
+	*/
+	struct MeshOptimizationStatistics {
+		uint32_t triangleCount = 0;
+		uint32_t inputVertexCount = 0;
+		uint32_t vertexCount = 0;
+		float inputACMR = 0.0f;
+		float inputATVR = 0.0f;
+		float ACMR = 0.0f;
+		float ATVR = 0.0f;
+	};
+
+	//Tamano del cache de vertices post transformacion supuesto por las optimizaciones y estadisticas.
+	constexpr uint32_t VERTEX_CACHE_SIZE = 16;
+
+	/*
+	* Une los vertices identicos byte a byte y compacta vertices en el lugar. Retorna la nueva cantidad de vertices.
+	*/
+	uint32_t WeldVertices(void* vertices, uint32_t vertexCount, uint32_t vertexSize, std::vector<uint32_t>& indices) noexcept;
+
+	/*
+	* Reordena los triangulos para aprovechar el cache de vertices usando Tipsify (Sander, Nehab y Barczak, "Fast Triangle
+	* Reordering for Vertex Locality and Reduced Overdraw"). Si clusters no es nulo recibe el primer triangulo de cada
+	* grupo, un grupo comienza cada vez que el algoritmo salta a un vertice que no esta en el cache.
+	*/
+	void OptimizeVertexCache(std::vector<uint32_t>& indices, uint32_t vertexCount, std::vector<uint32_t>* clusters) noexcept;
+
+	/*
+	* Reordena los grupos de triangulos generados por OptimizeVertexCache para reducir el overdraw, dibujando primero los
+	* grupos mas alejados del centro de la malla que miran hacia afuera. Los grupos se subdividen mientras el ACMR de cada
+	* parte no supere threshold veces el del grupo original. position es la posicion en bytes del vec3 de posicion.
+	*/
+	void OptimizeOverdraw(std::vector<uint32_t>& indices, const std::vector<uint32_t>& clusters, const void* vertices,
+		uint32_t vertexCount, uint32_t vertexSize, uint32_t positionOffset, float threshold) noexcept;
+
+	/*
+	* Reordena los vertices segun su primer uso en indices para que se lean de forma secuencial, descartando los vertices
+	* no referenciados. Retorna la nueva cantidad de vertices.
+	*/
+	uint32_t OptimizeVertexFetch(void* vertices, uint32_t vertexCount, uint32_t vertexSize, std::vector<uint32_t>& indices) noexcept;
+
+	/*
+	* Cantidad de fallos de un cache FIFO de VERTEX_CACHE_SIZE vertices al dibujar indices.
+	*/
+	uint32_t CountVertexCacheMisses(const std::vector<uint32_t>& indices, uint32_t vertexCount) noexcept;
+
+	/*
+	* Aplica todas las optimizaciones anteriores en orden: union de vertices, orden para el cache, orden contra overdraw y
+	* orden para la lectura de vertices. vertexCount se actualiza con la cantidad final de vertices.
+	*/
+	MeshOptimizationStatistics OptimizeMesh(void* vertices, uint32_t& vertexCount, uint32_t vertexSize, uint32_t positionOffset,
+		std::vector<uint32_t>& indices) noexcept;
+
+	/*
+	* Reporta en el log las estadisticas de la optimizacion de la malla name.
+	*/
+	void LogMeshOptimizationStatistics(const std::string& name, const MeshOptimizationStatistics& statistics) noexcept;
+}
+#endif
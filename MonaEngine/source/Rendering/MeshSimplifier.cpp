@@ -0,0 +1,304 @@
+#include "MeshSimplifier.hpp"
+#include <glm/glm.hpp>
+#include <algorithm>
+#include <cstring>
+#include <unordered_map>
+#include <unordered_set>
+namespace Mona {
+
+	namespace {
+		/*
+		* Cuadrica simetrica de 4x4 acumulada de planos ponderados por area. Evaluate retorna el promedio ponderado de las
+		* distancias al cuadrado a los planos.
+		*/
+		struct Quadric {
+			double a00 = 0.0, a01 = 0.0, a02 = 0.0, a11 = 0.0, a12 = 0.0, a22 = 0.0;
+			double b0 = 0.0, b1 = 0.0, b2 = 0.0, c = 0.0;
+			double weight = 0.0;
+
+			void AddPlane(const glm::dvec3& normal, double distance, double planeWeight) noexcept {
+				a00 += planeWeight * normal.x * normal.x;
+				a01 += planeWeight * normal.x * normal.y;
+				a02 += planeWeight * normal.x * normal.z;
+				a11 += planeWeight * normal.y * normal.y;
+				a12 += planeWeight * normal.y * normal.z;
+				a22 += planeWeight * normal.z * normal.z;
+				b0 += planeWeight * normal.x * distance;
+				b1 += planeWeight * normal.y * distance;
+				b2 += planeWeight * normal.z * distance;
+				c += planeWeight * distance * distance;
+				weight += planeWeight;
+			}
+
+			Quadric& operator+=(const Quadric& rhs) noexcept {
+				a00 += rhs.a00; a01 += rhs.a01; a02 += rhs.a02; a11 += rhs.a11; a12 += rhs.a12; a22 += rhs.a22;
+				b0 += rhs.b0; b1 += rhs.b1; b2 += rhs.b2; c += rhs.c;
+				weight += rhs.weight;
+				return *this;
+			}
+
+			double Evaluate(const glm::dvec3& p) const noexcept {
+				const double value = a00 * p.x * p.x + a11 * p.y * p.y + a22 * p.z * p.z
+					+ 2.0 * (a01 * p.x * p.y + a02 * p.x * p.z + a12 * p.y * p.z)
+					+ 2.0 * (b0 * p.x + b1 * p.y + b2 * p.z) + c;
+				return weight > 0.0 ? std::max(value, 0.0) / weight : 0.0;
+			}
+		};
+
+		struct Collapse {
+			uint32_t from;
+			uint32_t to;
+			double cost;
+		};
+
+		uint64_t EdgeKey(uint32_t a, uint32_t b) noexcept {
+			return (static_cast<uint64_t>(a) << 32) | b;
+		}
+	}
+
+	float SimplifyMesh(std::vector<uint32_t>& destination, const std::vector<uint32_t>& indices, const void* vertices,
+		uint32_t vertexCount, uint32_t vertexSize, uint32_t positionOffset, uint32_t targetIndexCount, float maxError) noexcept {
+		destination = indices;
+		if (indices.size() <= targetIndexCount || vertexCount == 0)
+			return 0.0f;
+		const uint8_t* data = static_cast<const uint8_t*>(vertices);
+		std::vector<glm::vec3> positions(vertexCount);
+		for (uint32_t v = 0; v < vertexCount; v++)
+			std::memcpy(&positions[v], data + static_cast<size_t>(v) * vertexSize + positionOffset, sizeof(glm::vec3));
+
+		//Los vertices identicos (todos sus bytes iguales) se reemplazan por el primero de ellos, de manera que solo los
+		//vertices con igual posicion y distintos atributos forman costuras.
+		{
+			struct VertexHash {
+				const uint8_t* data;
+				uint32_t vertexSize;
+				size_t operator()(uint32_t v) const noexcept {
+					const uint8_t* bytes = data + static_cast<size_t>(v) * vertexSize;
+					size_t hash = 2166136261u;
+					for (uint32_t i = 0; i < vertexSize; i++)
+						hash = (hash ^ bytes[i]) * 16777619u;
+					return hash;
+				}
+			};
+			struct VertexEqual {
+				const uint8_t* data;
+				uint32_t vertexSize;
+				bool operator()(uint32_t a, uint32_t b) const noexcept {
+					return std::memcmp(data + static_cast<size_t>(a) * vertexSize, data + static_cast<size_t>(b) * vertexSize, vertexSize) == 0;
+				}
+			};
+			std::unordered_map<uint32_t, uint32_t, VertexHash, VertexEqual> firstIdentical(vertexCount, VertexHash{ data, vertexSize },
+				VertexEqual{ data, vertexSize });
+			std::vector<uint32_t> canonical(vertexCount);
+			for (uint32_t v = 0; v < vertexCount; v++)
+				canonical[v] = firstIdentical.emplace(v, v).first->second;
+			for (uint32_t& index : destination)
+				index = canonical[index];
+		}
+
+		//Los vertices que comparten posicion forman un grupo, que se identifica por su primer vertice. Las cuadricas, los
+		//bloqueos y los colapsos se aplican a grupos completos.
+		std::vector<uint32_t> positionGroup(vertexCount);
+		{
+			struct PositionHash {
+				size_t operator()(const glm::vec3& p) const noexcept {
+					uint32_t bits[3];
+					std::memcpy(bits, &p, sizeof(bits));
+					return (bits[0] * 73856093u) ^ (bits[1] * 19349663u) ^ (bits[2] * 83492791u);
+				}
+			};
+			std::unordered_map<glm::vec3, uint32_t, PositionHash> firstWithPosition;
+			firstWithPosition.reserve(vertexCount);
+			for (uint32_t v = 0; v < vertexCount; v++)
+				positionGroup[v] = firstWithPosition.emplace(positions[v], v).first->second;
+		}
+		//Una arista dirigida sin su opuesta (comparando posiciones) es un borde abierto, los grupos de sus extremos se bloquean.
+		std::vector<bool> locked(vertexCount, false);
+		{
+			std::unordered_set<uint64_t> edges;
+			edges.reserve(destination.size());
+			for (size_t t = 0; t + 2 < destination.size(); t += 3) {
+				for (uint32_t k = 0; k < 3; k++)
+					edges.insert(EdgeKey(positionGroup[destination[t + k]], positionGroup[destination[t + (k + 1) % 3]]));
+			}
+			for (size_t t = 0; t + 2 < destination.size(); t += 3) {
+				for (uint32_t k = 0; k < 3; k++) {
+					const uint32_t a = positionGroup[destination[t + k]];
+					const uint32_t b = positionGroup[destination[t + (k + 1) % 3]];
+					if (edges.find(EdgeKey(b, a)) == edges.end()) {
+						locked[a] = true;
+						locked[b] = true;
+					}
+				}
+			}
+		}
+
+		std::vector<Quadric> quadrics(vertexCount);
+		for (size_t t = 0; t + 2 < destination.size(); t += 3) {
+			const glm::dvec3 p0 = positions[destination[t]];
+			const glm::dvec3 p1 = positions[destination[t + 1]];
+			const glm::dvec3 p2 = positions[destination[t + 2]];
+			const glm::dvec3 areaNormal = glm::cross(p1 - p0, p2 - p0);
+			const double doubleArea = glm::length(areaNormal);
+			if (doubleArea <= 0.0)
+				continue;
+			const glm::dvec3 normal = areaNormal / doubleArea;
+			const double distance = -glm::dot(normal, p0);
+			for (uint32_t k = 0; k < 3; k++)
+				quadrics[positionGroup[destination[t + k]]].AddPlane(normal, distance, 0.5 * doubleArea);
+		}
+
+		const double maxCost = static_cast<double>(maxError) * maxError;
+		double resultCost = 0.0;
+		std::vector<uint32_t> remap(vertexCount);
+		for (uint32_t v = 0; v < vertexCount; v++)
+			remap[v] = v;
+		std::vector<Collapse> collapses;
+		std::vector<uint32_t> triangleOffsets(vertexCount + 1);
+		std::vector<uint32_t> vertexTriangles;
+		std::vector<uint32_t> groupOffsets(vertexCount + 1);
+		std::vector<uint32_t> groupVertices;
+		std::vector<bool> touched(vertexCount);
+		std::vector<std::pair<uint32_t, uint32_t>> moves;
+		//Cada pasada colapsa, de menor a mayor costo, aristas entre grupos que no comparten vertices con colapsos anteriores
+		//de la misma pasada. Asi la adyacencia calculada al inicio de la pasada sigue siendo valida para revisar cada colapso.
+		while (destination.size() > targetIndexCount) {
+			const uint32_t triangleCount = static_cast<uint32_t>(destination.size() / 3);
+			std::fill(triangleOffsets.begin(), triangleOffsets.end(), 0);
+			for (uint32_t index : destination)
+				triangleOffsets[index + 1]++;
+			for (uint32_t v = 0; v < vertexCount; v++)
+				triangleOffsets[v + 1] += triangleOffsets[v];
+			vertexTriangles.resize(destination.size());
+			std::vector<uint32_t> fill(triangleOffsets.begin(), triangleOffsets.end() - 1);
+			for (uint32_t t = 0; t < triangleCount; t++) {
+				for (uint32_t k = 0; k < 3; k++)
+					vertexTriangles[fill[destination[3 * t + k]]++] = t;
+			}
+			//Vertices usados de cada grupo.
+			std::fill(groupOffsets.begin(), groupOffsets.end(), 0);
+			for (uint32_t v = 0; v < vertexCount; v++) {
+				if (triangleOffsets[v + 1] > triangleOffsets[v])
+					groupOffsets[positionGroup[v] + 1]++;
+			}
+			for (uint32_t v = 0; v < vertexCount; v++)
+				groupOffsets[v + 1] += groupOffsets[v];
+			groupVertices.resize(groupOffsets[vertexCount]);
+			fill.assign(groupOffsets.begin(), groupOffsets.end() - 1);
+			for (uint32_t v = 0; v < vertexCount; v++) {
+				if (triangleOffsets[v + 1] > triangleOffsets[v])
+					groupVertices[fill[positionGroup[v]]++] = v;
+			}
+
+			collapses.clear();
+			for (uint32_t t = 0; t < triangleCount; t++) {
+				for (uint32_t k = 0; k < 3; k++) {
+					const uint32_t a = positionGroup[destination[3 * t + k]];
+					const uint32_t b = positionGroup[destination[3 * t + (k + 1) % 3]];
+					for (const auto& [from, to] : { std::make_pair(a, b), std::make_pair(b, a) }) {
+						if (locked[from])
+							continue;
+						Quadric quadric = quadrics[from];
+						quadric += quadrics[to];
+						const double cost = quadric.Evaluate(positions[to]);
+						if (cost <= maxCost)
+							collapses.push_back({ from, to, cost });
+					}
+				}
+			}
+			if (collapses.empty())
+				break;
+			std::sort(collapses.begin(), collapses.end(), [](const Collapse& x, const Collapse& y) { return x.cost < y.cost; });
+
+			std::fill(touched.begin(), touched.end(), false);
+			uint32_t remainingTriangles = triangleCount;
+			const uint32_t targetTriangles = targetIndexCount / 3;
+			uint32_t collapseCount = 0;
+			for (const Collapse& collapse : collapses) {
+				if (remainingTriangles <= targetTriangles)
+					break;
+				if (touched[collapse.from] || touched[collapse.to])
+					continue;
+				//Cada vertice del grupo se mueve sobre un vertice del grupo destino con el que comparte una arista, es decir,
+				//con sus mismos atributos a lo largo de la arista. Si en el grupo hay vertices que no tienen una arista hacia el
+				//grupo destino la arista cruza una discontinuidad de atributos y el colapso se rechaza. En una costura entre dos
+				//vertices ambos lados se colapsan juntos, por lo que la costura no se abre.
+				moves.clear();
+				bool valid = true;
+				for (uint32_t g = groupOffsets[collapse.from]; g < groupOffsets[collapse.from + 1] && valid; g++) {
+					const uint32_t from = groupVertices[g];
+					uint32_t to = UINT32_MAX;
+					for (uint32_t a = triangleOffsets[from]; a < triangleOffsets[from + 1] && to == UINT32_MAX; a++) {
+						const uint32_t* triangle = &destination[3 * vertexTriangles[a]];
+						for (uint32_t k = 0; k < 3; k++) {
+							if (positionGroup[triangle[k]] == collapse.to) {
+								to = triangle[k];
+								break;
+							}
+						}
+					}
+					valid = to != UINT32_MAX;
+					moves.push_back({ from, to });
+				}
+				if (!valid)
+					continue;
+				//Se rechaza el colapso si invierte la orientacion de algun triangulo que no desaparece.
+				const glm::vec3& target = positions[collapse.to];
+				bool flips = false;
+				uint32_t removedTriangles = 0;
+				for (const auto& [from, to] : moves) {
+					for (uint32_t a = triangleOffsets[from]; a < triangleOffsets[from + 1] && !flips; a++) {
+						const uint32_t* triangle = &destination[3 * vertexTriangles[a]];
+						if (positionGroup[triangle[0]] == collapse.to || positionGroup[triangle[1]] == collapse.to ||
+							positionGroup[triangle[2]] == collapse.to) {
+							removedTriangles++;
+							continue;
+						}
+						glm::vec3 before[3];
+						glm::vec3 after[3];
+						for (uint32_t k = 0; k < 3; k++) {
+							before[k] = positions[triangle[k]];
+							after[k] = triangle[k] == from ? target : before[k];
+						}
+						const glm::vec3 normalBefore = glm::cross(before[1] - before[0], before[2] - before[0]);
+						const glm::vec3 normalAfter = glm::cross(after[1] - after[0], after[2] - after[0]);
+						flips = glm::dot(normalBefore, normalAfter) <= 0.0f;
+					}
+				}
+				if (flips)
+					continue;
+				//Los vecinos de los vertices eliminados cambian de triangulos, por lo que tampoco se colapsan en esta pasada.
+				for (const auto& [from, to] : moves) {
+					for (uint32_t a = triangleOffsets[from]; a < triangleOffsets[from + 1]; a++) {
+						const uint32_t t = vertexTriangles[a];
+						for (uint32_t k = 0; k < 3; k++)
+							touched[positionGroup[destination[3 * t + k]]] = true;
+					}
+					remap[from] = to;
+				}
+				quadrics[collapse.to] += quadrics[collapse.from];
+				resultCost = std::max(resultCost, collapse.cost);
+				remainingTriangles -= removedTriangles;
+				collapseCount++;
+			}
+			if (collapseCount == 0)
+				break;
+
+			//Se aplican los colapsos de la pasada eliminando los triangulos degenerados, incluyendo los que quedan con dos
+			//vertices en la misma posicion.
+			size_t writeIndex = 0;
+			for (size_t t = 0; t + 2 < destination.size(); t += 3) {
+				const uint32_t i0 = remap[destination[t]];
+				const uint32_t i1 = remap[destination[t + 1]];
+				const uint32_t i2 = remap[destination[t + 2]];
+				if (positionGroup[i0] == positionGroup[i1] || positionGroup[i1] == positionGroup[i2] || positionGroup[i0] == positionGroup[i2])
+					continue;
+				destination[writeIndex++] = i0;
+				destination[writeIndex++] = i1;
+				destination[writeIndex++] = i2;
+			}
+			destination.resize(writeIndex);
+		}
+		return static_cast<float>(std::sqrt(resultCost));
+	}
+}
@@ -0,0 +1,22 @@
+#pragma once
+#ifndef MESHSIMPLIFIER_HPP
+#define MESHSIMPLIFIER_HPP
+#include <vector>
+#include <cstdint>
+namespace Mona {
+	/*
+	* Simplifica una malla con colapsos de aristas guiados por cuadricas de error (Garland y Heckbert, "Surface
+	* Simplification Using Quadric Error Metrics"). Cada colapso mueve un vertice sobre uno de sus vecinos (half edge
+	* collapse), de manera que los vertices sobrevivientes conservan sus atributos originales y el resultado reutiliza el
+	* mismo buffer de vertices. Los vertices en bordes abiertos nunca se mueven, por lo que la silueta se preserva. Los
+	* vertices con la misma posicion y distintos atributos (costuras de normales o coordenadas de textura) se colapsan
+	* juntos, cada uno sobre un vecino con sus mismos atributos, de manera que las costuras solo se acortan a lo largo de si
+	* mismas y nunca se abren. Los indices resultantes pueden referirse a otro vertice con bytes identicos al original.
+	*
+	* Escribe en destination los indices simplificados, con a lo mas targetIndexCount indices si es posible sin superar
+	* maxError. Retorna el error alcanzado, como distancia en las unidades de las posiciones.
+	*/
+	float SimplifyMesh(std::vector<uint32_t>& destination, const std::vector<uint32_t>& indices, const void* vertices,
+		uint32_t vertexCount, uint32_t vertexSize, uint32_t positionOffset, uint32_t targetIndexCount, float maxError) noexcept;
+}
+#endif
@@ -0,0 +1,251 @@
+#include "OcclusionCuller.hpp"
+#include <algorithm>
+#include <cmath>
+#include <future>
+#include <limits>
+#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+#define MONA_OCCLUSION_CULLER_SSE
+#include <xmmintrin.h>
+#endif
+namespace Mona {
+	//Cantidad minima de triangulos por hilo, con menos triangulos no se justifica lanzar trabajos en paralelo.
+	static constexpr size_t s_minTrianglesPerJob = 256;
+	//Cajas que cubren a lo mas esta cantidad de pixeles se prueban pixel a pixel si el nivel de bloques no basta.
+	static constexpr uint32_t s_maxPixelTestArea = 1024;
+	//Margen relativo a favor de la visibilidad, evita que un oclusor se oculte a si mismo por errores de redondeo cuando
+	//su superficie coincide con una cara de su caja envolvente.
+	static constexpr float s_depthEpsilon = 1e-3f;
+
+	void OcclusionCuller::StartUp(uint32_t width, uint32_t height, uint32_t jobCount) noexcept {
+		m_tileCountX = std::max(1u, (width + s_tileSize - 1) / s_tileSize);
+		m_tileCountY = std::max(1u, (height + s_tileSize - 1) / s_tileSize);
+		m_width = m_tileCountX * s_tileSize;
+		m_height = m_tileCountY * s_tileSize;
+		m_jobCount = std::max(1u, jobCount);
+		m_depth.assign(static_cast<size_t>(m_width) * m_height, 0.0f);
+		m_tileDepth.assign(static_cast<size_t>(m_tileCountX) * m_tileCountY, 0.0f);
+		m_triangles.clear();
+	}
+
+	void OcclusionCuller::BeginFrame(const glm::mat4& viewProjectionMatrix) noexcept {
+		m_viewProjectionMatrix = viewProjectionMatrix;
+		m_triangles.clear();
+	}
+
+	void OcclusionCuller::AddOccluder(const glm::vec3* positions, uint32_t vertexCount, const uint32_t* indices, uint32_t indexCount,
+		const glm::mat4& modelMatrix) noexcept {
+		const glm::mat4 modelViewProjection = m_viewProjectionMatrix * modelMatrix;
+		m_clipPositions.resize(vertexCount);
+		for (uint32_t i = 0; i < vertexCount; i++)
+			m_clipPositions[i] = modelViewProjection * glm::vec4(positions[i], 1.0f);
+		for (uint32_t i = 0; i + 2 < indexCount; i += 3)
+			AddClipTriangle(m_clipPositions[indices[i]], m_clipPositions[indices[i + 1]], m_clipPositions[indices[i + 2]]);
+	}
+
+	void OcclusionCuller::AddClipTriangle(const glm::vec4& a, const glm::vec4& b, const glm::vec4& c) noexcept {
+		//Se recorta contra el plano cercano de OpenGL (z >= -w). El resultado tiene a lo mas cuatro vertices y se divide en
+		//triangulos en abanico.
+		const glm::vec4 input[3] = { a, b, c };
+		float distances[3];
+		uint32_t insideCount = 0;
+		for (uint32_t i = 0; i < 3; i++) {
+			distances[i] = input[i].z + input[i].w;
+			insideCount += distances[i] >= 0.0f;
+		}
+		if (insideCount == 0)
+			return;
+		if (insideCount == 3) {
+			AddScreenTriangle(a, b, c);
+			return;
+		}
+		glm::vec4 polygon[4];
+		uint32_t polygonSize = 0;
+		for (uint32_t i = 0; i < 3; i++) {
+			const uint32_t j = (i + 1) % 3;
+			if (distances[i] >= 0.0f)
+				polygon[polygonSize++] = input[i];
+			if ((distances[i] >= 0.0f) != (distances[j] >= 0.0f)) {
+				const float t = distances[i] / (distances[i] - distances[j]);
+				polygon[polygonSize++] = input[i] + t * (input[j] - input[i]);
+			}
+		}
+		for (uint32_t i = 2; i < polygonSize; i++)
+			AddScreenTriangle(polygon[0], polygon[i - 1], polygon[i]);
+	}
+
+	void OcclusionCuller::AddScreenTriangle(const glm::vec4& a, const glm::vec4& b, const glm::vec4& c) noexcept {
+		ScreenTriangle triangle;
+		const glm::vec4* clip[3] = { &a, &b, &c };
+		for (uint32_t i = 0; i < 3; i++) {
+			//Los vertices recortados siempre tienen w positivo salvo en proyecciones degeneradas.
+			if (clip[i]->w <= 0.0f)
+				return;
+			const float inverseW = 1.0f / clip[i]->w;
+			triangle.vertices[i] = glm::vec3((clip[i]->x * inverseW * 0.5f + 0.5f) * static_cast<float>(m_width),
+				(clip[i]->y * inverseW * 0.5f + 0.5f) * static_cast<float>(m_height), inverseW);
+		}
+		const glm::vec3& v0 = triangle.vertices[0];
+		const glm::vec3& v1 = triangle.vertices[1];
+		const glm::vec3& v2 = triangle.vertices[2];
+		if (std::max({ v0.x, v1.x, v2.x }) < 0.0f || std::min({ v0.x, v1.x, v2.x }) > static_cast<float>(m_width) ||
+			std::max({ v0.y, v1.y, v2.y }) < 0.0f || std::min({ v0.y, v1.y, v2.y }) > static_cast<float>(m_height))
+			return;
+		m_triangles.push_back(triangle);
+	}
+
+	void OcclusionCuller::Rasterize() noexcept {
+		//Cada trabajo rasteriza todos los triangulos dentro de una banda de filas de bloques, por lo que no comparten
+		//pixeles. La primera banda se procesa en el hilo actual.
+		const uint32_t jobCount = std::clamp(static_cast<uint32_t>(m_triangles.size() / s_minTrianglesPerJob), 1u,
+			std::min(m_jobCount, m_tileCountY));
+		const uint32_t tileRowsPerJob = (m_tileCountY + jobCount - 1) / jobCount;
+		std::vector<std::future<void>> jobs;
+		jobs.reserve(jobCount);
+		for (uint32_t j = 1; j < jobCount; j++) {
+			const uint32_t firstRow = std::min(j * tileRowsPerJob, m_tileCountY) * s_tileSize;
+			const uint32_t lastRow = std::min((j + 1) * tileRowsPerJob, m_tileCountY) * s_tileSize;
+			jobs.push_back(std::async(std::launch::async, [this, firstRow, lastRow]() { RasterizeRows(firstRow, lastRow); }));
+		}
+		RasterizeRows(0, std::min(tileRowsPerJob, m_tileCountY) * s_tileSize);
+		for (std::future<void>& job : jobs)
+			job.wait();
+	}
+
+	void OcclusionCuller::RasterizeRows(uint32_t firstRow, uint32_t lastRow) noexcept {
+		std::fill(m_depth.begin() + static_cast<size_t>(firstRow) * m_width, m_depth.begin() + static_cast<size_t>(lastRow) * m_width, 0.0f);
+		for (const ScreenTriangle& triangle : m_triangles) {
+			glm::vec3 v0 = triangle.vertices[0];
+			glm::vec3 v1 = triangle.vertices[1];
+			glm::vec3 v2 = triangle.vertices[2];
+			float area = (v1.x - v0.x) * (v2.y - v0.y) - (v1.y - v0.y) * (v2.x - v0.x);
+			if (area == 0.0f)
+				continue;
+			//Ambas orientaciones ocluyen, se lleva el triangulo a orientacion antihoraria.
+			if (area < 0.0f) {
+				std::swap(v1, v2);
+				area = -area;
+			}
+			const int32_t minX = std::max(0, static_cast<int32_t>(std::floor(std::min({ v0.x, v1.x, v2.x }))));
+			const int32_t maxX = std::min(static_cast<int32_t>(m_width) - 1, static_cast<int32_t>(std::ceil(std::max({ v0.x, v1.x, v2.x }))));
+			const int32_t minY = std::max(static_cast<int32_t>(firstRow), static_cast<int32_t>(std::floor(std::min({ v0.y, v1.y, v2.y }))));
+			const int32_t maxY = std::min(static_cast<int32_t>(lastRow) - 1, static_cast<int32_t>(std::ceil(std::max({ v0.y, v1.y, v2.y }))));
+			if (minX > maxX || minY > maxY)
+				continue;
+			//Funciones de arista E(x, y) = A * x + B * y + C, no negativas dentro del triangulo. Normalizadas por el area
+			//corresponden a las coordenadas baricentricas, con las que se interpola 1/w como un plano en pantalla.
+			const float inverseArea = 1.0f / area;
+			const float a12 = v1.y - v2.y, b12 = v2.x - v1.x, c12 = v1.x * v2.y - v1.y * v2.x;
+			const float a20 = v2.y - v0.y, b20 = v0.x - v2.x, c20 = v2.x * v0.y - v2.y * v0.x;
+			const float a01 = v0.y - v1.y, b01 = v1.x - v0.x, c01 = v0.x * v1.y - v0.y * v1.x;
+			const float depthA = (a12 * v0.z + a20 * v1.z + a01 * v2.z) * inverseArea;
+			const float depthB = (b12 * v0.z + b20 * v1.z + b01 * v2.z) * inverseArea;
+			const float depthC = (c12 * v0.z + c20 * v1.z + c01 * v2.z) * inverseArea;
+			//El ancho del buffer es multiplo de cuatro, por lo que los grupos de cuatro pixeles alineados nunca se salen de
+			//la fila. Los pixeles del grupo fuera de la caja del triangulo fallan la prueba de aristas.
+			const int32_t startX = minX & ~3;
+			for (int32_t y = minY; y <= maxY; y++) {
+				const float centerY = static_cast<float>(y) + 0.5f;
+				float* row = &m_depth[static_cast<size_t>(y) * m_width];
+#ifdef MONA_OCCLUSION_CULLER_SSE
+				const __m128 zero = _mm_setzero_ps();
+				const __m128 step = _mm_set1_ps(4.0f);
+				__m128 centerX = _mm_add_ps(_mm_set1_ps(static_cast<float>(startX)), _mm_setr_ps(0.5f, 1.5f, 2.5f, 3.5f));
+				const __m128 rowE12 = _mm_set1_ps(b12 * centerY + c12);
+				const __m128 rowE20 = _mm_set1_ps(b20 * centerY + c20);
+				const __m128 rowE01 = _mm_set1_ps(b01 * centerY + c01);
+				const __m128 rowDepth = _mm_set1_ps(depthB * centerY + depthC);
+				for (int32_t x = startX; x <= maxX; x += 4) {
+					const __m128 e12 = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(a12), centerX), rowE12);
+					const __m128 e20 = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(a20), centerX), rowE20);
+					const __m128 e01 = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(a01), centerX), rowE01);
+					const __m128 inside = _mm_and_ps(_mm_cmpge_ps(e12, zero), _mm_and_ps(_mm_cmpge_ps(e20, zero), _mm_cmpge_ps(e01, zero)));
+					if (_mm_movemask_ps(inside) != 0) {
+						const __m128 depth = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(depthA), centerX), rowDepth);
+						const __m128 current = _mm_loadu_ps(row + x);
+						const __m128 nearest = _mm_max_ps(current, depth);
+						_mm_storeu_ps(row + x, _mm_or_ps(_mm_and_ps(inside, nearest), _mm_andnot_ps(inside, current)));
+					}
+					centerX = _mm_add_ps(centerX, step);
+				}
+#else
+				for (int32_t x = startX; x <= maxX; x++) {
+					const float centerX = static_cast<float>(x) + 0.5f;
+					if (a12 * centerX + b12 * centerY + c12 < 0.0f || a20 * centerX + b20 * centerY + c20 < 0.0f ||
+						a01 * centerX + b01 * centerY + c01 < 0.0f)
+						continue;
+					row[x] = std::max(row[x], depthA * centerX + depthB * centerY + depthC);
+				}
+#endif
+			}
+		}
+		//Nivel de bloques de la banda: profundidad del oclusor mas lejano (menor 1/w) de cada bloque.
+		for (uint32_t tileY = firstRow / s_tileSize; tileY < lastRow / s_tileSize; tileY++) {
+			for (uint32_t tileX = 0; tileX < m_tileCountX; tileX++) {
+				float farthest = std::numeric_limits<float>::max();
+				for (uint32_t y = tileY * s_tileSize; y < (tileY + 1) * s_tileSize; y++) {
+					const float* row = &m_depth[static_cast<size_t>(y) * m_width + tileX * s_tileSize];
+					farthest = std::min(farthest, *std::min_element(row, row + s_tileSize));
+				}
+				m_tileDepth[static_cast<size_t>(tileY) * m_tileCountX + tileX] = farthest;
+			}
+		}
+	}
+
+	bool OcclusionCuller::IsOccluded(const BoundingBox& box) const noexcept {
+		if (m_triangles.empty() || box.IsEmpty())
+			return false;
+		//El punto de la caja mas cercano al plano de la camara es una de sus esquinas, por lo que basta proyectar las ocho
+		//esquinas para obtener el rectangulo que cubre en pantalla y su mayor valor de 1/w.
+		float minX = std::numeric_limits<float>::max();
+		float minY = std::numeric_limits<float>::max();
+		float maxX = std::numeric_limits<float>::lowest();
+		float maxY = std::numeric_limits<float>::lowest();
+		float nearestDepth = 0.0f;
+		for (uint32_t corner = 0; corner < 8; corner++) {
+			const glm::vec3 position((corner & 1) ? box.maxPoint.x : box.minPoint.x,
+				(corner & 2) ? box.maxPoint.y : box.minPoint.y,
+				(corner & 4) ? box.maxPoint.z : box.minPoint.z);
+			const glm::vec4 clip = m_viewProjectionMatrix * glm::vec4(position, 1.0f);
+			if (clip.w <= 0.0f || clip.z < -clip.w)
+				return false;
+			const float inverseW = 1.0f / clip.w;
+			const float x = (clip.x * inverseW * 0.5f + 0.5f) * static_cast<float>(m_width);
+			const float y = (clip.y * inverseW * 0.5f + 0.5f) * static_cast<float>(m_height);
+			minX = std::min(minX, x);
+			minY = std::min(minY, y);
+			maxX = std::max(maxX, x);
+			maxY = std::max(maxY, y);
+			nearestDepth = std::max(nearestDepth, inverseW);
+		}
+		const float threshold = nearestDepth * (1.0f + s_depthEpsilon);
+		const int32_t x0 = std::max(0, static_cast<int32_t>(std::floor(minX)));
+		const int32_t y0 = std::max(0, static_cast<int32_t>(std::floor(minY)));
+		const int32_t x1 = std::min(static_cast<int32_t>(m_width) - 1, static_cast<int32_t>(std::ceil(maxX)));
+		const int32_t y1 = std::min(static_cast<int32_t>(m_height) - 1, static_cast<int32_t>(std::ceil(maxY)));
+		if (x0 > x1 || y0 > y1)
+			return false;
+
+		//Primero se prueban los bloques que cubren el rectangulo, su profundidad es la del oclusor mas lejano del bloque.
+		bool tilesOccluded = true;
+		for (int32_t tileY = y0 / static_cast<int32_t>(s_tileSize); tileY <= y1 / static_cast<int32_t>(s_tileSize) && tilesOccluded; tileY++) {
+			for (int32_t tileX = x0 / static_cast<int32_t>(s_tileSize); tileX <= x1 / static_cast<int32_t>(s_tileSize); tileX++) {
+				if (m_tileDepth[static_cast<size_t>(tileY) * m_tileCountX + tileX] <= threshold) {
+					tilesOccluded = false;
+					break;
+				}
+			}
+		}
+		if (tilesOccluded)
+			return true;
+		if (static_cast<uint32_t>(x1 - x0 + 1) * static_cast<uint32_t>(y1 - y0 + 1) > s_maxPixelTestArea)
+			return false;
+		for (int32_t y = y0; y <= y1; y++) {
+			const float* row = &m_depth[static_cast<size_t>(y) * m_width];
+			for (int32_t x = x0; x <= x1; x++) {
+				if (row[x] <= threshold)
+					return false;
+			}
+		}
+		return true;
+	}
+}
@@ -0,0 +1,75 @@
+#pragma once
+#ifndef OCCLUSIONCULLER_HPP
+#define OCCLUSIONCULLER_HPP
+#include <vector>
+#include <cstdint>
+#include <glm/glm.hpp>
+#include "BoundingVolume.hpp"
+namespace Mona {
+	/*
+	* Descarte por oclusion en CPU. Los triangulos de las mallas marcadas como oclusoras se rasterizan a baja resolucion en
+	* un buffer de profundidad que guarda 1/w por pixel (cero donde no hay oclusores, valores mayores son mas cercanos),
+	* evaluando cuatro pixeles a la vez con SSE y repartiendo bandas de filas entre varios hilos. Sobre este buffer se
+	* mantiene un segundo nivel con la profundidad mas lejana de cada bloque de s_tileSize x s_tileSize pixeles. Una caja
+	* esta ocluida si todos los pixeles que cubre su proyeccion tienen un oclusor mas cercano que el punto mas cercano de la
+	* caja. No usa OpenGL, por lo que puede probarse sin contexto grafico.
+	*
+	* Los pixeles se cubren segun su centro, de manera que un oclusor puede ocultar objetos que asoman menos de un pixel
+	* (del buffer de oclusion) por su borde.
+	*/
+	class OcclusionCuller {
+	public:
+		static constexpr uint32_t s_tileSize = 8;
+		OcclusionCuller() = default;
+		/*
+		* width y height se redondean a multiplos de s_tileSize. jobCount es la cantidad maxima de hilos que rasterizan.
+		*/
+		void StartUp(uint32_t width, uint32_t height, uint32_t jobCount) noexcept;
+		/*
+		* Descarta los oclusores del frame anterior y fija la matriz de vista y proyeccion del frame.
+		*/
+		void BeginFrame(const glm::mat4& viewProjectionMatrix) noexcept;
+		/*
+		* Transforma los triangulos entregados (posiciones en espacio local e indices de a tres) y los recorta contra el
+		* plano cercano, quedando listos para Rasterize.
+		*/
+		void AddOccluder(const glm::vec3* positions, uint32_t vertexCount, const uint32_t* indices, uint32_t indexCount,
+			const glm::mat4& modelMatrix) noexcept;
+		/*
+		* Rasteriza los oclusores agregados desde BeginFrame y construye el nivel de bloques.
+		*/
+		void Rasterize() noexcept;
+		/*
+		* Prueba una caja en espacio de mundo contra el buffer rasterizado. Las cajas que cruzan el plano cercano o que no
+		* cubren ningun pixel nunca se consideran ocluidas.
+		*/
+		bool IsOccluded(const BoundingBox& box) const noexcept;
+		uint32_t GetOccluderTriangleCount() const noexcept { return static_cast<uint32_t>(m_triangles.size()); }
+		uint32_t GetWidth() const noexcept { return m_width; }
+		uint32_t GetHeight() const noexcept { return m_height; }
+		/*
+		* Valor 1/w del oclusor mas cercano en el pixel (x, y), cero si ningun oclusor lo cubre. La fila cero corresponde al
+		* borde inferior de la pantalla.
+		*/
+		float GetDepth(uint32_t x, uint32_t y) const noexcept { return m_depth[static_cast<size_t>(y) * m_width + x]; }
+	private:
+		//Vertices en pixeles con z igual a 1/w, que a diferencia de w varia linealmente en pantalla.
+		struct ScreenTriangle {
+			glm::vec3 vertices[3];
+		};
+		void AddClipTriangle(const glm::vec4& a, const glm::vec4& b, const glm::vec4& c) noexcept;
+		void AddScreenTriangle(const glm::vec4& a, const glm::vec4& b, const glm::vec4& c) noexcept;
+		void RasterizeRows(uint32_t firstRow, uint32_t lastRow) noexcept;
+		glm::mat4 m_viewProjectionMatrix = glm::mat4(1.0f);
+		uint32_t m_width = 0;
+		uint32_t m_height = 0;
+		uint32_t m_tileCountX = 0;
+		uint32_t m_tileCountY = 0;
+		uint32_t m_jobCount = 1;
+		std::vector<float> m_depth;
+		std::vector<float> m_tileDepth;
+		std::vector<ScreenTriangle> m_triangles;
+		std::vector<glm::vec4> m_clipPositions;
+	};
+}
+#endif
@@ -9,27 +9,24 @@ namespace Mona {
 	class PBRFlatMaterial : public Material {
 	public:
 		PBRFlatMaterial(const ShaderProgram& shaderProgram, bool isForSkinning) : 
-			Material(shaderProgram, isForSkinning),
+			Material(shaderProgram, isForSkinning, MaterialType::PBRFlat),
 			m_albedo(glm::vec3(1.0f)),
 			m_metallic(0.0f),
 			m_roughness(0.5f),
 			m_ambientOcclusion(1.0f)
 		{}
 		
-		void SetAlbedo(const glm::vec3& albedo) { m_albedo = albedo; }
-		void SetMetallic(float metallic) { m_metallic = metallic; }
-		void SetRoughnes(float roughness) { m_roughness = roughness; }
-		void SetAmbientOcclusion(float ambientOcclusion) { m_ambientOcclusion = ambientOcclusion; }
+		void SetAlbedo(const glm::vec3& albedo) { m_albedo = albedo; OnParametersChanged(); }
+		void SetMetallic(float metallic) { m_metallic = metallic; OnParametersChanged(); }
+		void SetRoughnes(float roughness) { m_roughness = roughness; OnParametersChanged(); }
+		void SetAmbientOcclusion(float ambientOcclusion) { m_ambientOcclusion = ambientOcclusion; OnParametersChanged(); }
 		const glm::vec3& GetAlbedo() const { return m_albedo; }
 		float GetMetallic() const { return m_metallic; }
 		float GetRoughness() const { return m_roughness; }
 		float GetAmbientOcclusion() const { return m_ambientOcclusion; }
-		virtual void SetMaterialUniforms(const glm::vec3& cameraPosition) {
-			glUniform3fv(ShaderProgram::AlbedoShaderLocation, 1, glm::value_ptr(m_albedo));
-			glUniform1f(ShaderProgram::MetallicShaderLocation, m_metallic);
-			glUniform1f(ShaderProgram::RoughnessShaderLocation, m_roughness);
-			glUniform1f(ShaderProgram::AmbientOcclusionShaderLocation, m_ambientOcclusion);
-			glUniform3fv(ShaderProgram::CameraPositionShaderLocation, 1, glm::value_ptr(cameraPosition));
+		void PackParameters(MaterialParameters& parameters, MaterialTextures&) const noexcept {
+			parameters.color = glm::vec4(m_albedo, 1.0f);
+			parameters.factors = glm::vec4(m_metallic, m_roughness, m_ambientOcclusion, 0.0f);
 		}
 	private:
 		glm::vec3 m_albedo;
@@ -11,7 +11,7 @@ namespace Mona {
 	class PBRTexturedMaterial : public Material {
 	public:
 		PBRTexturedMaterial(const ShaderProgram& shaderProgram, bool isForSkinning) : 
-			Material(shaderProgram, isForSkinning),
+			Material(shaderProgram, isForSkinning, MaterialType::PBRTextured),
 			m_albedoTexture(nullptr),
 			m_normalMapTexture(nullptr),
 			m_metallicTexture(nullptr),
@@ -19,39 +19,38 @@ namespace Mona {
 			m_ambientOcclusionTexture(nullptr),
 			m_materialTint(glm::vec3(1.0f)) {
 			//Dado que las ubicaiones de las texturas nunca cambian solo se configura al momento de construccin
-			glUseProgram(m_shaderID);
-			glUniform1i(ShaderProgram::AlbedoTextureSamplerShaderLocation, ShaderProgram::AlbedoTextureUnit);
-			glUniform1i(ShaderProgram::NormalMapSamplerShaderLocation, ShaderProgram::NormalMapTextureUnit);
-			glUniform1i(ShaderProgram::MetallicSamplerShaderLocation, ShaderProgram::MetallicTextureUnit);
-			glUniform1i(ShaderProgram::RoughnessSamplerShaderLocation, ShaderProgram::RoughnessTextureUnit);
-			glUniform1i(ShaderProgram::AmbientOcclusionSamplerShaderLocation, ShaderProgram::AmbientOcclusionTextureUnit);
+			RenderDevice::GetInstance().UseProgram(m_shaderID);
+			RenderDevice::GetInstance().SetUniform(ShaderProgram::AlbedoTextureSamplerShaderLocation, ShaderProgram::AlbedoTextureUnit);
+			RenderDevice::GetInstance().SetUniform(ShaderProgram::NormalMapSamplerShaderLocation, ShaderProgram::NormalMapTextureUnit);
+			RenderDevice::GetInstance().SetUniform(ShaderProgram::MetallicSamplerShaderLocation, ShaderProgram::MetallicTextureUnit);
+			RenderDevice::GetInstance().SetUniform(ShaderProgram::RoughnessSamplerShaderLocation, ShaderProgram::RoughnessTextureUnit);
+			RenderDevice::GetInstance().SetUniform(ShaderProgram::AmbientOcclusionSamplerShaderLocation, ShaderProgram::AmbientOcclusionTextureUnit);
 		}
 		const glm::vec3& GetMaterialTint() const { return m_materialTint; }
-		void SetMaterialTint(const glm::vec3& tint) { m_materialTint = tint; }
+		void SetMaterialTint(const glm::vec3& tint) { m_materialTint = tint; OnParametersChanged(); }
 		std::shared_ptr<Texture> GetAlbedoTexture() const { return m_albedoTexture; }
 		std::shared_ptr<Texture> GetNormalMapTextire() const { return m_normalMapTexture; }
 		std::shared_ptr<Texture> GetMetallicTexture() const { return m_metallicTexture; }
 		std::shared_ptr<Texture> GetRoughnessTexture() const { return m_roughnessTexture; }
 		std::shared_ptr<Texture> GetAmbienOcclusionTexture() const { return m_ambientOcclusionTexture; }
-		void SetAlbedoTexture(std::shared_ptr<Texture> albedoTexture) { m_albedoTexture = albedoTexture; }
-		void SetNormalMapTexture(std::shared_ptr<Texture> normalMapTexture) { m_normalMapTexture = normalMapTexture; }
-		void SetMetallicTexture(std::shared_ptr<Texture> metallicTexture) { m_metallicTexture = metallicTexture; }
-		void SetRoughnessTexture(std::shared_ptr<Texture> roughnessTexture) { m_roughnessTexture = roughnessTexture; }
-		void SetAmbientOcclusionTexture(std::shared_ptr<Texture> ambientOcclusionTexture) { m_ambientOcclusionTexture = ambientOcclusionTexture; }
+		void SetAlbedoTexture(std::shared_ptr<Texture> albedoTexture) { m_albedoTexture = albedoTexture; OnParametersChanged(); }
+		void SetNormalMapTexture(std::shared_ptr<Texture> normalMapTexture) { m_normalMapTexture = normalMapTexture; OnParametersChanged(); }
+		void SetMetallicTexture(std::shared_ptr<Texture> metallicTexture) { m_metallicTexture = metallicTexture; OnParametersChanged(); }
+		void SetRoughnessTexture(std::shared_ptr<Texture> roughnessTexture) { m_roughnessTexture = roughnessTexture; OnParametersChanged(); }
+		void SetAmbientOcclusionTexture(std::shared_ptr<Texture> ambientOcclusionTexture) { m_ambientOcclusionTexture = ambientOcclusionTexture; OnParametersChanged(); }
 
-		virtual void SetMaterialUniforms(const glm::vec3& cameraPosition) {
+		void PackParameters(MaterialParameters& parameters, MaterialTextures& textures) const noexcept {
 			MONA_ASSERT(m_albedoTexture != nullptr, "Material Error: Texture must be not nullptr for rendering to be posible");
 			MONA_ASSERT(m_normalMapTexture != nullptr, "Material Error: Texture must be not nullptr for rendering to be posible");
 			MONA_ASSERT(m_metallicTexture != nullptr, "Material Error: Texture must be not nullptr for rendering to be posible");
 			MONA_ASSERT(m_roughnessTexture != nullptr, "Material Error: Texture must be not nullptr for rendering to be posible");
 			MONA_ASSERT(m_ambientOcclusionTexture != nullptr, "Material Error: Texture must be not nullptr for rendering to be posible");
-			glBindTextureUnit(ShaderProgram::AlbedoTextureUnit, m_albedoTexture->GetID());
-			glBindTextureUnit(ShaderProgram::NormalMapTextureUnit, m_normalMapTexture->GetID());
-			glBindTextureUnit(ShaderProgram::MetallicTextureUnit, m_metallicTexture->GetID());
-			glBindTextureUnit(ShaderProgram::RoughnessTextureUnit, m_roughnessTexture->GetID());
-			glBindTextureUnit(ShaderProgram::AmbientOcclusionTextureUnit, m_ambientOcclusionTexture->GetID());
-			glUniform3fv(ShaderProgram::MaterialTintShaderLocation, 1, glm::value_ptr(m_materialTint));
-			glUniform3fv(ShaderProgram::CameraPositionShaderLocation, 1, glm::value_ptr(cameraPosition));
+			parameters.color = glm::vec4(m_materialTint, 1.0f);
+			textures.Add(ShaderProgram::AlbedoTextureUnit, m_albedoTexture->GetID());
+			textures.Add(ShaderProgram::NormalMapTextureUnit, m_normalMapTexture->GetID());
+			textures.Add(ShaderProgram::MetallicTextureUnit, m_metallicTexture->GetID());
+			textures.Add(ShaderProgram::RoughnessTextureUnit, m_roughnessTexture->GetID());
+			textures.Add(ShaderProgram::AmbientOcclusionTextureUnit, m_ambientOcclusionTexture->GetID());
 		}
 	private:
 		std::shared_ptr<Texture> m_albedoTexture;
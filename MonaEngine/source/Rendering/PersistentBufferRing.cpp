@@ -0,0 +1,88 @@
+#include "PersistentBufferRing.hpp"
+#include "RenderDevice.hpp"
+#include "../Core/Log.hpp"
+#include <algorithm>
+namespace Mona {
+
+	void PersistentBufferRing::StartUp(GLenum target, size_t initialRegionSize) noexcept {
+		MONA_ASSERT(m_bufferID == 0, "PersistentBufferRing Error: Calling StartUp for the second time.");
+		m_target = target;
+		GLint alignment = 1;
+		if (target == GL_SHADER_STORAGE_BUFFER)
+			RenderDevice::GetInstance().GetIntegerv(GL_SHADER_STORAGE_BUFFER_OFFSET_ALIGNMENT, &alignment);
+		else if (target == GL_UNIFORM_BUFFER)
+			RenderDevice::GetInstance().GetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &alignment);
+		else if (target == GL_DRAW_INDIRECT_BUFFER)
+			alignment = sizeof(GLuint);
+		m_alignment = static_cast<size_t>(alignment > 0 ? alignment : 1);
+		Allocate(initialRegionSize);
+	}
+
+	void PersistentBufferRing::ShutDown() noexcept {
+		RenderDevice& device = RenderDevice::GetInstance();
+		for (uint32_t i = 0; i < s_regionCount; i++) {
+			if (m_fences[i] != nullptr) {
+				device.DeleteFence(m_fences[i]);
+				m_fences[i] = nullptr;
+			}
+		}
+		if (m_bufferID != 0) {
+			device.UnmapBuffer(m_bufferID);
+			device.DeleteBuffer(m_bufferID);
+		}
+		m_bufferID = 0;
+		m_mappedData = nullptr;
+	}
+
+	void PersistentBufferRing::Allocate(size_t regionSize) noexcept {
+		//Antes de liberar el buffer anterior es necesario que la GPU haya terminado de leer todas sus regiones.
+		for (uint32_t i = 0; i < s_regionCount; i++)
+			WaitForRegion(i);
+		RenderDevice& device = RenderDevice::GetInstance();
+		if (m_bufferID != 0) {
+			device.UnmapBuffer(m_bufferID);
+			device.DeleteBuffer(m_bufferID);
+		}
+		m_regionSize = AlignSize(std::max(regionSize, size_t(1)));
+		const GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+		m_bufferID = device.CreateBuffer(m_regionSize * s_regionCount, nullptr, flags);
+		m_mappedData = static_cast<uint8_t*>(device.MapBufferRange(m_bufferID, 0, m_regionSize * s_regionCount, flags));
+		MONA_ASSERT(m_mappedData != nullptr, "PersistentBufferRing Error: Failed to map buffer.");
+		m_currentRegion = 0;
+	}
+
+	void PersistentBufferRing::WaitForRegion(uint32_t region) noexcept {
+		void*& fence = m_fences[region];
+		if (fence == nullptr)
+			return;
+		RenderDevice& device = RenderDevice::GetInstance();
+		if (!device.WaitFence(fence))
+			MONA_LOG_ERROR("PersistentBufferRing Error: Failed to wait for fence.");
+		device.DeleteFence(fence);
+		fence = nullptr;
+	}
+
+	void* PersistentBufferRing::BeginFrame(size_t size) noexcept {
+		if (size > m_regionSize)
+			Allocate(2 * size);
+		WaitForRegion(m_currentRegion);
+		RenderDevice::GetInstance().MappedRangeWritten(m_bufferID, m_currentRegion * m_regionSize, size);
+		return m_mappedData + m_currentRegion * m_regionSize;
+	}
+
+	void PersistentBufferRing::BindRange(uint32_t binding, size_t offset, size_t size) const noexcept {
+		if (size == 0)
+			return;
+		RenderDevice::GetInstance().BindBufferRange(m_target, binding, m_bufferID, m_currentRegion * m_regionSize + offset, size);
+	}
+
+	void PersistentBufferRing::Bind() const noexcept {
+		RenderDevice::GetInstance().BindBuffer(m_target, m_bufferID);
+	}
+
+	void PersistentBufferRing::EndFrame() noexcept {
+		MONA_ASSERT(m_fences[m_currentRegion] == nullptr, "PersistentBufferRing Error: Region already in use.");
+		m_fences[m_currentRegion] = RenderDevice::GetInstance().CreateFence();
+		m_currentRegion = (m_currentRegion + 1) % s_regionCount;
+	}
+}
@@ -0,0 +1,67 @@
+#pragma once
+#ifndef PERSISTENTBUFFERRING_HPP
+#define PERSISTENTBUFFERRING_HPP
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <glad/glad.h>
+namespace Mona {
+	/*
+	* Buffer de OpenGL mapeado de forma persistente y dividido en s_regionCount regiones. Cada frame escribe en una region
+	* distinta, de manera que la CPU puede llenar la region actual mientras la GPU aun lee las de frames anteriores. Al
+	* terminar de emitir los llamados de dibujo que leen una region se inserta un fence, y antes de volver a escribir en
+	* ella se espera a que ese fence se haya completado.
+	*/
+	class PersistentBufferRing {
+	public:
+		static constexpr uint32_t s_regionCount = 3;
+		PersistentBufferRing() = default;
+		PersistentBufferRing(const PersistentBufferRing&) = delete;
+		PersistentBufferRing& operator=(const PersistentBufferRing&) = delete;
+		/*
+		* target corresponde al tipo de buffer al que se enlazara cada region (por ejemplo GL_SHADER_STORAGE_BUFFER), de el
+		* depende la alineacion requerida para el inicio de cada region.
+		*/
+		void StartUp(GLenum target, size_t initialRegionSize) noexcept;
+		void ShutDown() noexcept;
+		/*
+		* Retorna un puntero a la region del frame actual con al menos size bytes disponibles. Si la region es demasiado
+		* pequena el buffer se vuelve a crear con el doble del tamano requerido.
+		*/
+		void* BeginFrame(size_t size) noexcept;
+		/*
+		* Enlaza los primeros size bytes de la region actual al punto de enlace entregado.
+		*/
+		void BindRegion(uint32_t binding, size_t size) const noexcept { BindRange(binding, 0, size); }
+		/*
+		* Enlaza size bytes de la region actual, a partir de offset, al punto de enlace entregado. offset debe ser multiplo
+		* de la alineacion requerida (ver AlignSize).
+		*/
+		void BindRange(uint32_t binding, size_t offset, size_t size) const noexcept;
+		/*
+		* Redondea size al siguiente multiplo de la alineacion requerida, permite ubicar varios bloques en una misma region.
+		*/
+		size_t AlignSize(size_t size) const noexcept { return (size + m_alignment - 1) / m_alignment * m_alignment; }
+		/*
+		* Marca la region actual como en uso por la GPU y avanza a la siguiente.
+		*/
+		void EndFrame() noexcept;
+		/*
+		* Para buffers que no se enlazan por rangos (por ejemplo GL_DRAW_INDIRECT_BUFFER) se enlaza el buffer completo y los
+		* datos del frame se ubican a partir de GetRegionOffset.
+		*/
+		void Bind() const noexcept;
+		size_t GetRegionOffset() const noexcept { return m_currentRegion * m_regionSize; }
+	private:
+		void Allocate(size_t regionSize) noexcept;
+		void WaitForRegion(uint32_t region) noexcept;
+		GLenum m_target = GL_SHADER_STORAGE_BUFFER;
+		GLuint m_bufferID = 0;
+		size_t m_alignment = 1;
+		size_t m_regionSize = 0;
+		uint32_t m_currentRegion = 0;
+		uint8_t* m_mappedData = nullptr;
+		std::array<void*, s_regionCount> m_fences = {};
+	};
+}
+#endif
@@ -0,0 +1,205 @@
+#include "PotentiallyVisibleSet.hpp"
+#include "../Core/Log.hpp"
+#include "OcclusionCuller.hpp"
+#include "FrustumCuller.hpp"
+#include <glm/gtc/matrix_transform.hpp>
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <thread>
+namespace Mona {
+
+	template <typename T>
+	static void WriteValue(std::ofstream& out, const T& value) {
+		out.write(reinterpret_cast<const char*>(&value), sizeof(T));
+	}
+
+	template <typename T>
+	static bool ReadValue(std::ifstream& in, T& value) {
+		in.read(reinterpret_cast<char*>(&value), sizeof(T));
+		return static_cast<bool>(in);
+	}
+
+	//Las cajas se comparan bit a bit: al cargar el conjunto, las cajas de la escena se calculan con las mismas
+	//operaciones que durante el calculo y coinciden exactamente si el objeto no se ha movido.
+	static uint64_t HashBoundingBox(const BoundingBox& box) noexcept {
+		uint32_t bits[6];
+		std::memcpy(&bits[0], &box.minPoint, sizeof(glm::vec3));
+		std::memcpy(&bits[3], &box.maxPoint, sizeof(glm::vec3));
+		uint64_t hash = 14695981039346656037ull;
+		for (uint32_t value : bits) {
+			hash ^= value;
+			hash *= 1099511628211ull;
+		}
+		return hash;
+	}
+
+	static bool IsSameBoundingBox(const BoundingBox& a, const BoundingBox& b) noexcept {
+		return std::memcmp(&a.minPoint, &b.minPoint, sizeof(glm::vec3)) == 0 && std::memcmp(&a.maxPoint, &b.maxPoint, sizeof(glm::vec3)) == 0;
+	}
+
+	PotentiallyVisibleSet PotentiallyVisibleSet::Bake(const std::vector<PVSBakeObject>& objects, const PVSBakeSettings& settings) noexcept {
+		PotentiallyVisibleSet pvs;
+		for (const PVSBakeObject& object : objects) {
+			pvs.m_objectBounds.push_back(object.worldBounds);
+			if (!object.worldBounds.IsEmpty())
+				pvs.m_bounds.Extend(object.worldBounds);
+		}
+		pvs.BuildObjectLookup();
+		if (pvs.m_bounds.IsEmpty())
+			return pvs;
+		//La grilla cubre la union de las cajas de los objetos, con celdas cubicas salvo que se alcance el maximo por eje.
+		const glm::vec3 size = pvs.m_bounds.maxPoint - pvs.m_bounds.minPoint;
+		const float cellSize = std::max(settings.cellSize, 1e-3f);
+		for (int axis = 0; axis < 3; axis++) {
+			pvs.m_cellCounts[axis] = std::clamp(static_cast<uint32_t>(std::ceil(size[axis] / cellSize)), 1u, s_maxCellsPerAxis);
+			pvs.m_cellSize[axis] = std::max(size[axis] / static_cast<float>(pvs.m_cellCounts[axis]), 1e-3f);
+		}
+		const uint32_t objectCount = static_cast<uint32_t>(objects.size());
+		const uint32_t cellCount = pvs.GetCellCount();
+		pvs.m_wordsPerCell = std::max(1u, (objectCount + 63) / 64);
+		pvs.m_visibility.assign(static_cast<size_t>(cellCount) * pvs.m_wordsPerCell, 0);
+
+		OcclusionCuller occlusionCuller;
+		occlusionCuller.StartUp(settings.resolution, settings.resolution, std::max(1u, std::thread::hardware_concurrency()));
+		FrustumCuller frustumCuller;
+		frustumCuller.Reserve(objectCount);
+		for (const PVSBakeObject& object : objects)
+			frustumCuller.AddBox(object.worldBounds);
+		const glm::mat4 projectionMatrix = glm::perspective(glm::radians(90.0f), 1.0f, settings.nearPlane, settings.farPlane);
+		const glm::vec3 faceDirections[6] = { glm::vec3(1.0f, 0.0f, 0.0f), glm::vec3(-1.0f, 0.0f, 0.0f), glm::vec3(0.0f, 1.0f, 0.0f),
+			glm::vec3(0.0f, -1.0f, 0.0f), glm::vec3(0.0f, 0.0f, 1.0f), glm::vec3(0.0f, 0.0f, -1.0f) };
+		const glm::vec3 faceUps[6] = { glm::vec3(0.0f, 1.0f, 0.0f), glm::vec3(0.0f, 1.0f, 0.0f), glm::vec3(0.0f, 0.0f, -1.0f),
+			glm::vec3(0.0f, 0.0f, 1.0f), glm::vec3(0.0f, 1.0f, 0.0f), glm::vec3(0.0f, 1.0f, 0.0f) };
+		const uint32_t samplesPerAxis = std::max(1u, settings.samplesPerAxis);
+		uint64_t visiblePairs = 0;
+		for (uint32_t cell = 0; cell < cellCount; cell++) {
+			uint64_t* cellVisibility = &pvs.m_visibility[static_cast<size_t>(cell) * pvs.m_wordsPerCell];
+			const BoundingBox cellBounds = pvs.GetCellBounds(cell);
+			for (uint32_t sample = 0; sample < samplesPerAxis * samplesPerAxis * samplesPerAxis; sample++) {
+				//Con dos o mas muestras por eje se incluyen las caras de la celda, que comparte con sus vecinas.
+				const glm::uvec3 sampleCoordinates(sample % samplesPerAxis, (sample / samplesPerAxis) % samplesPerAxis, sample / (samplesPerAxis * samplesPerAxis));
+				const glm::vec3 t = samplesPerAxis == 1 ? glm::vec3(0.5f) : glm::vec3(sampleCoordinates) / static_cast<float>(samplesPerAxis - 1);
+				const glm::vec3 viewPoint = glm::mix(cellBounds.minPoint, cellBounds.maxPoint, t);
+				for (uint32_t face = 0; face < 6; face++) {
+					const glm::mat4 viewProjectionMatrix = projectionMatrix * glm::lookAt(viewPoint, viewPoint + faceDirections[face], faceUps[face]);
+					occlusionCuller.BeginFrame(viewProjectionMatrix);
+					for (const PVSBakeObject& object : objects)
+						occlusionCuller.AddOccluder(object.positions, object.vertexCount, object.indices, object.indexCount, object.modelMatrix);
+					occlusionCuller.Rasterize();
+					frustumCuller.Cull(Frustum::FromViewProjection(viewProjectionMatrix));
+					for (uint32_t i = 0; i < objectCount; i++) {
+						if ((cellVisibility[i / 64] >> (i % 64)) & 1u)
+							continue;
+						const BoundingBox& box = objects[i].worldBounds;
+						const bool containsViewPoint = !box.IsEmpty() && glm::all(glm::lessThanEqual(box.minPoint, viewPoint)) &&
+							glm::all(glm::lessThanEqual(viewPoint, box.maxPoint));
+						if (box.IsEmpty() || containsViewPoint || (frustumCuller.IsVisible(i) && !occlusionCuller.IsOccluded(box)))
+							cellVisibility[i / 64] |= uint64_t(1) << (i % 64);
+					}
+				}
+			}
+			for (uint32_t w = 0; w < pvs.m_wordsPerCell; w++) {
+				uint64_t word = cellVisibility[w];
+				for (; word != 0; word &= word - 1)
+					visiblePairs++;
+			}
+		}
+		MONA_LOG_INFO("PotentiallyVisibleSet: Baked {0} cells for {1} objects, {2:.1f} visible objects per cell on average",
+			cellCount, objectCount, static_cast<double>(visiblePairs) / cellCount);
+		return pvs;
+	}
+
+	bool PotentiallyVisibleSet::SaveToFile(const std::filesystem::path& filePath) const noexcept {
+		std::ofstream out(filePath, std::ios::binary);
+		if (!out.is_open()) {
+			MONA_LOG_ERROR("PotentiallyVisibleSet Error: Failed to open file {0} for writing", filePath.string());
+			return false;
+		}
+		out.write(s_magic, sizeof(s_magic));
+		WriteValue(out, s_version);
+		WriteValue(out, m_bounds);
+		WriteValue(out, m_cellCounts);
+		WriteValue(out, m_cellSize);
+		WriteValue(out, static_cast<uint32_t>(m_objectBounds.size()));
+		out.write(reinterpret_cast<const char*>(m_objectBounds.data()), m_objectBounds.size() * sizeof(BoundingBox));
+		WriteValue(out, m_wordsPerCell);
+		out.write(reinterpret_cast<const char*>(m_visibility.data()), m_visibility.size() * sizeof(uint64_t));
+		return static_cast<bool>(out);
+	}
+
+	bool PotentiallyVisibleSet::LoadFromFile(const std::filesystem::path& filePath) noexcept {
+		std::ifstream in(filePath, std::ios::binary);
+		if (!in.is_open()) {
+			MONA_LOG_ERROR("PotentiallyVisibleSet Error: Failed to open file {0}", filePath.string());
+			return false;
+		}
+		char magic[4];
+		uint32_t version = 0;
+		in.read(magic, sizeof(magic));
+		if (!in || std::memcmp(magic, s_magic, sizeof(s_magic)) != 0 || !ReadValue(in, version) || version != s_version) {
+			MONA_LOG_ERROR("PotentiallyVisibleSet Error: File {0} is not a valid potentially visible set", filePath.string());
+			return false;
+		}
+		PotentiallyVisibleSet pvs;
+		uint32_t objectCount = 0;
+		bool success = ReadValue(in, pvs.m_bounds) && ReadValue(in, pvs.m_cellCounts) && ReadValue(in, pvs.m_cellSize) &&
+			ReadValue(in, objectCount) && glm::all(glm::lessThanEqual(pvs.m_cellCounts, glm::uvec3(s_maxCellsPerAxis)));
+		if (success) {
+			pvs.m_objectBounds.resize(objectCount);
+			in.read(reinterpret_cast<char*>(pvs.m_objectBounds.data()), pvs.m_objectBounds.size() * sizeof(BoundingBox));
+			success = static_cast<bool>(in) && ReadValue(in, pvs.m_wordsPerCell) && pvs.m_wordsPerCell * 64 >= objectCount;
+		}
+		if (success) {
+			pvs.m_visibility.resize(static_cast<size_t>(pvs.GetCellCount()) * pvs.m_wordsPerCell);
+			in.read(reinterpret_cast<char*>(pvs.m_visibility.data()), pvs.m_visibility.size() * sizeof(uint64_t));
+			success = static_cast<bool>(in);
+		}
+		if (!success) {
+			MONA_LOG_ERROR("PotentiallyVisibleSet Error: Unexpected end of file {0}", filePath.string());
+			return false;
+		}
+		pvs.BuildObjectLookup();
+		*this = std::move(pvs);
+		return true;
+	}
+
+	void PotentiallyVisibleSet::Clear() noexcept {
+		*this = PotentiallyVisibleSet();
+	}
+
+	uint32_t PotentiallyVisibleSet::FindCell(const glm::vec3& position) const noexcept {
+		if (m_visibility.empty())
+			return s_invalidIndex;
+		const glm::vec3 local = (position - m_bounds.minPoint) / m_cellSize;
+		if (glm::any(glm::lessThan(local, glm::vec3(0.0f))) || glm::any(glm::greaterThan(local, glm::vec3(m_cellCounts))))
+			return s_invalidIndex;
+		const glm::uvec3 coordinates = glm::min(glm::uvec3(local), m_cellCounts - 1u);
+		return (coordinates.z * m_cellCounts.y + coordinates.y) * m_cellCounts.x + coordinates.x;
+	}
+
+	uint32_t PotentiallyVisibleSet::FindObject(const BoundingBox& worldBounds) const noexcept {
+		auto range = m_objectLookup.equal_range(HashBoundingBox(worldBounds));
+		for (auto it = range.first; it != range.second; ++it) {
+			if (IsSameBoundingBox(m_objectBounds[it->second], worldBounds))
+				return it->second;
+		}
+		return s_invalidIndex;
+	}
+
+	void PotentiallyVisibleSet::BuildObjectLookup() noexcept {
+		m_objectLookup.clear();
+		m_objectLookup.reserve(m_objectBounds.size());
+		for (uint32_t i = 0; i < m_objectBounds.size(); i++) {
+			//Los objetos sin caja (por ejemplo mallas que no pudieron cargarse) nunca se asocian ni se descartan.
+			if (!m_objectBounds[i].IsEmpty())
+				m_objectLookup.emplace(HashBoundingBox(m_objectBounds[i]), i);
+		}
+	}
+
+	BoundingBox PotentiallyVisibleSet::GetCellBounds(uint32_t cell) const noexcept {
+		const glm::uvec3 coordinates(cell % m_cellCounts.x, (cell / m_cellCounts.x) % m_cellCounts.y, cell / (m_cellCounts.x * m_cellCounts.y));
+		const glm::vec3 minPoint = m_bounds.minPoint + glm::vec3(coordinates) * m_cellSize;
+		return BoundingBox(minPoint, minPoint + m_cellSize);
+	}
+}
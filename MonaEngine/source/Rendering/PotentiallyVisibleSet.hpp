@@ -0,0 +1,85 @@
+#pragma once
+#ifndef POTENTIALLYVISIBLESET_HPP
+#define POTENTIALLYVISIBLESET_HPP
+#include <vector>
+#include <filesystem>
+#include <cstdint>
+#include <unordered_map>
+#include <glm/glm.hpp>
+#include "BoundingVolume.hpp"
+namespace Mona {
+	/*
+	* Parametros del calculo offline de un PotentiallyVisibleSet. Cada celda es un cubo de lado cellSize y su visibilidad
+	* se muestrea desde samplesPerAxis^3 puntos distribuidos en la celda, incluyendo sus esquinas, rasterizando en cada
+	* punto las seis caras de un cubo con resolution x resolution pixeles.
+	*/
+	struct PVSBakeSettings {
+		float cellSize = 4.0f;
+		uint32_t samplesPerAxis = 2;
+		uint32_t resolution = 128;
+		float nearPlane = 0.05f;
+		float farPlane = 1000.0f;
+	};
+
+	/*
+	* Objeto estatico entregado al calculo: su caja en espacio de mundo y su geometria (en espacio local junto a su matriz
+	* de modelo), que actua como oclusor de los demas objetos.
+	*/
+	struct PVSBakeObject {
+		BoundingBox worldBounds;
+		const glm::vec3* positions = nullptr;
+		uint32_t vertexCount = 0;
+		const uint32_t* indices = nullptr;
+		uint32_t indexCount = 0;
+		glm::mat4 modelMatrix = glm::mat4(1.0f);
+	};
+
+	/*
+	* Conjunto de objetos potencialmente visibles precalculado para geometria estatica. El espacio que ocupan los objetos
+	* se divide en una grilla de celdas de vision y cada celda guarda un bit por objeto, encendido si el objeto es visible
+	* desde algun punto de la celda. Los objetos se identifican por su caja en espacio de mundo, de manera que al cargar el
+	* conjunto cada objeto de la escena puede asociarse a su bit sin depender del orden en que fue creado, y un objeto que
+	* se mueve deja de coincidir y nunca se descarta.
+	*/
+	class PotentiallyVisibleSet {
+	public:
+		static constexpr uint32_t s_invalidIndex = UINT32_MAX;
+		static constexpr uint32_t s_maxCellsPerAxis = 256;
+		PotentiallyVisibleSet() = default;
+		/*
+		* Calcula la visibilidad de cada celda rasterizando la geometria de todos los objetos con OcclusionCuller desde los
+		* puntos de muestreo. Es un proceso lento pensado para ejecutarse fuera del juego.
+		*/
+		static PotentiallyVisibleSet Bake(const std::vector<PVSBakeObject>& objects, const PVSBakeSettings& settings) noexcept;
+		bool SaveToFile(const std::filesystem::path& filePath) const noexcept;
+		bool LoadFromFile(const std::filesystem::path& filePath) noexcept;
+		void Clear() noexcept;
+		bool IsEmpty() const noexcept { return m_visibility.empty(); }
+		/*
+		* Retorna la celda que contiene la posicion o s_invalidIndex si esta fuera de la grilla.
+		*/
+		uint32_t FindCell(const glm::vec3& position) const noexcept;
+		/*
+		* Retorna el indice del objeto cuya caja es exactamente worldBounds o s_invalidIndex si ninguno coincide.
+		*/
+		uint32_t FindObject(const BoundingBox& worldBounds) const noexcept;
+		bool IsVisible(uint32_t cell, uint32_t object) const noexcept {
+			return (m_visibility[static_cast<size_t>(cell) * m_wordsPerCell + object / 64] >> (object % 64)) & 1u;
+		}
+		uint32_t GetCellCount() const noexcept { return m_cellCounts.x * m_cellCounts.y * m_cellCounts.z; }
+		uint32_t GetObjectCount() const noexcept { return static_cast<uint32_t>(m_objectBounds.size()); }
+	private:
+		static constexpr char s_magic[4] = { 'M', 'P', 'V', 'S' };
+		static constexpr uint32_t s_version = 1;
+		void BuildObjectLookup() noexcept;
+		BoundingBox GetCellBounds(uint32_t cell) const noexcept;
+		BoundingBox m_bounds;
+		glm::uvec3 m_cellCounts = glm::uvec3(0);
+		glm::vec3 m_cellSize = glm::vec3(1.0f);
+		std::vector<BoundingBox> m_objectBounds;
+		std::unordered_multimap<uint64_t, uint32_t> m_objectLookup;
+		uint32_t m_wordsPerCell = 0;
+		std::vector<uint64_t> m_visibility;
+	};
+}
+#endif
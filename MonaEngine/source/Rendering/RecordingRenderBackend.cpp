@@ -0,0 +1,255 @@
+#include "RecordingRenderBackend.hpp"
+#include "../Core/Log.hpp"
+#include <glad/glad.h>
+#include <algorithm>
+#include <cstring>
+namespace Mona {
+	//Mismo formato que DrawElementsIndirectCommand de OpenGL.
+	struct IndirectCommand {
+		uint32_t count;
+		uint32_t instanceCount;
+		uint32_t firstIndex;
+		int32_t baseVertex;
+		uint32_t baseInstance;
+	};
+
+	static uint32_t GetIndexSize(uint32_t indexType) noexcept {
+		switch (indexType) {
+		case GL_UNSIGNED_BYTE:
+			return 1;
+		case GL_UNSIGNED_SHORT:
+			return 2;
+		default:
+			return 4;
+		}
+	}
+
+	static uint64_t GetTriangleCount(uint32_t mode, uint32_t count) noexcept {
+		switch (mode) {
+		case GL_TRIANGLES:
+			return count / 3;
+		case GL_TRIANGLE_STRIP:
+		case GL_TRIANGLE_FAN:
+			return count >= 3 ? count - 2 : 0;
+		default:
+			return 0;
+		}
+	}
+
+	static size_t GetPixelSize(uint32_t format, uint32_t type) noexcept {
+		size_t channels = 4;
+		switch (format) {
+		case GL_RED:
+			channels = 1;
+			break;
+		case GL_RG:
+			channels = 2;
+			break;
+		case GL_RGB:
+			channels = 3;
+			break;
+		default:
+			break;
+		}
+		switch (type) {
+		case GL_UNSIGNED_BYTE:
+			return channels;
+		case GL_HALF_FLOAT:
+		case GL_UNSIGNED_SHORT:
+			return channels * 2;
+		default:
+			return channels * 4;
+		}
+	}
+
+	void RecordingRenderBackend::Reset() noexcept {
+		m_drawCalls.clear();
+		m_statistics = RecordingStatistics();
+	}
+
+	bool RecordingRenderBackend::IsEnabled(uint32_t capability) const noexcept {
+		auto it = m_capabilities.find(capability);
+		return it != m_capabilities.end() && it->second;
+	}
+
+	const std::vector<uint8_t>* RecordingRenderBackend::GetBufferData(uint32_t buffer) const noexcept {
+		auto it = m_buffers.find(buffer);
+		return it != m_buffers.end() ? &it->second : nullptr;
+	}
+
+	std::vector<uint8_t>* RecordingRenderBackend::FindBuffer(uint32_t buffer) noexcept {
+		auto it = m_buffers.find(buffer);
+		MONA_ASSERT(it != m_buffers.end(), "RecordingRenderBackend Error: Invalid buffer {0}.", buffer);
+		return it != m_buffers.end() ? &it->second : nullptr;
+	}
+
+	void RecordingRenderBackend::UseProgram(uint32_t program) noexcept {
+		m_program = program;
+		m_statistics.programBinds++;
+	}
+
+	void RecordingRenderBackend::BindVertexArray(uint32_t vertexArray) noexcept {
+		m_vertexArray = vertexArray;
+		m_statistics.vertexArrayBinds++;
+	}
+
+	void RecordingRenderBackend::BindBuffer(uint32_t target, uint32_t buffer) noexcept {
+		//Al igual que en OpenGL el buffer de indices enlazado se guarda en el VAO activo.
+		if (target == GL_ELEMENT_ARRAY_BUFFER)
+			m_elementBuffers[m_vertexArray] = buffer;
+		else
+			m_boundBuffers[target] = buffer;
+		m_statistics.bufferBinds++;
+	}
+
+	void RecordingRenderBackend::BindBufferBase(uint32_t target, uint32_t, uint32_t buffer) noexcept {
+		m_boundBuffers[target] = buffer;
+		m_statistics.bufferBinds++;
+	}
+
+	void RecordingRenderBackend::BindBufferRange(uint32_t target, uint32_t, uint32_t buffer, size_t, size_t) noexcept {
+		m_boundBuffers[target] = buffer;
+		m_statistics.bufferBinds++;
+	}
+
+	void RecordingRenderBackend::BindTextureUnit(uint32_t unit, uint32_t texture) noexcept {
+		if (unit < s_maxTextureUnits)
+			m_textures[unit] = texture;
+		m_statistics.textureBinds++;
+	}
+
+	void RecordingRenderBackend::SetCapability(uint32_t capability, bool enabled) noexcept {
+		m_capabilities[capability] = enabled;
+	}
+
+	void RecordingRenderBackend::DeleteVertexArray(uint32_t vertexArray) noexcept {
+		m_elementBuffers.erase(vertexArray);
+		if (m_vertexArray == vertexArray)
+			m_vertexArray = 0;
+	}
+
+	void RecordingRenderBackend::DeleteBuffer(uint32_t buffer) noexcept {
+		m_buffers.erase(buffer);
+		for (auto& binding : m_boundBuffers) {
+			if (binding.second == buffer)
+				binding.second = 0;
+		}
+	}
+
+	uint32_t RecordingRenderBackend::CreateBuffer(size_t size, const void* data, uint32_t) noexcept {
+		const uint32_t buffer = m_nextObjectID++;
+		std::vector<uint8_t>& storage = m_buffers[buffer];
+		storage.resize(size);
+		if (data != nullptr) {
+			std::memcpy(storage.data(), data, size);
+			m_statistics.bufferBytesUploaded += size;
+		}
+		return buffer;
+	}
+
+	void RecordingRenderBackend::BufferSubData(uint32_t buffer, size_t offset, size_t size, const void* data) noexcept {
+		std::vector<uint8_t>* storage = FindBuffer(buffer);
+		if (storage == nullptr)
+			return;
+		MONA_ASSERT(offset + size <= storage->size(), "RecordingRenderBackend Error: Buffer write out of bounds.");
+		std::memcpy(storage->data() + offset, data, size);
+		m_statistics.bufferBytesUploaded += size;
+	}
+
+	void RecordingRenderBackend::GetBufferSubData(uint32_t buffer, size_t offset, size_t size, void* data) noexcept {
+		m_statistics.bufferReads++;
+		const std::vector<uint8_t>* storage = FindBuffer(buffer);
+		if (storage == nullptr)
+			return;
+		MONA_ASSERT(offset + size <= storage->size(), "RecordingRenderBackend Error: Buffer read out of bounds.");
+		std::memcpy(data, storage->data() + offset, size);
+	}
+
+	void RecordingRenderBackend::CopyBufferSubData(uint32_t source, uint32_t destination, size_t sourceOffset, size_t destinationOffset, size_t size) noexcept {
+		const std::vector<uint8_t>* sourceStorage = FindBuffer(source);
+		std::vector<uint8_t>* destinationStorage = FindBuffer(destination);
+		if (sourceStorage == nullptr || destinationStorage == nullptr)
+			return;
+		MONA_ASSERT(sourceOffset + size <= sourceStorage->size() && destinationOffset + size <= destinationStorage->size(),
+			"RecordingRenderBackend Error: Buffer copy out of bounds.");
+		std::memmove(destinationStorage->data() + destinationOffset, sourceStorage->data() + sourceOffset, size);
+	}
+
+	void* RecordingRenderBackend::MapBufferRange(uint32_t buffer, size_t offset, size_t, uint32_t) noexcept {
+		//Los buffers nunca cambian de tamano, por lo que el puntero es valido hasta que el buffer se elimina.
+		std::vector<uint8_t>* storage = FindBuffer(buffer);
+		return storage != nullptr ? storage->data() + offset : nullptr;
+	}
+
+	uint32_t RecordingRenderBackend::CreateVertexArray() noexcept {
+		return m_nextObjectID++;
+	}
+
+	void RecordingRenderBackend::SetElementBuffer(uint32_t vertexArray, uint32_t buffer) noexcept {
+		m_elementBuffers[vertexArray] = buffer;
+	}
+
+	void RecordingRenderBackend::TextureSubImage2D(uint32_t, int32_t width, int32_t height, uint32_t format, uint32_t type, const void*) noexcept {
+		m_statistics.textureBytesUploaded += static_cast<uint64_t>(std::max(0, width)) * static_cast<uint64_t>(std::max(0, height)) * GetPixelSize(format, type);
+	}
+
+	void RecordingRenderBackend::GetIntegerv(uint32_t parameter, int32_t* values) noexcept {
+		switch (parameter) {
+		case GL_VIEWPORT:
+			values[0] = m_viewport.x;
+			values[1] = m_viewport.y;
+			values[2] = m_viewport.z;
+			values[3] = m_viewport.w;
+			return;
+		case GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT:
+		case GL_SHADER_STORAGE_BUFFER_OFFSET_ALIGNMENT:
+			values[0] = s_bufferOffsetAlignment;
+			return;
+		default:
+			values[0] = 0;
+			return;
+		}
+	}
+
+	void RecordingRenderBackend::RecordDraw(const RecordedDrawCall& drawCall) noexcept {
+		m_drawCalls.push_back(drawCall);
+		m_statistics.triangles += GetTriangleCount(drawCall.mode, drawCall.count) * drawCall.instanceCount;
+		m_statistics.instances += drawCall.instanceCount;
+	}
+
+	void RecordingRenderBackend::DrawArrays(uint32_t mode, int32_t first, int32_t count) noexcept {
+		RecordDraw({ RecordedDrawCall::Type::Arrays, m_program, m_vertexArray, mode, 0, static_cast<uint32_t>(count), 1,
+			static_cast<uint32_t>(first), 0, 0, 0 });
+		m_statistics.drawCalls++;
+	}
+
+	void RecordingRenderBackend::DrawElements(uint32_t mode, int32_t count, uint32_t indexType, size_t indexOffset, int32_t instanceCount) noexcept {
+		RecordDraw({ RecordedDrawCall::Type::Elements, m_program, m_vertexArray, mode, indexType, static_cast<uint32_t>(count),
+			static_cast<uint32_t>(instanceCount), static_cast<uint32_t>(indexOffset / GetIndexSize(indexType)), 0, 0, 0 });
+		m_statistics.drawCalls++;
+	}
+
+	void RecordingRenderBackend::MultiDrawElementsIndirect(uint32_t mode, uint32_t indexType, size_t indirectOffset, int32_t drawCount, int32_t stride) noexcept {
+		//Los comandos se leen desde la copia en CPU del buffer enlazado a GL_DRAW_INDIRECT_BUFFER.
+		auto it = m_boundBuffers.find(GL_DRAW_INDIRECT_BUFFER);
+		MONA_ASSERT(it != m_boundBuffers.end() && it->second != 0, "RecordingRenderBackend Error: No indirect buffer bound.");
+		const std::vector<uint8_t>* storage = it != m_boundBuffers.end() ? FindBuffer(it->second) : nullptr;
+		if (storage == nullptr)
+			return;
+		const size_t commandStride = stride != 0 ? static_cast<size_t>(stride) : sizeof(IndirectCommand);
+		MONA_ASSERT(indirectOffset + commandStride * static_cast<size_t>(std::max(0, drawCount)) <= storage->size(),
+			"RecordingRenderBackend Error: Indirect commands out of bounds.");
+		for (int32_t i = 0; i < drawCount; i++) {
+			IndirectCommand command;
+			std::memcpy(&command, storage->data() + indirectOffset + i * commandStride, sizeof(IndirectCommand));
+			RecordDraw({ RecordedDrawCall::Type::MultiDrawIndirect, m_program, m_vertexArray, mode, indexType, command.count,
+				command.instanceCount, command.firstIndex, command.baseVertex, command.baseInstance, static_cast<uint32_t>(i) });
+		}
+		m_statistics.indirectCommands += static_cast<uint32_t>(std::max(0, drawCount));
+		m_statistics.drawCalls++;
+	}
+
+	void* RecordingRenderBackend::CreateFence() noexcept {
+		return reinterpret_cast<void*>(m_nextFence++);
+	}
+}
@@ -0,0 +1,159 @@
+#pragma once
+#ifndef RECORDINGRENDERBACKEND_HPP
+#define RECORDINGRENDERBACKEND_HPP
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+#include <glm/glm.hpp>
+#include "RenderBackend.hpp"
+namespace Mona {
+	/*
+	* Llamado de dibujo registrado por RecordingRenderBackend junto al estado enlazado al momento de emitirlo. Cada comando
+	* de un MultiDrawElementsIndirect se registra por separado, con commandIndex igual a su posicion dentro del llamado.
+	*/
+	struct RecordedDrawCall {
+		enum class Type : uint8_t {
+			Arrays,
+			Elements,
+			MultiDrawIndirect
+		};
+		Type type;
+		uint32_t program;
+		uint32_t vertexArray;
+		uint32_t mode;
+		uint32_t indexType;
+		uint32_t count;
+		uint32_t instanceCount;
+		uint32_t firstIndex;
+		int32_t baseVertex;
+		uint32_t baseInstance;
+		uint32_t commandIndex;
+	};
+
+	/*
+	* Contadores de RecordingRenderBackend desde el ultimo llamado a Reset. drawCalls cuenta llamados a la API, de manera
+	* que un MultiDrawElementsIndirect suma uno a drawCalls y uno por comando a indirectCommands. bufferReads cuenta las
+	* lecturas de buffers hacia la CPU, que en OpenGL esperan a que la GPU termine de usarlos.
+	*/
+	struct RecordingStatistics {
+		uint32_t drawCalls = 0;
+		uint32_t indirectCommands = 0;
+		uint64_t triangles = 0;
+		uint64_t instances = 0;
+		uint32_t programBinds = 0;
+		uint32_t vertexArrayBinds = 0;
+		uint32_t bufferBinds = 0;
+		uint32_t textureBinds = 0;
+		uint32_t uniformUpdates = 0;
+		uint64_t bufferBytesUploaded = 0;
+		uint64_t textureBytesUploaded = 0;
+		uint64_t uniformBytesUploaded = 0;
+		uint32_t bufferReads = 0;
+	};
+
+	/*
+	* Backend que no requiere GPU: registra los llamados de dibujo y el estado enlazado, y mantiene en memoria de CPU el
+	* contenido de los buffers, de manera que lecturas, copias, mapeos y comandos de dibujo indirecto se comportan como en
+	* OpenGL. Permite ejecutar Renderer::Render en pruebas y mediciones sin contexto de OpenGL. Los programas y texturas
+	* solo reciben un identificador.
+	*/
+	class RecordingRenderBackend : public RenderBackend {
+	public:
+		RecordingRenderBackend() = default;
+		RecordingRenderBackend(const RecordingRenderBackend&) = delete;
+		RecordingRenderBackend& operator=(const RecordingRenderBackend&) = delete;
+		/*
+		* Descarta los llamados registrados y reinicia los contadores, sin modificar los objetos creados ni el estado enlazado.
+		* Se llama al comenzar cada frame, por lo que al terminar Renderer::Render contiene solo los llamados de ese frame.
+		*/
+		void Reset() noexcept;
+		virtual void BeginFrame() noexcept override { Reset(); }
+		const std::vector<RecordedDrawCall>& GetDrawCalls() const noexcept { return m_drawCalls; }
+		const RecordingStatistics& GetStatistics() const noexcept { return m_statistics; }
+		uint32_t GetBoundProgram() const noexcept { return m_program; }
+		uint32_t GetBoundVertexArray() const noexcept { return m_vertexArray; }
+		uint32_t GetBoundTexture(uint32_t unit) const noexcept { return unit < s_maxTextureUnits ? m_textures[unit] : 0; }
+		bool IsEnabled(uint32_t capability) const noexcept;
+		const glm::ivec4& GetViewport() const noexcept { return m_viewport; }
+		/*
+		* Contenido actual de un buffer, nullptr si el identificador no corresponde a un buffer vivo.
+		*/
+		const std::vector<uint8_t>* GetBufferData(uint32_t buffer) const noexcept;
+		size_t GetLiveBufferCount() const noexcept { return m_buffers.size(); }
+
+		virtual void UseProgram(uint32_t program) noexcept override;
+		virtual void BindVertexArray(uint32_t vertexArray) noexcept override;
+		virtual void BindBuffer(uint32_t target, uint32_t buffer) noexcept override;
+		virtual void BindBufferBase(uint32_t target, uint32_t index, uint32_t buffer) noexcept override;
+		virtual void BindBufferRange(uint32_t target, uint32_t index, uint32_t buffer, size_t offset, size_t size) noexcept override;
+		virtual void BindTextureUnit(uint32_t unit, uint32_t texture) noexcept override;
+		virtual void SetCapability(uint32_t capability, bool enabled) noexcept override;
+		virtual void DeleteProgram(uint32_t) noexcept override {}
+		virtual void DeleteVertexArray(uint32_t vertexArray) noexcept override;
+		virtual void DeleteBuffer(uint32_t buffer) noexcept override;
+		virtual void DeleteTexture(uint32_t) noexcept override {}
+		virtual uint32_t CreateBuffer(size_t size, const void* data, uint32_t storageFlags) noexcept override;
+		virtual void BufferSubData(uint32_t buffer, size_t offset, size_t size, const void* data) noexcept override;
+		virtual void GetBufferSubData(uint32_t buffer, size_t offset, size_t size, void* data) noexcept override;
+		virtual void CopyBufferSubData(uint32_t source, uint32_t destination, size_t sourceOffset, size_t destinationOffset, size_t size) noexcept override;
+		virtual void* MapBufferRange(uint32_t buffer, size_t offset, size_t size, uint32_t access) noexcept override;
+		virtual void UnmapBuffer(uint32_t) noexcept override {}
+		virtual void MappedRangeWritten(uint32_t, size_t, size_t size) noexcept override { m_statistics.bufferBytesUploaded += size; }
+		virtual uint32_t CreateVertexArray() noexcept override;
+		virtual void SetVertexAttribute(uint32_t, uint32_t, int32_t, uint32_t, bool, bool, uint32_t, uint32_t) noexcept override {}
+		virtual void SetVertexBuffer(uint32_t, uint32_t, uint32_t, size_t, uint32_t) noexcept override {}
+		virtual void SetVertexBindingDivisor(uint32_t, uint32_t, uint32_t) noexcept override {}
+		virtual void SetElementBuffer(uint32_t vertexArray, uint32_t buffer) noexcept override;
+		virtual uint32_t CreateProgram(const std::string&, const std::string&, std::string&) noexcept override {
+			return m_nextObjectID++;
+		}
+		virtual void SetUniform(int32_t, int32_t) noexcept override { CountUniform(sizeof(int32_t)); }
+		virtual void SetUniform(int32_t, float) noexcept override { CountUniform(sizeof(float)); }
+		virtual void SetUniform(int32_t, const glm::vec3&) noexcept override { CountUniform(sizeof(glm::vec3)); }
+		virtual void SetUniform(int32_t, const glm::mat4&) noexcept override { CountUniform(sizeof(glm::mat4)); }
+		virtual uint32_t CreateTexture2D(uint32_t, int32_t, int32_t, int32_t) noexcept override {
+			return m_nextObjectID++;
+		}
+		virtual void TextureSubImage2D(uint32_t texture, int32_t width, int32_t height, uint32_t format, uint32_t type, const void* data) noexcept override;
+		virtual void SetTextureParameter(uint32_t, uint32_t, int32_t) noexcept override {}
+		virtual void GenerateMipmaps(uint32_t) noexcept override {}
+		virtual void Clear(uint32_t) noexcept override {}
+		virtual void SetViewport(int32_t x, int32_t y, int32_t width, int32_t height) noexcept override { m_viewport = glm::ivec4(x, y, width, height); }
+		virtual void SetLineWidth(float) noexcept override {}
+		virtual void GetIntegerv(uint32_t parameter, int32_t* values) noexcept override;
+		virtual void DrawArrays(uint32_t mode, int32_t first, int32_t count) noexcept override;
+		virtual void DrawElements(uint32_t mode, int32_t count, uint32_t indexType, size_t indexOffset, int32_t instanceCount) noexcept override;
+		virtual void MultiDrawElementsIndirect(uint32_t mode, uint32_t indexType, size_t indirectOffset, int32_t drawCount, int32_t stride) noexcept override;
+		virtual void* CreateFence() noexcept override;
+		virtual bool WaitFence(void*) noexcept override { return true; }
+		virtual void DeleteFence(void*) noexcept override {}
+
+		static constexpr uint32_t s_maxTextureUnits = 32;
+		//Alineacion informada para los offsets de buffers uniformes y de almacenamiento, igual a la mas comun en GPUs actuales.
+		static constexpr int32_t s_bufferOffsetAlignment = 256;
+	private:
+		std::vector<uint8_t>* FindBuffer(uint32_t buffer) noexcept;
+		void CountUniform(size_t size) noexcept {
+			m_statistics.uniformUpdates++;
+			m_statistics.uniformBytesUploaded += size;
+		}
+		void RecordDraw(const RecordedDrawCall& drawCall) noexcept;
+		uint32_t m_nextObjectID = 1;
+		uintptr_t m_nextFence = 1;
+		std::unordered_map<uint32_t, std::vector<uint8_t>> m_buffers;
+		//Buffer de indices de cada VAO.
+		std::unordered_map<uint32_t, uint32_t> m_elementBuffers;
+		//Buffer enlazado a cada destino generico.
+		std::unordered_map<uint32_t, uint32_t> m_boundBuffers;
+		std::unordered_map<uint32_t, bool> m_capabilities;
+		std::array<uint32_t, s_maxTextureUnits> m_textures = {};
+		uint32_t m_program = 0;
+		uint32_t m_vertexArray = 0;
+		glm::ivec4 m_viewport = glm::ivec4(0, 0, 1280, 720);
+		std::vector<RecordedDrawCall> m_drawCalls;
+		RecordingStatistics m_statistics;
+	};
+}
+#endif
@@ -0,0 +1,250 @@
+#include "RenderBackend.hpp"
+#include <glad/glad.h>
+#include <vector>
+#include <glm/gtc/type_ptr.hpp>
+namespace Mona {
+
+	void OpenGLRenderBackend::UseProgram(uint32_t program) noexcept {
+		glUseProgram(program);
+	}
+
+	void OpenGLRenderBackend::BindVertexArray(uint32_t vertexArray) noexcept {
+		glBindVertexArray(vertexArray);
+	}
+
+	void OpenGLRenderBackend::BindBuffer(uint32_t target, uint32_t buffer) noexcept {
+		glBindBuffer(target, buffer);
+	}
+
+	void OpenGLRenderBackend::BindBufferBase(uint32_t target, uint32_t index, uint32_t buffer) noexcept {
+		glBindBufferBase(target, index, buffer);
+	}
+
+	void OpenGLRenderBackend::BindBufferRange(uint32_t target, uint32_t index, uint32_t buffer, size_t offset, size_t size) noexcept {
+		glBindBufferRange(target, index, buffer, static_cast<GLintptr>(offset), static_cast<GLsizeiptr>(size));
+	}
+
+	void OpenGLRenderBackend::BindTextureUnit(uint32_t unit, uint32_t texture) noexcept {
+		glBindTextureUnit(unit, texture);
+	}
+
+	void OpenGLRenderBackend::SetCapability(uint32_t capability, bool enabled) noexcept {
+		if (enabled)
+			glEnable(capability);
+		else
+			glDisable(capability);
+	}
+
+	void OpenGLRenderBackend::DeleteProgram(uint32_t program) noexcept {
+		glDeleteProgram(program);
+	}
+
+	void OpenGLRenderBackend::DeleteVertexArray(uint32_t vertexArray) noexcept {
+		glDeleteVertexArrays(1, &vertexArray);
+	}
+
+	void OpenGLRenderBackend::DeleteBuffer(uint32_t buffer) noexcept {
+		glDeleteBuffers(1, &buffer);
+	}
+
+	void OpenGLRenderBackend::DeleteTexture(uint32_t texture) noexcept {
+		glDeleteTextures(1, &texture);
+	}
+
+	uint32_t OpenGLRenderBackend::CreateBuffer(size_t size, const void* data, uint32_t storageFlags) noexcept {
+		GLuint buffer = 0;
+		glCreateBuffers(1, &buffer);
+		glNamedBufferStorage(buffer, static_cast<GLsizeiptr>(size), data, storageFlags);
+		return buffer;
+	}
+
+	void OpenGLRenderBackend::BufferSubData(uint32_t buffer, size_t offset, size_t size, const void* data) noexcept {
+		glNamedBufferSubData(buffer, static_cast<GLintptr>(offset), static_cast<GLsizeiptr>(size), data);
+	}
+
+	void OpenGLRenderBackend::GetBufferSubData(uint32_t buffer, size_t offset, size_t size, void* data) noexcept {
+		glGetNamedBufferSubData(buffer, static_cast<GLintptr>(offset), static_cast<GLsizeiptr>(size), data);
+	}
+
+	void OpenGLRenderBackend::CopyBufferSubData(uint32_t source, uint32_t destination, size_t sourceOffset, size_t destinationOffset, size_t size) noexcept {
+		glCopyNamedBufferSubData(source, destination, static_cast<GLintptr>(sourceOffset), static_cast<GLintptr>(destinationOffset),
+			static_cast<GLsizeiptr>(size));
+	}
+
+	void* OpenGLRenderBackend::MapBufferRange(uint32_t buffer, size_t offset, size_t size, uint32_t access) noexcept {
+		return glMapNamedBufferRange(buffer, static_cast<GLintptr>(offset), static_cast<GLsizeiptr>(size), access);
+	}
+
+	void OpenGLRenderBackend::UnmapBuffer(uint32_t buffer) noexcept {
+		glUnmapNamedBuffer(buffer);
+	}
+
+	uint32_t OpenGLRenderBackend::CreateVertexArray() noexcept {
+		GLuint vertexArray = 0;
+		glCreateVertexArrays(1, &vertexArray);
+		return vertexArray;
+	}
+
+	void OpenGLRenderBackend::SetVertexAttribute(uint32_t vertexArray, uint32_t location, int32_t componentCount, uint32_t type, bool normalized,
+		bool integer, uint32_t relativeOffset, uint32_t bindingIndex) noexcept {
+		glEnableVertexArrayAttrib(vertexArray, location);
+		if (integer)
+			glVertexArrayAttribIFormat(vertexArray, location, componentCount, type, relativeOffset);
+		else
+			glVertexArrayAttribFormat(vertexArray, location, componentCount, type, normalized ? GL_TRUE : GL_FALSE, relativeOffset);
+		glVertexArrayAttribBinding(vertexArray, location, bindingIndex);
+	}
+
+	void OpenGLRenderBackend::SetVertexBuffer(uint32_t vertexArray, uint32_t bindingIndex, uint32_t buffer, size_t offset, uint32_t stride) noexcept {
+		glVertexArrayVertexBuffer(vertexArray, bindingIndex, buffer, static_cast<GLintptr>(offset), static_cast<GLsizei>(stride));
+	}
+
+	void OpenGLRenderBackend::SetVertexBindingDivisor(uint32_t vertexArray, uint32_t bindingIndex, uint32_t divisor) noexcept {
+		glVertexArrayBindingDivisor(vertexArray, bindingIndex, divisor);
+	}
+
+	void OpenGLRenderBackend::SetElementBuffer(uint32_t vertexArray, uint32_t buffer) noexcept {
+		glVertexArrayElementBuffer(vertexArray, buffer);
+	}
+
+	uint32_t OpenGLRenderBackend::CompileShader(const std::string& code, uint32_t type, std::string& errorLog) noexcept {
+		GLuint shader = glCreateShader(type);
+		const char* cCode = code.c_str();
+		glShaderSource(shader, 1, &cCode, 0);
+		glCompileShader(shader);
+		GLint isCompiled = 0;
+		glGetShaderiv(shader, GL_COMPILE_STATUS, &isCompiled);
+		//Chequeo de errores de compilacion
+		if (isCompiled == GL_FALSE)
+		{
+			GLint maxLength = 0;
+			glGetShaderiv(shader, GL_INFO_LOG_LENGTH, &maxLength);
+			std::vector<GLchar> log(maxLength + 1, '\0');
+			glGetShaderInfoLog(shader, maxLength, &maxLength, log.data());
+			glDeleteShader(shader);
+			errorLog = log.data();
+			return 0;
+		}
+		return shader;
+	}
+
+	uint32_t OpenGLRenderBackend::CreateProgram(const std::string& vertexCode, const std::string& pixelCode, std::string& errorLog) noexcept {
+		GLuint vertex = CompileShader(vertexCode, GL_VERTEX_SHADER, errorLog);
+		if (vertex == 0)
+			return 0;
+		GLuint pixel = CompileShader(pixelCode, GL_FRAGMENT_SHADER, errorLog);
+		if (pixel == 0) {
+			glDeleteShader(vertex);
+			return 0;
+		}
+		GLuint program = glCreateProgram();
+		glAttachShader(program, vertex);
+		glAttachShader(program, pixel);
+		glLinkProgram(program);
+		GLint isLinked = 0;
+		glGetProgramiv(program, GL_LINK_STATUS, &isLinked);
+		glDetachShader(program, vertex);
+		glDetachShader(program, pixel);
+		glDeleteShader(vertex);
+		glDeleteShader(pixel);
+		//Chequeo de error de linkeo
+		if (isLinked == GL_FALSE)
+		{
+			GLint maxLength = 0;
+			glGetProgramiv(program, GL_INFO_LOG_LENGTH, &maxLength);
+			std::vector<GLchar> log(maxLength + 1, '\0');
+			glGetProgramInfoLog(program, maxLength, &maxLength, log.data());
+			glDeleteProgram(program);
+			errorLog = log.data();
+			return 0;
+		}
+		return program;
+	}
+
+	void OpenGLRenderBackend::SetUniform(int32_t location, int32_t value) noexcept {
+		glUniform1i(location, value);
+	}
+
+	void OpenGLRenderBackend::SetUniform(int32_t location, float value) noexcept {
+		glUniform1f(location, value);
+	}
+
+	void OpenGLRenderBackend::SetUniform(int32_t location, const glm::vec3& value) noexcept {
+		glUniform3fv(location, 1, glm::value_ptr(value));
+	}
+
+	void OpenGLRenderBackend::SetUniform(int32_t location, const glm::mat4& value) noexcept {
+		glUniformMatrix4fv(location, 1, GL_FALSE, glm::value_ptr(value));
+	}
+
+	uint32_t OpenGLRenderBackend::CreateTexture2D(uint32_t internalFormat, int32_t width, int32_t height, int32_t levels) noexcept {
+		GLuint texture = 0;
+		glCreateTextures(GL_TEXTURE_2D, 1, &texture);
+		glTextureStorage2D(texture, levels, internalFormat, width, height);
+		return texture;
+	}
+
+	void OpenGLRenderBackend::TextureSubImage2D(uint32_t texture, int32_t width, int32_t height, uint32_t format, uint32_t type, const void* data) noexcept {
+		glTextureSubImage2D(texture, 0, 0, 0, width, height, format, type, data);
+	}
+
+	void OpenGLRenderBackend::SetTextureParameter(uint32_t texture, uint32_t parameter, int32_t value) noexcept {
+		glTextureParameteri(texture, parameter, value);
+	}
+
+	void OpenGLRenderBackend::GenerateMipmaps(uint32_t texture) noexcept {
+		glGenerateTextureMipmap(texture);
+	}
+
+	void OpenGLRenderBackend::Clear(uint32_t mask) noexcept {
+		glClear(mask);
+	}
+
+	void OpenGLRenderBackend::SetViewport(int32_t x, int32_t y, int32_t width, int32_t height) noexcept {
+		glViewport(x, y, width, height);
+	}
+
+	void OpenGLRenderBackend::SetLineWidth(float width) noexcept {
+		glLineWidth(width);
+	}
+
+	void OpenGLRenderBackend::GetIntegerv(uint32_t parameter, int32_t* values) noexcept {
+		glGetIntegerv(parameter, values);
+	}
+
+	void OpenGLRenderBackend::DrawArrays(uint32_t mode, int32_t first, int32_t count) noexcept {
+		glDrawArrays(mode, first, count);
+	}
+
+	void OpenGLRenderBackend::DrawElements(uint32_t mode, int32_t count, uint32_t indexType, size_t indexOffset, int32_t instanceCount) noexcept {
+		const void* indices = reinterpret_cast<const void*>(indexOffset);
+		if (instanceCount == 1)
+			glDrawElements(mode, count, indexType, indices);
+		else
+			glDrawElementsInstanced(mode, count, indexType, indices, instanceCount);
+	}
+
+	void OpenGLRenderBackend::MultiDrawElementsIndirect(uint32_t mode, uint32_t indexType, size_t indirectOffset, int32_t drawCount, int32_t stride) noexcept {
+		glMultiDrawElementsIndirect(mode, indexType, reinterpret_cast<const void*>(indirectOffset), drawCount, stride);
+	}
+
+	void* OpenGLRenderBackend::CreateFence() noexcept {
+		return glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+	}
+
+	bool OpenGLRenderBackend::WaitFence(void* fence) noexcept {
+		GLsync sync = static_cast<GLsync>(fence);
+		//Se espera en intervalos de un segundo, la primera espera ademas envia los comandos pendientes a la GPU.
+		GLbitfield waitFlags = GL_SYNC_FLUSH_COMMANDS_BIT;
+		GLenum result = glClientWaitSync(sync, waitFlags, 1000000000);
+		while (result == GL_TIMEOUT_EXPIRED) {
+			waitFlags = 0;
+			result = glClientWaitSync(sync, waitFlags, 1000000000);
+		}
+		return result != GL_WAIT_FAILED;
+	}
+
+	void OpenGLRenderBackend::DeleteFence(void* fence) noexcept {
+		glDeleteSync(static_cast<GLsync>(fence));
+	}
+}
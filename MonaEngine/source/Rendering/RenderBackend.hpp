@@ -0,0 +1,155 @@
+#pragma once
+#ifndef RENDERBACKEND_HPP
+#define RENDERBACKEND_HPP
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <glm/glm.hpp>
+namespace Mona {
+	/*
+	* Destino final de los llamados que pasan por RenderDevice. Los parametros usan los mismos valores que OpenGL (por ejemplo
+	* target es GL_UNIFORM_BUFFER), de manera que la implementacion de OpenGL solo reenvia cada llamado y otras
+	* implementaciones pueden registrarlos sin necesidad de una GPU. Los objetos se crean con la API de acceso directo
+	* (DSA) de OpenGL 4.5, por lo que crearlos o modificarlos no altera el estado enlazado.
+	*/
+	class RenderBackend {
+	public:
+		virtual ~RenderBackend() = default;
+		/*
+		* RenderDevice lo llama al comenzar cada frame.
+		*/
+		virtual void BeginFrame() noexcept = 0;
+		virtual void UseProgram(uint32_t program) noexcept = 0;
+		virtual void BindVertexArray(uint32_t vertexArray) noexcept = 0;
+		virtual void BindBuffer(uint32_t target, uint32_t buffer) noexcept = 0;
+		virtual void BindBufferBase(uint32_t target, uint32_t index, uint32_t buffer) noexcept = 0;
+		virtual void BindBufferRange(uint32_t target, uint32_t index, uint32_t buffer, size_t offset, size_t size) noexcept = 0;
+		virtual void BindTextureUnit(uint32_t unit, uint32_t texture) noexcept = 0;
+		virtual void SetCapability(uint32_t capability, bool enabled) noexcept = 0;
+		virtual void DeleteProgram(uint32_t program) noexcept = 0;
+		virtual void DeleteVertexArray(uint32_t vertexArray) noexcept = 0;
+		virtual void DeleteBuffer(uint32_t buffer) noexcept = 0;
+		virtual void DeleteTexture(uint32_t texture) noexcept = 0;
+
+		//Buffers
+		virtual uint32_t CreateBuffer(size_t size, const void* data, uint32_t storageFlags) noexcept = 0;
+		virtual void BufferSubData(uint32_t buffer, size_t offset, size_t size, const void* data) noexcept = 0;
+		virtual void GetBufferSubData(uint32_t buffer, size_t offset, size_t size, void* data) noexcept = 0;
+		virtual void CopyBufferSubData(uint32_t source, uint32_t destination, size_t sourceOffset, size_t destinationOffset, size_t size) noexcept = 0;
+		virtual void* MapBufferRange(uint32_t buffer, size_t offset, size_t size, uint32_t access) noexcept = 0;
+		virtual void UnmapBuffer(uint32_t buffer) noexcept = 0;
+		/*
+		* Informa que se escribieron size bytes en un buffer mapeado de forma persistente. OpenGL no lo necesita cuando el
+		* mapeo es coherente, pero permite a otras implementaciones contar los bytes enviados a la GPU.
+		*/
+		virtual void MappedRangeWritten(uint32_t buffer, size_t offset, size_t size) noexcept = 0;
+
+		//Vertex arrays
+		virtual uint32_t CreateVertexArray() noexcept = 0;
+		/*
+		* Activa el atributo location y define su formato. Si integer es verdadero el atributo se lee como entero en el
+		* shader (glVertexArrayAttribIFormat) y normalized se ignora.
+		*/
+		virtual void SetVertexAttribute(uint32_t vertexArray, uint32_t location, int32_t componentCount, uint32_t type, bool normalized,
+			bool integer, uint32_t relativeOffset, uint32_t bindingIndex) noexcept = 0;
+		virtual void SetVertexBuffer(uint32_t vertexArray, uint32_t bindingIndex, uint32_t buffer, size_t offset, uint32_t stride) noexcept = 0;
+		virtual void SetVertexBindingDivisor(uint32_t vertexArray, uint32_t bindingIndex, uint32_t divisor) noexcept = 0;
+		virtual void SetElementBuffer(uint32_t vertexArray, uint32_t buffer) noexcept = 0;
+
+		//Programas
+		/*
+		* Compila y enlaza un programa a partir del codigo de sus shaders. Retorna 0 en caso de error, en cuyo caso
+		* errorLog contiene el mensaje del compilador.
+		*/
+		virtual uint32_t CreateProgram(const std::string& vertexCode, const std::string& pixelCode, std::string& errorLog) noexcept = 0;
+		virtual void SetUniform(int32_t location, int32_t value) noexcept = 0;
+		virtual void SetUniform(int32_t location, float value) noexcept = 0;
+		virtual void SetUniform(int32_t location, const glm::vec3& value) noexcept = 0;
+		virtual void SetUniform(int32_t location, const glm::mat4& value) noexcept = 0;
+
+		//Texturas
+		virtual uint32_t CreateTexture2D(uint32_t internalFormat, int32_t width, int32_t height, int32_t levels) noexcept = 0;
+		virtual void TextureSubImage2D(uint32_t texture, int32_t width, int32_t height, uint32_t format, uint32_t type, const void* data) noexcept = 0;
+		virtual void SetTextureParameter(uint32_t texture, uint32_t parameter, int32_t value) noexcept = 0;
+		virtual void GenerateMipmaps(uint32_t texture) noexcept = 0;
+
+		//Estado del framebuffer y consultas
+		virtual void Clear(uint32_t mask) noexcept = 0;
+		virtual void SetViewport(int32_t x, int32_t y, int32_t width, int32_t height) noexcept = 0;
+		virtual void SetLineWidth(float width) noexcept = 0;
+		virtual void GetIntegerv(uint32_t parameter, int32_t* values) noexcept = 0;
+
+		//Llamados de dibujo
+		virtual void DrawArrays(uint32_t mode, int32_t first, int32_t count) noexcept = 0;
+		/*
+		* indexOffset es el offset en bytes dentro del buffer de indices del VAO enlazado.
+		*/
+		virtual void DrawElements(uint32_t mode, int32_t count, uint32_t indexType, size_t indexOffset, int32_t instanceCount) noexcept = 0;
+		/*
+		* Lee drawCount comandos desde el buffer enlazado a GL_DRAW_INDIRECT_BUFFER, a partir de indirectOffset.
+		*/
+		virtual void MultiDrawElementsIndirect(uint32_t mode, uint32_t indexType, size_t indirectOffset, int32_t drawCount, int32_t stride) noexcept = 0;
+
+		//Sincronizacion
+		virtual void* CreateFence() noexcept = 0;
+		/*
+		* Bloquea hasta que la GPU complete los comandos anteriores al fence. Retorna falso si la espera fallo.
+		*/
+		virtual bool WaitFence(void* fence) noexcept = 0;
+		virtual void DeleteFence(void* fence) noexcept = 0;
+	};
+
+	/*
+	* Implementacion que reenvia cada llamado a OpenGL, es la usada por el motor.
+	*/
+	class OpenGLRenderBackend : public RenderBackend {
+	public:
+		virtual void BeginFrame() noexcept override {}
+		virtual void UseProgram(uint32_t program) noexcept override;
+		virtual void BindVertexArray(uint32_t vertexArray) noexcept override;
+		virtual void BindBuffer(uint32_t target, uint32_t buffer) noexcept override;
+		virtual void BindBufferBase(uint32_t target, uint32_t index, uint32_t buffer) noexcept override;
+		virtual void BindBufferRange(uint32_t target, uint32_t index, uint32_t buffer, size_t offset, size_t size) noexcept override;
+		virtual void BindTextureUnit(uint32_t unit, uint32_t texture) noexcept override;
+		virtual void SetCapability(uint32_t capability, bool enabled) noexcept override;
+		virtual void DeleteProgram(uint32_t program) noexcept override;
+		virtual void DeleteVertexArray(uint32_t vertexArray) noexcept override;
+		virtual void DeleteBuffer(uint32_t buffer) noexcept override;
+		virtual void DeleteTexture(uint32_t texture) noexcept override;
+		virtual uint32_t CreateBuffer(size_t size, const void* data, uint32_t storageFlags) noexcept override;
+		virtual void BufferSubData(uint32_t buffer, size_t offset, size_t size, const void* data) noexcept override;
+		virtual void GetBufferSubData(uint32_t buffer, size_t offset, size_t size, void* data) noexcept override;
+		virtual void CopyBufferSubData(uint32_t source, uint32_t destination, size_t sourceOffset, size_t destinationOffset, size_t size) noexcept override;
+		virtual void* MapBufferRange(uint32_t buffer, size_t offset, size_t size, uint32_t access) noexcept override;
+		virtual void UnmapBuffer(uint32_t buffer) noexcept override;
+		virtual void MappedRangeWritten(uint32_t, size_t, size_t) noexcept override {}
+		virtual uint32_t CreateVertexArray() noexcept override;
+		virtual void SetVertexAttribute(uint32_t vertexArray, uint32_t location, int32_t componentCount, uint32_t type, bool normalized,
+			bool integer, uint32_t relativeOffset, uint32_t bindingIndex) noexcept override;
+		virtual void SetVertexBuffer(uint32_t vertexArray, uint32_t bindingIndex, uint32_t buffer, size_t offset, uint32_t stride) noexcept override;
+		virtual void SetVertexBindingDivisor(uint32_t vertexArray, uint32_t bindingIndex, uint32_t divisor) noexcept override;
+		virtual void SetElementBuffer(uint32_t vertexArray, uint32_t buffer) noexcept override;
+		virtual uint32_t CreateProgram(const std::string& vertexCode, const std::string& pixelCode, std::string& errorLog) noexcept override;
+		virtual void SetUniform(int32_t location, int32_t value) noexcept override;
+		virtual void SetUniform(int32_t location, float value) noexcept override;
+		virtual void SetUniform(int32_t location, const glm::vec3& value) noexcept override;
+		virtual void SetUniform(int32_t location, const glm::mat4& value) noexcept override;
+		virtual uint32_t CreateTexture2D(uint32_t internalFormat, int32_t width, int32_t height, int32_t levels) noexcept override;
+		virtual void TextureSubImage2D(uint32_t texture, int32_t width, int32_t height, uint32_t format, uint32_t type, const void* data) noexcept override;
+		virtual void SetTextureParameter(uint32_t texture, uint32_t parameter, int32_t value) noexcept override;
+		virtual void GenerateMipmaps(uint32_t texture) noexcept override;
+		virtual void Clear(uint32_t mask) noexcept override;
+		virtual void SetViewport(int32_t x, int32_t y, int32_t width, int32_t height) noexcept override;
+		virtual void SetLineWidth(float width) noexcept override;
+		virtual void GetIntegerv(uint32_t parameter, int32_t* values) noexcept override;
+		virtual void DrawArrays(uint32_t mode, int32_t first, int32_t count) noexcept override;
+		virtual void DrawElements(uint32_t mode, int32_t count, uint32_t indexType, size_t indexOffset, int32_t instanceCount) noexcept override;
+		virtual void MultiDrawElementsIndirect(uint32_t mode, uint32_t indexType, size_t indirectOffset, int32_t drawCount, int32_t stride) noexcept override;
+		virtual void* CreateFence() noexcept override;
+		virtual bool WaitFence(void* fence) noexcept override;
+		virtual void DeleteFence(void* fence) noexcept override;
+	private:
+		uint32_t CompileShader(const std::string& code, uint32_t type, std::string& errorLog) noexcept;
+	};
+}
+#endif
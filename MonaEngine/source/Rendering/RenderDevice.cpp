@@ -0,0 +1,210 @@
+#include "RenderDevice.hpp"
+#include <glad/glad.h>
+namespace Mona {
+
+	RenderDevice::RenderDevice(RenderBackend& backend) noexcept : m_backend(&backend) {
+		Invalidate();
+	}
+
+	static OpenGLRenderBackend& GetOpenGLRenderBackend() noexcept {
+		static OpenGLRenderBackend backend;
+		return backend;
+	}
+
+	RenderDevice& RenderDevice::GetInstance() noexcept {
+		static RenderDevice instance(GetOpenGLRenderBackend());
+		return instance;
+	}
+
+	void RenderDevice::SetBackend(RenderBackend& backend) noexcept {
+		m_backend = &backend;
+		Invalidate();
+	}
+
+	void RenderDevice::ResetBackend() noexcept {
+		SetBackend(GetOpenGLRenderBackend());
+	}
+
+	void RenderDevice::Invalidate() noexcept {
+		m_program = s_unknown;
+		m_vertexArray = s_unknown;
+		m_buffers.fill(s_unknown);
+		m_uniformBindings.fill({ s_unknown, 0, 0 });
+		m_storageBindings.fill({ s_unknown, 0, 0 });
+		m_textures.fill(s_unknown);
+		m_capabilities.fill(s_unknown);
+	}
+
+	RenderDevice::BufferTarget RenderDevice::GetBufferTarget(uint32_t target) noexcept {
+		switch (target) {
+		case GL_ARRAY_BUFFER:
+			return BufferTarget::Array;
+		case GL_ELEMENT_ARRAY_BUFFER:
+			return BufferTarget::ElementArray;
+		case GL_UNIFORM_BUFFER:
+			return BufferTarget::Uniform;
+		case GL_SHADER_STORAGE_BUFFER:
+			return BufferTarget::ShaderStorage;
+		case GL_DRAW_INDIRECT_BUFFER:
+			return BufferTarget::DrawIndirect;
+		default:
+			return BufferTarget::Untracked;
+		}
+	}
+
+	RenderDevice::Capability RenderDevice::GetCapability(uint32_t capability) noexcept {
+		switch (capability) {
+		case GL_DEPTH_TEST:
+			return Capability::DepthTest;
+		case GL_CULL_FACE:
+			return Capability::CullFace;
+		case GL_BLEND:
+			return Capability::Blend;
+		case GL_SCISSOR_TEST:
+			return Capability::ScissorTest;
+		default:
+			return Capability::Untracked;
+		}
+	}
+
+	RenderDevice::IndexedBinding* RenderDevice::GetIndexedBinding(BufferTarget target, uint32_t index) noexcept {
+		if (index >= s_maxIndexedBindings)
+			return nullptr;
+		if (target == BufferTarget::Uniform)
+			return &m_uniformBindings[index];
+		if (target == BufferTarget::ShaderStorage)
+			return &m_storageBindings[index];
+		return nullptr;
+	}
+
+	void RenderDevice::UseProgram(uint32_t program) noexcept {
+		if (program == m_program) {
+			m_statistics.programBindsAvoided++;
+			return;
+		}
+		m_program = program;
+		m_backend->UseProgram(program);
+		m_statistics.programBinds++;
+	}
+
+	void RenderDevice::BindVertexArray(uint32_t vertexArray) noexcept {
+		if (vertexArray == m_vertexArray) {
+			m_statistics.vertexArrayBindsAvoided++;
+			return;
+		}
+		m_vertexArray = vertexArray;
+		m_buffers[static_cast<size_t>(BufferTarget::ElementArray)] = s_unknown;
+		m_backend->BindVertexArray(vertexArray);
+		m_statistics.vertexArrayBinds++;
+	}
+
+	void RenderDevice::BindBuffer(uint32_t target, uint32_t buffer) noexcept {
+		const BufferTarget bufferTarget = GetBufferTarget(target);
+		if (bufferTarget != BufferTarget::Untracked) {
+			uint32_t& current = m_buffers[static_cast<size_t>(bufferTarget)];
+			if (current == buffer) {
+				m_statistics.bufferBindsAvoided++;
+				return;
+			}
+			current = buffer;
+		}
+		m_backend->BindBuffer(target, buffer);
+		m_statistics.bufferBinds++;
+	}
+
+	void RenderDevice::BindBufferBase(uint32_t target, uint32_t index, uint32_t buffer) noexcept {
+		const BufferTarget bufferTarget = GetBufferTarget(target);
+		IndexedBinding* binding = GetIndexedBinding(bufferTarget, index);
+		if (binding != nullptr) {
+			if (binding->buffer == buffer && binding->size == 0) {
+				m_statistics.bufferBindsAvoided++;
+				return;
+			}
+			*binding = { buffer, 0, 0 };
+		}
+		if (bufferTarget != BufferTarget::Untracked)
+			m_buffers[static_cast<size_t>(bufferTarget)] = buffer;
+		m_backend->BindBufferBase(target, index, buffer);
+		m_statistics.bufferBinds++;
+	}
+
+	void RenderDevice::BindBufferRange(uint32_t target, uint32_t index, uint32_t buffer, size_t offset, size_t size) noexcept {
+		const BufferTarget bufferTarget = GetBufferTarget(target);
+		IndexedBinding* binding = GetIndexedBinding(bufferTarget, index);
+		if (binding != nullptr) {
+			if (binding->buffer == buffer && binding->offset == offset && binding->size == size) {
+				m_statistics.bufferBindsAvoided++;
+				return;
+			}
+			*binding = { buffer, offset, size };
+		}
+		if (bufferTarget != BufferTarget::Untracked)
+			m_buffers[static_cast<size_t>(bufferTarget)] = buffer;
+		m_backend->BindBufferRange(target, index, buffer, offset, size);
+		m_statistics.bufferBinds++;
+	}
+
+	void RenderDevice::BindTextureUnit(uint32_t unit, uint32_t texture) noexcept {
+		if (unit < s_maxTextureUnits) {
+			if (m_textures[unit] == texture) {
+				m_statistics.textureBindsAvoided++;
+				return;
+			}
+			m_textures[unit] = texture;
+		}
+		m_backend->BindTextureUnit(unit, texture);
+		m_statistics.textureBinds++;
+	}
+
+	void RenderDevice::SetCapability(uint32_t capability, bool enabled) noexcept {
+		const Capability trackedCapability = GetCapability(capability);
+		if (trackedCapability != Capability::Untracked) {
+			uint32_t& current = m_capabilities[static_cast<size_t>(trackedCapability)];
+			if (current == static_cast<uint32_t>(enabled)) {
+				m_statistics.capabilityChangesAvoided++;
+				return;
+			}
+			current = static_cast<uint32_t>(enabled);
+		}
+		m_backend->SetCapability(capability, enabled);
+		m_statistics.capabilityChanges++;
+	}
+
+	void RenderDevice::DeleteProgram(uint32_t program) noexcept {
+		if (m_program == program)
+			m_program = s_unknown;
+		m_backend->DeleteProgram(program);
+	}
+
+	void RenderDevice::DeleteVertexArray(uint32_t vertexArray) noexcept {
+		if (m_vertexArray == vertexArray) {
+			m_vertexArray = s_unknown;
+			m_buffers[static_cast<size_t>(BufferTarget::ElementArray)] = s_unknown;
+		}
+		m_backend->DeleteVertexArray(vertexArray);
+	}
+
+	void RenderDevice::DeleteBuffer(uint32_t buffer) noexcept {
+		for (uint32_t& current : m_buffers) {
+			if (current == buffer)
+				current = s_unknown;
+		}
+		for (IndexedBinding& binding : m_uniformBindings) {
+			if (binding.buffer == buffer)
+				binding.buffer = s_unknown;
+		}
+		for (IndexedBinding& binding : m_storageBindings) {
+			if (binding.buffer == buffer)
+				binding.buffer = s_unknown;
+		}
+		m_backend->DeleteBuffer(buffer);
+	}
+
+	void RenderDevice::DeleteTexture(uint32_t texture) noexcept {
+		for (uint32_t& current : m_textures) {
+			if (current == texture)
+				current = s_unknown;
+		}
+		m_backend->DeleteTexture(texture);
+	}
+}
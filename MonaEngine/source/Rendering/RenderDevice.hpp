@@ -0,0 +1,202 @@
+#pragma once
+#ifndef RENDERDEVICE_HPP
+#define RENDERDEVICE_HPP
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include "RenderBackend.hpp"
+namespace Mona {
+	/*
+	* Contadores de RenderDevice desde el ultimo llamado a BeginFrame. Los campos Avoided cuentan los llamados que no llegaron
+	* al backend porque el estado pedido ya estaba activo.
+	*/
+	struct RenderDeviceStatistics {
+		uint32_t programBinds = 0;
+		uint32_t programBindsAvoided = 0;
+		uint32_t vertexArrayBinds = 0;
+		uint32_t vertexArrayBindsAvoided = 0;
+		uint32_t bufferBinds = 0;
+		uint32_t bufferBindsAvoided = 0;
+		uint32_t textureBinds = 0;
+		uint32_t textureBindsAvoided = 0;
+		uint32_t capabilityChanges = 0;
+		uint32_t capabilityChangesAvoided = 0;
+		uint32_t uniformUpdates = 0;
+		uint64_t uniformBytes = 0;
+	};
+
+	/*
+	* Capa delgada por la que pasan los cambios de estado de OpenGL del motor (programa, VAO, buffers, texturas y
+	* capacidades). Guarda una copia del estado activo y descarta los llamados que no lo cambian. Los destinos, puntos de
+	* enlace y capacidades que no se siguen se reenvian siempre al backend. Si codigo externo modifica el estado de OpenGL
+	* sin restaurarlo debe llamarse Invalidate.
+	*/
+	class RenderDevice {
+	public:
+		explicit RenderDevice(RenderBackend& backend) noexcept;
+		RenderDevice(const RenderDevice&) = delete;
+		RenderDevice& operator=(const RenderDevice&) = delete;
+		/*
+		* Dispositivo usado por el motor, por defecto con un backend de OpenGL.
+		*/
+		static RenderDevice& GetInstance() noexcept;
+		/*
+		* Cambia el backend que recibe los llamados y olvida el estado guardado.
+		*/
+		void SetBackend(RenderBackend& backend) noexcept;
+		/*
+		* Vuelve al backend de OpenGL usado por defecto.
+		*/
+		void ResetBackend() noexcept;
+		RenderBackend& GetBackend() const noexcept { return *m_backend; }
+		/*
+		* Olvida el estado guardado, el siguiente llamado de cada tipo llega siempre al backend.
+		*/
+		void Invalidate() noexcept;
+		/*
+		* Reinicia los contadores y avisa al backend, el renderer lo llama al comenzar cada frame.
+		*/
+		void BeginFrame() noexcept {
+			m_statistics = RenderDeviceStatistics();
+			m_backend->BeginFrame();
+		}
+		const RenderDeviceStatistics& GetStatistics() const noexcept { return m_statistics; }
+
+		void UseProgram(uint32_t program) noexcept;
+		/*
+		* El buffer de indices enlazado es parte del estado del VAO, por lo que al cambiar de VAO se olvida.
+		*/
+		void BindVertexArray(uint32_t vertexArray) noexcept;
+		void BindBuffer(uint32_t target, uint32_t buffer) noexcept;
+		/*
+		* Al igual que en OpenGL, enlazar a un punto de enlace indexado tambien enlaza el buffer al destino generico.
+		*/
+		void BindBufferBase(uint32_t target, uint32_t index, uint32_t buffer) noexcept;
+		void BindBufferRange(uint32_t target, uint32_t index, uint32_t buffer, size_t offset, size_t size) noexcept;
+		void BindTextureUnit(uint32_t unit, uint32_t texture) noexcept;
+		void Enable(uint32_t capability) noexcept { SetCapability(capability, true); }
+		void Disable(uint32_t capability) noexcept { SetCapability(capability, false); }
+		/*
+		* Los identificadores de objetos eliminados pueden ser reutilizados por OpenGL, por lo que se eliminan mediante el
+		* dispositivo para olvidar los enlaces que los referencian.
+		*/
+		void DeleteProgram(uint32_t program) noexcept;
+		void DeleteVertexArray(uint32_t vertexArray) noexcept;
+		void DeleteBuffer(uint32_t buffer) noexcept;
+		void DeleteTexture(uint32_t texture) noexcept;
+
+		/*
+		* Los siguientes llamados no dependen del estado guardado ni lo modifican, por lo que se reenvian directamente al
+		* backend. Ver RenderBackend para el significado de cada parametro.
+		*/
+		uint32_t CreateBuffer(size_t size, const void* data, uint32_t storageFlags) noexcept { return m_backend->CreateBuffer(size, data, storageFlags); }
+		void BufferSubData(uint32_t buffer, size_t offset, size_t size, const void* data) noexcept { m_backend->BufferSubData(buffer, offset, size, data); }
+		void GetBufferSubData(uint32_t buffer, size_t offset, size_t size, void* data) noexcept { m_backend->GetBufferSubData(buffer, offset, size, data); }
+		void CopyBufferSubData(uint32_t source, uint32_t destination, size_t sourceOffset, size_t destinationOffset, size_t size) noexcept {
+			m_backend->CopyBufferSubData(source, destination, sourceOffset, destinationOffset, size);
+		}
+		void* MapBufferRange(uint32_t buffer, size_t offset, size_t size, uint32_t access) noexcept { return m_backend->MapBufferRange(buffer, offset, size, access); }
+		void UnmapBuffer(uint32_t buffer) noexcept { m_backend->UnmapBuffer(buffer); }
+		void MappedRangeWritten(uint32_t buffer, size_t offset, size_t size) noexcept { m_backend->MappedRangeWritten(buffer, offset, size); }
+		uint32_t CreateVertexArray() noexcept { return m_backend->CreateVertexArray(); }
+		void SetVertexAttribute(uint32_t vertexArray, uint32_t location, int32_t componentCount, uint32_t type, bool normalized, bool integer,
+			uint32_t relativeOffset, uint32_t bindingIndex) noexcept {
+			m_backend->SetVertexAttribute(vertexArray, location, componentCount, type, normalized, integer, relativeOffset, bindingIndex);
+		}
+		void SetVertexBuffer(uint32_t vertexArray, uint32_t bindingIndex, uint32_t buffer, size_t offset, uint32_t stride) noexcept {
+			m_backend->SetVertexBuffer(vertexArray, bindingIndex, buffer, offset, stride);
+		}
+		void SetVertexBindingDivisor(uint32_t vertexArray, uint32_t bindingIndex, uint32_t divisor) noexcept {
+			m_backend->SetVertexBindingDivisor(vertexArray, bindingIndex, divisor);
+		}
+		void SetElementBuffer(uint32_t vertexArray, uint32_t buffer) noexcept { m_backend->SetElementBuffer(vertexArray, buffer); }
+		uint32_t CreateProgram(const std::string& vertexCode, const std::string& pixelCode, std::string& errorLog) noexcept {
+			return m_backend->CreateProgram(vertexCode, pixelCode, errorLog);
+		}
+		void SetUniform(int32_t location, int32_t value) noexcept {
+			CountUniform(sizeof(value));
+			m_backend->SetUniform(location, value);
+		}
+		void SetUniform(int32_t location, float value) noexcept {
+			CountUniform(sizeof(value));
+			m_backend->SetUniform(location, value);
+		}
+		void SetUniform(int32_t location, const glm::vec3& value) noexcept {
+			CountUniform(sizeof(value));
+			m_backend->SetUniform(location, value);
+		}
+		void SetUniform(int32_t location, const glm::mat4& value) noexcept {
+			CountUniform(sizeof(value));
+			m_backend->SetUniform(location, value);
+		}
+		uint32_t CreateTexture2D(uint32_t internalFormat, int32_t width, int32_t height, int32_t levels) noexcept {
+			return m_backend->CreateTexture2D(internalFormat, width, height, levels);
+		}
+		void TextureSubImage2D(uint32_t texture, int32_t width, int32_t height, uint32_t format, uint32_t type, const void* data) noexcept {
+			m_backend->TextureSubImage2D(texture, width, height, format, type, data);
+		}
+		void SetTextureParameter(uint32_t texture, uint32_t parameter, int32_t value) noexcept { m_backend->SetTextureParameter(texture, parameter, value); }
+		void GenerateMipmaps(uint32_t texture) noexcept { m_backend->GenerateMipmaps(texture); }
+		void Clear(uint32_t mask) noexcept { m_backend->Clear(mask); }
+		void SetViewport(int32_t x, int32_t y, int32_t width, int32_t height) noexcept { m_backend->SetViewport(x, y, width, height); }
+		void SetLineWidth(float width) noexcept { m_backend->SetLineWidth(width); }
+		void GetIntegerv(uint32_t parameter, int32_t* values) noexcept { m_backend->GetIntegerv(parameter, values); }
+		void DrawArrays(uint32_t mode, int32_t first, int32_t count) noexcept { m_backend->DrawArrays(mode, first, count); }
+		void DrawElements(uint32_t mode, int32_t count, uint32_t indexType, size_t indexOffset, int32_t instanceCount = 1) noexcept {
+			m_backend->DrawElements(mode, count, indexType, indexOffset, instanceCount);
+		}
+		void MultiDrawElementsIndirect(uint32_t mode, uint32_t indexType, size_t indirectOffset, int32_t drawCount, int32_t stride) noexcept {
+			m_backend->MultiDrawElementsIndirect(mode, indexType, indirectOffset, drawCount, stride);
+		}
+		void* CreateFence() noexcept { return m_backend->CreateFence(); }
+		bool WaitFence(void* fence) noexcept { return m_backend->WaitFence(fence); }
+		void DeleteFence(void* fence) noexcept { m_backend->DeleteFence(fence); }
+
+		static constexpr uint32_t s_maxIndexedBindings = 16;
+		static constexpr uint32_t s_maxTextureUnits = 32;
+	private:
+		void SetCapability(uint32_t capability, bool enabled) noexcept;
+		void CountUniform(size_t size) noexcept {
+			m_statistics.uniformUpdates++;
+			m_statistics.uniformBytes += size;
+		}
+		static constexpr uint32_t s_unknown = UINT32_MAX;
+		enum class BufferTarget : uint8_t {
+			Array,
+			ElementArray,
+			Uniform,
+			ShaderStorage,
+			DrawIndirect,
+			TargetCount,
+			Untracked = TargetCount
+		};
+		enum class Capability : uint8_t {
+			DepthTest,
+			CullFace,
+			Blend,
+			ScissorTest,
+			CapabilityCount,
+			Untracked = CapabilityCount
+		};
+		struct IndexedBinding {
+			uint32_t buffer;
+			size_t offset;
+			//Cero para enlaces hechos con BindBufferBase.
+			size_t size;
+		};
+		static BufferTarget GetBufferTarget(uint32_t target) noexcept;
+		static Capability GetCapability(uint32_t capability) noexcept;
+		IndexedBinding* GetIndexedBinding(BufferTarget target, uint32_t index) noexcept;
+		RenderBackend* m_backend;
+		RenderDeviceStatistics m_statistics;
+		uint32_t m_program;
+		uint32_t m_vertexArray;
+		std::array<uint32_t, static_cast<size_t>(BufferTarget::TargetCount)> m_buffers;
+		std::array<IndexedBinding, s_maxIndexedBindings> m_uniformBindings;
+		std::array<IndexedBinding, s_maxIndexedBindings> m_storageBindings;
+		std::array<uint32_t, s_maxTextureUnits> m_textures;
+		//0 desactivada, 1 activada y s_unknown desconocido.
+		std::array<uint32_t, static_cast<size_t>(Capability::CapabilityCount)> m_capabilities;
+	};
+}
+#endif
@@ -0,0 +1,80 @@
+#include "RenderQueue.hpp"
+#include <array>
+#include <algorithm>
+namespace Mona {
+
+	void RenderQueue::Reserve(uint32_t count) {
+		m_items.reserve(count);
+		m_entries.reserve(count);
+		m_sortBuffer.reserve(count);
+	}
+
+	void RenderQueue::Clear() noexcept {
+		m_items.clear();
+		m_entries.clear();
+		for (uint32_t meshID : m_usedMeshIDs)
+			m_meshSortIndices[meshID] = 0;
+		m_usedMeshIDs.clear();
+	}
+
+	uint32_t RenderQueue::GetMeshSortIndex(uint32_t meshID) noexcept {
+		if (meshID >= m_meshSortIndices.size())
+			m_meshSortIndices.resize(static_cast<size_t>(meshID) + 1, 0);
+		uint32_t& sortIndex = m_meshSortIndices[meshID];
+		if (sortIndex == 0) {
+			m_usedMeshIDs.push_back(meshID);
+			sortIndex = static_cast<uint32_t>(m_usedMeshIDs.size());
+		}
+		return sortIndex - 1;
+	}
+
+	uint64_t RenderQueue::MakeSortKey(RenderPass pass, uint8_t shaderIndex, uint32_t materialIndex, uint32_t meshIndex, float normalizedDepth) noexcept {
+		constexpr uint32_t maxDepth = (1u << 24) - 1;
+		const uint64_t depth = static_cast<uint64_t>(std::clamp(normalizedDepth, 0.0f, 1.0f) * static_cast<float>(maxDepth));
+		return (static_cast<uint64_t>(pass) & 0x3) << 62 |
+			(static_cast<uint64_t>(shaderIndex) & 0x3F) << 56 |
+			(static_cast<uint64_t>(materialIndex) & 0xFFFF) << 40 |
+			(static_cast<uint64_t>(meshIndex) & 0xFFFF) << 24 |
+			depth;
+	}
+
+	void RenderQueue::Push(const RenderItem& item, RenderPass pass, uint8_t shaderIndex, float normalizedDepth) noexcept {
+		const uint64_t key = MakeSortKey(pass, shaderIndex, item.materialIndex, GetMeshSortIndex(item.meshID), normalizedDepth);
+		m_entries.push_back({ key, static_cast<uint32_t>(m_items.size()) });
+		m_items.push_back(item);
+	}
+
+	void RenderQueue::Sort() noexcept {
+		const size_t count = m_entries.size();
+		if (count < 2)
+			return;
+		//Radix sort LSD de 8 pasadas de 8 bits. Los histogramas de todas las pasadas se calculan en un unico recorrido y
+		//se omiten las pasadas en que todas las llaves comparten el mismo byte.
+		std::array<std::array<uint32_t, 256>, 8> histograms = {};
+		for (const SortEntry& entry : m_entries) {
+			for (uint32_t pass = 0; pass < 8; pass++)
+				histograms[pass][(entry.key >> (pass * 8)) & 0xFF]++;
+		}
+		m_sortBuffer.resize(count);
+		std::vector<SortEntry>* source = &m_entries;
+		std::vector<SortEntry>* destination = &m_sortBuffer;
+		for (uint32_t pass = 0; pass < 8; pass++) {
+			auto& histogram = histograms[pass];
+			const uint32_t firstByte = ((*source)[0].key >> (pass * 8)) & 0xFF;
+			if (histogram[firstByte] == count)
+				continue;
+			uint32_t offset = 0;
+			for (uint32_t& bucket : histogram) {
+				const uint32_t bucketCount = bucket;
+				bucket = offset;
+				offset += bucketCount;
+			}
+			for (const SortEntry& entry : *source) {
+				(*destination)[histogram[(entry.key >> (pass * 8)) & 0xFF]++] = entry;
+			}
+			std::swap(source, destination);
+		}
+		if (source != &m_entries)
+			m_entries.swap(m_sortBuffer);
+	}
+}
@@ -0,0 +1,115 @@
+#pragma once
+#ifndef RENDERQUEUE_HPP
+#define RENDERQUEUE_HPP
+#include <vector>
+#include <cstdint>
+#include <glm/glm.hpp>
+namespace Mona {
+	class Material;
+	class SkeletalMeshComponent;
+
+	enum class RenderPass : uint8_t {
+		Opaque,
+		PassCount
+	};
+
+	/*
+	* Informacion necesaria para emitir un llamado de dibujo. skeletalMesh es nulo para mallas estaticas, en caso contrario
+	* paletteOffset indica la posicion de su paleta de matrices dentro de las paletas del frame. Las mallas estaticas comparten
+	* VAO, por lo que meshID identifica la malla y firstIndex y baseVertex ubican su geometria en los buffers compartidos.
+	* indexType es GL_UNSIGNED_SHORT o GL_UNSIGNED_INT segun el buffer de indices de la malla. Si clusterRangeCount es mayor
+	* a cero, en lugar de [firstIndex, firstIndex + indexCount) se dibujan los rangos de indices de los grupos de triangulos
+	* visibles, ubicados a partir de firstClusterRange en los rangos del frame del renderer. modelInverseTransposeMatrix
+	* apunta a la inversa transpuesta ya calculada de modelMatrix, o es nulo para calcularla al escribir los datos por objeto.
+	* materialIndex es la entrada del material en la tabla de materiales del frame (ver MaterialTable).
+	*/
+	struct RenderItem {
+		Material* material;
+		uint32_t materialIndex;
+		SkeletalMeshComponent* skeletalMesh;
+		uint32_t vertexArrayID;
+		uint32_t meshID;
+		uint32_t indexCount;
+		uint32_t indexType;
+		uint32_t firstIndex;
+		int32_t baseVertex;
+		uint32_t paletteOffset;
+		glm::mat4 modelMatrix;
+		const glm::mat4* modelInverseTransposeMatrix;
+		uint32_t firstClusterRange;
+		uint32_t clusterRangeCount;
+	};
+
+	/*
+	* Contadores de la ultima llamada a Renderer::Render. Los campos Avoided cuentan los cambios de estado que no fue necesario
+	* realizar gracias al orden de la cola. submittedCount y culledCount cuentan los objetos que pasaron o no la prueba contra
+	* el frustum de la camara, occludedCount los que estando dentro del frustum fueron descartados por oclusion, incluyendo
+	* los pvsCulledCount descartados por el conjunto de objetos potencialmente visibles. clusterCount cuenta los grupos de
+	* triangulos probados y clusterCulledCount los descartados, los objetos con todos sus grupos descartados no se cuentan
+	* en submittedCount. drawCount cuenta llamados a OpenGL, un llamado a glMultiDrawElementsIndirect cuenta como uno y sus
+	* comandos se cuentan en indirectCommandCount. Los parametros de los materiales se leen desde la tabla de materiales, por
+	* lo que materialBinds solo cuenta los cambios de texturas de material.
+	*/
+	struct RenderQueueStatistics {
+		uint32_t drawCount = 0;
+		uint32_t multiDrawCount = 0;
+		uint32_t indirectCommandCount = 0;
+		uint32_t programBinds = 0;
+		uint32_t programBindsAvoided = 0;
+		uint32_t vertexArrayBinds = 0;
+		uint32_t vertexArrayBindsAvoided = 0;
+		uint32_t materialBinds = 0;
+		uint32_t materialBindsAvoided = 0;
+		uint32_t instancedDrawCount = 0;
+		uint32_t instanceCount = 0;
+		uint32_t submittedCount = 0;
+		uint32_t culledCount = 0;
+		uint32_t occludedCount = 0;
+		uint32_t pvsCulledCount = 0;
+		uint32_t clusterCount = 0;
+		uint32_t clusterCulledCount = 0;
+	};
+
+	/*
+	* Cola de llamados de dibujo de un frame. Cada elemento recibe una llave de 64 bits con el siguiente formato (del bit mas
+	* significativo al menos significativo): pase (2 bits), shader (6 bits), entrada en la tabla de materiales (16 bits), malla
+	* (16 bits) y profundidad (24 bits). En lugar de meshID la llave guarda un indice denso asignado en el orden en que cada
+	* malla aparece por primera vez desde el ultimo Clear, por lo que mallas con identificadores grandes no se confunden. Al
+	* ordenar por esta llave los elementos que comparten shader, parametros de material y malla quedan contiguos, y dentro de
+	* cada grupo se dibujan de adelante hacia atras.
+	*/
+	class RenderQueue {
+	public:
+		RenderQueue() = default;
+		void Reserve(uint32_t count);
+		void Clear() noexcept;
+		/*
+		* Agrega un elemento a la cola, normalizedDepth es la distancia a la camara normalizada al rango [0,1].
+		*/
+		void Push(const RenderItem& item, RenderPass pass, uint8_t shaderIndex, float normalizedDepth) noexcept;
+		/*
+		* Ordena los elementos de la cola segun su llave usando radix sort.
+		*/
+		void Sort() noexcept;
+		uint32_t GetCount() const noexcept { return static_cast<uint32_t>(m_entries.size()); }
+		/*
+		* Retorna el i-esimo elemento segun el orden calculado por Sort.
+		*/
+		const RenderItem& GetSortedItem(uint32_t index) const noexcept { return m_items[m_entries[index].itemIndex]; }
+		uint64_t GetSortedKey(uint32_t index) const noexcept { return m_entries[index].key; }
+		static uint64_t MakeSortKey(RenderPass pass, uint8_t shaderIndex, uint32_t materialIndex, uint32_t meshIndex, float normalizedDepth) noexcept;
+	private:
+		uint32_t GetMeshSortIndex(uint32_t meshID) noexcept;
+		struct SortEntry {
+			uint64_t key;
+			uint32_t itemIndex;
+		};
+		std::vector<RenderItem> m_items;
+		std::vector<SortEntry> m_entries;
+		std::vector<SortEntry> m_sortBuffer;
+		//Indice denso mas uno de cada meshID usado desde el ultimo Clear (cero si no se ha usado), y los meshID usados.
+		std::vector<uint32_t> m_meshSortIndices;
+		std::vector<uint32_t> m_usedMeshIDs;
+	};
+}
+#endif
@@ -0,0 +1,44 @@
+#pragma once
+#ifndef RENDERSTATISTICS_HPP
+#define RENDERSTATISTICS_HPP
+#include <cstdint>
+namespace Mona {
+	/*
+	* Contadores del ultimo llamado a Renderer::Render, sin incluir el dibujo de depuracion. drawCalls cuenta llamados a
+	* OpenGL (un glMultiDrawElementsIndirect cuenta como uno), mientras que triangles e instances suman lo dibujado por cada
+	* comando. Los enlaces cuentan solo los cambios de estado que llegaron al backend (ver RenderDevice). uniformBytes cuenta
+	* las uniformes de programa, uniformBufferBytes los bloques de camara y luces, y storageBufferBytes los datos por objeto,
+	* las paletas de skinning y las luces por cluster escritos en los buffers mapeados. De los objetos probados que no se
+	* dibujaron, frustumCulledCount cuenta los que quedaron fuera del frustum, pvsCulledCount los descartados por el conjunto
+	* de objetos potencialmente visibles, occludedCount los ocultos por los oclusores y clusterCulledObjectCount los que
+	* tenian todos sus grupos de triangulos descartados. Se suben las paletas de todas las mallas animadas, sean visibles o no. patchedStaticMeshCount cuenta las mallas estaticas cuya transformacion o
+	* material cambio, y drawListsReused indica que se reutilizo la cola del frame anterior sin descartar ni ordenar.
+	* materialCount cuenta las entradas de la tabla de materiales y mergedMaterialCount los materiales que compartieron la
+	* entrada de otro con iguales parametros.
+	*/
+	struct RenderStatistics {
+		uint32_t drawCalls = 0;
+		uint64_t triangles = 0;
+		uint32_t instances = 0;
+		uint32_t programBinds = 0;
+		uint32_t vertexArrayBinds = 0;
+		uint32_t textureBinds = 0;
+		uint32_t uniformUpdates = 0;
+		uint64_t uniformBytes = 0;
+		uint64_t uniformBufferBytes = 0;
+		uint64_t storageBufferBytes = 0;
+		uint64_t indirectCommandBytes = 0;
+		uint32_t submittedCount = 0;
+		uint32_t frustumCulledCount = 0;
+		uint32_t pvsCulledCount = 0;
+		uint32_t occludedCount = 0;
+		uint32_t clusterCulledObjectCount = 0;
+		uint32_t skinningPalettes = 0;
+		uint64_t skinningPaletteBytes = 0;
+		uint32_t patchedStaticMeshCount = 0;
+		bool drawListsReused = false;
+		uint32_t materialCount = 0;
+		uint32_t mergedMaterialCount = 0;
+	};
+}
+#endif
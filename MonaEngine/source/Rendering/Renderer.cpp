@@ -6,10 +6,20 @@
 #include <GLFW/glfw3.h>
 #include <glm/glm.hpp>
 #include <glm/gtc/type_ptr.hpp>
+#include <algorithm>
+#include <cstring>
+#include <map>
+#include <numeric>
+#include <tuple>
+#include <thread>
 #include "../Core/Log.hpp"
+#include "../Core/Config.hpp"
 #include "../Core/RootDirectory.hpp"
 #include "../DebugDrawing/DebugDrawingSystem.hpp"
 #include "Mesh.hpp"
+#include "MeshManager.hpp"
+#include "RenderDevice.hpp"
+#include "StaticMeshLifetimePolicy.hpp"
 #include "../Animation/SkinnedMesh.hpp"
 #include "UnlitFlatMaterial.hpp"
 #include "UnlitTexturedMaterial.hpp"
@@ -49,24 +59,101 @@ namespace Mona{
 		//del framebuffer al que OpenGL renderiza.
 		eventManager.Subscribe(m_onWindowResizeSubscription, this, &Renderer::OnWindowResizeEvent);
 		m_debugDrawingSystemPtr = debugDrawingSystemPtr;
-		m_currentMatrixPalette.resize(NUM_MAX_BONES, glm::mat4(1.0f));
-		glEnable(GL_DEPTH_TEST);
+		RenderDevice& device = RenderDevice::GetInstance();
+		device.Enable(GL_DEPTH_TEST);
 
 		//Se genera el buffer que contendra toda la informacin lumnica de la escena
-		glGenBuffers(1, &m_lightDataUBO);
-		glBindBuffer(GL_UNIFORM_BUFFER, m_lightDataUBO);
-		glBufferData(GL_UNIFORM_BUFFER, sizeof(Lights), NULL, GL_DYNAMIC_DRAW);
-		glBindBuffer(GL_UNIFORM_BUFFER, 0);
-		glBindBufferBase(GL_UNIFORM_BUFFER, 0, m_lightDataUBO);
+		m_lightDataUBO = device.CreateBuffer(sizeof(Lights), nullptr, GL_DYNAMIC_STORAGE_BIT);
+		device.BindBufferBase(GL_UNIFORM_BUFFER, 0, m_lightDataUBO);
+
+		//Buffer con la matriz de vista y proyeccion y la posicion de la camara, se actualiza una vez por frame.
+		m_cameraDataUBO = device.CreateBuffer(sizeof(CameraData), nullptr, GL_DYNAMIC_STORAGE_BIT);
+		device.BindBufferBase(GL_UNIFORM_BUFFER, ShaderProgram::CameraUniformBlockBinding, m_cameraDataUBO);
+
+		//Buffer con las matrices de cada objeto, crece segun sea necesario.
+		Config& config = Config::GetInstance();
+		const int expectedDrawCount = config.getValueOrDefault<int>("expected_number_of_draws", 1024);
+		m_drawDataRing.StartUp(GL_SHADER_STORAGE_BUFFER, static_cast<size_t>(std::max(1, expectedDrawCount)) * sizeof(DrawData));
+		//Tabla con los parametros de los materiales distintos dibujados en el frame.
+		const int expectedMaterialCount = config.getValueOrDefault<int>("expected_number_of_materials", 64);
+		m_materialDataRing.StartUp(GL_SHADER_STORAGE_BUFFER, static_cast<size_t>(std::max(1, expectedMaterialCount)) * sizeof(MaterialParameters));
+		//Comandos de dibujo indirecto de las mallas estaticas, construidos en CPU cada frame.
+		m_drawCommandRing.StartUp(GL_DRAW_INDIRECT_BUFFER, static_cast<size_t>(std::max(1, expectedDrawCount)) * sizeof(DrawElementsIndirectCommand));
+		EnsureDrawIndexCapacity(static_cast<uint32_t>(std::max(1, expectedDrawCount)));
+		//Paletas de skinning de las mallas animadas, sin limite de huesos por esqueleto.
+		m_skinningPaletteFormat = GetSkinningPaletteFormat();
+		const int expectedSkinningMatrices = config.getValueOrDefault<int>("expected_number_of_skinning_matrices", 4096);
+		m_skinningPaletteRing.StartUp(GL_SHADER_STORAGE_BUFFER,
+			static_cast<size_t>(std::max(1, expectedSkinningMatrices)) * GetSkinningPaletteStride(m_skinningPaletteFormat));
+
+		//Buffer con las luces puntuales, spotlights y su asignacion a clusters. La asignacion se reparte entre varios hilos.
+		const int defaultLightCullingJobs = static_cast<int>(std::clamp(std::thread::hardware_concurrency(), 1u, 4u));
+		m_lightClusterGrid.StartUp(static_cast<uint32_t>(std::max(1, config.getValueOrDefault<int>("light_culling_jobs", defaultLightCullingJobs))));
+		m_lightDataRing.StartUp(GL_SHADER_STORAGE_BUFFER, LightClusterGrid::s_clusterCount * (sizeof(ClusterLightRange) + 8 * sizeof(uint32_t)));
+		//Buffer de profundidad de baja resolucion del descarte por oclusion, rasterizado en CPU por bandas en varios hilos.
+		m_occlusionCullingEnabled = config.getValueOrDefault<int>("occlusion_culling", 1) != 0;
+		m_occlusionCuller.StartUp(static_cast<uint32_t>(std::max(8, config.getValueOrDefault<int>("occlusion_buffer_width", 256))),
+			static_cast<uint32_t>(std::max(8, config.getValueOrDefault<int>("occlusion_buffer_height", 128))),
+			static_cast<uint32_t>(std::max(1, config.getValueOrDefault<int>("occlusion_culling_jobs", defaultLightCullingJobs))));
+		//Descarte por grupos de triangulos (frustum y cono de normales) de las mallas estaticas divididas al importarlas.
+		m_clusterCullingEnabled = config.getValueOrDefault<int>("cluster_culling", 1) != 0;
+		GLint viewport[4];
+		device.GetIntegerv(GL_VIEWPORT, viewport);
+		m_viewportSize = glm::ivec2(std::max(1, viewport[2]), std::max(1, viewport[3]));
+		//Seleccion de niveles de detalle de las mallas estaticas.
+		m_lodErrorThreshold = std::max(0.0f, config.getValueOrDefault<float>("lod_error_threshold_pixels", 1.0f));
+		m_lodHysteresis = std::clamp(config.getValueOrDefault<float>("lod_hysteresis", 0.2f), 0.0f, 0.9f);
 	}
 	void Renderer::ShutDown(EventManager& eventManager) noexcept {
 		eventManager.Unsubscribe(m_onWindowResizeSubscription);
-		glDeleteBuffers(1, &m_lightDataUBO);
+		RenderDevice& device = RenderDevice::GetInstance();
+		device.DeleteBuffer(m_lightDataUBO);
+		device.DeleteBuffer(m_cameraDataUBO);
+		m_drawDataRing.ShutDown();
+		m_materialDataRing.ShutDown();
+		m_drawCommandRing.ShutDown();
+		m_skinningPaletteRing.ShutDown();
+		m_lightDataRing.ShutDown();
+		device.DeleteBuffer(m_drawIndexBufferID);
+		m_drawIndexBufferID = 0;
+		m_drawIndexCapacity = 0;
+		//Los programas se liberan aqui, mientras el backend que los creo sigue activo.
+		for (ShaderProgram& shader : m_shaders)
+			shader = ShaderProgram();
 	}
 	void Renderer::OnWindowResizeEvent(const WindowResizeEvent& event) {
 		if (event.width == 0 || event.height == 0)
 			return;
-		glViewport(0, 0, event.width, event.height);
+		RenderDevice::GetInstance().SetViewport(0, 0, event.width, event.height);
+		m_viewportSize = glm::ivec2(event.width, event.height);
+		m_retainedDrawListsValid = false;
+	}
+
+	void Renderer::AddStaticMesh(const InnerComponentHandle& meshHandle, const InnerComponentHandle& transformHandle) noexcept {
+		if (meshHandle.m_index >= m_staticMeshEntryIndices.size())
+			m_staticMeshEntryIndices.resize(meshHandle.m_index + 1, s_invalidEntryIndex);
+		m_staticMeshEntryIndices[meshHandle.m_index] = static_cast<uint32_t>(m_staticMeshEntries.size());
+		//La version cero obliga a calcular sus matrices y caja en el siguiente frame.
+		StaticMeshEntry& entry = m_staticMeshEntries.emplace_back();
+		entry.meshHandle = meshHandle;
+		entry.transformHandle = transformHandle;
+		entry.transformVersion = 0;
+		m_staticMeshListChanged = true;
+	}
+
+	void Renderer::RemoveStaticMesh(const InnerComponentHandle& meshHandle, StaticMeshComponent& staticMesh) noexcept {
+		if (staticMesh.m_staticBatchIndex != StaticMeshComponent::s_invalidStaticBatchIndex)
+			RemoveFromStaticBatch(meshHandle, staticMesh);
+		//Al igual que en ComponentManager, la ultima entrada ocupa el lugar de la removida.
+		const uint32_t index = m_staticMeshEntryIndices[meshHandle.m_index];
+		MONA_ASSERT(index < m_staticMeshEntries.size(), "Renderer Error: Trying to remove an unknown static mesh.");
+		if (index + 1 < m_staticMeshEntries.size()) {
+			m_staticMeshEntries[index] = m_staticMeshEntries.back();
+			m_staticMeshEntryIndices[m_staticMeshEntries[index].meshHandle.m_index] = index;
+		}
+		m_staticMeshEntries.pop_back();
+		m_staticMeshEntryIndices[meshHandle.m_index] = s_invalidEntryIndex;
+		m_staticMeshListChanged = true;
 	}
 
 	void Renderer::Render(EventManager& eventManager,
@@ -80,10 +167,17 @@ namespace Mona{
 		ComponentManager<SpotLightComponent>& spotLightDataManager,
 		ComponentManager<PointLightComponent>& pointLightDataManager) noexcept
 	{
-		glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+		RenderDevice& device = RenderDevice::GetInstance();
+		device.BeginFrame();
+		device.Clear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+		m_renderStatistics = RenderStatistics();
 		glm::mat4 viewMatrix;
 		glm::mat4 projectionMatrix;
 		glm::vec3 cameraPosition = glm::vec3(0.0f);
+		float nearPlane = 0.1f;
+		float farPlane = 100.0f;
+		float fieldOfView = glm::radians(50.0f);
+		float aspectRatio = 16.0f / 9.0f;
 		if (cameraDataManager.IsValid(cameraHandle)) {
 			//Si el usuario configuro la camara principal configuramos apartir de esta la matriz de vista y projeccin
 			//viewMatrix y projectionMatrix respectivamente
@@ -93,12 +187,16 @@ namespace Mona{
 			viewMatrix = cameraTransform->GetViewMatrixFromTransform();
 			projectionMatrix = camera->GetProjectionMatrix();
 			cameraPosition = cameraTransform->GetLocalTranslation();
+			nearPlane = camera->GetZNearPlane();
+			farPlane = camera->GetZFarPlane();
+			fieldOfView = glm::radians(camera->GetFieldOfView());
+			aspectRatio = camera->GetAspectRatio();
 		}
 		else {
 			//En caso de que el usuario no haya configurado una cama principal usamos valores predeterminados para ambas matrices
 			MONA_LOG_INFO("Render Info: No camera has been set, using defaults transformations");
 			viewMatrix = glm::mat4(1.0f);
-			projectionMatrix = glm::perspective(glm::radians(50.0f), 16.0f / 9.0f, 0.1f, 100.0f);
+			projectionMatrix = glm::perspective(fieldOfView, aspectRatio, nearPlane, farPlane);
 		}
 
 
@@ -119,80 +217,757 @@ namespace Mona{
 			lights.directionalLights[i].direction = glm::rotate(dirLight.GetLightDirection(), lightTransform->GetFrontVector());
 		}
 
-		//Lo mismo para spotlights
-		uint32_t spotLightsCount = std::min(static_cast<uint32_t>(NUM_HALF_MAX_SPOT_LIGHTS * 2), spotLightDataManager.GetCount());
-		lights.spotLightsCount = static_cast<int>(spotLightsCount);
+		//Las spotlights y luces puntuales no tienen limite, ademas de su version en coordenadas de mundo se guarda su version
+		//en coordenadas de camara para asignarlas a los clusters.
+		const uint32_t spotLightsCount = spotLightDataManager.GetCount();
+		m_spotLights.resize(spotLightsCount);
+		m_clusterSpotLights.resize(spotLightsCount);
 		for (uint32_t i = 0; i < spotLightsCount; i++) {
 			const SpotLightComponent& spotLight = spotLightDataManager[i];
 			GameObject* spotLightOwner = spotLightDataManager.GetOwnerByIndex(i);
 			TransformComponent* lightTransform = transformDataManager.GetComponentPointer(spotLightOwner->GetInnerComponentHandle<TransformComponent>());
-			lights.spotLights[i].colorIntensity = spotLight.GetLightColor();
-			lights.spotLights[i].direction = glm::rotate(spotLight.GetLightDirection(), lightTransform->GetFrontVector());
-			lights.spotLights[i].position = lightTransform->GetLocalTranslation();
-			lights.spotLights[i].cosPenumbraAngle = glm::cos(spotLight.GetPenumbraAngle());
-			lights.spotLights[i].cosUmbraAngle = glm::cos(spotLight.GetUmbraAngle());
-			lights.spotLights[i].maxRadius = spotLight.GetMaxRadius();
+			SpotLight& light = m_spotLights[i];
+			light.colorIntensity = spotLight.GetLightColor();
+			light.direction = glm::rotate(spotLight.GetLightDirection(), lightTransform->GetFrontVector());
+			light.position = lightTransform->GetLocalTranslation();
+			light.cosPenumbraAngle = glm::cos(spotLight.GetPenumbraAngle());
+			light.cosUmbraAngle = glm::cos(spotLight.GetUmbraAngle());
+			light.maxRadius = spotLight.GetMaxRadius();
+			const float coneAngle = std::min(std::max(spotLight.GetPenumbraAngle(), spotLight.GetUmbraAngle()), glm::pi<float>());
+			m_clusterSpotLights[i] = { glm::vec3(viewMatrix * glm::vec4(light.position, 1.0f)), light.maxRadius,
+				glm::normalize(glm::mat3(viewMatrix) * light.direction), glm::cos(coneAngle), glm::sin(coneAngle) };
 		}
 
 		//Finalmente luces puntuales
-		uint32_t pointLightsCount = std::min(static_cast<uint32_t>(NUM_HALF_MAX_POINT_LIGHTS * 2), pointLightDataManager.GetCount());
-		lights.pointLightsCount = static_cast<int>(pointLightsCount);
+		const uint32_t pointLightsCount = pointLightDataManager.GetCount();
+		m_pointLights.resize(pointLightsCount);
+		m_clusterPointLights.resize(pointLightsCount);
 		for (uint32_t i = 0; i < pointLightsCount; i++) {
 			const PointLightComponent& pointLight = pointLightDataManager[i];
 			GameObject* pointLightOwner = pointLightDataManager.GetOwnerByIndex(i);
 			TransformComponent* lightTransform = transformDataManager.GetComponentPointer(pointLightOwner->GetInnerComponentHandle<TransformComponent>());
-			lights.pointLights[i].colorIntensity = pointLight.GetLightColor();
-			lights.pointLights[i].position = lightTransform->GetLocalTranslation();
-			lights.pointLights[i].maxRadius = pointLight.GetMaxRadius();
+			PointLight& light = m_pointLights[i];
+			light.colorIntensity = pointLight.GetLightColor();
+			light.position = lightTransform->GetLocalTranslation();
+			light.maxRadius = pointLight.GetMaxRadius();
+			m_clusterPointLights[i] = { glm::vec3(viewMatrix * glm::vec4(light.position, 1.0f)), light.maxRadius };
 		}
+		m_lightClusterGrid.UpdateBounds(fieldOfView, aspectRatio, nearPlane, farPlane);
+		m_lightClusterGrid.Build(m_clusterPointLights, m_clusterSpotLights);
+		WriteClusteredLightData();
+
+		const glm::mat4 viewProjectionMatrix = projectionMatrix * viewMatrix;
+		CameraData cameraData;
+		cameraData.viewProjectionMatrix = viewProjectionMatrix;
+		cameraData.viewMatrix = viewMatrix;
+		cameraData.cameraPosition = cameraPosition;
+		cameraData.clusterTileSize = glm::vec2(m_viewportSize) / glm::vec2(LightClusterGrid::s_gridX, LightClusterGrid::s_gridY);
+		cameraData.clusterDepthSliceParameters = m_lightClusterGrid.GetDepthSliceParameters();
+		device.BufferSubData(m_cameraDataUBO, 0, sizeof(CameraData), &cameraData);
 
 		//Pasamos la informacion lumnica a GPU con un unico llamado a OpenGL fuera de los loops de las primitivas.
-		glBindBuffer(GL_UNIFORM_BUFFER, m_lightDataUBO);
-		glBufferSubData(GL_UNIFORM_BUFFER, 0, sizeof(Lights), &lights);
-		glBindBuffer(GL_UNIFORM_BUFFER, 0);
-		//Iteracin sobre todas las instancias de StaticMeshComponent
-		for (decltype(staticMeshDataManager.GetCount()) i = 0;
-			i < staticMeshDataManager.GetCount();
-			i++)
+		device.BufferSubData(m_lightDataUBO, 0, sizeof(Lights), &lights);
+		m_renderStatistics.uniformBufferBytes += sizeof(CameraData) + sizeof(Lights);
+		//Se actualizan los datos retenidos de las mallas estaticas (ver StaticMeshLifetimePolicy). Sus matrices, cajas en
+		//espacio de mundo y cajas dentro del culler solo se recalculan cuando cambia la version de su transformacion.
+		//Las mallas de un lote que se mueven o cambian de material salen de el, y el lote se reconstruye antes de descartar.
+		const uint32_t staticMeshCount = static_cast<uint32_t>(m_staticMeshEntries.size());
+		const uint32_t skeletalMeshCount = skeletalMeshDataManager.GetCount();
+		uint32_t patchedStaticMeshCount = 0;
+		for (uint32_t i = 0; i < staticMeshCount; i++)
 		{
-			StaticMeshComponent& staticMesh = staticMeshDataManager[i];
-			GameObject* owner = staticMeshDataManager.GetOwnerByIndex(i);
-			//Se obtiene la informacin espacial para configurar la matriz de modelo dentro del shader.
-			TransformComponent* transform = transformDataManager.GetComponentPointer(owner->GetInnerComponentHandle<TransformComponent>());
-			//Configuracin de la malla a ser renderizada y las uniformes asociadas a su material.
-			glBindVertexArray(staticMesh.GetMeshVAOID());
-			staticMesh.m_materialPtr->SetUniforms(projectionMatrix, viewMatrix, transform->GetModelMatrix(), cameraPosition);
-			glDrawElements(GL_TRIANGLES, staticMesh.GetMeshIndexCount(), GL_UNSIGNED_INT, 0);
-			
+			StaticMeshEntry& entry = m_staticMeshEntries[i];
+			StaticMeshComponent& staticMesh = *staticMeshDataManager.GetComponentPointer(entry.meshHandle);
+			const TransformComponent* transform = transformDataManager.GetComponentPointer(entry.transformHandle);
+			bool patched = staticMesh.m_isDirty;
+			staticMesh.m_isDirty = false;
+			if (entry.transformVersion != transform->GetVersion()) {
+				entry.modelMatrix = transform->GetModelMatrix();
+				entry.modelInverseTransposeMatrix = glm::transpose(glm::inverse(entry.modelMatrix));
+				entry.transformVersion = transform->GetVersion();
+				staticMesh.m_worldBounds = staticMesh.m_meshPtr->GetBounds().box.Transform(entry.modelMatrix);
+				staticMesh.m_pvsVersion = 0;
+				if (!m_staticMeshListChanged && m_staticMeshBoxIndices[i] != s_invalidBoxIndex)
+					m_frustumCuller.SetBox(m_staticMeshBoxIndices[i], staticMesh.m_worldBounds);
+				patched = true;
+			}
+			if (patched && staticMesh.m_staticBatchIndex != StaticMeshComponent::s_invalidStaticBatchIndex)
+				RemoveFromStaticBatch(entry.meshHandle, staticMesh);
+			if (patched)
+				patchedStaticMeshCount++;
+		}
+		if (m_hasStaleStaticBatches)
+			RebuildStaleStaticBatches(staticMeshDataManager, transformDataManager);
+		const bool staticMeshListChanged = m_staticMeshListChanged;
+		//Las cajas se ubican en el culler en el orden: mallas estaticas que no forman parte de un lote, mallas animadas y
+		//lotes estaticos. Las cajas de mallas estaticas se mantienen entre frames y solo se vuelven a agregar cuando cambia
+		//la lista (mallas agregadas o removidas, o lotes reconstruidos). Las mallas de un lote no se prueban, pero siguen
+		//actuando como oclusoras.
+		if (staticMeshListChanged) {
+			m_frustumCuller.Clear();
+			m_frustumCuller.Reserve(staticMeshCount + skeletalMeshCount + static_cast<uint32_t>(m_staticBatches.size()));
+			m_staticMeshBoxIndices.resize(staticMeshCount);
+			for (uint32_t i = 0; i < staticMeshCount; i++) {
+				const StaticMeshComponent& staticMesh = *staticMeshDataManager.GetComponentPointer(m_staticMeshEntries[i].meshHandle);
+				m_staticMeshBoxIndices[i] = staticMesh.m_staticBatchIndex != StaticMeshComponent::s_invalidStaticBatchIndex ? s_invalidBoxIndex :
+					m_frustumCuller.AddBox(staticMesh.m_worldBounds);
+			}
+			m_staticBoxCount = m_frustumCuller.GetCount();
+			m_staticMeshListChanged = false;
 		}
+
+		//Si ninguna malla cambio, no hay mallas animadas, la camara no se movio y la geometria de las mallas sigue en el mismo
+		//lugar de los buffers compartidos, la cola, los grupos y los datos por objeto del frame anterior siguen siendo validos
+		//y se vuelven a enviar sin descartar ni ordenar.
+		const uint32_t geometryVersion = MeshManager::GetInstance().GetStaticGeometryVersion();
+		const bool reuseDrawLists = m_retainedDrawListsValid && !staticMeshListChanged && patchedStaticMeshCount == 0 &&
+			skeletalMeshCount == 0 && viewProjectionMatrix == m_retainedViewProjectionMatrix && cameraPosition == m_retainedCameraPosition &&
+			Material::s_parametersVersion == m_retainedMaterialParametersVersion && geometryVersion == m_retainedGeometryVersion;
+		RenderQueueStatistics cullingStatistics = m_renderQueueStatistics;
+		if (!reuseDrawLists) {
+			CullAndQueueMeshes(viewProjectionMatrix, projectionMatrix, cameraPosition, nearPlane, farPlane, staticMeshDataManager,
+				skeletalMeshDataManager, transformDataManager, cullingStatistics);
+			m_retainedViewProjectionMatrix = viewProjectionMatrix;
+			m_retainedCameraPosition = cameraPosition;
+			m_retainedMaterialParametersVersion = Material::s_parametersVersion;
+			m_retainedGeometryVersion = geometryVersion;
+			m_retainedDrawListsValid = true;
+		}
+		SubmitRenderQueue(!reuseDrawLists);
+		m_renderQueueStatistics.submittedCount = cullingStatistics.submittedCount;
+		m_renderQueueStatistics.culledCount = cullingStatistics.culledCount;
+		m_renderQueueStatistics.occludedCount = cullingStatistics.occludedCount;
+		m_renderQueueStatistics.pvsCulledCount = cullingStatistics.pvsCulledCount;
+		m_renderQueueStatistics.clusterCount = cullingStatistics.clusterCount;
+		m_renderQueueStatistics.clusterCulledCount = cullingStatistics.clusterCulledCount;
+		//Los contadores del dispositivo se copian antes del dibujo de depuracion, que no forma parte del costo de la escena.
+		const RenderDeviceStatistics& deviceStatistics = device.GetStatistics();
+		m_renderStatistics.programBinds = deviceStatistics.programBinds;
+		m_renderStatistics.vertexArrayBinds = deviceStatistics.vertexArrayBinds;
+		m_renderStatistics.textureBinds = deviceStatistics.textureBinds;
+		m_renderStatistics.uniformUpdates = deviceStatistics.uniformUpdates;
+		m_renderStatistics.uniformBytes = deviceStatistics.uniformBytes;
+		m_renderStatistics.submittedCount = cullingStatistics.submittedCount;
+		//A diferencia de RenderQueueStatistics, occludedCount no incluye los objetos descartados por el conjunto de objetos
+		//potencialmente visibles.
+		m_renderStatistics.frustumCulledCount = cullingStatistics.culledCount;
+		m_renderStatistics.pvsCulledCount = cullingStatistics.pvsCulledCount;
+		m_renderStatistics.occludedCount = cullingStatistics.occludedCount - cullingStatistics.pvsCulledCount;
+		m_renderStatistics.clusterCulledObjectCount = m_frustumCuller.GetCount() - cullingStatistics.culledCount -
+			cullingStatistics.occludedCount - cullingStatistics.submittedCount;
+		m_renderStatistics.skinningPalettes = skeletalMeshCount;
+		m_renderStatistics.patchedStaticMeshCount = patchedStaticMeshCount;
+		m_renderStatistics.drawListsReused = reuseDrawLists;
+		m_renderStatistics.materialCount = m_materialTable.GetCount();
+		m_renderStatistics.mergedMaterialCount = m_materialTable.GetMergedCount();
+		//En no Debub build este llamado es vacio, en caso contrario se renderiza informacin de debug
+		if (m_debugDrawingSystemPtr != nullptr)
+			m_debugDrawingSystemPtr->Draw(eventManager, viewMatrix, projectionMatrix, m_renderStatistics);
 		
-		//Iteracion sobre todas las instancias de SkeletalMeshComponent
-		for (decltype(skeletalMeshDataManager.GetCount()) i = 0;
-			i < skeletalMeshDataManager.GetCount();
-			i++)
+	}
+
+	void Renderer::CullAndQueueMeshes(const glm::mat4& viewProjectionMatrix,
+		const glm::mat4& projectionMatrix,
+		const glm::vec3& cameraPosition,
+		float nearPlane,
+		float farPlane,
+		ComponentManager<StaticMeshComponent>& staticMeshDataManager,
+		ComponentManager<SkeletalMeshComponent>& skeletalMeshDataManager,
+		ComponentManager<TransformComponent>& transformDataManager,
+		RenderQueueStatistics& statistics) noexcept
+	{
+		//Se descartan las cajas de mallas animadas y lotes del frame anterior, las de mallas estaticas ya estan actualizadas.
+		m_frustumCuller.Truncate(m_staticBoxCount);
+		const uint32_t staticMeshCount = static_cast<uint32_t>(m_staticMeshEntries.size());
+		const uint32_t skeletalMeshCount = skeletalMeshDataManager.GetCount();
+		m_occlusionCuller.BeginFrame(viewProjectionMatrix);
+		if (m_occlusionCullingEnabled) {
+			for (const StaticMeshEntry& entry : m_staticMeshEntries) {
+				const StaticMeshComponent& staticMesh = *staticMeshDataManager.GetComponentPointer(entry.meshHandle);
+				if (!staticMesh.m_isOccluder)
+					continue;
+				const MeshOccluderGeometry& occluder = staticMesh.m_meshPtr->GetOccluderGeometry();
+				m_occlusionCuller.AddOccluder(occluder.positions.data(), static_cast<uint32_t>(occluder.positions.size()),
+					occluder.indices.data(), static_cast<uint32_t>(occluder.indices.size()), entry.modelMatrix);
+			}
+		}
+		const uint32_t skeletalBoxBase = m_frustumCuller.GetCount();
+		m_skinningPalettes.clear();
+		for (uint32_t i = 0; i < skeletalMeshCount; i++)
 		{
 			SkeletalMeshComponent& skeletalMesh = skeletalMeshDataManager[i];
 			GameObject* owner = skeletalMeshDataManager.GetOwnerByIndex(i);
-			TransformComponent* transform = transformDataManager.GetComponentPointer(owner->GetInnerComponentHandle<TransformComponent>());
-			auto skinnedMesh = skeletalMesh.m_skinnedMeshPtr;
-			glBindVertexArray(skinnedMesh->GetVertexArrayID());
-			//A diferencias de StaticMeshes, SkeletalMeshComponent necesita configurar las paletas de matrices de animacion
-			//estas se le solicitan al animationController
-			auto &animController = skeletalMesh.GetAnimationController();
-			skeletalMesh.m_materialPtr->SetUniforms(projectionMatrix, viewMatrix, transform->GetModelMatrix(), cameraPosition);
-			animController.GetMatrixPalette(m_currentMatrixPalette);
-			glUniformMatrix4fv(ShaderProgram::BoneTransformShaderLocation, skeletalMesh.GetSkeleton()->JointCount(), GL_FALSE, (GLfloat*) m_currentMatrixPalette.data());
-			glDrawElements(GL_TRIANGLES, skinnedMesh->GetIndexBufferCount(), GL_UNSIGNED_INT, 0);
+			const TransformComponent* transform = transformDataManager.GetComponentPointer(owner->GetInnerComponentHandle<TransformComponent>());
+			//La paleta de matrices calculada aqui se reutiliza al momento de dibujar.
+			const size_t paletteOffset = m_skinningPalettes.size();
+			m_skinningPalettes.resize(paletteOffset + skeletalMesh.GetSkeleton()->JointCount());
+			skeletalMesh.GetAnimationController().GetMatrixPalette(m_skinningPalettes.data() + paletteOffset);
+			const BoundingBox poseBounds = skeletalMesh.m_skinnedMeshPtr->ComputePoseBounds(m_skinningPalettes.data() + paletteOffset);
+			m_frustumCuller.AddBox(poseBounds.Transform(transform->GetModelMatrix()));
+		}
+		const uint32_t batchBoxBase = m_frustumCuller.GetCount();
+		for (const StaticBatch& batch : m_staticBatches)
+			m_frustumCuller.AddBox(batch.worldBounds);
+		uint32_t visibleCount = m_frustumCuller.Cull(Frustum::FromViewProjection(viewProjectionMatrix));
+		const uint32_t frustumVisibleCount = visibleCount;
+		//Las mallas estaticas que no son visibles desde la celda de la camara se descartan con un bit del conjunto de objetos
+		//potencialmente visibles. Las que no aparecen en el conjunto (por ejemplo porque se movieron) nunca se descartan.
+		uint32_t pvsCulledCount = 0;
+		const uint32_t pvsCell = m_potentiallyVisibleSet.FindCell(cameraPosition);
+		if (pvsCell != PotentiallyVisibleSet::s_invalidIndex) {
+			for (uint32_t i = 0; i < staticMeshCount; i++) {
+				const uint32_t boxIndex = m_staticMeshBoxIndices[i];
+				if (boxIndex == s_invalidBoxIndex || !m_frustumCuller.IsVisible(boxIndex))
+					continue;
+				StaticMeshComponent& staticMesh = *staticMeshDataManager.GetComponentPointer(m_staticMeshEntries[i].meshHandle);
+				if (staticMesh.m_pvsVersion != m_pvsVersion) {
+					staticMesh.m_pvsObjectIndex = m_potentiallyVisibleSet.FindObject(staticMesh.m_worldBounds);
+					staticMesh.m_pvsVersion = m_pvsVersion;
+				}
+				if (staticMesh.m_pvsObjectIndex != PotentiallyVisibleSet::s_invalidIndex &&
+					!m_potentiallyVisibleSet.IsVisible(pvsCell, staticMesh.m_pvsObjectIndex)) {
+					m_frustumCuller.SetVisible(boxIndex, false);
+					pvsCulledCount++;
+				}
+			}
+			visibleCount -= pvsCulledCount;
+		}
+		//Las cajas que pasaron la prueba del frustum se prueban ademas contra los oclusores rasterizados.
+		if (m_occlusionCuller.GetOccluderTriangleCount() > 0) {
+			m_occlusionCuller.Rasterize();
+			for (uint32_t i = 0; i < m_frustumCuller.GetCount(); i++) {
+				if (m_frustumCuller.IsVisible(i) && m_occlusionCuller.IsOccluded(m_frustumCuller.GetBox(i))) {
+					m_frustumCuller.SetVisible(i, false);
+					visibleCount--;
+				}
+			}
+		}
+
+		const uint32_t occludedCount = frustumVisibleCount - visibleCount;
+
+		//Se agregan a la cola de render las instancias visibles, la profundidad usada para ordenar corresponde a la
+		//distancia a la camara normalizada por el plano lejano.
+		const float inverseFarPlane = 1.0f / farPlane;
+		//Un objeto a distancia d con radio r mide r * pixelsPerRadius / d pixeles de radio en pantalla.
+		const float pixelsPerRadius = 0.5f * static_cast<float>(m_viewportSize.y) * projectionMatrix[1][1];
+		m_renderQueue.Clear();
+		m_materialTable.Clear();
+		m_clusterRanges.clear();
+		StaticDrawContext drawContext = { viewProjectionMatrix, cameraPosition, nearPlane, pixelsPerRadius, 0, 0 };
+		for (uint32_t i = 0; i < staticMeshCount; i++)
+		{
+			const uint32_t boxIndex = m_staticMeshBoxIndices[i];
+			if (boxIndex == s_invalidBoxIndex || !m_frustumCuller.IsVisible(boxIndex))
+				continue;
+			const StaticMeshEntry& entry = m_staticMeshEntries[i];
+			StaticMeshComponent& staticMesh = *staticMeshDataManager.GetComponentPointer(entry.meshHandle);
+			const float depth = glm::distance(glm::vec3(entry.modelMatrix[3]), cameraPosition) * inverseFarPlane;
+			if (!PushStaticMesh(*staticMesh.m_meshPtr, staticMesh.m_materialPtr.get(), entry.modelMatrix, &entry.modelInverseTransposeMatrix,
+				staticMesh.m_worldBounds, depth, staticMesh.m_lodLevel, drawContext))
+				visibleCount--;
+		}
+		//Los lotes estaticos ya estan en espacio de mundo y se dibujan con la matriz identidad.
+		for (uint32_t i = 0; i < m_staticBatches.size(); i++)
+		{
+			if (!m_frustumCuller.IsVisible(batchBoxBase + i))
+				continue;
+			StaticBatch& batch = m_staticBatches[i];
+			const float depth = glm::distance(batch.worldBounds.GetCenter(), cameraPosition) * inverseFarPlane;
+			if (!PushStaticMesh(*batch.mesh, batch.material.get(), s_identityMatrix, &s_identityMatrix, batch.worldBounds, depth, batch.lodLevel,
+				drawContext))
+				visibleCount--;
 		}
-		//En no Debub build este llamado es vacio, en caso contrario se renderiza informacin de debug
-		m_debugDrawingSystemPtr->Draw(eventManager, viewMatrix, projectionMatrix);
 		
+		uint32_t paletteOffset = 0;
+		for (uint32_t i = 0; i < skeletalMeshCount; i++)
+		{
+			SkeletalMeshComponent& skeletalMesh = skeletalMeshDataManager[i];
+			const uint32_t currentPaletteOffset = paletteOffset;
+			paletteOffset += static_cast<uint32_t>(skeletalMesh.GetSkeleton()->JointCount());
+			if (!m_frustumCuller.IsVisible(skeletalBoxBase + i))
+				continue;
+			GameObject* owner = skeletalMeshDataManager.GetOwnerByIndex(i);
+			TransformComponent* transform = transformDataManager.GetComponentPointer(owner->GetInnerComponentHandle<TransformComponent>());
+			auto& skinnedMesh = skeletalMesh.m_skinnedMeshPtr;
+			Material* material = skeletalMesh.m_materialPtr.get();
+			const float depth = glm::distance(transform->GetLocalTranslation(), cameraPosition) * inverseFarPlane;
+			m_renderQueue.Push({ material, m_materialTable.Resolve(*material), &skeletalMesh, skinnedMesh->GetVertexArrayID(), skinnedMesh->GetVertexArrayID(), skinnedMesh->GetIndexBufferCount(),
+				skinnedMesh->GetIndexType(), 0, 0, currentPaletteOffset, transform->GetModelMatrix(), nullptr, 0, 0 }, RenderPass::Opaque, material->m_shaderIndex, depth);
+		}
+		m_renderQueue.Sort();
+		statistics.submittedCount = visibleCount;
+		statistics.culledCount = m_frustumCuller.GetCount() - frustumVisibleCount;
+		statistics.occludedCount = occludedCount;
+		statistics.pvsCulledCount = pvsCulledCount;
+		statistics.clusterCount = drawContext.clusterCount;
+		statistics.clusterCulledCount = drawContext.clusterCulledCount;
+	}
+
+
+	PotentiallyVisibleSet Renderer::BakePotentiallyVisibleSet(ComponentManager<StaticMeshComponent>& staticMeshDataManager,
+		ComponentManager<TransformComponent>& transformDataManager,
+		const PVSBakeSettings& settings) noexcept
+	{
+		//Las cajas se calculan igual que en Render para que al usar el conjunto coincidan exactamente con las de la escena.
+		const uint32_t staticMeshCount = staticMeshDataManager.GetCount();
+		std::vector<PVSBakeObject> objects;
+		objects.reserve(staticMeshCount);
+		for (uint32_t i = 0; i < staticMeshCount; i++)
+		{
+			StaticMeshComponent& staticMesh = staticMeshDataManager[i];
+			GameObject* owner = staticMeshDataManager.GetOwnerByIndex(i);
+			const TransformComponent* transform = transformDataManager.GetComponentPointer(owner->GetInnerComponentHandle<TransformComponent>());
+			staticMesh.m_worldBounds = staticMesh.m_meshPtr->GetBounds().box.Transform(transform->GetModelMatrix());
+			staticMesh.m_pvsVersion = 0;
+			const MeshOccluderGeometry& occluder = staticMesh.m_meshPtr->GetOccluderGeometry();
+			PVSBakeObject& object = objects.emplace_back();
+			object.worldBounds = staticMesh.m_worldBounds;
+			object.positions = occluder.positions.data();
+			object.vertexCount = static_cast<uint32_t>(occluder.positions.size());
+			object.indices = occluder.indices.data();
+			object.indexCount = static_cast<uint32_t>(occluder.indices.size());
+			object.modelMatrix = transform->GetModelMatrix();
+		}
+		return PotentiallyVisibleSet::Bake(objects, settings);
+	}
+
+	void Renderer::SetPotentiallyVisibleSet(PotentiallyVisibleSet pvs) noexcept {
+		m_potentiallyVisibleSet = std::move(pvs);
+		m_pvsVersion++;
+		m_retainedDrawListsValid = false;
+	}
+
+	bool Renderer::LoadPotentiallyVisibleSet(const std::filesystem::path& filePath) noexcept {
+		if (!m_potentiallyVisibleSet.LoadFromFile(filePath))
+			return false;
+		m_pvsVersion++;
+		m_retainedDrawListsValid = false;
+		return true;
+	}
+
+	void Renderer::ClearPotentiallyVisibleSet() noexcept {
+		m_potentiallyVisibleSet.Clear();
+		m_pvsVersion++;
+		m_retainedDrawListsValid = false;
+	}
+
+	bool Renderer::PushStaticMesh(const Mesh& mesh, Material* material, const glm::mat4& modelMatrix, const glm::mat4* modelInverseTransposeMatrix,
+		const BoundingBox& worldBounds, float depth, uint8_t& lodLevel, StaticDrawContext& context) noexcept
+	{
+		const GeometryRange& range = mesh.GetGeometryRange();
+		const float boundsDistance = std::max(glm::distance(worldBounds.GetCenter(), context.cameraPosition), context.nearPlane);
+		const float projectedRadius = glm::length(worldBounds.GetExtents()) * context.pixelsPerRadius / boundsDistance;
+		lodLevel = SelectMeshLOD(mesh, lodLevel, projectedRadius);
+		const MeshLOD& lod = mesh.GetLOD(lodLevel);
+		//Cada nivel de detalle cuenta como una malla distinta para que solo se agrupen instancias con el mismo nivel.
+		const uint32_t meshID = mesh.GetMeshID() * Mesh::s_maxLODCount + lodLevel;
+		//Los grupos de triangulos del nivel cero se prueban en el espacio local de la malla. Los grupos visibles
+		//consecutivos se unen en un unico rango de indices.
+		const std::vector<MeshCluster>& clusters = mesh.GetClusters();
+		const uint32_t firstClusterRange = static_cast<uint32_t>(m_clusterRanges.size());
+		if (m_clusterCullingEnabled && lodLevel == 0 && !clusters.empty()) {
+			const Frustum localFrustum = Frustum::FromViewProjection(context.viewProjectionMatrix * modelMatrix);
+			const glm::vec3 localCameraPosition = glm::vec3(glm::transpose(*modelInverseTransposeMatrix) * glm::vec4(context.cameraPosition, 1.0f));
+			//Desde dentro de la malla, o si la transformacion invierte el sentido de los triangulos, las caras traseras
+			//pueden verse y no se descarta por cono.
+			const BoundingBox& localBounds = mesh.GetBounds().box;
+			const bool cameraInsideBounds = glm::all(glm::lessThanEqual(localBounds.minPoint, localCameraPosition)) &&
+				glm::all(glm::lessThanEqual(localCameraPosition, localBounds.maxPoint));
+			const bool coneCulling = !cameraInsideBounds && glm::determinant(glm::mat3(modelMatrix)) > 0.0f;
+			for (const MeshCluster& cluster : clusters) {
+				if (!IsMeshClusterVisible(cluster, localFrustum, localCameraPosition, coneCulling)) {
+					context.clusterCulledCount++;
+					continue;
+				}
+				const uint32_t firstIndex = range.firstIndex + cluster.indexOffset;
+				if (m_clusterRanges.size() > firstClusterRange && m_clusterRanges.back().firstIndex + m_clusterRanges.back().indexCount == firstIndex)
+					m_clusterRanges.back().indexCount += cluster.indexCount;
+				else
+					m_clusterRanges.push_back({ firstIndex, cluster.indexCount });
+			}
+			context.clusterCount += static_cast<uint32_t>(clusters.size());
+			if (m_clusterRanges.size() == firstClusterRange)
+				return false;
+		}
+		const uint32_t clusterRangeCount = static_cast<uint32_t>(m_clusterRanges.size()) - firstClusterRange;
+		m_renderQueue.Push({ material, m_materialTable.Resolve(*material), nullptr, mesh.GetVertexArrayID(), meshID, lod.indexCount, mesh.GetIndexType(), range.firstIndex + lod.indexOffset,
+			range.baseVertex, 0, modelMatrix, modelInverseTransposeMatrix, firstClusterRange, clusterRangeCount }, RenderPass::Opaque, material->m_shaderIndex, depth);
+		return true;
+	}
+
+	uint32_t Renderer::BuildStaticBatches(ComponentManager<StaticMeshComponent>& staticMeshDataManager,
+		ComponentManager<TransformComponent>& transformDataManager,
+		float cellSize) noexcept
+	{
+		ClearStaticBatches(staticMeshDataManager);
+		//Las mallas marcadas como estaticas se agrupan por la llave de su material en la tabla de materiales (programa,
+		//parametros y texturas), de manera que materiales distintos pero equivalentes comparten lote, y por la celda de la
+		//grilla que contiene el centro de su caja. Los grupos de una sola malla no ganan nada y se siguen dibujando por separado. Los datos retenidos de cada
+		//malla se actualizan aqui, de manera que solo los cambios posteriores la saquen de su lote.
+		const float inverseCellSize = 1.0f / std::max(cellSize, 1e-3f);
+		std::map<std::tuple<MaterialTable::Key, int32_t, int32_t, int32_t>, std::vector<InnerComponentHandle>> groups;
+		for (StaticMeshEntry& entry : m_staticMeshEntries)
+		{
+			StaticMeshComponent& staticMesh = *staticMeshDataManager.GetComponentPointer(entry.meshHandle);
+			if (!staticMesh.m_isStatic)
+				continue;
+			const TransformComponent* transform = transformDataManager.GetComponentPointer(entry.transformHandle);
+			if (entry.transformVersion != transform->GetVersion()) {
+				entry.modelMatrix = transform->GetModelMatrix();
+				entry.modelInverseTransposeMatrix = glm::transpose(glm::inverse(entry.modelMatrix));
+				entry.transformVersion = transform->GetVersion();
+				staticMesh.m_worldBounds = staticMesh.m_meshPtr->GetBounds().box.Transform(entry.modelMatrix);
+				staticMesh.m_pvsVersion = 0;
+			}
+			staticMesh.m_isDirty = false;
+			if (staticMesh.m_worldBounds.IsEmpty())
+				continue;
+			const glm::ivec3 cell = glm::ivec3(glm::floor(staticMesh.m_worldBounds.GetCenter() * inverseCellSize));
+			groups[{ MaterialTable::MakeKey(*staticMesh.m_materialPtr), cell.x, cell.y, cell.z }].push_back(entry.meshHandle);
+		}
+		uint32_t batchedMeshCount = 0;
+		for (auto& group : groups) {
+			if (group.second.size() < 2)
+				continue;
+			StaticBatch& batch = m_staticBatches.emplace_back();
+			batch.members = std::move(group.second);
+			batch.isStale = true;
+			batchedMeshCount += static_cast<uint32_t>(batch.members.size());
+		}
+		m_hasStaleStaticBatches = true;
+		RebuildStaleStaticBatches(staticMeshDataManager, transformDataManager);
+		MONA_LOG_INFO("Renderer: Merged {0} static meshes into {1} static batches", batchedMeshCount, m_staticBatches.size());
+		return static_cast<uint32_t>(m_staticBatches.size());
+	}
+
+	void Renderer::ClearStaticBatches(ComponentManager<StaticMeshComponent>& staticMeshDataManager) noexcept {
+		for (uint32_t i = 0; i < staticMeshDataManager.GetCount(); i++)
+			staticMeshDataManager[i].m_staticBatchIndex = StaticMeshComponent::s_invalidStaticBatchIndex;
+		m_staticBatches.clear();
+		m_hasStaleStaticBatches = false;
+		//Las mallas que forman parte de un lote no tienen caja en el culler, por lo que la lista retenida debe reconstruirse.
+		m_staticMeshListChanged = true;
+	}
+
+	void Renderer::RemoveFromStaticBatch(const InnerComponentHandle& meshHandle, StaticMeshComponent& staticMesh) noexcept {
+		StaticBatch& batch = m_staticBatches[staticMesh.m_staticBatchIndex];
+		auto member = std::find_if(batch.members.begin(), batch.members.end(),
+			[&meshHandle](const InnerComponentHandle& handle) { return handle.m_index == meshHandle.m_index; });
+		MONA_ASSERT(member != batch.members.end(), "Renderer Error: Static mesh missing from its static batch.");
+		*member = batch.members.back();
+		batch.members.pop_back();
+		batch.isStale = true;
+		staticMesh.m_staticBatchIndex = StaticMeshComponent::s_invalidStaticBatchIndex;
+		m_hasStaleStaticBatches = true;
+		//La malla vuelve a necesitar su propia caja en el culler.
+		m_staticMeshListChanged = true;
+	}
+
+	void Renderer::RebuildStaleStaticBatches(ComponentManager<StaticMeshComponent>& staticMeshDataManager,
+		ComponentManager<TransformComponent>& transformDataManager) noexcept
+	{
+		std::vector<StaticBatchPart> parts;
+		for (uint32_t i = static_cast<uint32_t>(m_staticBatches.size()); i-- > 0;)
+		{
+			StaticBatch& batch = m_staticBatches[i];
+			if (!batch.isStale)
+				continue;
+			if (batch.members.size() < 2) {
+				//El lote se elimina y el ultimo toma su lugar, por lo que sus mallas se actualizan con la nueva posicion.
+				for (const InnerComponentHandle& handle : batch.members)
+					staticMeshDataManager.GetComponentPointer(handle)->m_staticBatchIndex = StaticMeshComponent::s_invalidStaticBatchIndex;
+				if (i + 1 < m_staticBatches.size()) {
+					batch = std::move(m_staticBatches.back());
+					for (const InnerComponentHandle& handle : batch.members)
+						staticMeshDataManager.GetComponentPointer(handle)->m_staticBatchIndex = i;
+				}
+				m_staticBatches.pop_back();
+				continue;
+			}
+			parts.clear();
+			for (const InnerComponentHandle& handle : batch.members) {
+				StaticMeshComponent& staticMesh = *staticMeshDataManager.GetComponentPointer(handle);
+				const StaticMeshEntry& entry = m_staticMeshEntries[m_staticMeshEntryIndices[handle.m_index]];
+				parts.push_back({ staticMesh.m_meshPtr.get(), transformDataManager.GetComponentPointer(entry.transformHandle)->GetModelMatrix() });
+				staticMesh.m_staticBatchIndex = i;
+				batch.material = staticMesh.m_materialPtr;
+			}
+			batch.mesh = MeshManager::GetInstance().CreateStaticBatchMesh(parts);
+			batch.worldBounds = batch.mesh->GetBounds().box;
+			batch.lodLevel = 0;
+			batch.isStale = false;
+		}
+		m_hasStaleStaticBatches = false;
+		//Las cajas de los lotes y de las mallas que salieron de ellos cambian, por lo que la lista retenida debe reconstruirse.
+		m_staticMeshListChanged = true;
+	}
+
+	uint8_t Renderer::SelectMeshLOD(const Mesh& mesh, uint8_t currentLevel, float projectedRadius) const noexcept {
+		const uint32_t lodCount = mesh.GetLODCount();
+		if (currentLevel >= lodCount)
+			currentLevel = static_cast<uint8_t>(lodCount - 1);
+		const float threshold = m_lodErrorThreshold * std::exp2(m_lodBias);
+		//Los errores crecen con el nivel, por lo que se busca el ultimo nivel bajo el umbral.
+		uint8_t level = 0;
+		while (level + 1u < lodCount && mesh.GetLOD(level + 1u).error * projectedRadius <= threshold)
+			level++;
+		if (level > currentLevel) {
+			//Para simplificar el error del nuevo nivel debe quedar claramente bajo el umbral.
+			while (level > currentLevel && mesh.GetLOD(level).error * projectedRadius > threshold * (1.0f - m_lodHysteresis))
+				level--;
+		}
+		else if (level < currentLevel) {
+			//Para refinar el error del nivel actual debe superar claramente el umbral.
+			if (mesh.GetLOD(currentLevel).error * projectedRadius <= threshold * (1.0f + m_lodHysteresis))
+				level = currentLevel;
+		}
+		return level;
+	}
+
+	void Renderer::BuildDrawBatches() noexcept {
+		//Los elementos consecutivos de la cola (ya ordenada) que corresponden a mallas estaticas y comparten programa, VAO y
+		//texturas de material forman un unico grupo dibujado con glMultiDrawElementsIndirect, aunque los parametros de sus
+		//materiales difieran. Dentro del grupo cada secuencia de elementos con la misma malla se convierte en un comando con
+		//tantas instancias como elementos, cuyo baseInstance es la posicion del primero de ellos en la cola. Los elementos que dibujan rangos de grupos de triangulos no se instancian y emiten un
+		//comando por rango. Las mallas animadas que comparten programa, texturas de material y SkinnedMesh se dibujan con un
+		//llamado instanciado, cada instancia lee su propia paleta y material gracias a sus datos por objeto.
+		m_drawBatches.clear();
+		m_drawCommands.clear();
+		const uint32_t count = m_renderQueue.GetCount();
+		auto sharesMaterialState = [this](const RenderItem& first, const RenderItem& second) {
+			return first.material->GetShaderID() == second.material->GetShaderID() &&
+				m_materialTable.SharesTextures(first.materialIndex, second.materialIndex);
+		};
+		uint32_t i = 0;
+		while (i < count) {
+			const RenderItem& first = m_renderQueue.GetSortedItem(i);
+			if (first.skeletalMesh != nullptr) {
+				uint32_t runEnd = i + 1;
+				while (runEnd < count) {
+					const RenderItem& next = m_renderQueue.GetSortedItem(runEnd);
+					if (next.skeletalMesh == nullptr || !sharesMaterialState(first, next) || next.meshID != first.meshID)
+						break;
+					runEnd++;
+				}
+				m_drawBatches.push_back({ i, runEnd - i, 0, 0 });
+				i = runEnd;
+				continue;
+			}
+			const uint32_t firstCommand = static_cast<uint32_t>(m_drawCommands.size());
+			uint32_t runEnd = i;
+			while (runEnd < count) {
+				const RenderItem& item = m_renderQueue.GetSortedItem(runEnd);
+				if (item.skeletalMesh != nullptr || !sharesMaterialState(first, item) || item.vertexArrayID != first.vertexArrayID)
+					break;
+				if (item.clusterRangeCount > 0) {
+					//Cada rango de grupos visibles es un comando de una instancia que lee los datos del mismo elemento.
+					for (uint32_t r = item.firstClusterRange; r < item.firstClusterRange + item.clusterRangeCount; r++)
+						m_drawCommands.push_back({ m_clusterRanges[r].indexCount, 1, m_clusterRanges[r].firstIndex, item.baseVertex, runEnd });
+				}
+				else if (runEnd > i && item.meshID == m_renderQueue.GetSortedItem(runEnd - 1).meshID &&
+					m_renderQueue.GetSortedItem(runEnd - 1).clusterRangeCount == 0)
+					m_drawCommands.back().instanceCount++;
+				else
+					m_drawCommands.push_back({ item.indexCount, 1, item.firstIndex, item.baseVertex, runEnd });
+				runEnd++;
+			}
+			m_drawBatches.push_back({ i, runEnd - i, firstCommand, static_cast<uint32_t>(m_drawCommands.size()) - firstCommand });
+			i = runEnd;
+		}
+	}
+
+	void Renderer::EnsureDrawIndexCapacity(uint32_t count) noexcept {
+		if (count <= m_drawIndexCapacity)
+			return;
+		//El contenido del buffer nunca cambia, por lo que al crecer se crea uno nuevo y se vuelve a enlazar al VAO de las
+		//mallas estaticas.
+		const uint32_t capacity = std::max(count, 2 * m_drawIndexCapacity);
+		std::vector<uint32_t> drawIndices(capacity);
+		std::iota(drawIndices.begin(), drawIndices.end(), 0u);
+		if (m_drawIndexBufferID != 0)
+			RenderDevice::GetInstance().DeleteBuffer(m_drawIndexBufferID);
+		m_drawIndexBufferID = RenderDevice::GetInstance().CreateBuffer(capacity * sizeof(uint32_t), drawIndices.data(), 0);
+		for (GeometryBuffer& geometryBuffer : MeshManager::GetInstance().GetStaticGeometryBuffers())
+			geometryBuffer.BindInstanceBuffer(ShaderProgram::DrawIndexAttributeLocation, m_drawIndexBufferID);
+		m_drawIndexCapacity = capacity;
+	}
+
+	void Renderer::WriteDrawCommands() noexcept {
+		EnsureDrawIndexCapacity(m_renderQueue.GetCount());
+		const size_t size = m_drawCommands.size() * sizeof(DrawElementsIndirectCommand);
+		void* commands = m_drawCommandRing.BeginFrame(size);
+		if (size > 0)
+			std::memcpy(commands, m_drawCommands.data(), size);
+		m_drawCommandRing.Bind();
+		m_renderStatistics.indirectCommandBytes += size;
+	}
+
+	void Renderer::BuildDrawData() noexcept {
+		//Las matrices de todos los elementos de la cola se guardan en el mismo orden de la cola. Las mallas estaticas ya
+		//tienen su inversa transpuesta calculada, solo la de las mallas animadas se calcula aqui.
+		const uint32_t count = m_renderQueue.GetCount();
+		m_drawData.resize(count);
+		for (uint32_t i = 0; i < count; i++) {
+			const RenderItem& item = m_renderQueue.GetSortedItem(i);
+			m_drawData[i].modelMatrix = item.modelMatrix;
+			m_drawData[i].modelInverseTransposeMatrix = item.modelInverseTransposeMatrix != nullptr ? *item.modelInverseTransposeMatrix :
+				glm::transpose(glm::inverse(item.modelMatrix));
+			m_drawData[i].paletteOffset = item.paletteOffset;
+			m_drawData[i].materialIndex = item.materialIndex;
+		}
+	}
+
+	void Renderer::WriteDrawData() noexcept {
+		const size_t size = m_drawData.size() * sizeof(DrawData);
+		void* drawData = m_drawDataRing.BeginFrame(size);
+		if (size > 0)
+			std::memcpy(drawData, m_drawData.data(), size);
+		m_drawDataRing.BindRegion(ShaderProgram::DrawDataBufferBinding, size);
+		m_renderStatistics.storageBufferBytes += size;
+	}
+
+	void Renderer::WriteMaterialData() noexcept {
+		const std::vector<MaterialParameters>& parameters = m_materialTable.GetParameters();
+		const size_t size = std::max(parameters.size() * sizeof(MaterialParameters), sizeof(MaterialParameters));
+		void* materialData = m_materialDataRing.BeginFrame(size);
+		if (!parameters.empty())
+			std::memcpy(materialData, parameters.data(), parameters.size() * sizeof(MaterialParameters));
+		m_materialDataRing.BindRegion(ShaderProgram::MaterialDataBufferBinding, size);
+		m_renderStatistics.storageBufferBytes += size;
+	}
+
+	void Renderer::WriteSkinningPalettes() noexcept {
+		//Las paletas de todas las mallas animadas (visibles o no) se codifican en un unico bloque, de manera que el
+		//paletteOffset calculado durante el descarte sirve directamente como indice de articulacion en el shader.
+		const size_t size = m_skinningPalettes.size() * GetSkinningPaletteStride(m_skinningPaletteFormat);
+		void* palettes = m_skinningPaletteRing.BeginFrame(size);
+		if (size > 0)
+			EncodeSkinningPalette(m_skinningPaletteFormat, m_skinningPalettes.data(), m_skinningPalettes.size(), palettes);
+		m_skinningPaletteRing.BindRegion(ShaderProgram::SkinningPaletteBufferBinding, size);
+		m_renderStatistics.storageBufferBytes += size;
+		m_renderStatistics.skinningPaletteBytes += size;
+	}
+
+	void Renderer::WriteClusteredLightData() noexcept {
+		//Los cuatro bloques (luces puntuales, spotlights, rangos por cluster e indices) se ubican uno tras otro en la region del
+		//frame actual, cada uno alineado segun lo requerido para enlazarlo por separado.
+		const std::vector<ClusterLightRange>& clusters = m_lightClusterGrid.GetClusters();
+		const std::vector<uint32_t>& lightIndices = m_lightClusterGrid.GetLightIndices();
+		const std::array<size_t, 4> sizes = {
+			std::max(m_pointLights.size() * sizeof(PointLight), sizeof(PointLight)),
+			std::max(m_spotLights.size() * sizeof(SpotLight), sizeof(SpotLight)),
+			clusters.size() * sizeof(ClusterLightRange),
+			std::max(lightIndices.size() * sizeof(uint32_t), sizeof(uint32_t))
+		};
+		const std::array<const void*, 4> sources = { m_pointLights.data(), m_spotLights.data(), clusters.data(), lightIndices.data() };
+		const std::array<size_t, 4> sourceSizes = { m_pointLights.size() * sizeof(PointLight), m_spotLights.size() * sizeof(SpotLight),
+			clusters.size() * sizeof(ClusterLightRange), lightIndices.size() * sizeof(uint32_t) };
+		const std::array<uint32_t, 4> bindings = { ShaderProgram::PointLightBufferBinding, ShaderProgram::SpotLightBufferBinding,
+			ShaderProgram::LightClusterBufferBinding, ShaderProgram::LightIndexBufferBinding };
+		size_t totalSize = 0;
+		for (size_t size : sizes)
+			totalSize += m_lightDataRing.AlignSize(size);
+		uint8_t* data = static_cast<uint8_t*>(m_lightDataRing.BeginFrame(totalSize));
+		size_t offset = 0;
+		for (size_t i = 0; i < sizes.size(); i++) {
+			if (sourceSizes[i] > 0)
+				std::memcpy(data + offset, sources[i], sourceSizes[i]);
+			m_lightDataRing.BindRange(bindings[i], offset, sizes[i]);
+			offset += m_lightDataRing.AlignSize(sizes[i]);
+		}
+		m_renderStatistics.storageBufferBytes += totalSize;
+	}
+
+	void Renderer::SubmitRenderQueue(bool rebuildDrawLists) noexcept {
+		if (rebuildDrawLists) {
+			BuildDrawBatches();
+			BuildDrawData();
+		}
+		WriteDrawData();
+		WriteMaterialData();
+		WriteSkinningPalettes();
+		WriteDrawCommands();
+		//Se recorren los grupos en el orden de la cola, solo se cambia el programa, el VAO o las texturas del material
+		//cuando difieren de los del grupo anterior. Los parametros de los materiales ya estan en la tabla de materiales.
+		RenderQueueStatistics statistics;
+		RenderDevice& device = RenderDevice::GetInstance();
+		uint32_t currentProgram = 0;
+		uint32_t currentVertexArray = 0;
+		uint32_t currentMaterialIndex = UINT32_MAX;
+		for (const DrawBatch& batch : m_drawBatches) {
+			const RenderItem& item = m_renderQueue.GetSortedItem(batch.firstItem);
+			const uint32_t program = item.material->GetShaderID();
+			if (program != currentProgram) {
+				currentProgram = program;
+				device.UseProgram(currentProgram);
+				statistics.programBinds++;
+			}
+			else
+				statistics.programBindsAvoided++;
+			if (item.vertexArrayID != currentVertexArray) {
+				currentVertexArray = item.vertexArrayID;
+				device.BindVertexArray(currentVertexArray);
+				statistics.vertexArrayBinds++;
+			}
+			else
+				statistics.vertexArrayBindsAvoided++;
+			if (currentMaterialIndex == UINT32_MAX || !m_materialTable.SharesTextures(currentMaterialIndex, item.materialIndex)) {
+				const MaterialTextures& textures = m_materialTable.GetTextures(item.materialIndex);
+				for (uint32_t t = 0; t < textures.count; t++)
+					device.BindTextureUnit(textures.units[t], textures.textureIDs[t]);
+				statistics.materialBinds++;
+			}
+			else
+				statistics.materialBindsAvoided++;
+			currentMaterialIndex = item.materialIndex;
+			if (batch.commandCount > 0) {
+				const size_t commandOffset = m_drawCommandRing.GetRegionOffset() + batch.firstCommand * sizeof(DrawElementsIndirectCommand);
+				device.MultiDrawElementsIndirect(GL_TRIANGLES, item.indexType, commandOffset, static_cast<int32_t>(batch.commandCount), 0);
+				for (uint32_t c = batch.firstCommand; c < batch.firstCommand + batch.commandCount; c++) {
+					m_renderStatistics.instances += m_drawCommands[c].instanceCount;
+					m_renderStatistics.triangles += static_cast<uint64_t>(m_drawCommands[c].count / 3) * m_drawCommands[c].instanceCount;
+					if (m_drawCommands[c].instanceCount > 1) {
+						statistics.instancedDrawCount++;
+						statistics.instanceCount += m_drawCommands[c].instanceCount;
+					}
+				}
+				statistics.indirectCommandCount += batch.commandCount;
+				statistics.multiDrawCount++;
+				statistics.drawCount++;
+				m_renderStatistics.drawCalls++;
+				continue;
+			}
+			//Las mallas animadas leen sus matrices y su paleta desde los buffers del frame a partir de firstItem.
+			device.SetUniform(ShaderProgram::DrawDataOffsetShaderLocation, static_cast<int32_t>(batch.firstItem));
+			device.DrawElements(GL_TRIANGLES, static_cast<int32_t>(item.indexCount), item.indexType, 0, static_cast<int32_t>(batch.count));
+			if (batch.count > 1) {
+				statistics.instancedDrawCount++;
+				statistics.instanceCount += batch.count;
+			}
+			statistics.drawCount++;
+			m_renderStatistics.drawCalls++;
+			m_renderStatistics.instances += batch.count;
+			m_renderStatistics.triangles += static_cast<uint64_t>(item.indexCount / 3) * batch.count;
+		}
+		m_drawDataRing.EndFrame();
+		m_materialDataRing.EndFrame();
+		m_drawCommandRing.EndFrame();
+		m_skinningPaletteRing.EndFrame();
+		m_lightDataRing.EndFrame();
+		m_renderQueueStatistics = statistics;
 	}
 
 	std::shared_ptr<Material> Renderer::CreateMaterial(MaterialType type, bool isForSkinning) {
 
 		unsigned int offset = static_cast<unsigned int>(type);
 		offset = isForSkinning ? offset + static_cast<unsigned int>(MaterialType::MaterialTypeCount) : offset;
+		std::shared_ptr<Material> material = CreateMaterialInstance(type, offset, isForSkinning);
+		if (material != nullptr)
+			material->m_shaderIndex = static_cast<uint8_t>(offset);
+		return material;
+	}
+
+	std::shared_ptr<Material> Renderer::CreateMaterialInstance(MaterialType type, unsigned int offset, bool isForSkinning) {
 		switch (type)
 		{
 		case Mona::MaterialType::UnlitFlat:
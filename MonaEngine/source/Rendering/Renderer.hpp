@@ -3,6 +3,7 @@
 #define RENDERER_HPP
 #include <vector>
 #include <array>
+#include <filesystem>
 #include <glm/glm.hpp>
 #include "../Event/EventManager.hpp"
 #include "../World/ComponentTypes.hpp"
@@ -15,6 +16,15 @@
 #include "SpotLightComponent.hpp"
 #include "PointLightComponent.hpp"
 #include "Material.hpp"
+#include "MaterialTable.hpp"
+#include "RenderQueue.hpp"
+#include "RenderStatistics.hpp"
+#include "FrustumCuller.hpp"
+#include "OcclusionCuller.hpp"
+#include "PotentiallyVisibleSet.hpp"
+#include "PersistentBufferRing.hpp"
+#include "LightClusterGrid.hpp"
+#include "SkinningPalette.hpp"
 #include "../DebugDrawing/DebugDrawingSystem.hpp"
 
 
@@ -25,9 +35,6 @@ namespace Mona {
 	class Renderer {
 	public:
 		static constexpr int NUM_HALF_MAX_DIRECTIONAL_LIGHTS = 1;
-		static constexpr int NUM_HALF_MAX_POINT_LIGHTS = 3;
-		static constexpr int NUM_HALF_MAX_SPOT_LIGHTS = 3;
-		static constexpr int NUM_MAX_BONES = 70;
 		Renderer() = default;
 		void StartUp(EventManager& eventManager, DebugDrawingSystem* debugDrawingSystemPtr) noexcept;
 		void Render(EventManager& eventManager,
@@ -43,7 +50,113 @@ namespace Mona {
 		void ShutDown(EventManager& eventManager) noexcept;
 		void OnWindowResizeEvent(const WindowResizeEvent& event);
 		std::shared_ptr<Material> CreateMaterial(MaterialType type, bool isForSkinning);
+		/*
+		* Sesgo aplicado al elegir el nivel de detalle de las mallas, valores mayores prefieren niveles mas simples.
+		*/
+		float GetLODBias() const noexcept { return m_lodBias; }
+		void SetLODBias(float bias) noexcept {
+			m_retainedDrawListsValid = m_retainedDrawListsValid && bias == m_lodBias;
+			m_lodBias = bias;
+		}
+		/*
+		* Agregan y quitan una malla de la lista de dibujo retenida, los llama StaticMeshLifetimePolicy al agregar o remover
+		* un StaticMeshComponent. Quitar una malla que forma parte de un lote estatico marca el lote para reconstruirse.
+		*/
+		void AddStaticMesh(const InnerComponentHandle& meshHandle, const InnerComponentHandle& transformHandle) noexcept;
+		void RemoveStaticMesh(const InnerComponentHandle& meshHandle, StaticMeshComponent& staticMesh) noexcept;
+		/*
+		* Retorna los contadores de llamados de dibujo y cambios de estado del ultimo frame.
+		*/
+		const RenderQueueStatistics& GetRenderQueueStatistics() const noexcept { return m_renderQueueStatistics; }
+		/*
+		* Retorna los contadores de dibujo, cambios de estado y datos subidos del ultimo frame.
+		*/
+		const RenderStatistics& GetRenderStatistics() const noexcept { return m_renderStatistics; }
+		/*
+		* Calcula el conjunto de objetos potencialmente visibles de las mallas estaticas actuales, todas ellas actuando como
+		* oclusoras. Es un proceso lento pensado para ejecutarse fuera del juego y guardar su resultado en un archivo.
+		*/
+		PotentiallyVisibleSet BakePotentiallyVisibleSet(ComponentManager<StaticMeshComponent>& staticMeshDataManager,
+			ComponentManager<TransformComponent>& transformDataManager,
+			const PVSBakeSettings& settings) noexcept;
+		/*
+		* Mientras la camara este dentro de la grilla del conjunto, las mallas estaticas que no son visibles desde su celda
+		* se descartan sin probarlas contra los oclusores.
+		*/
+		void SetPotentiallyVisibleSet(PotentiallyVisibleSet pvs) noexcept;
+		bool LoadPotentiallyVisibleSet(const std::filesystem::path& filePath) noexcept;
+		void ClearPotentiallyVisibleSet() noexcept;
+		/*
+		* Une las mallas marcadas como estaticas (ver StaticMeshComponent::SetStatic) cuyos materiales comparten entrada en la
+		* tabla de materiales (ver MaterialTable::MakeKey) y cuyas cajas tienen su centro en la misma celda de una grilla de lado
+		* cellSize. Cada grupo se convierte en una malla en espacio de mundo que se descarta y dibuja como un solo objeto con el
+		* material de una de sus mallas, y sus mallas originales dejan de dibujarse. Si luego cambian los parametros de uno de
+		* esos materiales debe volver a llamarse. Los lotes anteriores se descartan. Retorna la cantidad de lotes creados.
+		*/
+		uint32_t BuildStaticBatches(ComponentManager<StaticMeshComponent>& staticMeshDataManager,
+			ComponentManager<TransformComponent>& transformDataManager,
+			float cellSize) noexcept;
+		void ClearStaticBatches(ComponentManager<StaticMeshComponent>& staticMeshDataManager) noexcept;
+		uint32_t GetStaticBatchCount() const noexcept { return static_cast<uint32_t>(m_staticBatches.size()); }
 	private:
+		//Datos del frame usados al agregar mallas estaticas a la cola y contadores de grupos de triangulos.
+		struct StaticDrawContext {
+			glm::mat4 viewProjectionMatrix;
+			glm::vec3 cameraPosition;
+			float nearPlane;
+			float pixelsPerRadius;
+			uint32_t clusterCount;
+			uint32_t clusterCulledCount;
+		};
+		/*
+		* Elige el nivel de detalle de la malla, descarta sus grupos de triangulos no visibles y la agrega a la cola. Retorna
+		* false si todos sus grupos fueron descartados.
+		*/
+		bool PushStaticMesh(const Mesh& mesh, Material* material, const glm::mat4& modelMatrix, const glm::mat4* modelInverseTransposeMatrix,
+			const BoundingBox& worldBounds, float depth, uint8_t& lodLevel, StaticDrawContext& context) noexcept;
+		/*
+		* Descarta las mallas contra el frustum, el conjunto de objetos potencialmente visibles y los oclusores, y construye y
+		* ordena la cola de render con las visibles. Escribe en statistics los contadores de descarte.
+		*/
+		void CullAndQueueMeshes(const glm::mat4& viewProjectionMatrix,
+			const glm::mat4& projectionMatrix,
+			const glm::vec3& cameraPosition,
+			float nearPlane,
+			float farPlane,
+			ComponentManager<StaticMeshComponent>& staticMeshDataManager,
+			ComponentManager<SkeletalMeshComponent>& skeletalMeshDataManager,
+			ComponentManager<TransformComponent>& transformDataManager,
+			RenderQueueStatistics& statistics) noexcept;
+		/*
+		* Envia la cola de render a la GPU. Si rebuildDrawLists es falso se reutilizan los grupos, comandos y datos por objeto
+		* construidos a partir de la misma cola en un frame anterior.
+		*/
+		void SubmitRenderQueue(bool rebuildDrawLists) noexcept;
+		/*
+		* Saca una malla de su lote estatico y marca el lote para reconstruirse. La malla vuelve a dibujarse por separado.
+		*/
+		void RemoveFromStaticBatch(const InnerComponentHandle& meshHandle, StaticMeshComponent& staticMesh) noexcept;
+		/*
+		* Vuelve a unir la geometria de los lotes marcados con sus mallas restantes. Los lotes que quedan con menos de dos
+		* mallas se eliminan y su malla restante se dibuja por separado.
+		*/
+		void RebuildStaleStaticBatches(ComponentManager<StaticMeshComponent>& staticMeshDataManager,
+			ComponentManager<TransformComponent>& transformDataManager) noexcept;
+		void BuildDrawBatches() noexcept;
+		void BuildDrawData() noexcept;
+		void WriteDrawData() noexcept;
+		void WriteMaterialData() noexcept;
+		void WriteSkinningPalettes() noexcept;
+		void WriteDrawCommands() noexcept;
+		void EnsureDrawIndexCapacity(uint32_t count) noexcept;
+		void WriteClusteredLightData() noexcept;
+		/*
+		* Elige el nivel de detalle de una malla a partir del tamano en pixeles del radio de su esfera envolvente. Se usa el
+		* nivel mas simple cuyo error proyectado no supera el umbral, pero para cambiar desde currentLevel el error debe
+		* quedar bajo (o sobre) el umbral por un margen de m_lodHysteresis, evitando que el nivel alterne entre frames.
+		*/
+		uint8_t SelectMeshLOD(const Mesh& mesh, uint8_t currentLevel, float projectedRadius) const noexcept;
+		std::shared_ptr<Material> CreateMaterialInstance(MaterialType type, unsigned int offset, bool isForSkinning);
 		struct DirectionalLight
 		{
 			glm::vec3 colorIntensity; //12
@@ -68,20 +181,144 @@ namespace Mona {
 			float cosUmbraAngle; //48
 		};
 
+		//Las luces puntuales y spotlights no tienen limite y se entregan mediante buffers separados (ver LightClusterGrid),
+		//este bloque solo contiene las luces direccionales y la luz ambiental.
 		struct Lights {
-			SpotLight spotLights[2 * NUM_HALF_MAX_SPOT_LIGHTS];
-			PointLight pointLights[2 * NUM_HALF_MAX_POINT_LIGHTS]; 
 			DirectionalLight directionalLights[2 * NUM_HALF_MAX_DIRECTIONAL_LIGHTS]; 
 			glm::vec3 ambientLight; 
-			int spotLightsCount; 
-			int pointLightsCount; 
 			int directionalLightsCount; 
 		};
+		struct CameraData {
+			glm::mat4 viewProjectionMatrix; //64
+			glm::mat4 viewMatrix; //128
+			glm::vec3 cameraPosition; //140
+			float padding; //144
+			glm::vec2 clusterTileSize; //152
+			glm::vec2 clusterDepthSliceParameters; //160
+		};
+		//Grupo de elementos consecutivos de la cola de render que se dibujan con un unico llamado. Las matrices del i-esimo
+		//elemento de la cola se encuentran en la posicion i del buffer de datos por objeto. Los grupos de mallas estaticas
+		//(commandCount mayor a cero) comparten programa, texturas de material y VAO y se dibujan con
+		//glMultiDrawElementsIndirect usando los comandos [firstCommand, firstCommand + commandCount). Los grupos de mallas
+		//animadas comparten programa, texturas de material y SkinnedMesh y se dibujan con un llamado instanciado, firstItem es
+		//el desplazamiento que se entrega al shader. Cada elemento lee los parametros de su material desde la tabla.
+		struct DrawBatch {
+			uint32_t firstItem;
+			uint32_t count;
+			uint32_t firstCommand;
+			uint32_t commandCount;
+		};
+		//Formato definido por OpenGL para los comandos de glMultiDrawElementsIndirect.
+		struct DrawElementsIndirectCommand {
+			uint32_t count;
+			uint32_t instanceCount;
+			uint32_t firstIndex;
+			int32_t baseVertex;
+			uint32_t baseInstance;
+		};
+		//Debe coincidir con el layout std430 de DrawData en los shaders, el tamano de la estructura es multiplo de 16 bytes.
+		struct DrawData {
+			glm::mat4 modelMatrix; //64
+			glm::mat4 modelInverseTransposeMatrix; //128
+			uint32_t paletteOffset; //132
+			uint32_t materialIndex; //136
+			uint32_t padding[2]; //144
+		};
 		std::array<ShaderProgram, 2 * static_cast<unsigned int>(MaterialType::MaterialTypeCount)> m_shaders;
-		std::vector<glm::mat4> m_currentMatrixPalette;
+		std::vector<DrawBatch> m_drawBatches;
+		std::vector<DrawElementsIndirectCommand> m_drawCommands;
+		//Datos por objeto de la cola actual, se copian cada frame a la region correspondiente del buffer mapeado.
+		std::vector<DrawData> m_drawData;
+		//Rangos de indices de los grupos de triangulos visibles de las mallas estaticas del frame (ver RenderItem).
+		struct ClusterRange {
+			uint32_t firstIndex;
+			uint32_t indexCount;
+		};
+		std::vector<ClusterRange> m_clusterRanges;
+		bool m_clusterCullingEnabled = true;
+		PersistentBufferRing m_drawCommandRing;
+		//Buffer con los valores 0, 1, 2, ... que alimenta el atributo por instancia drawIndex de las mallas estaticas.
+		unsigned int m_drawIndexBufferID = 0;
+		uint32_t m_drawIndexCapacity = 0;
+		//Buffer triple mapeado de forma persistente con las matrices de cada objeto dibujado en el frame.
+		PersistentBufferRing m_drawDataRing;
+		//Parametros de los materiales de la cola actual, se reconstruye junto a ella y se copia cada frame a su buffer.
+		MaterialTable m_materialTable;
+		PersistentBufferRing m_materialDataRing;
+		unsigned int m_cameraDataUBO = 0;
+		//Luces puntuales y spotlights de la escena y su asignacion a clusters, en coordenadas de mundo las que se suben a la
+		//GPU y en coordenadas de camara las usadas para la asignacion.
+		std::vector<PointLight> m_pointLights;
+		std::vector<SpotLight> m_spotLights;
+		std::vector<ClusterPointLight> m_clusterPointLights;
+		std::vector<ClusterSpotLight> m_clusterSpotLights;
+		LightClusterGrid m_lightClusterGrid;
+		PersistentBufferRing m_lightDataRing;
+		glm::ivec2 m_viewportSize = glm::ivec2(1);
+		//Paletas de matrices de todas las mallas animadas del frame, una a continuacion de la otra. Se calculan en CPU durante
+		//el descarte (se necesitan para las cajas envolventes) y luego se codifican en el buffer mapeado con el formato
+		//m_skinningPaletteFormat.
+		std::vector<glm::mat4> m_skinningPalettes;
+		PersistentBufferRing m_skinningPaletteRing;
+		SkinningPaletteFormat m_skinningPaletteFormat = SkinningPaletteFormat::Affine3x4;
+		FrustumCuller m_frustumCuller;
+		//Datos de cada StaticMeshComponent que se mantienen entre frames. Las matrices se recalculan solo cuando la version de
+		//la transformacion difiere de transformVersion.
+		struct StaticMeshEntry {
+			InnerComponentHandle meshHandle;
+			InnerComponentHandle transformHandle;
+			uint32_t transformVersion;
+			glm::mat4 modelMatrix;
+			glm::mat4 modelInverseTransposeMatrix;
+		};
+		std::vector<StaticMeshEntry> m_staticMeshEntries;
+		//Posicion en m_staticMeshEntries de cada malla, indexada por el indice de su handle.
+		static constexpr uint32_t s_invalidEntryIndex = UINT32_MAX;
+		std::vector<uint32_t> m_staticMeshEntryIndices;
+		//Indica que se agregaron o quitaron mallas, o que cambiaron los lotes, desde el ultimo frame.
+		bool m_staticMeshListChanged = true;
+		//Posicion de la caja de cada malla estatica en el culler, s_invalidBoxIndex si forma parte de un lote. Las cajas de
+		//las mallas estaticas ocupan las primeras m_staticBoxCount posiciones del culler y se mantienen entre frames.
+		static constexpr uint32_t s_invalidBoxIndex = UINT32_MAX;
+		std::vector<uint32_t> m_staticMeshBoxIndices;
+		uint32_t m_staticBoxCount = 0;
+		//Camara, version de los parametros de materiales y version de la geometria estatica con que se construyo la cola
+		//actual. Mientras no cambien, ni cambien las mallas, la cola y los datos derivados de ella se reutilizan.
+		bool m_retainedDrawListsValid = false;
+		glm::mat4 m_retainedViewProjectionMatrix = glm::mat4(1.0f);
+		glm::vec3 m_retainedCameraPosition = glm::vec3(0.0f);
+		uint32_t m_retainedMaterialParametersVersion = 0;
+		uint32_t m_retainedGeometryVersion = 0;
+		static inline const glm::mat4 s_identityMatrix = glm::mat4(1.0f);
+		//Mallas estaticas unidas por BuildStaticBatches, con su geometria ya en espacio de mundo. Se guardan las mallas que
+		//forman cada lote para poder reconstruirlo cuando una de ellas lo abandona.
+		struct StaticBatch {
+			std::shared_ptr<Mesh> mesh;
+			std::shared_ptr<Material> material;
+			BoundingBox worldBounds;
+			uint8_t lodLevel = 0;
+			std::vector<InnerComponentHandle> members;
+			bool isStale = false;
+		};
+		std::vector<StaticBatch> m_staticBatches;
+		bool m_hasStaleStaticBatches = false;
+		//Descarte por oclusion en CPU contra las mallas estaticas marcadas como oclusoras, se omite si no hay oclusores.
+		OcclusionCuller m_occlusionCuller;
+		bool m_occlusionCullingEnabled = true;
+		//Conjunto de objetos potencialmente visibles precalculado, su version aumenta cada vez que cambia para que las mallas
+		//estaticas vuelvan a buscar su indice.
+		PotentiallyVisibleSet m_potentiallyVisibleSet;
+		uint32_t m_pvsVersion = 1;
 		SubscriptionHandle m_onWindowResizeSubscription;
 		DebugDrawingSystem* m_debugDrawingSystemPtr = nullptr;
 		unsigned int m_lightDataUBO = 0;
+		float m_lodBias = 0.0f;
+		//Error maximo en pixeles permitido al elegir un nivel de detalle (antes del sesgo) y margen relativo de histeresis.
+		float m_lodErrorThreshold = 1.0f;
+		float m_lodHysteresis = 0.2f;
+		RenderQueue m_renderQueue;
+		RenderQueueStatistics m_renderQueueStatistics;
+		RenderStatistics m_renderStatistics;
 
 	};
 }
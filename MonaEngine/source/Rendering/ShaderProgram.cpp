@@ -1,10 +1,10 @@
 #include "ShaderProgram.hpp"
 #include "Renderer.hpp"
+#include "SkinningPalette.hpp"
+#include "RenderDevice.hpp"
 #include "../Core/Log.hpp"
-#include <glad/glad.h>
 #include <sstream>
 #include <fstream>
-#include <glm/gtc/type_ptr.hpp>
 
 namespace Mona {
 
@@ -24,17 +24,14 @@ namespace Mona {
 
 		if (vertexShaderCode.length() == 0 || pixelShaderCode.length() == 0)
 			return;
-		//Intento de Compilar ambos shaders
-		unsigned int vertex = CompileShader(vertexShaderCode, vertexShaderPath, GL_VERTEX_SHADER);
-		unsigned int pixel = CompileShader(pixelShaderCode, pixelShaderPath, GL_FRAGMENT_SHADER);
-		
-		if (vertex && pixel)
-		{
-			//En caso de exito linkeamos el programa
-			LinkProgram(vertex, pixel);
+		//Intento de compilar y linkear ambos shaders
+		std::string errorLog;
+		m_programID = RenderDevice::GetInstance().CreateProgram(vertexShaderCode, pixelShaderCode, errorLog);
+		if (m_programID == 0) {
+			MONA_LOG_ERROR("ShaderProgram Error: {0}", errorLog);
+			MONA_LOG_ERROR("File Location: {0}, {1}", vertexShaderPath.string(), pixelShaderPath.string());
+			MONA_ASSERT(false, "");
 		}
-
-
 	}
 
 
@@ -50,7 +47,7 @@ namespace Mona {
 		if (&a == this)
 			return *this;
 		if (m_programID)
-			glDeleteProgram(m_programID);
+			RenderDevice::GetInstance().DeleteProgram(m_programID);
 		m_programID = a.m_programID;
 		a.m_programID = 0;
 		return *this;
@@ -71,72 +68,18 @@ namespace Mona {
 		return shaderStream.str();
 	}
 
-	unsigned int ShaderProgram::CompileShader(const std::string& code, const std::filesystem::path& shaderPath, unsigned int type) const noexcept
-	{
-
-		unsigned int shader = glCreateShader(type);
-		const char* cCode = code.c_str();
-		glShaderSource(shader, 1, &cCode, 0);
-		glCompileShader(shader);
-		GLint isCompiled = 0;
-		glGetShaderiv(shader, GL_COMPILE_STATUS, &isCompiled);
-		//Chequeo de errores de compilacin
-		if (isCompiled == GL_FALSE)
-		{
-			GLint maxLength = 0;
-			glGetShaderiv(shader, GL_INFO_LOG_LENGTH, &maxLength);
-			std::vector<GLchar> errorLog(maxLength);
-			glGetShaderInfoLog(shader, maxLength, &maxLength, &errorLog[0]);
-			glDeleteShader(shader);
-			MONA_LOG_ERROR("ShaderProgram Error: {0}", errorLog.data());
-			MONA_LOG_ERROR("File Location: {0}", shaderPath.string());
-			MONA_ASSERT(false, "");
-			return 0;
-		}
-		return shader;
-
-	}
-
-	void ShaderProgram::LinkProgram(unsigned int vertex, unsigned int pixel) noexcept
-	{
-		unsigned int program = glCreateProgram();
-		glAttachShader(program, vertex);
-		glAttachShader(program, pixel);
-		glLinkProgram(program);
-		GLint isLinked = 0;
-		glGetProgramiv(program, GL_LINK_STATUS, (int*)&isLinked);
-		//Chequeo de error de linkeo
-		if (isLinked == GL_FALSE)
-		{
-			GLint maxLength = 0;
-			glGetProgramiv(program, GL_INFO_LOG_LENGTH, &maxLength);
-			std::vector<GLchar> infoLog(maxLength);
-			glGetProgramInfoLog(program, maxLength, &maxLength, &infoLog[0]);
-			glDeleteProgram(program);
-			glDeleteShader(vertex);
-			glDeleteShader(pixel);
-
-			MONA_LOG_ERROR("Shader Linking Error: {0}", infoLog.data());
-			MONA_ASSERT(false, "");
-			return;
-		}
-
-		glDetachShader(program, vertex);
-		glDetachShader(program, pixel);
-		m_programID = program;
-	}
-
 	void ShaderProgram::PreProcessCode(std::string& code)
 	{
 		struct ShaderConstant {
 			std::string key;
 			std::string value;
 		};
-		std::array<ShaderConstant,4> constants = {{
+		std::array<ShaderConstant,5> constants = {{
 			{"${MAX_DIRECTIONAL_LIGHTS}", std::to_string(Renderer::NUM_HALF_MAX_DIRECTIONAL_LIGHTS * 2)},
-			{"${MAX_SPOT_LIGHTS}", std::to_string(Renderer::NUM_HALF_MAX_SPOT_LIGHTS * 2)} ,
-			{"${MAX_POINT_LIGHTS}", std::to_string(Renderer::NUM_HALF_MAX_POINT_LIGHTS * 2)},
-			{"${MAX_BONES}", std::to_string(Renderer::NUM_MAX_BONES)}} };
+			{"${CLUSTER_GRID_X}", std::to_string(LightClusterGrid::s_gridX)},
+			{"${CLUSTER_GRID_Y}", std::to_string(LightClusterGrid::s_gridY)},
+			{"${CLUSTER_GRID_Z}", std::to_string(LightClusterGrid::s_gridZ)},
+			{"${SKINNING_FORMAT}", std::to_string(static_cast<int>(GetSkinningPaletteFormat()))}} };
 		
 		for (ShaderConstant& c : constants) {
 			size_t pos = 0;
@@ -152,7 +95,7 @@ namespace Mona {
 	ShaderProgram::~ShaderProgram()
 	{
 		if(m_programID)
-			glDeleteProgram(m_programID);
+			RenderDevice::GetInstance().DeleteProgram(m_programID);
 	}
 
 }
\ No newline at end of file
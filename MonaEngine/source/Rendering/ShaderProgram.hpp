@@ -8,33 +8,41 @@
 namespace Mona {
 	class ShaderProgram {
 	public:
-		static constexpr int MvpMatrixShaderLocation = 0;
-		static constexpr int ModelMatrixShaderLocation = 1;
-		static constexpr int ModelInverseTransposeMatrixShaderLocation = 2;
-		static constexpr int UnlitColorShaderLocation = 3;
 		static constexpr int UnlitColorTextureSamplerShaderLocation = 3;
 		static constexpr int UnlitColorTextureUnit = 0;
-		static constexpr int DiffuseColorShaderLocation = 3;
 		static constexpr int DiffuseTextureSamplerShaderLocation = 3;
 		static constexpr int DiffuseTextureUnit = 0;
-		static constexpr int AlbedoShaderLocation = 3;
 		static constexpr int AlbedoTextureSamplerShaderLocation = 3;
 		static constexpr int AlbedoTextureUnit = 0;
 		static constexpr int NormalMapSamplerShaderLocation = 5;
 		static constexpr int NormalMapTextureUnit = 1;
-		static constexpr int MetallicShaderLocation = 6;
 		static constexpr int MetallicSamplerShaderLocation = 6;
 		static constexpr int MetallicTextureUnit = 2;
-		static constexpr int RoughnessShaderLocation = 7;
 		static constexpr int RoughnessSamplerShaderLocation = 7;
 		static constexpr int RoughnessTextureUnit = 3;
-		static constexpr int AmbientOcclusionShaderLocation = 8;
 		static constexpr int AmbientOcclusionSamplerShaderLocation = 8;
 		static constexpr int AmbientOcclusionTextureUnit = 4;
-		static constexpr int MaterialTintShaderLocation = 4;
 		static constexpr int LightsUniformBlockBinding = 0;
-		static constexpr int CameraPositionShaderLocation = 9;
-		static constexpr int BoneTransformShaderLocation = 10;
+		//Las matrices de cada objeto se leen desde un buffer (DrawDataBufferBinding). Las mallas animadas las leen en la
+		//posicion indicada por la uniforme DrawDataOffsetShaderLocation, las mallas estaticas (dibujadas con comandos
+		//indirectos) en la posicion entregada por el atributo por instancia DrawIndexAttributeLocation. La matriz de vista y
+		//proyeccion y la posicion de la camara se leen desde un bloque uniforme compartido por todos los shaders.
+		static constexpr int DrawDataOffsetShaderLocation = 12;
+		static constexpr int DrawIndexAttributeLocation = 5;
+		static constexpr int DrawDataBufferBinding = 1;
+		static constexpr int CameraUniformBlockBinding = 2;
+		//Buffers de luces puntuales y spotlights, rango de luces de cada cluster e indices de luces (ver LightClusterGrid).
+		static constexpr int PointLightBufferBinding = 3;
+		static constexpr int SpotLightBufferBinding = 4;
+		static constexpr int LightClusterBufferBinding = 5;
+		static constexpr int LightIndexBufferBinding = 6;
+		//Paletas de skinning de todas las mallas animadas del frame, cada objeto lee la suya a partir de su paletteOffset. El
+		//formato de cada articulacion (ver SkinningPaletteFormat) se inyecta en los shaders como ${SKINNING_FORMAT}.
+		static constexpr int SkinningPaletteBufferBinding = 7;
+		//Parametros de todos los materiales dibujados en el frame (ver MaterialTable), cada objeto lee los suyos a partir del
+		//materialIndex de sus datos por objeto. Los puntos de enlace de buffers de almacenamiento son independientes de los
+		//de bloques uniformes, por lo que no entra en conflicto con LightsUniformBlockBinding.
+		static constexpr int MaterialDataBufferBinding = 0;
 
 
 		ShaderProgram(const std::filesystem::path& vertexShaderPath,
@@ -49,8 +57,6 @@ namespace Mona {
 
 	private:
 		std::string LoadCode(const std::filesystem::path& shaderPath) const noexcept;
-		unsigned int CompileShader(const std::string& code, const std::filesystem::path& shaderPath, unsigned int type) const noexcept;
-		void LinkProgram(unsigned int vertex, unsigned int pixel) noexcept;
 		void PreProcessCode(std::string& code);
 		uint32_t m_programID;
 	};
@@ -2,11 +2,29 @@
 layout (location = 0) in vec3 aPos;
 layout (location = 1) in vec3 aNormal;
 layout (location = 2) in vec2 aTexCoord;
-layout (location = 3) in vec3 aTangent;
-layout (location = 4) in vec3 aBitangent;
-layout(location = 0) uniform mat4 mvpMatrix;
-layout(location = 1) uniform mat4 modelMatrix;
-layout(location = 2) uniform mat4 modelInverseTransposeMatrix;
+//El componente w de la tangente guarda el signo de la bitangente.
+layout (location = 3) in vec4 aTangent;
+layout (location = 5) in uint drawIndex;
+layout(std140, binding = 2) uniform Camera {
+	mat4 viewProjectionMatrix;
+	mat4 viewMatrix;
+	vec3 cameraPosition;
+	vec2 clusterTileSize;
+	vec2 clusterDepthSliceParameters;
+};
+
+//Matrices de cada objeto, escritas por el renderer una vez por frame. drawIndex es un atributo por instancia cuyo valor es
+//baseInstance mas el indice de instancia del comando indirecto que dibuja al objeto.
+struct DrawData {
+	mat4 modelMatrix;
+	mat4 modelInverseTransposeMatrix;
+	uint paletteOffset;
+	uint materialIndex;
+};
+
+layout(std430, binding = 1) readonly buffer DrawDataBuffer {
+	DrawData drawData[];
+};
 
 //out vec3 normal;
 out vec3 worldPos;
@@ -15,11 +33,19 @@ out vec3 normal;
 out vec3 tangent;
 out vec3 bitangent;
 
+//Indice de los parametros del material del objeto dentro de la tabla de materiales.
+flat out uint materialIndex;
+
 void main()
 {
+	DrawData data = drawData[drawIndex];
+	materialIndex = data.materialIndex;
+	mat4 modelMatrix = data.modelMatrix;
+	mat4 modelInverseTransposeMatrix = data.modelInverseTransposeMatrix;
+	mat4 mvpMatrix = viewProjectionMatrix * modelMatrix;
 	normal = normalize(mat3(modelInverseTransposeMatrix) * aNormal);
-	tangent = normalize(mat3(modelMatrix)* aTangent);
-	bitangent = normalize(mat3(modelMatrix)* aBitangent);
+	tangent = normalize(mat3(modelMatrix)* aTangent.xyz);
+	bitangent = normalize(mat3(modelMatrix)* (cross(aNormal, aTangent.xyz) * aTangent.w));
 
 	texCoord = aTexCoord;
 	worldPos = vec3(modelMatrix * vec4(aPos,1.0f));
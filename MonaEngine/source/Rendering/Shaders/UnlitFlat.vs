@@ -1,11 +1,37 @@
 #version 450 core
 layout (location = 0) in vec3 aPos;
-layout(location = 0) uniform mat4 mvpMatrix;
-layout(location = 1) uniform mat4 modelMatrix;
-layout(location = 2) uniform mat4 modelInverseTransposeMatrix;
+layout (location = 5) in uint drawIndex;
+layout(std140, binding = 2) uniform Camera {
+	mat4 viewProjectionMatrix;
+	mat4 viewMatrix;
+	vec3 cameraPosition;
+	vec2 clusterTileSize;
+	vec2 clusterDepthSliceParameters;
+};
 
+//Matrices de cada objeto, escritas por el renderer una vez por frame. drawIndex es un atributo por instancia cuyo valor es
+//baseInstance mas el indice de instancia del comando indirecto que dibuja al objeto.
+struct DrawData {
+	mat4 modelMatrix;
+	mat4 modelInverseTransposeMatrix;
+	uint paletteOffset;
+	uint materialIndex;
+};
+
+layout(std430, binding = 1) readonly buffer DrawDataBuffer {
+	DrawData drawData[];
+};
+
+
+//Indice de los parametros del material del objeto dentro de la tabla de materiales.
+flat out uint materialIndex;
 
 void main()
 {
+	DrawData data = drawData[drawIndex];
+	materialIndex = data.materialIndex;
+	mat4 modelMatrix = data.modelMatrix;
+	mat4 modelInverseTransposeMatrix = data.modelInverseTransposeMatrix;
+	mat4 mvpMatrix = viewProjectionMatrix * modelMatrix;
 	gl_Position = mvpMatrix * vec4(aPos,1.0);
 }
\ No newline at end of file
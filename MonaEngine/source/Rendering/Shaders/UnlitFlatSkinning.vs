@@ -1,19 +1,122 @@
 #version 450 core
 layout (location = 0) in vec3 aPos;
-layout (location = 5) in vec4 aBoneIndices;
+layout (location = 5) in uvec4 aBoneIndices;
 layout (location = 6) in vec4 aBoneWeights;
-layout(location = 0) uniform mat4 mvpMatrix;
-layout(location = 1) uniform mat4 modelMatrix;
-layout(location = 2) uniform mat4 modelInverseTransposeMatrix;
+layout(std140, binding = 2) uniform Camera {
+	mat4 viewProjectionMatrix;
+	mat4 viewMatrix;
+	vec3 cameraPosition;
+	vec2 clusterTileSize;
+	vec2 clusterDepthSliceParameters;
+};
+layout(location = 12) uniform int drawDataOffset;
 
-layout(location = 10) uniform mat4 boneTransforms[${MAX_BONES}];
+//Matrices de cada objeto, escritas por el renderer una vez por frame. Los llamados instanciados leen una entrada por instancia.
+struct DrawData {
+	mat4 modelMatrix;
+	mat4 modelInverseTransposeMatrix;
+	uint paletteOffset;
+	uint materialIndex;
+};
+
+layout(std430, binding = 1) readonly buffer DrawDataBuffer {
+	DrawData drawData[];
+};
+
+#define SKINNING_MATRIX4 0
+#define SKINNING_AFFINE3X4 1
+#define SKINNING_DUAL_QUATERNION 2
+#define SKINNING_FORMAT ${SKINNING_FORMAT}
+
+//Paletas de skinning de todas las mallas animadas del frame, la paleta de cada objeto comienza en la articulacion
+//paletteOffset. Cada articulacion ocupa 4 vec4 (columnas de una matriz), 3 vec4 (filas de una matriz afin) o 2 vec4
+//(cuaternion dual con la escala en el largo de la parte real) segun SKINNING_FORMAT.
+layout(std430, binding = 7) readonly buffer SkinningPaletteBuffer {
+	vec4 palette[];
+};
+
+#if SKINNING_FORMAT == SKINNING_DUAL_QUATERNION
+vec4 skinRotation;
+vec3 skinTranslation;
+float skinScale;
+
+vec3 RotateVector(vec4 q, vec3 v) {
+	return v + 2.0 * cross(q.xyz, cross(q.xyz, v) + q.w * v);
+}
+
+//Mezcla lineal de los cuaterniones duales de las articulaciones que influyen al vertice. Los cuaterniones opuestos a
+//la primera articulacion se invierten para interpolar por el camino corto.
+void ComputeSkinning(uint paletteOffset) {
+	uint first = 2 * (paletteOffset + aBoneIndices.x);
+	vec4 firstReal = palette[first];
+	vec4 real = firstReal * aBoneWeights.x;
+	vec4 dual = palette[first + 1] * aBoneWeights.x;
+	for (int i = 1; i < 4; i++) {
+		uint joint = 2 * (paletteOffset + aBoneIndices[i]);
+		vec4 jointReal = palette[joint];
+		float weight = dot(jointReal, firstReal) < 0.0 ? -aBoneWeights[i] : aBoneWeights[i];
+		real += jointReal * weight;
+		dual += palette[joint + 1] * weight;
+	}
+	skinScale = length(real);
+	skinRotation = real / skinScale;
+	dual /= skinScale;
+	skinTranslation = 2.0 * (skinRotation.w * dual.xyz - dual.w * skinRotation.xyz + cross(skinRotation.xyz, dual.xyz));
+}
+
+vec3 SkinPosition(vec3 position) {
+	return skinScale * RotateVector(skinRotation, position) + skinTranslation;
+}
+
+vec3 SkinVector(vec3 v) {
+	return RotateVector(skinRotation, v);
+}
+
+vec3 SkinNormal(vec3 n) {
+	return RotateVector(skinRotation, n);
+}
+#else
+mat4 skinMatrix;
+
+void ComputeSkinning(uint paletteOffset) {
+	skinMatrix = mat4(0.0);
+	for (int i = 0; i < 4; i++) {
+#if SKINNING_FORMAT == SKINNING_MATRIX4
+		uint joint = 4 * (paletteOffset + aBoneIndices[i]);
+		skinMatrix += mat4(palette[joint], palette[joint + 1], palette[joint + 2], palette[joint + 3]) * aBoneWeights[i];
+#else
+		uint joint = 3 * (paletteOffset + aBoneIndices[i]);
+		skinMatrix += transpose(mat4(palette[joint], palette[joint + 1], palette[joint + 2], vec4(0.0))) * aBoneWeights[i];
+#endif
+	}
+#if SKINNING_FORMAT == SKINNING_AFFINE3X4
+	skinMatrix[3][3] = 1.0;
+#endif
+}
+
+vec3 SkinPosition(vec3 position) {
+	return vec3(skinMatrix * vec4(position, 1.0));
+}
+
+vec3 SkinVector(vec3 v) {
+	return mat3(skinMatrix) * v;
+}
+
+//La matriz de cofactores es proporcional a la inversa traspuesta, basta para transformar normales que luego se normalizan.
+vec3 SkinNormal(vec3 n) {
+	mat3 m = mat3(skinMatrix);
+	return mat3(cross(m[1], m[2]), cross(m[2], m[0]), cross(m[0], m[1])) * n;
+}
+#endif
+
+//Indice de los parametros del material del objeto dentro de la tabla de materiales.
+flat out uint materialIndex;
 
 void main()
 {
-	mat4 boneTransform  =  mat4(0.0);
-	boneTransform  +=    boneTransforms[int(aBoneIndices.x)] * aBoneWeights.x;
-	boneTransform  +=    boneTransforms[int(aBoneIndices.y)] * aBoneWeights.y;
-	boneTransform  +=    boneTransforms[int(aBoneIndices.z)] * aBoneWeights.z;
-	boneTransform  +=    boneTransforms[int(aBoneIndices.w)] * aBoneWeights.w;	
-	gl_Position = mvpMatrix * boneTransform * vec4(aPos,1.0);
-}
\ No newline at end of file
+	DrawData data = drawData[drawDataOffset + gl_InstanceID];
+	materialIndex = data.materialIndex;
+	mat4 modelMatrix = data.modelMatrix;
+	ComputeSkinning(data.paletteOffset);
+	gl_Position = viewProjectionMatrix * modelMatrix * vec4(SkinPosition(aPos), 1.0);
+}
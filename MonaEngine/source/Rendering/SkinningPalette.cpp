@@ -0,0 +1,72 @@
+#include "SkinningPalette.hpp"
+#include "../Core/Config.hpp"
+#include "../Core/Log.hpp"
+#include <glm/gtc/quaternion.hpp>
+#include <string>
+namespace Mona {
+
+	SkinningPaletteFormat GetSkinningPaletteFormat() noexcept {
+		static const SkinningPaletteFormat s_format = []() {
+			const std::string value = Config::GetInstance().getValueOrDefault<std::string>("skinning_palette_format", "affine3x4");
+			if (value == "matrix4")
+				return SkinningPaletteFormat::Matrix4;
+			if (value == "dual_quaternion")
+				return SkinningPaletteFormat::DualQuaternion;
+			if (value != "affine3x4")
+				MONA_LOG_ERROR("SkinningPalette Error: Unknown skinning_palette_format {0}, using affine3x4.", value);
+			return SkinningPaletteFormat::Affine3x4;
+		}();
+		return s_format;
+	}
+
+	void EncodeSkinningPalette(SkinningPaletteFormat format, const glm::mat4* matrixPalette, size_t count, void* destination) noexcept {
+		float* out = static_cast<float*>(destination);
+		if (format == SkinningPaletteFormat::DualQuaternion) {
+			for (size_t i = 0; i < count; i++) {
+				const glm::mat4& matrix = matrixPalette[i];
+				//La escala de cada eje es el largo de su columna y la rotacion se obtiene de las columnas normalizadas. Si la
+				//matriz tiene cizalle las columnas normalizadas no son ortogonales y la rotacion resultante es aproximada.
+				const glm::vec3 scale(glm::length(glm::vec3(matrix[0])), glm::length(glm::vec3(matrix[1])), glm::length(glm::vec3(matrix[2])));
+				glm::mat3 rotation(1.0f);
+				for (int c = 0; c < 3; c++) {
+					if (scale[c] > 0.0f)
+						rotation[c] = glm::vec3(matrix[c]) / scale[c];
+				}
+				const glm::fquat q = glm::normalize(glm::quat_cast(rotation));
+				const glm::vec3 t(matrix[3]);
+				//Parte dual = 0.5 * t * q, con t como cuaternion puro. Ambas partes se multiplican por la escala uniforme,
+				//el shader la recupera como el largo de la parte real mezclada.
+				const float s = (scale.x + scale.y + scale.z) * (1.0f / 3.0f);
+				const float h = 0.5f * s;
+				out[0] = s * q.x;
+				out[1] = s * q.y;
+				out[2] = s * q.z;
+				out[3] = s * q.w;
+				out[4] = h * (t.x * q.w + t.y * q.z - t.z * q.y);
+				out[5] = h * (-t.x * q.z + t.y * q.w + t.z * q.x);
+				out[6] = h * (t.x * q.y - t.y * q.x + t.z * q.w);
+				out[7] = h * (-t.x * q.x - t.y * q.y - t.z * q.z);
+				out += 8;
+			}
+			return;
+		}
+
+		for (size_t i = 0; i < count; i++) {
+			const glm::mat4& matrix = matrixPalette[i];
+			if (format == SkinningPaletteFormat::Matrix4) {
+				//Columnas de la matriz, tal como las almacena glm.
+				for (int c = 0; c < 4; c++) {
+					for (int r = 0; r < 4; r++)
+						*out++ = matrix[c][r];
+				}
+			}
+			else {
+				//Filas de la matriz, la cuarta fila (0, 0, 0, 1) se omite.
+				for (int r = 0; r < 3; r++) {
+					for (int c = 0; c < 4; c++)
+						*out++ = matrix[c][r];
+				}
+			}
+		}
+	}
+}
@@ -0,0 +1,53 @@
+#pragma once
+#ifndef SKINNINGPALETTE_HPP
+#define SKINNINGPALETTE_HPP
+#include <cstdint>
+#include <cstddef>
+#include <glm/glm.hpp>
+namespace Mona {
+	/*
+	* Formato en que se sube a la GPU la transformacion de cada articulacion de una paleta de skinning:
+	* - Matrix4: matriz completa de 4x4 (64 bytes por articulacion).
+	* - Affine3x4: las tres primeras filas de la matriz, la ultima siempre es (0, 0, 0, 1) (48 bytes).
+	* - DualQuaternion: cuaternion dual con la escala uniforme codificada en el largo de la parte real (32 bytes). Es el
+	*   unico formato aproximado: las escalas no uniformes se reemplazan por el promedio del largo de las columnas y el
+	*   cizalle que pueda tener la matriz se pierde.
+	* Ninguno de los formatos requiere invertir matrices por vertice para transformar normales.
+	*/
+	enum class SkinningPaletteFormat : uint8_t {
+		Matrix4,
+		Affine3x4,
+		DualQuaternion
+	};
+
+	/*
+	* Formato configurado con la llave skinning_palette_format ("matrix4", "affine3x4" o "dual_quaternion"). Se lee una
+	* unica vez, pues los shaders de skinning se compilan para un formato especifico.
+	*/
+	SkinningPaletteFormat GetSkinningPaletteFormat() noexcept;
+
+	/*
+	* Cantidad de vec4 que ocupa cada articulacion en el formato entregado.
+	*/
+	constexpr uint32_t GetSkinningPaletteVec4Count(SkinningPaletteFormat format) noexcept {
+		switch (format) {
+		case SkinningPaletteFormat::Matrix4:
+			return 4;
+		case SkinningPaletteFormat::Affine3x4:
+			return 3;
+		default:
+			return 2;
+		}
+	}
+
+	constexpr size_t GetSkinningPaletteStride(SkinningPaletteFormat format) noexcept {
+		return GetSkinningPaletteVec4Count(format) * 4 * sizeof(float);
+	}
+
+	/*
+	* Escribe las count matrices de skinning entregadas (pose actual por inversa de la bind pose) en destination con el
+	* formato pedido. destination suele ser memoria mapeada, por lo que solo se escribe de forma secuencial.
+	*/
+	void EncodeSkinningPalette(SkinningPaletteFormat format, const glm::mat4* matrixPalette, size_t count, void* destination) noexcept;
+}
+#endif
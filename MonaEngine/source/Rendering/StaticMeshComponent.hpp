@@ -7,11 +7,12 @@
 #include "Material.hpp"
 namespace Mona {
 	class TransformComponent;
+	class StaticMeshLifetimePolicy;
 	class StaticMeshComponent
 	{
 	public:
 		friend class Renderer;
-		using LifetimePolicyType = DefaultLifetimePolicy<StaticMeshComponent>;
+		using LifetimePolicyType = StaticMeshLifetimePolicy;
 		using dependencies = DependencyList<TransformComponent>;
 		static constexpr std::string_view componentName = "StaticMeshComponent";
 		static constexpr uint8_t componentIndex = GetComponentIndex(EComponentType::StaticMeshComponent);
@@ -30,6 +31,24 @@ namespace Mona {
 			return m_meshPtr->GetVertexArrayID();
 		}
 
+		/*
+		* Las mallas marcadas como oclusoras se rasterizan en CPU cada frame y ocultan a los objetos que quedan completamente
+		* detras de ellas. Conviene marcar solo geometria grande y simple, como muros o edificios.
+		*/
+		void SetOccluder(bool isOccluder) noexcept {
+			m_isDirty = m_isDirty || isOccluder != m_isOccluder;
+			m_isOccluder = isOccluder;
+		}
+		bool IsOccluder() const noexcept { return m_isOccluder; }
+
+		/*
+		* Las mallas estaticas que casi nunca se mueven ni se destruyen pueden marcarse para que World::BuildStaticBatches las
+		* una con otras del mismo material. Si una malla de un lote se mueve, cambia de material o se destruye, sale del lote y
+		* el renderer vuelve a construir el lote con las mallas restantes antes del siguiente frame.
+		*/
+		void SetStatic(bool isStatic) noexcept { m_isStatic = isStatic; }
+		bool IsStatic() const noexcept { return m_isStatic; }
+
 		std::shared_ptr<Material> GetMaterial() const noexcept {
 			return m_materialPtr;
 		}
@@ -38,6 +57,7 @@ namespace Mona {
 			if (material != nullptr)
 			{
 				MONA_ASSERT(!material->IsForSkinning(), "StaticMeshComponent Error: Material cannot be used for this type of Mesh");
+				m_isDirty = m_isDirty || material != m_materialPtr;
 				m_materialPtr = material;
 			}
 		}
@@ -46,6 +66,22 @@ namespace Mona {
 	private:
 		std::shared_ptr<Mesh> m_meshPtr;
 		std::shared_ptr<Material> m_materialPtr;
+		//Caja envolvente en espacio de mundo, el renderer la recalcula cuando cambia la transformacion.
+		BoundingBox m_worldBounds;
+		//Indica al renderer que cambio el material o el estado de oclusor, por lo que no puede reutilizar su cola retenida.
+		bool m_isDirty = false;
+		//Nivel de detalle usado en el ultimo frame, el renderer lo mantiene mientras el cambio no supere la histeresis.
+		uint8_t m_lodLevel = 0;
+		bool m_isOccluder = false;
+		bool m_isStatic = false;
+		//Posicion en la lista de lotes estaticos del renderer del lote que contiene a la malla, s_invalidStaticBatchIndex si
+		//no forma parte de uno.
+		static constexpr uint32_t s_invalidStaticBatchIndex = UINT32_MAX;
+		uint32_t m_staticBatchIndex = s_invalidStaticBatchIndex;
+		//Indice del objeto en el conjunto de objetos potencialmente visibles del renderer y version del conjunto con la que
+		//fue buscado, cero obliga a buscarlo nuevamente (por ejemplo luego de que la caja cambia).
+		uint32_t m_pvsObjectIndex = UINT32_MAX;
+		uint32_t m_pvsVersion = 0;
 	};
 }
 #endif
\ No newline at end of file
@@ -0,0 +1,28 @@
+#pragma once
+#ifndef STATICMESHLIFETIMEPOLICY_HPP
+#define STATICMESHLIFETIMEPOLICY_HPP
+#include "../World/GameObject.hpp"
+#include "../World/TransformComponent.hpp"
+#include "StaticMeshComponent.hpp"
+#include "Renderer.hpp"
+namespace Mona {
+	/*
+	* Clase que representa las polizas de agregar y remover una instancia de StaticMeshComponent a un GameObject. Mantiene
+	* al dia la lista de dibujo retenida del renderer, de manera que este no necesita recorrer los GameObjects de las mallas
+	* cada frame.
+	*/
+	class StaticMeshLifetimePolicy {
+	public:
+		StaticMeshLifetimePolicy() = default;
+		StaticMeshLifetimePolicy(Renderer* rendererPtr) : m_rendererPtr(rendererPtr) {}
+		void OnAddComponent(GameObject* gameObjectPtr, StaticMeshComponent& staticMesh, const InnerComponentHandle& handle) noexcept {
+			m_rendererPtr->AddStaticMesh(handle, gameObjectPtr->GetInnerComponentHandle<TransformComponent>());
+		}
+		void OnRemoveComponent(GameObject* gameObjectPtr, StaticMeshComponent& staticMesh, const InnerComponentHandle& handle) noexcept {
+			m_rendererPtr->RemoveStaticMesh(handle, staticMesh);
+		}
+	private:
+		Renderer* m_rendererPtr = nullptr;
+	};
+}
+#endif
@@ -1,6 +1,7 @@
 #include "Texture.hpp"
 
 #include <stb_image.h>
+#include "RenderDevice.hpp"
 #include "../Core/Log.hpp"
 #include <glad/glad.h>
 namespace Mona {
@@ -65,20 +66,20 @@ namespace Mona {
 	}
 	
 	void Texture::SetSWrapMode(WrapMode wrapMode) noexcept{
-		glTextureParameteri(m_ID,GL_TEXTURE_WRAP_S, WrapEnumToOpenGLEnum(wrapMode));
+		RenderDevice::GetInstance().SetTextureParameter(m_ID, GL_TEXTURE_WRAP_S, WrapEnumToOpenGLEnum(wrapMode));
 	}
 
 	void Texture::SetTWrapMode(WrapMode wrapMode) noexcept {
-		glTextureParameteri(m_ID, GL_TEXTURE_WRAP_T, WrapEnumToOpenGLEnum(wrapMode));
+		RenderDevice::GetInstance().SetTextureParameter(m_ID, GL_TEXTURE_WRAP_T, WrapEnumToOpenGLEnum(wrapMode));
 	}
 
 	void Texture::SetMagnificationFilter(TextureMagnificationFilter magFilter) noexcept {
-		glTextureParameteri(m_ID, GL_TEXTURE_MAG_FILTER, MagnificationFilterEnumToOpenGLEnum(magFilter));
+		RenderDevice::GetInstance().SetTextureParameter(m_ID, GL_TEXTURE_MAG_FILTER, MagnificationFilterEnumToOpenGLEnum(magFilter));
 		
 	}
 
 	void Texture::SetMinificationFilter(TextureMinificationFilter minFilter) noexcept {
-		glTextureParameteri(m_ID, GL_TEXTURE_MIN_FILTER, MinificationFilterEnumToOpenGLEnum(minFilter));
+		RenderDevice::GetInstance().SetTextureParameter(m_ID, GL_TEXTURE_MIN_FILTER, MinificationFilterEnumToOpenGLEnum(minFilter));
 	}
 
 	Texture::~Texture() {
@@ -88,7 +89,7 @@ namespace Mona {
 
 	void Texture::ClearData() noexcept {
 		MONA_ASSERT(m_ID, "Texture Error: Trying to clear data from already freed texture.");
-		glDeleteTextures(1, &m_ID);
+		RenderDevice::GetInstance().DeleteTexture(m_ID);
 		m_ID = 0;
 	}
 
@@ -137,15 +138,15 @@ namespace Mona {
 		}
 
 		//Se pasa los datos de CPU a GPU usando OpenGL
-		glCreateTextures(GL_TEXTURE_2D, 1, &m_ID);
-		glTextureStorage2D(m_ID, 1, internalFormat, width, height);
-		glTextureParameteri(m_ID, GL_TEXTURE_WRAP_S, WrapEnumToOpenGLEnum(sWrapMode));
-		glTextureParameteri(m_ID, GL_TEXTURE_WRAP_T, WrapEnumToOpenGLEnum(tWrapMode));
-		glTextureParameteri(m_ID, GL_TEXTURE_MAG_FILTER, MagnificationFilterEnumToOpenGLEnum(magFilter));
-		glTextureParameteri(m_ID, GL_TEXTURE_MIN_FILTER, MinificationFilterEnumToOpenGLEnum(minFilter));
-		glTextureSubImage2D(m_ID, 0, 0, 0, width, height, dataFormat, GL_UNSIGNED_BYTE, data);
+		RenderDevice& device = RenderDevice::GetInstance();
+		m_ID = device.CreateTexture2D(internalFormat, width, height, 1);
+		device.SetTextureParameter(m_ID, GL_TEXTURE_WRAP_S, WrapEnumToOpenGLEnum(sWrapMode));
+		device.SetTextureParameter(m_ID, GL_TEXTURE_WRAP_T, WrapEnumToOpenGLEnum(tWrapMode));
+		device.SetTextureParameter(m_ID, GL_TEXTURE_MAG_FILTER, MagnificationFilterEnumToOpenGLEnum(magFilter));
+		device.SetTextureParameter(m_ID, GL_TEXTURE_MIN_FILTER, MinificationFilterEnumToOpenGLEnum(minFilter));
+		device.TextureSubImage2D(m_ID, width, height, dataFormat, GL_UNSIGNED_BYTE, data);
 		if (genMipmaps) {
-			glGenerateTextureMipmap(m_ID);
+			device.GenerateMipmaps(m_ID);
 		}
 		m_channels = channels;
 		m_width = width;
@@ -7,12 +7,12 @@ namespace Mona {
 	class UnlitFlatMaterial : public Material {
 	public:
  
-		UnlitFlatMaterial(const ShaderProgram& shaderProgram, bool isForSkinning) : Material(shaderProgram, isForSkinning), m_color(glm::vec3(1.0f)) {}
-		virtual void SetMaterialUniforms(const glm::vec3& cameraPosition) {
-			glUniform3fv(ShaderProgram::UnlitColorShaderLocation, 1, glm::value_ptr(m_color));
+		UnlitFlatMaterial(const ShaderProgram& shaderProgram, bool isForSkinning) : Material(shaderProgram, isForSkinning, MaterialType::UnlitFlat), m_color(glm::vec3(1.0f)) {}
+		void PackParameters(MaterialParameters& parameters, MaterialTextures&) const noexcept {
+			parameters.color = glm::vec4(m_color, 1.0f);
 		}
 		const glm::vec3& GetColor() const { return m_color; }
-		void SetColor(const glm::vec3& color) { m_color = color; }
+		void SetColor(const glm::vec3& color) { m_color = color; OnParametersChanged(); }
 	private:
 		glm::vec3 m_color;
 	};
@@ -9,17 +9,17 @@ namespace Mona {
 	class UnlitTexturedMaterial : public Material {
 	public:
  
-		UnlitTexturedMaterial(const ShaderProgram& shaderProgram, bool isForSkinning) : Material(shaderProgram, isForSkinning), m_unlitColorTexture(nullptr) {
-			glUseProgram(m_shaderID);
+		UnlitTexturedMaterial(const ShaderProgram& shaderProgram, bool isForSkinning) : Material(shaderProgram, isForSkinning, MaterialType::UnlitTextured), m_unlitColorTexture(nullptr) {
+			RenderDevice::GetInstance().UseProgram(m_shaderID);
 			//Dado que las ubicaiones de las texturas nunca cambian solo se configura al momento de construccin
-			glUniform1i(ShaderProgram::UnlitColorTextureSamplerShaderLocation, ShaderProgram::UnlitColorTextureUnit);
+			RenderDevice::GetInstance().SetUniform(ShaderProgram::UnlitColorTextureSamplerShaderLocation, ShaderProgram::UnlitColorTextureUnit);
 		}
-		virtual void SetMaterialUniforms(const glm::vec3& cameraPosition) {
+		void PackParameters(MaterialParameters&, MaterialTextures& textures) const noexcept {
 			MONA_ASSERT(m_unlitColorTexture != nullptr, "Material Error: Texture must be not nullptr for rendering to be posible");
-			glBindTextureUnit(ShaderProgram::UnlitColorTextureUnit, m_unlitColorTexture->GetID());
+			textures.Add(ShaderProgram::UnlitColorTextureUnit, m_unlitColorTexture->GetID());
 		}
 		std::shared_ptr<Texture> GetUnlitColorTexture() const { return m_unlitColorTexture; }
-		void SetUnlitColorTexture(std::shared_ptr<Texture> colorTexture) { m_unlitColorTexture = colorTexture; }
+		void SetUnlitColorTexture(std::shared_ptr<Texture> colorTexture) { m_unlitColorTexture = colorTexture; OnParametersChanged(); }
 	private:
 		std::shared_ptr<Texture> m_unlitColorTexture;
 	};
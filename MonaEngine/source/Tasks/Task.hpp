@@ -0,0 +1,115 @@
+#pragma once
+#ifndef TASK_HPP
+#define TASK_HPP
+#include <coroutine>
+#include <future>
+#include <functional>
+#include <exception>
+#include <utility>
+#include "TaskFramePool.hpp"
+namespace Mona {
+	/*
+	* Tipo de retorno de las corrutinas que el motor ejecuta repartidas en varios frames (ver World::StartTask).
+	* Dentro de una de estas corrutinas se puede suspender la ejecucion con:
+	*	co_await NextFrame();				continua en el siguiente frame.
+	*	co_await Seconds(x);				continua luego de que transcurran x segundos de juego.
+	*	co_await RunInBackground(job);		ejecuta job en otro hilo y continua en el hilo principal una vez que termina.
+	* Los frames de las corrutinas se obtienen desde TaskFramePool.
+	*/
+	class Task {
+	public:
+		enum class EWaitType {
+			NextFrame,
+			Seconds,
+			BackgroundJob
+		};
+		struct promise_type {
+			EWaitType waitType = EWaitType::NextFrame;
+			float remainingSeconds = 0.0f;
+			std::future<void> backgroundJob;
+
+			Task get_return_object() noexcept {
+				return Task(std::coroutine_handle<promise_type>::from_promise(*this));
+			}
+			//Las tareas comienzan suspendidas, su primera ejecucion ocurre cuando el scheduler las reanuda.
+			std::suspend_always initial_suspend() noexcept { return {}; }
+			std::suspend_always final_suspend() noexcept { return {}; }
+			void return_void() noexcept {}
+			void unhandled_exception() noexcept { std::terminate(); }
+
+			static void* operator new(std::size_t size) {
+				return TaskFramePool::GetInstance().Allocate(size);
+			}
+			static void operator delete(void* pointer, std::size_t size) noexcept {
+				TaskFramePool::GetInstance().Deallocate(pointer, size);
+			}
+		};
+		using HandleType = std::coroutine_handle<promise_type>;
+
+		Task() noexcept : m_handle(nullptr) {}
+		Task(const Task&) = delete;
+		Task& operator=(const Task&) = delete;
+		Task(Task&& task) noexcept : m_handle(std::exchange(task.m_handle, nullptr)) {}
+		Task& operator=(Task&& task) noexcept {
+			if (this != &task) {
+				if (m_handle)
+					m_handle.destroy();
+				m_handle = std::exchange(task.m_handle, nullptr);
+			}
+			return *this;
+		}
+		~Task() {
+			if (m_handle)
+				m_handle.destroy();
+		}
+		bool IsValid() const noexcept { return static_cast<bool>(m_handle); }
+	private:
+		friend class TaskScheduler;
+		explicit Task(HandleType handle) noexcept : m_handle(handle) {}
+		HandleType Release() noexcept { return std::exchange(m_handle, nullptr); }
+		HandleType m_handle;
+	};
+
+	/*
+	* Awaitable que suspende la tarea hasta el siguiente frame.
+	*/
+	struct NextFrame {
+		bool await_ready() const noexcept { return false; }
+		void await_suspend(Task::HandleType handle) const noexcept {
+			handle.promise().waitType = Task::EWaitType::NextFrame;
+		}
+		void await_resume() const noexcept {}
+	};
+
+	/*
+	* Awaitable que suspende la tarea durante la cantidad de segundos entregada, medida con el paso de tiempo de World::Update.
+	*/
+	struct Seconds {
+		explicit Seconds(float seconds) noexcept : m_seconds(seconds) {}
+		bool await_ready() const noexcept { return m_seconds <= 0.0f; }
+		void await_suspend(Task::HandleType handle) const noexcept {
+			handle.promise().waitType = Task::EWaitType::Seconds;
+			handle.promise().remainingSeconds = m_seconds;
+		}
+		void await_resume() const noexcept {}
+	private:
+		float m_seconds;
+	};
+
+	/*
+	* Awaitable que ejecuta un trabajo en otro hilo. La tarea se reanuda en el hilo principal, en el primer frame en que
+	* el trabajo haya terminado. El trabajo no debe acceder al World ni a sus componentes.
+	*/
+	struct RunInBackground {
+		explicit RunInBackground(std::function<void()> job) : m_job(std::move(job)) {}
+		bool await_ready() const noexcept { return false; }
+		void await_suspend(Task::HandleType handle) {
+			handle.promise().waitType = Task::EWaitType::BackgroundJob;
+			handle.promise().backgroundJob = std::async(std::launch::async, std::move(m_job));
+		}
+		void await_resume() const noexcept {}
+	private:
+		std::function<void()> m_job;
+	};
+}
+#endif
@@ -0,0 +1,52 @@
+#include "TaskFramePool.hpp"
+#include <new>
+namespace Mona {
+
+	std::size_t TaskFramePool::GetSizeClass(std::size_t size) noexcept {
+		std::size_t sizeClass = 0;
+		while (sizeClass < s_sizeClassCount && (std::size_t(1) << (sizeClass + s_minBlockSizeLog2)) < size)
+			sizeClass++;
+		return sizeClass;
+	}
+
+	void* TaskFramePool::Allocate(std::size_t size) {
+		const std::size_t sizeClass = GetSizeClass(size);
+		//Frames mas grandes que el mayor tamano de bloque se reservan directamente.
+		if (sizeClass == s_sizeClassCount)
+			return ::operator new(size);
+		auto& freeBlocks = m_freeBlocks[sizeClass];
+		if (freeBlocks.empty())
+			return ::operator new(std::size_t(1) << (sizeClass + s_minBlockSizeLog2));
+		void* block = freeBlocks.back();
+		freeBlocks.pop_back();
+		return block;
+	}
+
+	void TaskFramePool::Deallocate(void* pointer, std::size_t size) noexcept {
+		const std::size_t sizeClass = GetSizeClass(size);
+		if (sizeClass == s_sizeClassCount) {
+			::operator delete(pointer);
+			return;
+		}
+		m_freeBlocks[sizeClass].push_back(pointer);
+	}
+
+	void TaskFramePool::Reserve(std::size_t frameSize, std::size_t blockCount) {
+		const std::size_t sizeClass = GetSizeClass(frameSize);
+		if (sizeClass == s_sizeClassCount)
+			return;
+		auto& freeBlocks = m_freeBlocks[sizeClass];
+		freeBlocks.reserve(freeBlocks.size() + blockCount);
+		for (std::size_t i = 0; i < blockCount; i++)
+			freeBlocks.push_back(::operator new(std::size_t(1) << (sizeClass + s_minBlockSizeLog2)));
+	}
+
+	void TaskFramePool::ShutDown() noexcept {
+		for (auto& freeBlocks : m_freeBlocks) {
+			for (void* block : freeBlocks)
+				::operator delete(block);
+			freeBlocks.clear();
+			freeBlocks.shrink_to_fit();
+		}
+	}
+}
@@ -0,0 +1,38 @@
+#pragma once
+#ifndef TASKFRAMEPOOL_HPP
+#define TASKFRAMEPOOL_HPP
+#include <array>
+#include <vector>
+#include <cstddef>
+namespace Mona {
+	/*
+	* Pool de bloques de memoria usado para los frames de las corrutinas de tipo Task. Los bloques se agrupan en clases de
+	* tamanos potencia de dos y los bloques liberados se reutilizan, de modo que una vez alcanzado el regimen estable crear
+	* o terminar tareas no realiza reservas de memoria. Solo debe usarse desde el hilo principal.
+	*/
+	class TaskFramePool {
+	public:
+		friend class World;
+		TaskFramePool(TaskFramePool const&) = delete;
+		TaskFramePool& operator=(TaskFramePool const&) = delete;
+		static TaskFramePool& GetInstance() noexcept {
+			static TaskFramePool instance;
+			return instance;
+		}
+		void* Allocate(std::size_t size);
+		void Deallocate(void* pointer, std::size_t size) noexcept;
+		/*
+		* Reserva por adelantado blockCount bloques capaces de contener frames de tamano frameSize.
+		*/
+		void Reserve(std::size_t frameSize, std::size_t blockCount);
+	private:
+		TaskFramePool() = default;
+		void ShutDown() noexcept;
+		static constexpr std::size_t s_minBlockSizeLog2 = 6;
+		static constexpr std::size_t s_maxBlockSizeLog2 = 13;
+		static constexpr std::size_t s_sizeClassCount = s_maxBlockSizeLog2 - s_minBlockSizeLog2 + 1;
+		static std::size_t GetSizeClass(std::size_t size) noexcept;
+		std::array<std::vector<void*>, s_sizeClassCount> m_freeBlocks;
+	};
+}
+#endif
@@ -0,0 +1,136 @@
+#include "TaskScheduler.hpp"
+#include "../World/GameObjectManager.hpp"
+#include "../Core/Log.hpp"
+#include <chrono>
+namespace Mona {
+
+	void TaskScheduler::StartUp(uint32_t expectedTasks, float budgetMilliseconds) noexcept {
+		m_tasks.reserve(expectedTasks);
+		m_readyFlags.reserve(expectedTasks);
+		m_budgetMilliseconds = budgetMilliseconds;
+	}
+
+	void TaskScheduler::ShutDown() noexcept {
+		for (auto& entry : m_tasks)
+			entry.handle.destroy();
+		m_tasks.clear();
+		m_nextTaskIndex = 0;
+		//Al apagar el motor si se espera a los trabajos en segundo plano pendientes.
+		for (auto& handle : m_pendingBackgroundTasks)
+			handle.destroy();
+		m_pendingBackgroundTasks.clear();
+	}
+
+	TaskID TaskScheduler::StartTask(Task&& task, const InnerGameObjectHandle& owner) noexcept {
+		MONA_ASSERT(task.IsValid(), "TaskScheduler Error: Trying to start an empty task");
+		TaskID id(m_nextID++);
+		m_tasks.push_back({ task.Release(), owner, id, owner.m_index != INVALID_INDEX, false });
+		return id;
+	}
+
+	void TaskScheduler::StopTask(const TaskID& id) noexcept {
+		//La tarea solo se marca, se destruye al final de Update ya que puede estar siendo ejecutada en este momento.
+		for (auto& entry : m_tasks) {
+			if (entry.id == id) {
+				entry.stopped = true;
+				return;
+			}
+		}
+	}
+
+	bool TaskScheduler::IsTaskRunning(const TaskID& id) const noexcept {
+		for (const auto& entry : m_tasks) {
+			if (entry.id == id)
+				return !entry.stopped;
+		}
+		return false;
+	}
+
+	bool TaskScheduler::IsReady(TaskEntry& entry, float timeStep) const noexcept {
+		auto& promise = entry.handle.promise();
+		switch (promise.waitType) {
+		case Task::EWaitType::NextFrame:
+			return true;
+		case Task::EWaitType::Seconds:
+			promise.remainingSeconds -= timeStep;
+			return promise.remainingSeconds <= 0.0f;
+		case Task::EWaitType::BackgroundJob:
+			return promise.backgroundJob.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+		default:
+			return true;
+		}
+	}
+
+	void TaskScheduler::DestroyTask(uint32_t index) noexcept {
+		Task::HandleType handle = m_tasks[index].handle;
+		auto& promise = handle.promise();
+		if (promise.waitType == Task::EWaitType::BackgroundJob && promise.backgroundJob.valid() &&
+			promise.backgroundJob.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+			m_pendingBackgroundTasks.push_back(handle);
+		else
+			handle.destroy();
+		//La ultima tarea ocupa el lugar de la eliminada, si era la siguiente por reanudar el indice la sigue.
+		const uint32_t lastIndex = static_cast<uint32_t>(m_tasks.size()) - 1;
+		if (index < lastIndex) {
+			m_tasks[index] = m_tasks.back();
+			if (m_nextTaskIndex == lastIndex)
+				m_nextTaskIndex = index;
+		}
+		m_tasks.pop_back();
+		if (m_nextTaskIndex >= m_tasks.size())
+			m_nextTaskIndex = 0;
+	}
+
+	void TaskScheduler::DestroyFinishedBackgroundTasks() noexcept {
+		for (uint32_t i = 0; i < m_pendingBackgroundTasks.size();) {
+			Task::HandleType handle = m_pendingBackgroundTasks[i];
+			if (handle.promise().backgroundJob.wait_for(std::chrono::seconds(0)) == std::future_status::ready) {
+				handle.destroy();
+				m_pendingBackgroundTasks[i] = m_pendingBackgroundTasks.back();
+				m_pendingBackgroundTasks.pop_back();
+			}
+			else
+				i++;
+		}
+	}
+
+	void TaskScheduler::Update(const GameObjectManager& objectManager, float timeStep) noexcept {
+		if (!m_pendingBackgroundTasks.empty())
+			DestroyFinishedBackgroundTasks();
+		//Se detienen las tareas cuyo dueno fue destruido y se actualizan los tiempos de espera de todas las demas.
+		const uint32_t count = static_cast<uint32_t>(m_tasks.size());
+		m_readyFlags.resize(count);
+		for (uint32_t i = 0; i < count; i++) {
+			auto& entry = m_tasks[i];
+			if (entry.hasOwner && !objectManager.IsValid(entry.owner))
+				entry.stopped = true;
+			m_readyFlags[i] = !entry.stopped && IsReady(entry, timeStep);
+		}
+		const auto startTime = std::chrono::steady_clock::now();
+		const auto budget = std::chrono::duration<float, std::milli>(m_budgetMilliseconds);
+		const uint32_t startIndex = m_nextTaskIndex < count ? m_nextTaskIndex : 0;
+		m_nextTaskIndex = 0;
+		//Las tareas listas se reanudan en orden circular comenzando por la primera que no alcanzo a ejecutarse el frame anterior.
+		//Las tareas que no alcanzan a ejecutarse siguen listas en el frame siguiente. El presupuesto se revisa despues de la
+		//primera tarea reanudada, de modo que al menos una avanza en cada frame aunque el presupuesto sea cero.
+		bool resumedAny = false;
+		for (uint32_t visited = 0; visited < count; visited++) {
+			const uint32_t index = (startIndex + visited) % count;
+			if (!m_readyFlags[index] || m_tasks[index].stopped)
+				continue;
+			if (resumedAny && std::chrono::steady_clock::now() - startTime >= budget) {
+				m_nextTaskIndex = index;
+				break;
+			}
+			m_tasks[index].handle.resume();
+			resumedAny = true;
+		}
+		//Las tareas terminadas o detenidas se eliminan al final para no alterar los indices durante la iteracion.
+		for (uint32_t i = 0; i < m_tasks.size();) {
+			if (m_tasks[i].stopped || m_tasks[i].handle.done())
+				DestroyTask(i);
+			else
+				i++;
+		}
+	}
+}
@@ -0,0 +1,65 @@
+#pragma once
+#ifndef TASKSCHEDULER_HPP
+#define TASKSCHEDULER_HPP
+#include <vector>
+#include <cstdint>
+#include "Task.hpp"
+#include "../World/GameObjectTypes.hpp"
+namespace Mona {
+	class GameObjectManager;
+
+	/*
+	* Identificador de una tarea iniciada con World::StartTask.
+	*/
+	struct TaskID {
+		TaskID() : m_value(0) {}
+		explicit TaskID(uint64_t value) : m_value(value) {}
+		bool operator==(const TaskID& other) const noexcept { return m_value == other.m_value; }
+		uint64_t m_value;
+	};
+
+	/*
+	* Ejecuta las tareas iniciadas por el usuario. En cada frame se reanudan las tareas listas en orden circular hasta agotar
+	* el presupuesto de tiempo por frame, las tareas que no alcanzan a ejecutarse se reanudan primero en el frame siguiente.
+	* Siempre se reanuda al menos una tarea lista por frame, por lo que ninguna tarea espera indefinidamente. Como las tareas no pueden ser interrumpidas, una tarea que no suspende a tiempo excede el presupuesto.
+	*/
+	class TaskScheduler {
+	public:
+		TaskScheduler() = default;
+		TaskScheduler(const TaskScheduler&) = delete;
+		TaskScheduler& operator=(const TaskScheduler&) = delete;
+		void StartUp(uint32_t expectedTasks, float budgetMilliseconds) noexcept;
+		void ShutDown() noexcept;
+		/*
+		* Toma posesion de la tarea entregada. Si owner es valido la tarea se detiene automaticamente al destruir ese GameObject.
+		*/
+		TaskID StartTask(Task&& task, const InnerGameObjectHandle& owner = InnerGameObjectHandle()) noexcept;
+		void StopTask(const TaskID& id) noexcept;
+		bool IsTaskRunning(const TaskID& id) const noexcept;
+		uint32_t GetTaskCount() const noexcept { return static_cast<uint32_t>(m_tasks.size()); }
+		float GetBudgetMilliseconds() const noexcept { return m_budgetMilliseconds; }
+		void SetBudgetMilliseconds(float budget) noexcept { m_budgetMilliseconds = budget; }
+		void Update(const GameObjectManager& objectManager, float timeStep) noexcept;
+	private:
+		struct TaskEntry {
+			Task::HandleType handle;
+			InnerGameObjectHandle owner;
+			TaskID id;
+			bool hasOwner;
+			bool stopped;
+		};
+		bool IsReady(TaskEntry& entry, float timeStep) const noexcept;
+		void DestroyTask(uint32_t index) noexcept;
+		void DestroyFinishedBackgroundTasks() noexcept;
+		std::vector<TaskEntry> m_tasks;
+		//Tareas detenidas mientras esperaban un trabajo en segundo plano. Destruirlas de inmediato bloquearia el hilo principal
+		//hasta que el trabajo termine (y el trabajo podria usar variables del frame de la corrutina), por lo que se destruyen
+		//en el primer Update en que el trabajo haya terminado.
+		std::vector<Task::HandleType> m_pendingBackgroundTasks;
+		std::vector<uint8_t> m_readyFlags;
+		uint64_t m_nextID = 1;
+		uint32_t m_nextTaskIndex = 0;
+		float m_budgetMilliseconds = 2.0f;
+	};
+}
+#endif
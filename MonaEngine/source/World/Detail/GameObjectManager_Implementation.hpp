@@ -32,6 +32,7 @@ namespace Mona {
 			InnerGameObjectHandle resultHandle(handleIndex, handleEntry.generation);
 			m_gameObjects.emplace_back(std::move(gameObjectPointer));
 			rawPointer->SetObjectHandle(resultHandle);
+			AddTickEntry(*rawPointer);
 			rawPointer->StartUp(world);
 			//m_gameObjectHandleIndices.emplace_back(handleIndex);
 			return rawPointer;
@@ -42,6 +43,7 @@ namespace Mona {
 			InnerGameObjectHandle resultHandle(static_cast<size_type>(m_handleEntries.size() - 1), 0);
 			m_gameObjects.emplace_back(std::move(gameObjectPointer));
 			rawPointer->SetObjectHandle(resultHandle);
+			AddTickEntry(*rawPointer);
 			rawPointer->StartUp(world);
 			//m_gameObjectHandleIndices.emplace_back(static_cast<size_type>(m_handleEntries.size() - 1));
 			return rawPointer;
@@ -8,6 +8,35 @@
 namespace Mona {
 	class World;
 	class GameObjectManager;
+
+	/*
+	* Grupos de actualizacion de los GameObjects, cada uno corresponde a un momento distinto de World::Update:
+	* antes de la simulacion fisica, despues de la simulacion fisica y despues de actualizar las animaciones.
+	*/
+	enum class ETickGroup : uint8_t {
+		PrePhysics,
+		PostPhysics,
+		PostAnimation,
+		GroupCount
+	};
+
+	constexpr uint8_t GetTickGroupCount() {
+		return static_cast<uint8_t>(ETickGroup::GroupCount);
+	}
+
+	/*
+	* Configuracion de la actualizacion de un GameObject. interval es el tiempo minimo (en segundos) entre dos llamadas a
+	* UserUpdate, con cero se actualiza todos los frames. Si farDistance es mayor a cero el intervalo depende de la distancia
+	* a la camara principal: vale interval hasta nearDistance y crece linealmente hasta farInterval en farDistance.
+	*/
+	struct TickSettings {
+		ETickGroup group = ETickGroup::PostAnimation;
+		float interval = 0.0f;
+		float nearDistance = 0.0f;
+		float farDistance = 0.0f;
+		float farInterval = 0.0f;
+	};
+
 	class GameObject {
 	public:
 		enum class EState {
@@ -33,6 +62,8 @@ namespace Mona {
 		virtual void UserStartUp(World& world) noexcept {};
 
 		const EState GetState() const { return m_state; }
+		const TickSettings& GetTickSettings() const noexcept { return m_tickSettings; }
+		bool IsSleeping() const noexcept { return m_sleeping; }
 		template <typename ComponentType>
 		bool HasComponent() const {
 			static_assert(is_component<ComponentType>, "Template parameter is not a component");
@@ -53,7 +84,8 @@ namespace Mona {
 		GameObject& operator=(const GameObject&) = delete;
 		GameObject(GameObject&&) = default;
 		GameObject& operator=(GameObject&&) = default;
-		GameObject() : m_objectHandle(), m_state(EState::Active) {}
+		GameObject() : m_objectHandle(), m_state(EState::Active), m_tickSettings(), m_tickGroup(ETickGroup::PostAnimation),
+			m_tickIndex(INVALID_INDEX), m_sleeping(false) {}
 	private:
 		
 		friend class GameObjectManager;
@@ -74,6 +106,12 @@ namespace Mona {
 		}
 		InnerGameObjectHandle m_objectHandle;
 		EState m_state;
+		TickSettings m_tickSettings;
+		//Grupo y posicion del objeto dentro de los arreglos de actualizacion de GameObjectManager, m_tickIndex es
+		//INVALID_INDEX mientras el objeto no se actualiza (por ejemplo al estar durmiendo).
+		ETickGroup m_tickGroup;
+		GameObjectID m_tickIndex;
+		bool m_sleeping;
 		std::unordered_map<decltype(GetComponentTypeCount()), InnerComponentHandle> m_componentHandles;
 	};
 }
@@ -1,9 +1,12 @@
 #include "GameObjectManager.hpp"
 #include "../Event/EventManager.hpp"
 #include "../Core/Log.hpp"
+#include <algorithm>
 namespace Mona {
 
 	GameObjectManager::GameObjectManager() :
+		m_isTicking(false),
+		m_tickIntervalScale(1.0f),
 		m_firstFreeIndex(s_maxEntries),
 		m_lastFreeIndex(s_maxEntries),
 		m_freeIndicesCount(0)
@@ -14,6 +17,7 @@ namespace Mona {
 		m_handleEntries.reserve(expectedObjects);
 		m_gameObjects.reserve(expectedObjects);
 		m_pendingDestroyObjectHandles.reserve(expectedObjects);
+		m_tickGroups[static_cast<uint8_t>(ETickGroup::PostAnimation)].reserve(expectedObjects);
 	}
 
 	void GameObjectManager::ShutDown(World& world) noexcept
@@ -21,6 +25,9 @@ namespace Mona {
 		m_handleEntries.clear();
 		m_gameObjects.clear();
 		m_pendingDestroyObjectHandles.clear();
+		for (auto& tickGroup : m_tickGroups)
+			tickGroup.clear();
+		m_pendingTickUpdateHandles.clear();
 		m_firstFreeIndex = s_maxEntries;
 		m_lastFreeIndex = s_maxEntries;
 		m_freeIndicesCount = 0;
@@ -46,6 +53,7 @@ namespace Mona {
 		auto& handleEntry = m_handleEntries[index];
 		GameObjectDestroyedEvent event(*m_gameObjects[handleEntry.index]);
 		eventManager.Publish(event);
+		RemoveTickEntry(*m_gameObjects[handleEntry.index]);
 
 		if (handleEntry.index < m_gameObjects.size() - 1)
 		{
@@ -91,11 +99,46 @@ namespace Mona {
 			return false;
 		return true;
 	}
-	void GameObjectManager::UpdateGameObjects(World& world, EventManager& eventManager, float timeStep) noexcept {
-		auto const count = GetCount();
-		for (decltype(GetCount()) i = 0; i < count; i++) {
-			m_gameObjects[i]->Update(world, timeStep);
+	void GameObjectManager::UpdateGameObjects(World& world,
+		EventManager& eventManager,
+		ETickGroup group,
+		float timeStep,
+		const ComponentManager<TransformComponent>& transformDataManager,
+		const glm::vec3* cameraPosition) noexcept
+	{
+		auto& tickEntries = m_tickGroups[static_cast<uint8_t>(group)];
+		//Los objetos creados durante la iteracion se agregan al final del arreglo y recien se actualizan en el siguiente frame.
+		//Cambios de grupo o de estado de sueno se aplican al terminar la iteracion.
+		m_isTicking = true;
+		const auto count = tickEntries.size();
+		for (decltype(tickEntries.size()) i = 0; i < count; i++) {
+			TickEntry& entry = tickEntries[i];
+			entry.elapsed += timeStep;
+			float interval = entry.interval;
+			if (entry.farDistance > 0.0f && cameraPosition != nullptr) {
+				if (!transformDataManager.IsValid(entry.transformHandle))
+					entry.transformHandle = entry.object->GetInnerComponentHandle<TransformComponent>();
+				if (transformDataManager.IsValid(entry.transformHandle)) {
+					const TransformComponent* transform = transformDataManager.GetComponentPointer(entry.transformHandle);
+					const float distance = glm::length(transform->GetLocalTranslation() - *cameraPosition);
+					const float fraction = glm::clamp((distance - entry.nearDistance) / (entry.farDistance - entry.nearDistance), 0.0f, 1.0f);
+					interval = glm::mix(entry.interval, entry.farInterval, fraction);
+				}
+			}
+			if (entry.elapsed + entry.phase < interval * m_tickIntervalScale)
+				continue;
+			const float elapsed = entry.elapsed;
+			entry.elapsed = 0.0f;
+			entry.phase = 0.0f;
+			//UserUpdate recibe el tiempo transcurrido desde la ultima actualizacion del objeto.
+			entry.object->Update(world, elapsed);
+		}
+		m_isTicking = false;
+		for (const auto& handle : m_pendingTickUpdateHandles) {
+			if (IsValid(handle))
+				UpdateTickEntry(*GetGameObjectPointer(handle));
 		}
+		m_pendingTickUpdateHandles.clear();
 		for (const auto& handle : m_pendingDestroyObjectHandles) {
 			ImmediateDestroyGameObject(eventManager, handle);
 		}
@@ -103,4 +146,78 @@ namespace Mona {
 		
 
 	}
-}
\ No newline at end of file
+
+	void GameObjectManager::SetTickSettings(GameObject& gameObject, const TickSettings& settings) noexcept {
+		MONA_ASSERT(settings.group != ETickGroup::GroupCount, "GameObjectManager Error: Invalid tick group");
+		MONA_ASSERT(settings.interval >= 0.0f, "GameObjectManager Error: Tick interval must be non negative");
+		MONA_ASSERT(settings.farDistance <= 0.0f || settings.farDistance > settings.nearDistance,
+			"GameObjectManager Error: Tick farDistance must be greater than nearDistance");
+		gameObject.m_tickSettings = settings;
+		if (gameObject.m_tickIndex != INVALID_INDEX && gameObject.m_tickGroup == settings.group) {
+			//Si el grupo no cambia basta con actualizar los datos del objeto en su posicion actual.
+			TickEntry& entry = m_tickGroups[static_cast<uint8_t>(gameObject.m_tickGroup)][gameObject.m_tickIndex];
+			entry.interval = settings.interval;
+			entry.nearDistance = settings.nearDistance;
+			entry.farDistance = settings.farDistance;
+			entry.farInterval = settings.farInterval;
+			return;
+		}
+		RequestTickUpdate(gameObject);
+	}
+
+	void GameObjectManager::SetSleeping(GameObject& gameObject, bool sleeping) noexcept {
+		if (gameObject.m_sleeping == sleeping)
+			return;
+		gameObject.m_sleeping = sleeping;
+		RequestTickUpdate(gameObject);
+	}
+
+	GameObjectManager::size_type GameObjectManager::GetTickingCount(ETickGroup group) const noexcept {
+		return static_cast<size_type>(m_tickGroups[static_cast<uint8_t>(group)].size());
+	}
+
+	void GameObjectManager::RequestTickUpdate(GameObject& gameObject) noexcept {
+		if (m_isTicking)
+			m_pendingTickUpdateHandles.push_back(gameObject.GetInnerObjectHandle());
+		else
+			UpdateTickEntry(gameObject);
+	}
+
+	void GameObjectManager::UpdateTickEntry(GameObject& gameObject) noexcept {
+		RemoveTickEntry(gameObject);
+		if (!gameObject.m_sleeping && gameObject.GetState() == GameObject::EState::Active)
+			AddTickEntry(gameObject);
+	}
+
+	void GameObjectManager::AddTickEntry(GameObject& gameObject) noexcept {
+		MONA_ASSERT(gameObject.m_tickIndex == INVALID_INDEX, "GameObjectManager Error: Object is already ticking");
+		const TickSettings& settings = gameObject.m_tickSettings;
+		auto& tickEntries = m_tickGroups[static_cast<uint8_t>(settings.group)];
+		//Se desfasa la primera actualizacion de cada objeto para que objetos con el mismo intervalo no se actualicen todos en el
+		//mismo frame. El desfase no cuenta como tiempo transcurrido.
+		const float phase = glm::fract(static_cast<float>(gameObject.GetInnerObjectHandle().m_index) * 0.618034f);
+		tickEntries.push_back({ &gameObject,
+			InnerComponentHandle(),
+			settings.interval,
+			settings.nearDistance,
+			settings.farDistance,
+			settings.farInterval,
+			0.0f,
+			phase * std::max(settings.interval, settings.farInterval) });
+		gameObject.m_tickGroup = settings.group;
+		gameObject.m_tickIndex = static_cast<GameObjectID>(tickEntries.size() - 1);
+	}
+
+	void GameObjectManager::RemoveTickEntry(GameObject& gameObject) noexcept {
+		if (gameObject.m_tickIndex == INVALID_INDEX)
+			return;
+		auto& tickEntries = m_tickGroups[static_cast<uint8_t>(gameObject.m_tickGroup)];
+		const GameObjectID index = gameObject.m_tickIndex;
+		if (index < tickEntries.size() - 1) {
+			tickEntries[index] = tickEntries.back();
+			tickEntries[index].object->m_tickIndex = index;
+		}
+		tickEntries.pop_back();
+		gameObject.m_tickIndex = INVALID_INDEX;
+	}
+}
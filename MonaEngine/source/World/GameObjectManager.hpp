@@ -2,8 +2,11 @@
 #ifndef GAMEOBJECTMANAGER_HPP
 #define GAMEOBJECTMANAGER_HPP
 #include "GameObject.hpp"
+#include "ComponentManager.hpp"
+#include "TransformComponent.hpp"
 #include <memory>
 #include <vector>
+#include <array>
 #include <unordered_map>
 namespace Mona {
 	class World;
@@ -26,10 +29,44 @@ namespace Mona {
 		bool IsValid(const InnerGameObjectHandle& handle) const noexcept;
 
 
-		void UpdateGameObjects(World& world, EventManager& eventManager, float timeStep) noexcept;
+		/*
+		* Actualiza los GameObjects del grupo entregado cuyo intervalo de actualizacion se haya cumplido y luego destruye
+		* los objetos pendientes. cameraPosition puede ser nulo, en ese caso se ignoran los intervalos que dependen de la distancia.
+		*/
+		void UpdateGameObjects(World& world,
+			EventManager& eventManager,
+			ETickGroup group,
+			float timeStep,
+			const ComponentManager<TransformComponent>& transformDataManager,
+			const glm::vec3* cameraPosition) noexcept;
+		void SetTickSettings(GameObject& gameObject, const TickSettings& settings) noexcept;
+		void SetSleeping(GameObject& gameObject, bool sleeping) noexcept;
+		size_type GetTickingCount(ETickGroup group) const noexcept;
+		/*
+		* Factor que multiplica los intervalos de actualizacion de todos los GameObjects.
+		*/
+		float GetTickIntervalScale() const noexcept { return m_tickIntervalScale; }
+		void SetTickIntervalScale(float scale) noexcept { m_tickIntervalScale = scale; }
 	private:
 		
 		void ImmediateDestroyGameObject(EventManager& eventManager, const InnerGameObjectHandle& handle) noexcept;
+		void RequestTickUpdate(GameObject& gameObject) noexcept;
+		void UpdateTickEntry(GameObject& gameObject) noexcept;
+		void AddTickEntry(GameObject& gameObject) noexcept;
+		void RemoveTickEntry(GameObject& gameObject) noexcept;
+		//Datos necesarios para decidir si un objeto debe actualizarse, almacenados de forma contigua por grupo para que
+		//los objetos que no se actualizan en un frame tengan un costo minimo.
+		struct TickEntry {
+			GameObject* object;
+			InnerComponentHandle transformHandle;
+			float interval;
+			float nearDistance;
+			float farDistance;
+			float farInterval;
+			float elapsed;
+			//Desfase que solo adelanta la primera actualizacion del objeto, no se suma al tiempo entregado a UserUpdate.
+			float phase;
+		};
 		constexpr static size_type s_maxEntries = std::numeric_limits<size_type>::max();
 		constexpr static size_type s_minFreeIndices = 1024;
 		struct HandleEntry {
@@ -44,6 +81,10 @@ namespace Mona {
 		std::vector<HandleEntry> m_handleEntries;
 
 		std::vector<InnerGameObjectHandle> m_pendingDestroyObjectHandles;
+		std::array<std::vector<TickEntry>, GetTickGroupCount()> m_tickGroups;
+		std::vector<InnerGameObjectHandle> m_pendingTickUpdateHandles;
+		bool m_isTicking;
+		float m_tickIntervalScale;
 		size_type m_firstFreeIndex;
 		size_type m_lastFreeIndex;
 		size_type m_freeIndicesCount;
@@ -43,26 +43,40 @@ namespace Mona {
 		}
 		void Translate(glm::vec3 translation) {
 			localTranslation += translation;
+			version++;
 		}
 
 		void SetTranslation(const glm::vec3 translation) {
 			localTranslation = translation;
+			version++;
 		}
 
 		void Scale(glm::vec3 scale){
 			localScale *= scale;
+			version++;
 		}
 
 		void SetScale(const glm::vec3& scale) {
 			localScale = scale;
+			version++;
 		}
 		
 		void Rotate(glm::vec3 axis, float angle){
 			localRotation = glm::rotate(localRotation, angle, axis);
+			version++;
 		}
 
 		void SetRotation(const glm::fquat& rotation) {
 			localRotation = rotation;
+			version++;
+		}
+
+		/*
+		* Contador que aumenta cada vez que se modifica la transformacion, permite a otros sistemas actualizar
+		* datos derivados (por ejemplo volumenes envolventes en espacio de mundo) solo cuando esta cambia.
+		*/
+		uint32_t GetVersion() const {
+			return version;
 		}
 
 		glm::vec3 GetUpVector() const {
@@ -81,6 +95,7 @@ namespace Mona {
 		glm::vec3 localTranslation;
 		glm::fquat localRotation;
 		glm::vec3 localScale;
+		uint32_t version = 1;
 	};
 
 
@@ -7,11 +7,13 @@
 #include "../PhysicsCollision/PhysicsCollisionSystem.hpp"
 #include "../Rendering/Material.hpp"
 #include "../Rendering/MeshManager.hpp"
+#include "../Rendering/RenderDevice.hpp"
 #include "../Rendering/TextureManager.hpp"
 #include "../Animation/SkeletonManager.hpp"
 #include "../Animation/AnimationClipManager.hpp"
 #include "../Animation/AnimationController.hpp"
 #include <chrono>
+#include <fstream>
 namespace Mona {
 	
 	World::World(Application& app) : 
@@ -36,30 +38,57 @@ namespace Mona {
 		m_componentManagers[SpotLightComponent::componentIndex].reset(new ComponentManager<SpotLightComponent>());
 		m_componentManagers[PointLightComponent::componentIndex].reset(new ComponentManager<PointLightComponent>());
 		m_componentManagers[SkeletalMeshComponent::componentIndex].reset(new ComponentManager<SkeletalMeshComponent>());
-		m_debugDrawingSystem.reset(new DebugDrawingSystem());
+		//Sin contexto de OpenGL no hay informacion de debug que dibujar.
+		const bool headlessRendering = config.getValueOrDefault<bool>("headless_rendering", false);
+		if (!headlessRendering)
+			m_debugDrawingSystem.reset(new DebugDrawingSystem());
 		
 		auto& transformDataManager = GetComponentManager<TransformComponent>();
 		auto& rigidBodyDataManager = GetComponentManager<RigidBodyComponent>();
 		auto& audioSourceDataManager = GetComponentManager<AudioSourceComponent>();
+		auto& staticMeshDataManager = GetComponentManager<StaticMeshComponent>();
 
 		const GameObjectID expectedObjects = config.getValueOrDefault<int>("expected_number_of_gameobjects", 1000);
 		rigidBodyDataManager.SetLifetimePolicy(RigidBodyLifetimePolicy(&transformDataManager, &m_physicsCollisionSystem));
 		audioSourceDataManager.SetLifetimePolicy(AudioSourceComponentLifetimePolicy(&m_audioSystem));
+		staticMeshDataManager.SetLifetimePolicy(StaticMeshLifetimePolicy(&m_renderer));
 		m_window.StartUp(m_eventManager);
+		if (headlessRendering) {
+			//Todos los llamados a la API grafica pasan por RenderDevice, por lo que basta cambiar su backend antes de crear
+			//cualquier recurso.
+			m_recordingRenderBackend = std::make_unique<RecordingRenderBackend>();
+			const glm::ivec2 frameBufferSize = m_window.GetWindowFrameBufferSize();
+			m_recordingRenderBackend->SetViewport(0, 0, frameBufferSize.x, frameBufferSize.y);
+			RenderDevice::GetInstance().SetBackend(*m_recordingRenderBackend);
+		}
 		m_input.StartUp(m_eventManager);
 		m_objectManager.StartUp(expectedObjects);
 		for (auto& componentManager : m_componentManagers)
 			componentManager->StartUp(m_eventManager, expectedObjects);
 		m_application = std::move(app);
+		MeshManager::GetInstance().StartUp();
 		m_renderer.StartUp(m_eventManager, m_debugDrawingSystem.get());
 		m_audioSystem.StartUp();
-		m_debugDrawingSystem->StartUp(&m_physicsCollisionSystem);
+		m_physicsCollisionSystem.SetMaxSubSteps(config.getValueOrDefault<int>("physics_max_substeps", 1));
+		m_taskScheduler.StartUp(config.getValueOrDefault<int>("expected_number_of_tasks", 64),
+			config.getValueOrDefault<float>("task_budget_milliseconds", 2.0f));
+		if (m_debugDrawingSystem != nullptr)
+			m_debugDrawingSystem->StartUp(&m_physicsCollisionSystem);
+		QualitySettings baseSettings;
+		baseSettings.animationUpdateInterval = m_animationSystem.GetUpdateInterval();
+		baseSettings.physicsMaxSubSteps = m_physicsCollisionSystem.GetMaxSubSteps();
+		baseSettings.audioVoiceLimit = m_audioSystem.GetVoiceLimit();
+		baseSettings.renderLODBias = m_renderer.GetLODBias();
+		baseSettings.tickIntervalScale = m_objectManager.GetTickIntervalScale();
+		m_frameBudgetGovernor.StartUp(baseSettings);
 		m_application.StartUp(*this);
 	
 	}
 	
 	World::~World() {
 		m_application.UserShutDown(*this);
+		m_taskScheduler.ShutDown();
+		TaskFramePool::GetInstance().ShutDown();
 		m_objectManager.ShutDown(*this);
 		for (auto& componentManager : m_componentManagers)
 			componentManager->ShutDown(m_eventManager);
@@ -72,10 +101,13 @@ namespace Mona {
 		SkeletonManager::GetInstance().ShutDown();
 		AnimationClipManager::GetInstance().ShutDown();
 		m_renderer.ShutDown(m_eventManager);
-		m_debugDrawingSystem->ShutDown();
+		if (m_debugDrawingSystem != nullptr)
+			m_debugDrawingSystem->ShutDown();
 		m_window.ShutDown();
 		m_input.ShutDown(m_eventManager);
 		m_eventManager.ShutDown();
+		if (m_recordingRenderBackend != nullptr)
+			RenderDevice::GetInstance().ResetBackend();
 
 	}
 
@@ -93,6 +125,16 @@ namespace Mona {
 		m_objectManager.DestroyGameObject(gameObject.GetInnerObjectHandle());
 	}
 
+	void World::SetTickSettings(GameObject& gameObject, const TickSettings& settings) noexcept {
+		MONA_ASSERT(m_objectManager.IsValid(gameObject.GetInnerObjectHandle()), "World Error: Trying to set tick settings of invalid object");
+		m_objectManager.SetTickSettings(gameObject, settings);
+	}
+
+	void World::SetSleeping(GameObject& gameObject, bool sleeping) noexcept {
+		MONA_ASSERT(m_objectManager.IsValid(gameObject.GetInnerObjectHandle()), "World Error: Trying to set sleeping state of invalid object");
+		m_objectManager.SetSleeping(gameObject, sleeping);
+	}
+
 	bool World::IsValid(const BaseGameObjectHandle& handle) const noexcept {
 		return m_objectManager.IsValid(handle->GetInnerObjectHandle());
 	}
@@ -118,7 +160,10 @@ namespace Mona {
 
 	void World::StartMainLoop() noexcept {
 		std::chrono::time_point<std::chrono::steady_clock> startTime = std::chrono::steady_clock::now();
-		
+		//Si se configura una ruta de grabacion se guardan el paso de tiempo y la instantanea de input de cada frame
+		//para luego poder reproducir la sesion con World::StartReplayLoop.
+		const std::string recordingPath = Config::GetInstance().getValueOrDefault<std::string>("input_recording_path", "");
+		InputRecording recording;
 		while (!m_window.ShouldClose() && !m_shouldClose)
 		{
 			std::chrono::time_point<std::chrono::steady_clock> newTime = std::chrono::steady_clock::now();
@@ -126,12 +171,50 @@ namespace Mona {
 			startTime = newTime;
 			float timeStep = std::chrono::duration_cast<std::chrono::duration<float>>(frameTime).count();
 			Update(timeStep);
+			//Luego del ajuste tardio de la camara no se recolectan eventos, por lo que la posicion mas reciente del mouse es
+			//la que recibio el ajuste.
+			if (!recordingPath.empty())
+				recording.AddFrame(timeStep, m_input.GetSnapshot(), m_input.GetLatestMousePosition());
+		}
+		if (!recordingPath.empty() && recording.SaveToFile(recordingPath)) {
+			MONA_LOG_INFO("World: Saved input recording with {0} frames to {1}", recording.GetFrameCount(), recordingPath);
 		}
 		m_eventManager.Publish(ApplicationEndEvent());
 		
 	}
 
-	void World::Update(float timeStep) noexcept
+	static void WriteFrameTimingsJSON(std::ofstream& out, const FrameTimings& timings, bool isFirst) {
+		out << (isFirst ? "\n" : ",\n");
+		out << "{\"frame\":" << timings.frameIndex << ",\"timeStep\":" << timings.timeStep << ",\"total\":" << timings.totalMilliseconds << ",\"stages\":{";
+		for (uint8_t i = 0; i < GetFrameStageCount(); i++) {
+			out << (i == 0 ? "" : ",") << "\"" << GetFrameStageName(static_cast<FrameStage>(i)) << "\":" << timings.stageMilliseconds[i];
+		}
+		out << "}}";
+	}
+
+	bool World::StartReplayLoop(const std::filesystem::path& recordingPath, const std::filesystem::path& timingsPath) noexcept {
+		InputRecording recording;
+		if (!recording.LoadFromFile(recordingPath))
+			return false;
+		std::ofstream out(timingsPath);
+		if (!out.is_open()) {
+			MONA_LOG_ERROR("World Error: Failed to open file {0} for writing frame timings", timingsPath.string());
+			return false;
+		}
+		//Durante la reproduccion no se espera la sincronizacion vertical para que los tiempos medidos reflejen el costo real de cada frame.
+		m_window.SetSwapInterval(0);
+		out << "{\"frames\":[";
+		for (size_t i = 0; i < recording.GetFrameCount() && !m_shouldClose; i++) {
+			const InputRecording::Frame& frame = recording.GetFrame(i);
+			Update(frame.timeStep, &frame);
+			WriteFrameTimingsJSON(out, m_lastFrameTimings, i == 0);
+		}
+		out << "\n]}\n";
+		m_eventManager.Publish(ApplicationEndEvent());
+		return true;
+	}
+
+	void World::Update(float timeStep, const InputRecording::Frame* replayFrame) noexcept
 	{
 		auto &transformDataManager = GetComponentManager<TransformComponent>();
 		auto &staticMeshDataManager = GetComponentManager<StaticMeshComponent>();
@@ -142,17 +225,60 @@ namespace Mona {
 		auto& spotLightDataManager = GetComponentManager<SpotLightComponent>();
 		auto& pointLightDataManager = GetComponentManager<PointLightComponent>();
 		auto& skeletalMeshDataManager = GetComponentManager<SkeletalMeshComponent>();
-		m_input.Update();
+		FrameTimings timings;
+		timings.frameIndex = m_lastFrameTimings.frameIndex + 1;
+		timings.timeStep = timeStep;
+		const auto frameStartTime = std::chrono::steady_clock::now();
+		auto stageStartTime = frameStartTime;
+		auto endStage = [&timings, &stageStartTime](FrameStage stage) {
+			const auto now = std::chrono::steady_clock::now();
+			timings.stageMilliseconds[static_cast<uint8_t>(stage)] += std::chrono::duration<float, std::milli>(now - stageStartTime).count();
+			stageStartTime = now;
+		};
+		if (replayFrame != nullptr)
+			m_input.ReplayUpdate(replayFrame->snapshot);
+		else
+			m_input.Update();
+		endStage(FrameStage::Input);
+		//La posicion de la camara principal se usa para los intervalos de actualizacion que dependen de la distancia.
+		glm::vec3 cameraPosition;
+		const glm::vec3* cameraPositionPtr = nullptr;
+		if (cameraDataManager.IsValid(m_cameraHandle)) {
+			GameObject* cameraOwner = cameraDataManager.GetOwner(m_cameraHandle);
+			cameraPosition = transformDataManager.GetComponentPointer(cameraOwner->GetInnerComponentHandle<TransformComponent>())->GetLocalTranslation();
+			cameraPositionPtr = &cameraPosition;
+		}
+		m_objectManager.UpdateGameObjects(*this, m_eventManager, ETickGroup::PrePhysics, timeStep, transformDataManager, cameraPositionPtr);
+		endStage(FrameStage::GameObjects);
 		m_physicsCollisionSystem.StepSimulation(timeStep);
 		m_physicsCollisionSystem.SubmitCollisionEvents(*this, m_eventManager, rigidBodyDataManager);
+		endStage(FrameStage::Physics);
+		m_objectManager.UpdateGameObjects(*this, m_eventManager, ETickGroup::PostPhysics, timeStep, transformDataManager, cameraPositionPtr);
+		endStage(FrameStage::GameObjects);
 		m_animationSystem.UpdateAllPoses(skeletalMeshDataManager, timeStep);
-		m_objectManager.UpdateGameObjects(*this, m_eventManager, timeStep);
+		endStage(FrameStage::Animation);
+		m_objectManager.UpdateGameObjects(*this, m_eventManager, ETickGroup::PostAnimation, timeStep, transformDataManager, cameraPositionPtr);
+		m_taskScheduler.Update(m_objectManager, timeStep);
+		endStage(FrameStage::GameObjects);
 		m_application.UserUpdate(*this, timeStep);
+		endStage(FrameStage::Application);
 		m_audioSystem.Update(m_audoListenerTransformHandle,
 			m_audioListenerOffsetRotation,
 			timeStep,
 			transformDataManager,
 			audioSourceDataManager);
+		endStage(FrameStage::Audio);
+		if (m_cameraLateLatchHook && cameraDataManager.IsValid(m_cameraHandle)) {
+			//Se recolectan los eventos de input llegados durante el frame para ajustar la camara con el estado mas reciente del mouse
+			//justo antes de que el renderer construya la matriz de vista. Al reproducir se usa la posicion grabada en ese momento.
+			if (replayFrame != nullptr)
+				m_input.ReplayLateLatch(replayFrame->lateLatchedMousePosition);
+			else
+				m_input.LateLatch();
+			GameObject* cameraOwner = cameraDataManager.GetOwner(m_cameraHandle);
+			TransformComponent* cameraTransform = transformDataManager.GetComponentPointer(cameraOwner->GetInnerComponentHandle<TransformComponent>());
+			m_cameraLateLatchHook(*cameraTransform, m_input);
+		}
 		m_renderer.Render(m_eventManager,
 			m_cameraHandle,
 			m_ambientLight,
@@ -163,7 +289,38 @@ namespace Mona {
 			directionalLightDataManager,
 			spotLightDataManager,
 			pointLightDataManager);
+		endStage(FrameStage::Render);
 		m_window.Update();
+		endStage(FrameStage::Present);
+		timings.totalMilliseconds = std::chrono::duration<float, std::milli>(stageStartTime - frameStartTime).count();
+		m_lastFrameTimings = timings;
+		if (m_frameBudgetGovernor.Update(timings))
+			ApplyQualitySettings(m_frameBudgetGovernor.GetCurrentSettings());
+	}
+
+	void World::ApplyQualitySettings(const QualitySettings& settings) noexcept {
+		m_animationSystem.SetUpdateInterval(settings.animationUpdateInterval);
+		m_physicsCollisionSystem.SetMaxSubSteps(settings.physicsMaxSubSteps);
+		m_audioSystem.SetVoiceLimit(settings.audioVoiceLimit);
+		m_renderer.SetLODBias(settings.renderLODBias);
+		m_objectManager.SetTickIntervalScale(settings.tickIntervalScale);
+	}
+
+	TaskID World::StartTask(Task task) noexcept {
+		return m_taskScheduler.StartTask(std::move(task));
+	}
+
+	TaskID World::StartTask(Task task, const GameObject& owner) noexcept {
+		MONA_ASSERT(m_objectManager.IsValid(owner.GetInnerObjectHandle()), "World Error: Trying to start task with invalid owner");
+		return m_taskScheduler.StartTask(std::move(task), owner.GetInnerObjectHandle());
+	}
+
+	void World::StopTask(const TaskID& id) noexcept {
+		m_taskScheduler.StopTask(id);
+	}
+
+	bool World::IsTaskRunning(const TaskID& id) const noexcept {
+		return m_taskScheduler.IsTaskRunning(id);
 	}
 
 	void World::SetMainCamera(const ComponentHandle<CameraComponent>& cameraHandle) noexcept {
@@ -198,11 +355,44 @@ namespace Mona {
 		auto& cameraDataManager = GetComponentManager<CameraComponent>();
 		return ComponentHandle<CameraComponent>(m_cameraHandle, &cameraDataManager);
 	}
+
+	void World::SetCameraLateLatchHook(CameraLateLatchHook hook) noexcept {
+		m_cameraLateLatchHook = std::move(hook);
+	}
+
+	void World::ClearCameraLateLatchHook() noexcept {
+		m_cameraLateLatchHook = nullptr;
+	}
 	
 	std::shared_ptr<Material> World::CreateMaterial(MaterialType type, bool isForSkinning) noexcept {
 		return m_renderer.CreateMaterial(type, isForSkinning);
 	}
 
+	bool World::BakePotentiallyVisibleSet(const PVSBakeSettings& settings, const std::filesystem::path& filePath) noexcept {
+		PotentiallyVisibleSet pvs = m_renderer.BakePotentiallyVisibleSet(GetComponentManager<StaticMeshComponent>(),
+			GetComponentManager<TransformComponent>(), settings);
+		const bool saved = pvs.SaveToFile(filePath);
+		m_renderer.SetPotentiallyVisibleSet(std::move(pvs));
+		return saved;
+	}
+
+	bool World::LoadPotentiallyVisibleSet(const std::filesystem::path& filePath) noexcept {
+		return m_renderer.LoadPotentiallyVisibleSet(filePath);
+	}
+
+	void World::ClearPotentiallyVisibleSet() noexcept {
+		m_renderer.ClearPotentiallyVisibleSet();
+	}
+
+	uint32_t World::BuildStaticBatches(float cellSize) noexcept {
+		return m_renderer.BuildStaticBatches(GetComponentManager<StaticMeshComponent>(), GetComponentManager<TransformComponent>(),
+			cellSize);
+	}
+
+	void World::ClearStaticBatches() noexcept {
+		m_renderer.ClearStaticBatches(GetComponentManager<StaticMeshComponent>());
+	}
+
 	void World::SetAudioListenerTransform(const ComponentHandle<TransformComponent>& transformHandle,
 		const glm::fquat& offsetRotation) noexcept{
 		m_audoListenerTransformHandle = transformHandle.GetInnerHandle();
@@ -12,6 +12,9 @@
 #include "../Event/EventManager.hpp"
 #include "../Platform/Window.hpp"
 #include "../Platform/Input.hpp"
+#include "../Platform/InputRecording.hpp"
+#include "../Core/FrameTimings.hpp"
+#include "../Core/FrameBudgetGovernor.hpp"
 #include "../Application.hpp"
 #include "../Rendering/CameraComponent.hpp"
 #include "../Rendering/StaticMeshComponent.hpp"
@@ -19,6 +22,8 @@
 #include "../Rendering/PointLightComponent.hpp"
 #include "../Rendering/SpotLightComponent.hpp"
 #include "../Rendering/Renderer.hpp"
+#include "../Rendering/StaticMeshLifetimePolicy.hpp"
+#include "../Rendering/RecordingRenderBackend.hpp"
 #include "../PhysicsCollision/RigidBodyComponent.hpp"
 #include "../PhysicsCollision/RigidBodyLifetimePolicy.hpp"
 #include "../PhysicsCollision/RaycastResults.hpp"
@@ -32,11 +37,14 @@
 #include "../IK/IKSolver.hpp"
 #include "../IK/FABRIKSolver.hpp"
 #include "../IK/CCDSolver.hpp"
+#include "../Tasks/Task.hpp"
+#include "../Tasks/TaskScheduler.hpp"
 
 #include <memory>
 #include <array>
 #include <filesystem>
 #include <string>
+#include <functional>
 
 namespace Mona {
 
@@ -45,6 +53,12 @@ namespace Mona {
 	public:
 		friend class Engine;
 		friend class MonaTest;
+		/*
+		* Funcion llamada justo antes de renderizar, luego de recolectar los eventos de input mas recientes, con el TransformComponent
+		* de la camara principal. Permite aplicar a la camara el ultimo estado del mouse (Input::GetLatestMousePosition) reduciendo
+		* la latencia percibida en un frame.
+		*/
+		using CameraLateLatchHook = std::function<void(TransformComponent& cameraTransform, const Input& input)>;
 		
 		World(const World& world) = delete;
 		World& operator=(const World& world) = delete;
@@ -55,6 +69,14 @@ namespace Mona {
 		GameObjectHandle<ObjectType> CreateGameObject(Args&& ... args) noexcept;
 		void DestroyGameObject(BaseGameObjectHandle& handle) noexcept;
 		void DestroyGameObject(GameObject& gameObject) noexcept;
+		/*
+		* Ajusta el grupo y el intervalo de actualizacion del GameObject entregado (ver TickSettings).
+		*/
+		void SetTickSettings(GameObject& gameObject, const TickSettings& settings) noexcept;
+		/*
+		* Un GameObject durmiendo no es considerado al actualizar los GameObjects hasta que se despierte.
+		*/
+		void SetSleeping(GameObject& gameObject, bool sleeping) noexcept;
 
 		template <typename ComponentType, typename ...Args>
 		ComponentHandle<ComponentType> AddComponent(BaseGameObjectHandle& objectHandle, Args&& ... args) noexcept;
@@ -83,7 +105,41 @@ namespace Mona {
 		const glm::vec3& GetAmbientLight() const { return m_ambientLight; }
 		void SetAmbientLight(const glm::vec3& light) { m_ambientLight = light; }
 		ComponentHandle<CameraComponent> GetMainCameraComponent() noexcept;
+		void SetCameraLateLatchHook(CameraLateLatchHook hook) noexcept;
+		void ClearCameraLateLatchHook() noexcept;
+		/*
+		* Retorna los tiempos medidos en CPU para cada etapa del ultimo frame completado.
+		*/
+		const FrameTimings& GetLastFrameTimings() const noexcept { return m_lastFrameTimings; }
+		/*
+		* Retorna el controlador que degrada automaticamente la calidad para mantener el tiempo por frame objetivo.
+		*/
+		FrameBudgetGovernor& GetFrameBudgetGovernor() noexcept { return m_frameBudgetGovernor; }
 		std::shared_ptr<Material> CreateMaterial(MaterialType type, bool isForSkinning = false) noexcept;
+		/*
+		* Calcula el conjunto de objetos potencialmente visibles de las mallas estaticas de la escena actual, lo guarda en
+		* filePath y comienza a usarlo. Pensado para ejecutarse una vez fuera del juego, luego basta cargar el archivo con
+		* LoadPotentiallyVisibleSet al crear la misma escena.
+		*/
+		bool BakePotentiallyVisibleSet(const PVSBakeSettings& settings, const std::filesystem::path& filePath) noexcept;
+		bool LoadPotentiallyVisibleSet(const std::filesystem::path& filePath) noexcept;
+		void ClearPotentiallyVisibleSet() noexcept;
+		/*
+		* Une las mallas estaticas de la escena marcadas con StaticMeshComponent::SetStatic en lotes por material y celda
+		* de lado cellSize. Debe llamarse luego de crear la escena. Las mallas unidas que luego se mueven, cambian de material
+		* o se destruyen salen de su lote, que se reconstruye con las restantes. Retorna la cantidad de lotes creados.
+		*/
+		uint32_t BuildStaticBatches(float cellSize) noexcept;
+		void ClearStaticBatches() noexcept;
+		/*
+		* Con headless_rendering activado en la configuracion no se crea una ventana y el renderer emite sus llamados a un
+		* RecordingRenderBackend, que registra los de cada frame. Retorna nullptr en caso contrario.
+		*/
+		const RecordingRenderBackend* GetRecordingRenderBackend() const noexcept { return m_recordingRenderBackend.get(); }
+		/*
+		* Retorna los contadores de dibujo, cambios de estado y datos subidos a la GPU del ultimo frame renderizado.
+		*/
+		const RenderStatistics& GetRenderStatistics() const noexcept { return m_renderer.GetRenderStatistics(); }
 
 
 		void SetGravity(const glm::vec3& gravity);
@@ -109,13 +165,33 @@ namespace Mona {
 		float GetMasterVolume() const noexcept;
 		void SetMasterVolume(float volume) noexcept;
 
+		/*
+		* Inicia una tarea (corrutina) que el motor reanuda cada frame luego de actualizar los GameObjects, respetando el
+		* presupuesto de tiempo por frame configurado en task_budget_milliseconds. Si se entrega un GameObject como dueno,
+		* la tarea se detiene automaticamente al destruirlo.
+		*/
+		TaskID StartTask(Task task) noexcept;
+		TaskID StartTask(Task task, const GameObject& owner) noexcept;
+		void StopTask(const TaskID& id) noexcept;
+		bool IsTaskRunning(const TaskID& id) const noexcept;
+
 		JointPose GetJointWorldPose(const ComponentHandle<SkeletalMeshComponent>& skeletalMeshHandel, uint32_t jointIndex) noexcept;
 
 	private:
 		World(Application& app);
 		~World();
 		void StartMainLoop() noexcept;
-		void Update(float timeStep) noexcept;
+		/*
+		* Ejecuta exactamente los frames de la grabacion ubicada en recordingPath, con los mismos pasos de tiempo e instantaneas
+		* de input, y escribe en timingsPath (formato JSON) los tiempos de cada etapa de cada frame.
+		*/
+		bool StartReplayLoop(const std::filesystem::path& recordingPath, const std::filesystem::path& timingsPath) noexcept;
+		/*
+		* Si replayFrame no es nulo su instantanea y su posicion tardia del mouse se usan como input del frame en lugar de los
+		* eventos recibidos por la ventana.
+		*/
+		void Update(float timeStep, const InputRecording::Frame* replayFrame = nullptr) noexcept;
+		void ApplyQualitySettings(const QualitySettings& settings) noexcept;
 
 		template <typename ComponentType>
 		auto& GetComponentManager() noexcept;
@@ -134,6 +210,9 @@ namespace Mona {
 
 		Renderer m_renderer;
 		InnerComponentHandle m_cameraHandle;
+		CameraLateLatchHook m_cameraLateLatchHook;
+		FrameTimings m_lastFrameTimings;
+		FrameBudgetGovernor m_frameBudgetGovernor;
 		glm::vec3 m_ambientLight;
 
 		PhysicsCollisionSystem m_physicsCollisionSystem;
@@ -143,7 +222,9 @@ namespace Mona {
 		glm::fquat m_audioListenerOffsetRotation = glm::fquat(1.0f, 0.0f, 0.0f, 0.0f);
 
 		AnimationSystem m_animationSystem;
+		TaskScheduler m_taskScheduler;
 		std::unique_ptr<DebugDrawingSystem> m_debugDrawingSystem;
+		std::unique_ptr<RecordingRenderBackend> m_recordingRenderBackend;
 
 		
 	};
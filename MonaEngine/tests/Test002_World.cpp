@@ -6,6 +6,7 @@
 #include "World/ComponentHandle.hpp"
 #include "World/GameObjectHandle.hpp"
 #include <memory>
+#include <vector>
 int globalStartUpCalls = 0;
 int globalDestructorCalls = 0;
 int globalUpdateCalls = 0;
@@ -79,6 +80,21 @@ public:
 private:
 	int m_frameCount;
 };
+//Objeto que se actualiza cada medio segundo y suma el tiempo que recibe en UserUpdate.
+class IntervalObject : public Mona::GameObject {
+public:
+	virtual void UserStartUp(Mona::World& world) noexcept override {
+		Mona::TickSettings settings;
+		settings.interval = 0.5f;
+		world.SetTickSettings(*this, settings);
+	}
+	virtual void UserUpdate(Mona::World& world, float timeStep) noexcept override {
+		m_reportedTime += timeStep;
+		m_updateCount++;
+	}
+	float m_reportedTime = 0.0f;
+	int m_updateCount = 0;
+};
 Mona::GameObjectHandle<MyBox> boxes[2000];
 namespace Mona{
 class MonaTest  {
@@ -128,6 +144,18 @@ public:
 		}
 		MONA_ASSERT(globalStartUpCalls == 2003, "Incorrect number of startUp calls");
 		world.Update(1.0f);
+
+		//El desfase entre objetos con el mismo intervalo solo adelanta su primera actualizacion, el tiempo que reciben
+		//nunca supera el tiempo que realmente transcurrio.
+		std::vector<Mona::GameObjectHandle<IntervalObject>> intervalObjects;
+		for (uint32_t i = 0; i < 8; i++)
+			intervalObjects.push_back(world.CreateGameObject<IntervalObject>());
+		for (uint32_t i = 0; i < 20; i++)
+			world.Update(0.125f);
+		for (auto& intervalObject : intervalObjects) {
+			MONA_ASSERT(intervalObject->m_updateCount >= 4 && intervalObject->m_updateCount <= 5, "Incorrect number of interval updates");
+			MONA_ASSERT(intervalObject->m_reportedTime <= 20 * 0.125f + 1e-4f, "Objects should not receive time that did not pass");
+		}
 		
 	}
 };
@@ -0,0 +1,79 @@
+#include "Core/Log.hpp"
+#include "Rendering/OcclusionCuller.hpp"
+#include <glm/gtc/matrix_transform.hpp>
+#include <vector>
+//Pared cuadrada de lado 2 * halfSize centrada en el origen del plano z = 0.
+void AddWall(Mona::OcclusionCuller& culler, float halfSize, const glm::mat4& modelMatrix) {
+	const glm::vec3 positions[] = {
+		glm::vec3(-halfSize, -halfSize, 0.0f),
+		glm::vec3(halfSize, -halfSize, 0.0f),
+		glm::vec3(halfSize, halfSize, 0.0f),
+		glm::vec3(-halfSize, halfSize, 0.0f)
+	};
+	const uint32_t indices[] = { 0, 1, 2, 0, 2, 3 };
+	culler.AddOccluder(positions, 4, indices, 6, modelMatrix);
+}
+
+Mona::BoundingBox BoxAt(const glm::vec3& center, float halfSize) {
+	return Mona::BoundingBox(center - glm::vec3(halfSize), center + glm::vec3(halfSize));
+}
+
+int main() {
+	//Camara en el origen mirando hacia -z.
+	const glm::mat4 projectionMatrix = glm::perspective(glm::radians(60.0f), 2.0f, 0.1f, 100.0f);
+	const glm::mat4 viewMatrix = glm::lookAt(glm::vec3(0.0f), glm::vec3(0.0f, 0.0f, -1.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+	Mona::OcclusionCuller culler;
+	culler.StartUp(250, 125, 4);
+	MONA_ASSERT(culler.GetWidth() == 256 && culler.GetHeight() == 128, "Resolution should be rounded to whole tiles");
+
+	//Sin oclusores nada esta ocluido.
+	culler.BeginFrame(projectionMatrix * viewMatrix);
+	culler.Rasterize();
+	MONA_ASSERT(!culler.IsOccluded(BoxAt(glm::vec3(0.0f, 0.0f, -10.0f), 1.0f)), "Nothing should be occluded without occluders");
+
+	//Pared de 4x4 a distancia 5.
+	culler.BeginFrame(projectionMatrix * viewMatrix);
+	AddWall(culler, 2.0f, glm::translate(glm::mat4(1.0f), glm::vec3(0.0f, 0.0f, -5.0f)));
+	culler.Rasterize();
+	MONA_ASSERT(culler.GetOccluderTriangleCount() == 2, "Incorrect occluder triangle count");
+	const float centerDepth = culler.GetDepth(culler.GetWidth() / 2, culler.GetHeight() / 2);
+	MONA_ASSERT(glm::abs(centerDepth - 0.2f) < 1e-3f, "Center pixel should store 1/w of the wall");
+	MONA_ASSERT(culler.GetDepth(0, 0) == 0.0f, "Corner pixel should not be covered");
+	MONA_ASSERT(culler.IsOccluded(BoxAt(glm::vec3(0.0f, 0.0f, -10.0f), 0.5f)), "Box behind the wall should be occluded");
+	MONA_ASSERT(culler.IsOccluded(BoxAt(glm::vec3(0.0f, 0.0f, -50.0f), 5.0f)), "Large distant box behind the wall should be occluded");
+	MONA_ASSERT(!culler.IsOccluded(BoxAt(glm::vec3(0.0f, 0.0f, -3.0f), 0.5f)), "Box in front of the wall should be visible");
+	MONA_ASSERT(!culler.IsOccluded(BoxAt(glm::vec3(6.0f, 0.0f, -10.0f), 0.5f)), "Box beside the wall should be visible");
+	MONA_ASSERT(!culler.IsOccluded(BoxAt(glm::vec3(3.5f, 0.0f, -10.0f), 1.0f)), "Box partially behind the wall should be visible");
+	MONA_ASSERT(!culler.IsOccluded(BoxAt(glm::vec3(0.0f, 0.0f, -5.0f), 2.0f)), "The wall bounds should not be occluded by the wall");
+	MONA_ASSERT(!culler.IsOccluded(BoxAt(glm::vec3(0.0f, 0.0f, 0.0f), 1.0f)), "Boxes crossing the near plane should be visible");
+
+	//Pared que cruza el plano cercano, debe recortarse y seguir ocluyendo lo que esta detras de la parte visible.
+	culler.BeginFrame(projectionMatrix * viewMatrix);
+	AddWall(culler, 20.0f, glm::translate(glm::mat4(1.0f), glm::vec3(-1.0f, 0.0f, 0.0f)) *
+		glm::rotate(glm::mat4(1.0f), glm::radians(80.0f), glm::vec3(0.0f, 1.0f, 0.0f)));
+	culler.Rasterize();
+	MONA_ASSERT(culler.GetDepth(8, culler.GetHeight() / 2) > 0.0f, "Clipped wall should cover the left side of the screen");
+	MONA_ASSERT(culler.GetDepth(culler.GetWidth() - 8, culler.GetHeight() / 2) == 0.0f, "Clipped wall should not cover the right side of the screen");
+	MONA_ASSERT(culler.IsOccluded(BoxAt(glm::vec3(-8.0f, 0.0f, -10.0f), 0.5f)), "Box behind the clipped wall should be occluded");
+	MONA_ASSERT(!culler.IsOccluded(BoxAt(glm::vec3(3.0f, 0.0f, -10.0f), 0.5f)), "Box in front of the clipped wall should be visible");
+
+	//Muchos oclusores se reparten entre varios hilos, el resultado debe ser el mismo que con un hilo.
+	Mona::OcclusionCuller singleThreadCuller;
+	singleThreadCuller.StartUp(256, 128, 1);
+	culler.BeginFrame(projectionMatrix * viewMatrix);
+	singleThreadCuller.BeginFrame(projectionMatrix * viewMatrix);
+	for (uint32_t i = 0; i < 2000; i++) {
+		const glm::mat4 modelMatrix = glm::translate(glm::mat4(1.0f),
+			glm::vec3(static_cast<float>(i % 40) - 20.0f, static_cast<float>(i / 40) * 0.5f - 12.0f, -20.0f - static_cast<float>(i % 7)));
+		AddWall(culler, 0.3f, modelMatrix);
+		AddWall(singleThreadCuller, 0.3f, modelMatrix);
+	}
+	culler.Rasterize();
+	singleThreadCuller.Rasterize();
+	for (uint32_t y = 0; y < culler.GetHeight(); y++) {
+		for (uint32_t x = 0; x < culler.GetWidth(); x++)
+			MONA_ASSERT(culler.GetDepth(x, y) == singleThreadCuller.GetDepth(x, y), "Multithreaded rasterization should match");
+	}
+	MONA_LOG_INFO("All test passed!!!");
+	return 0;
+}
@@ -0,0 +1,69 @@
+#include "Core/Log.hpp"
+#include "Rendering/PotentiallyVisibleSet.hpp"
+#include <filesystem>
+#include <vector>
+Mona::BoundingBox BoxAt(const glm::vec3& center, float halfSize) {
+	return Mona::BoundingBox(center - glm::vec3(halfSize), center + glm::vec3(halfSize));
+}
+
+int main() {
+	//Pared cuadrada en el plano x = 0 que separa dos cajas sin geometria, una a cada lado.
+	const glm::vec3 wallPositions[] = {
+		glm::vec3(0.0f, -10.0f, -10.0f),
+		glm::vec3(0.0f, 10.0f, -10.0f),
+		glm::vec3(0.0f, 10.0f, 10.0f),
+		glm::vec3(0.0f, -10.0f, 10.0f)
+	};
+	const uint32_t wallIndices[] = { 0, 1, 2, 0, 2, 3 };
+	std::vector<Mona::PVSBakeObject> objects(4);
+	objects[0].worldBounds = Mona::BoundingBox(glm::vec3(0.0f, -10.0f, -10.0f), glm::vec3(0.0f, 10.0f, 10.0f));
+	objects[0].positions = wallPositions;
+	objects[0].vertexCount = 4;
+	objects[0].indices = wallIndices;
+	objects[0].indexCount = 6;
+	objects[1].worldBounds = BoxAt(glm::vec3(-5.0f, 0.0f, 0.0f), 1.0f);
+	objects[2].worldBounds = BoxAt(glm::vec3(5.0f, 0.0f, 0.0f), 1.0f);
+	//Un objeto sin caja nunca se descarta.
+	objects[3].worldBounds = Mona::BoundingBox();
+
+	Mona::PVSBakeSettings settings;
+	settings.cellSize = 4.0f;
+	settings.resolution = 64;
+	Mona::PotentiallyVisibleSet pvs = Mona::PotentiallyVisibleSet::Bake(objects, settings);
+	MONA_ASSERT(pvs.GetObjectCount() == 4, "Incorrect object count");
+	MONA_ASSERT(pvs.GetCellCount() == 3 * 5 * 5, "Incorrect cell count");
+	const uint32_t leftCell = pvs.FindCell(glm::vec3(-5.0f, 0.0f, 5.0f));
+	const uint32_t middleCell = pvs.FindCell(glm::vec3(0.5f, 0.0f, 0.0f));
+	const uint32_t rightCell = pvs.FindCell(glm::vec3(5.0f, 3.0f, 0.0f));
+	MONA_ASSERT(leftCell != Mona::PotentiallyVisibleSet::s_invalidIndex && rightCell != Mona::PotentiallyVisibleSet::s_invalidIndex,
+		"Points inside the scene should have a cell");
+	MONA_ASSERT(pvs.FindCell(glm::vec3(20.0f, 0.0f, 0.0f)) == Mona::PotentiallyVisibleSet::s_invalidIndex, "Points outside the grid should not have a cell");
+	MONA_ASSERT(pvs.IsVisible(leftCell, 0) && pvs.IsVisible(leftCell, 1) && !pvs.IsVisible(leftCell, 2), "Left cell should not see the right box");
+	MONA_ASSERT(pvs.IsVisible(rightCell, 0) && !pvs.IsVisible(rightCell, 1) && pvs.IsVisible(rightCell, 2), "Right cell should not see the left box");
+	MONA_ASSERT(pvs.IsVisible(middleCell, 1) && pvs.IsVisible(middleCell, 2), "Cell around the wall should see both boxes");
+	for (uint32_t cell = 0; cell < pvs.GetCellCount(); cell++)
+		MONA_ASSERT(pvs.IsVisible(cell, 3), "Objects without bounds should always be visible");
+
+	//Los objetos se identifican por su caja exacta, una caja desplazada no coincide con ninguno.
+	MONA_ASSERT(pvs.FindObject(objects[2].worldBounds) == 2, "Object should be found by its bounds");
+	MONA_ASSERT(pvs.FindObject(BoxAt(glm::vec3(5.0f, 0.0f, 0.001f), 1.0f)) == Mona::PotentiallyVisibleSet::s_invalidIndex,
+		"Moved objects should not be found");
+	MONA_ASSERT(pvs.FindObject(Mona::BoundingBox()) == Mona::PotentiallyVisibleSet::s_invalidIndex, "Objects without bounds should not be found");
+
+	const std::filesystem::path filePath = std::filesystem::temp_directory_path() / "Test004_PotentiallyVisibleSet.pvs";
+	MONA_ASSERT(pvs.SaveToFile(filePath), "Saving should succeed");
+	Mona::PotentiallyVisibleSet loaded;
+	MONA_ASSERT(loaded.LoadFromFile(filePath), "Loading should succeed");
+	std::filesystem::remove(filePath);
+	MONA_ASSERT(loaded.GetCellCount() == pvs.GetCellCount() && loaded.GetObjectCount() == pvs.GetObjectCount(), "Loaded set should match");
+	MONA_ASSERT(loaded.FindObject(objects[1].worldBounds) == 1, "Loaded set should find objects by their bounds");
+	for (uint32_t cell = 0; cell < pvs.GetCellCount(); cell++) {
+		for (uint32_t object = 0; object < pvs.GetObjectCount(); object++)
+			MONA_ASSERT(loaded.IsVisible(cell, object) == pvs.IsVisible(cell, object), "Loaded visibility should match");
+	}
+	MONA_ASSERT(!loaded.LoadFromFile(filePath), "Loading a missing file should fail");
+	loaded.Clear();
+	MONA_ASSERT(loaded.IsEmpty() && loaded.FindCell(glm::vec3(0.0f)) == Mona::PotentiallyVisibleSet::s_invalidIndex, "Cleared set should be empty");
+	MONA_LOG_INFO("All test passed!!!");
+	return 0;
+}
@@ -0,0 +1,114 @@
+#include "Core/Log.hpp"
+#include "Rendering/MeshClusters.hpp"
+#include <glm/gtc/matrix_transform.hpp>
+#include <glm/gtc/constants.hpp>
+#include <algorithm>
+#include <array>
+#include <vector>
+//Esfera de radio uno con los vertices de la costura y de los polos repetidos, triangulos con normal hacia afuera.
+void CreateSphere(std::vector<glm::vec3>& positions, std::vector<uint32_t>& indices, uint32_t stacks, uint32_t slices, uint32_t lastStack) {
+	positions.clear();
+	indices.clear();
+	for (uint32_t i = 0; i <= stacks; i++) {
+		const float phi = glm::pi<float>() * static_cast<float>(i) / static_cast<float>(stacks);
+		for (uint32_t j = 0; j <= slices; j++) {
+			const float theta = 2.0f * glm::pi<float>() * static_cast<float>(j) / static_cast<float>(slices);
+			//Se fuerzan los valores exactos en la costura y los polos para que las posiciones repetidas coincidan.
+			const float sinPhi = i == 0 || i == stacks ? 0.0f : glm::sin(phi);
+			const float cosPhi = i == 0 ? 1.0f : (i == stacks ? -1.0f : glm::cos(phi));
+			const float sinTheta = j == slices ? 0.0f : glm::sin(theta);
+			const float cosTheta = j == slices ? 1.0f : glm::cos(theta);
+			positions.push_back(glm::vec3(sinPhi * cosTheta, cosPhi, sinPhi * sinTheta));
+		}
+	}
+	for (uint32_t i = 0; i < lastStack; i++) {
+		for (uint32_t j = 0; j < slices; j++) {
+			const uint32_t a = i * (slices + 1) + j;
+			const uint32_t b = a + slices + 1;
+			if (i != 0)
+				indices.insert(indices.end(), { a, a + 1, b });
+			if (i != stacks - 1)
+				indices.insert(indices.end(), { a + 1, b + 1, b });
+		}
+	}
+}
+
+glm::vec3 TriangleNormal(const std::vector<glm::vec3>& positions, const uint32_t* triangle) {
+	return glm::normalize(glm::cross(positions[triangle[1]] - positions[triangle[0]], positions[triangle[2]] - positions[triangle[0]]));
+}
+
+std::vector<std::array<uint32_t, 3>> SortedTriangles(const std::vector<uint32_t>& indices) {
+	std::vector<std::array<uint32_t, 3>> triangles;
+	for (size_t i = 0; i < indices.size(); i += 3)
+		triangles.push_back({ indices[i], indices[i + 1], indices[i + 2] });
+	std::sort(triangles.begin(), triangles.end());
+	return triangles;
+}
+
+int main() {
+	std::vector<glm::vec3> positions;
+	std::vector<uint32_t> indices;
+	CreateSphere(positions, indices, 48, 64, 48);
+	MONA_ASSERT(glm::dot(TriangleNormal(positions, &indices[0]), positions[indices[0]] + positions[indices[1]]) > 0.0f,
+		"Sphere triangles should face outwards");
+	const std::vector<uint32_t> originalIndices = indices;
+	std::vector<Mona::MeshCluster> clusters;
+	Mona::BuildMeshClusters(clusters, indices, positions.data(), static_cast<uint32_t>(positions.size()), sizeof(glm::vec3), 0);
+	MONA_ASSERT(SortedTriangles(indices) == SortedTriangles(originalIndices), "Clustering should only reorder triangles");
+	const uint32_t triangleCount = static_cast<uint32_t>(indices.size() / 3);
+	MONA_ASSERT(clusters.size() >= (triangleCount + Mona::MAX_CLUSTER_TRIANGLES - 1) / Mona::MAX_CLUSTER_TRIANGLES, "Too few clusters");
+	MONA_ASSERT(clusters.size() <= 2 * triangleCount / Mona::MAX_CLUSTER_TRIANGLES, "Clusters should be mostly full");
+	uint32_t expectedOffset = 0;
+	for (const Mona::MeshCluster& cluster : clusters) {
+		MONA_ASSERT(cluster.indexOffset == expectedOffset, "Clusters should cover the indices in order");
+		MONA_ASSERT(cluster.indexCount > 0 && cluster.indexCount <= 3 * Mona::MAX_CLUSTER_TRIANGLES, "Incorrect cluster size");
+		expectedOffset += cluster.indexCount;
+		std::vector<uint32_t> clusterVertices(indices.begin() + cluster.indexOffset, indices.begin() + cluster.indexOffset + cluster.indexCount);
+		std::sort(clusterVertices.begin(), clusterVertices.end());
+		const size_t vertexCount = std::unique(clusterVertices.begin(), clusterVertices.end()) - clusterVertices.begin();
+		MONA_ASSERT(vertexCount <= Mona::MAX_CLUSTER_VERTICES, "Too many vertices in cluster");
+		MONA_ASSERT(cluster.coneCutoff < 1.0f, "Small clusters of a closed sphere should have a valid normal cone");
+		const float minimumDot = glm::sqrt(1.0f - cluster.coneCutoff * cluster.coneCutoff);
+		for (uint32_t i = cluster.indexOffset; i < cluster.indexOffset + cluster.indexCount; i += 3) {
+			for (uint32_t k = 0; k < 3; k++)
+				MONA_ASSERT(glm::length(positions[indices[i + k]] - cluster.center) <= cluster.radius + 1e-5f, "Vertex outside cluster sphere");
+			MONA_ASSERT(glm::dot(TriangleNormal(positions, &indices[i]), cluster.coneAxis) >= minimumDot - 1e-4f, "Normal outside cluster cone");
+		}
+	}
+	MONA_ASSERT(expectedOffset == indices.size(), "Clusters should cover all indices");
+
+	//Camara en (0, 0, 5) mirando hacia -z. Cerca de la mitad de los grupos mira hacia atras, y todos los triangulos de los
+	//grupos descartados miran hacia atras.
+	const glm::vec3 cameraPosition(0.0f, 0.0f, 5.0f);
+	const glm::mat4 projectionMatrix = glm::perspective(glm::radians(60.0f), 1.0f, 0.1f, 100.0f);
+	const glm::mat4 viewMatrix = glm::lookAt(cameraPosition, glm::vec3(0.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+	const Mona::Frustum frustum = Mona::Frustum::FromViewProjection(projectionMatrix * viewMatrix);
+	uint32_t culledCount = 0;
+	for (const Mona::MeshCluster& cluster : clusters) {
+		MONA_ASSERT(Mona::IsMeshClusterVisible(cluster, frustum, cameraPosition, false), "All clusters are inside the frustum");
+		if (Mona::IsMeshClusterVisible(cluster, frustum, cameraPosition, true))
+			continue;
+		culledCount++;
+		for (uint32_t i = cluster.indexOffset; i < cluster.indexOffset + cluster.indexCount; i += 3) {
+			for (uint32_t k = 0; k < 3; k++)
+				MONA_ASSERT(glm::dot(TriangleNormal(positions, &indices[i]), positions[indices[i + k]] - cameraPosition) > 0.0f,
+					"Culled cluster has a front facing triangle");
+		}
+	}
+	MONA_ASSERT(culledCount >= clusters.size() / 4 && culledCount <= clusters.size() / 2, "Incorrect number of back facing clusters");
+	//Los grupos se prueban en el espacio local de la malla, trasladada fuera del campo de vision no queda ninguno visible.
+	const glm::mat4 modelMatrix = glm::translate(glm::mat4(1.0f), glm::vec3(20.0f, 0.0f, 0.0f));
+	const Mona::Frustum localFrustum = Mona::Frustum::FromViewProjection(projectionMatrix * viewMatrix * modelMatrix);
+	const glm::vec3 localCameraPosition = glm::vec3(glm::inverse(modelMatrix) * glm::vec4(cameraPosition, 1.0f));
+	for (const Mona::MeshCluster& cluster : clusters)
+		MONA_ASSERT(!Mona::IsMeshClusterVisible(cluster, localFrustum, localCameraPosition, true), "Clusters outside the frustum should be culled");
+
+	//En una malla abierta (media esfera) las caras traseras pueden verse, ningun grupo puede descartarse por su cono.
+	CreateSphere(positions, indices, 48, 64, 24);
+	Mona::BuildMeshClusters(clusters, indices, positions.data(), static_cast<uint32_t>(positions.size()), sizeof(glm::vec3), 0);
+	MONA_ASSERT(!clusters.empty(), "Open mesh should be clustered");
+	for (const Mona::MeshCluster& cluster : clusters)
+		MONA_ASSERT(cluster.coneCutoff == 1.0f, "Open meshes should not have normal cones");
+	MONA_LOG_INFO("All test passed!!!");
+	return 0;
+}
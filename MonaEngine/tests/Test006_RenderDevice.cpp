@@ -0,0 +1,118 @@
+#include "Core/Log.hpp"
+#include "Rendering/RenderDevice.hpp"
+#include "Rendering/RecordingRenderBackend.hpp"
+#include <glad/glad.h>
+#include <vector>
+//Backend que registra en orden los cambios de estado que recibe, permite probar RenderDevice sin una GPU.
+class MockRenderBackend : public Mona::RecordingRenderBackend {
+public:
+	struct Call {
+		const char* name;
+		uint32_t a;
+		uint32_t b;
+		uint32_t c;
+	};
+	virtual void UseProgram(uint32_t program) noexcept override { calls.push_back({ "UseProgram", program, 0, 0 }); }
+	virtual void BindVertexArray(uint32_t vertexArray) noexcept override { calls.push_back({ "BindVertexArray", vertexArray, 0, 0 }); }
+	virtual void BindBuffer(uint32_t target, uint32_t buffer) noexcept override { calls.push_back({ "BindBuffer", target, buffer, 0 }); }
+	virtual void BindBufferBase(uint32_t target, uint32_t index, uint32_t buffer) noexcept override {
+		calls.push_back({ "BindBufferBase", target, index, buffer });
+	}
+	virtual void BindBufferRange(uint32_t target, uint32_t index, uint32_t buffer, size_t, size_t) noexcept override {
+		calls.push_back({ "BindBufferRange", target, index, buffer });
+	}
+	virtual void BindTextureUnit(uint32_t unit, uint32_t texture) noexcept override { calls.push_back({ "BindTextureUnit", unit, texture, 0 }); }
+	virtual void SetCapability(uint32_t capability, bool enabled) noexcept override {
+		calls.push_back({ "SetCapability", capability, static_cast<uint32_t>(enabled), 0 });
+	}
+	virtual void DeleteProgram(uint32_t program) noexcept override { calls.push_back({ "DeleteProgram", program, 0, 0 }); }
+	virtual void DeleteVertexArray(uint32_t vertexArray) noexcept override { calls.push_back({ "DeleteVertexArray", vertexArray, 0, 0 }); }
+	virtual void DeleteBuffer(uint32_t buffer) noexcept override { calls.push_back({ "DeleteBuffer", buffer, 0, 0 }); }
+	virtual void DeleteTexture(uint32_t texture) noexcept override { calls.push_back({ "DeleteTexture", texture, 0, 0 }); }
+	std::vector<Call> calls;
+};
+
+int main() {
+	MockRenderBackend backend;
+	Mona::RenderDevice device(backend);
+
+	//Los llamados repetidos no llegan al backend.
+	device.UseProgram(3);
+	device.UseProgram(3);
+	device.UseProgram(4);
+	device.BindVertexArray(7);
+	device.BindVertexArray(7);
+	MONA_ASSERT(backend.calls.size() == 3, "Redundant binds should be dropped");
+	const Mona::RenderDeviceStatistics& statistics = device.GetStatistics();
+	MONA_ASSERT(statistics.programBinds == 2 && statistics.programBindsAvoided == 1, "Wrong program bind counts");
+	MONA_ASSERT(statistics.vertexArrayBinds == 1 && statistics.vertexArrayBindsAvoided == 1, "Wrong vertex array bind counts");
+
+	//El buffer de indices pertenece al VAO, al cambiar de VAO debe volver a enlazarse.
+	backend.calls.clear();
+	device.BindBuffer(GL_ELEMENT_ARRAY_BUFFER, 11);
+	device.BindBuffer(GL_ELEMENT_ARRAY_BUFFER, 11);
+	device.BindVertexArray(8);
+	device.BindBuffer(GL_ELEMENT_ARRAY_BUFFER, 11);
+	MONA_ASSERT(backend.calls.size() == 3, "Element buffer should be rebound after a vertex array change");
+
+	//Los enlaces indexados se comparan por buffer, offset y tamano, y tambien actualizan el destino generico.
+	backend.calls.clear();
+	device.BindBufferRange(GL_SHADER_STORAGE_BUFFER, 2, 20, 0, 256);
+	device.BindBufferRange(GL_SHADER_STORAGE_BUFFER, 2, 20, 0, 256);
+	device.BindBufferRange(GL_SHADER_STORAGE_BUFFER, 2, 20, 256, 256);
+	device.BindBufferRange(GL_SHADER_STORAGE_BUFFER, 3, 20, 256, 256);
+	device.BindBuffer(GL_SHADER_STORAGE_BUFFER, 20);
+	device.BindBufferBase(GL_UNIFORM_BUFFER, 0, 21);
+	device.BindBufferBase(GL_UNIFORM_BUFFER, 0, 21);
+	device.BindBuffer(GL_UNIFORM_BUFFER, 21);
+	MONA_ASSERT(backend.calls.size() == 4, "Indexed bindings should be cached per index");
+	//Los destinos no seguidos se reenvian siempre.
+	device.BindBuffer(GL_COPY_READ_BUFFER, 22);
+	device.BindBuffer(GL_COPY_READ_BUFFER, 22);
+	MONA_ASSERT(backend.calls.size() == 6, "Untracked targets should always be forwarded");
+
+	//Texturas por unidad.
+	backend.calls.clear();
+	device.BindTextureUnit(0, 30);
+	device.BindTextureUnit(1, 30);
+	device.BindTextureUnit(0, 30);
+	device.BindTextureUnit(0, 31);
+	MONA_ASSERT(backend.calls.size() == 3, "Texture binds should be cached per unit");
+
+	//Capacidades.
+	backend.calls.clear();
+	device.Enable(GL_DEPTH_TEST);
+	device.Enable(GL_DEPTH_TEST);
+	device.Disable(GL_DEPTH_TEST);
+	device.Enable(GL_DEBUG_OUTPUT);
+	device.Enable(GL_DEBUG_OUTPUT);
+	MONA_ASSERT(backend.calls.size() == 4, "Only tracked capabilities should be cached");
+
+	//Al eliminar un objeto se olvidan los enlaces que lo referencian, ya que OpenGL puede reutilizar su identificador.
+	backend.calls.clear();
+	device.DeleteBuffer(20);
+	device.BindBufferRange(GL_SHADER_STORAGE_BUFFER, 2, 20, 256, 256);
+	device.BindBuffer(GL_UNIFORM_BUFFER, 21);
+	device.DeleteTexture(31);
+	device.BindTextureUnit(0, 31);
+	device.BindTextureUnit(1, 30);
+	device.DeleteProgram(4);
+	device.UseProgram(4);
+	device.DeleteVertexArray(8);
+	device.BindVertexArray(8);
+	MONA_ASSERT(backend.calls.size() == 8, "Deleted objects should be forgotten");
+
+	//Invalidate obliga a reenviar todo y BeginFrame reinicia los contadores.
+	backend.calls.clear();
+	device.Invalidate();
+	device.UseProgram(4);
+	device.BindTextureUnit(1, 30);
+	MONA_ASSERT(backend.calls.size() == 2, "Invalidate should forget all cached state");
+	device.BeginFrame();
+	MONA_ASSERT(device.GetStatistics().programBinds == 0 && device.GetStatistics().textureBinds == 0, "BeginFrame should reset statistics");
+	device.UseProgram(4);
+	MONA_ASSERT(device.GetStatistics().programBindsAvoided == 1, "Cached state should survive BeginFrame");
+
+	MONA_LOG_INFO("All test passed!!!");
+	return 0;
+}
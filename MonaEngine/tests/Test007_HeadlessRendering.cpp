@@ -0,0 +1,229 @@
+#include "Core/Log.hpp"
+#include "Core/Config.hpp"
+#include "Application.hpp"
+#include "World/GameObject.hpp"
+#include "World/World.hpp"
+#include "World/ComponentHandle.hpp"
+#include "World/GameObjectHandle.hpp"
+#include "Rendering/MeshManager.hpp"
+#include "Rendering/UnlitFlatMaterial.hpp"
+#include "Rendering/DiffuseFlatMaterial.hpp"
+#include "Rendering/RecordingRenderBackend.hpp"
+#include <glad/glad.h>
+#include <fstream>
+#include <set>
+class Sandbox : public Mona::Application
+{
+public:
+	Sandbox() = default;
+	~Sandbox() = default;
+	virtual void UserStartUp(Mona::World& world) noexcept override {}
+	virtual void UserShutDown(Mona::World& world) noexcept override {}
+	virtual void UserUpdate(Mona::World& world, float timeStep) noexcept override {}
+};
+
+class Cube : public Mona::GameObject {
+public:
+	Cube(const glm::vec3& position, std::shared_ptr<Mona::Material> material) : m_position(position), m_material(material) {}
+	virtual void UserStartUp(Mona::World& world) noexcept override {
+		m_transform = world.AddComponent<Mona::TransformComponent>(*this);
+		m_transform->Translate(m_position);
+		m_staticMesh = world.AddComponent<Mona::StaticMeshComponent>(*this, Mona::MeshManager::GetInstance().LoadMesh(Mona::Mesh::PrimitiveType::Cube), m_material);
+	}
+	void MoveTo(const glm::vec3& position) {
+		m_transform->Translate(position - m_transform->GetLocalTranslation());
+	}
+	void SetStatic(bool isStatic) {
+		m_staticMesh->SetStatic(isStatic);
+	}
+private:
+	glm::vec3 m_position;
+	std::shared_ptr<Mona::Material> m_material;
+	Mona::TransformHandle m_transform;
+	Mona::StaticMeshHandle m_staticMesh;
+};
+
+class Camera : public Mona::GameObject {
+public:
+	virtual void UserStartUp(Mona::World& world) noexcept override {
+		m_transform = world.AddComponent<Mona::TransformComponent>(*this);
+		world.SetMainCamera(world.AddComponent<Mona::CameraComponent>(*this));
+	}
+private:
+	Mona::TransformHandle m_transform;
+};
+
+namespace Mona {
+class MonaTest {
+public:
+	MonaTest() = default;
+	void Run() {
+		//Sin ventana ni contexto de OpenGL, y sin descartes que dependan de la orientacion de los triangulos.
+		{
+			std::ofstream configFile("headless_rendering.cfg");
+			configFile << "headless_rendering = 1\n";
+			configFile << "windowWidth = 640\n";
+			configFile << "windowHeight = 480\n";
+			configFile << "occlusion_culling = 0\n";
+			configFile << "cluster_culling = 0\n";
+			//Buffers de geometria pequenos, para que cargar una malla nueva obligue a recrearlos.
+			configFile << "expected_number_of_static_vertices = 64\n";
+			configFile << "expected_number_of_static_indices = 128\n";
+		}
+		Mona::Config& config = Mona::Config::GetInstance();
+		config.readFile("headless_rendering.cfg");
+		Sandbox sandbox;
+		Mona::World world(sandbox);
+		const Mona::RecordingRenderBackend* backend = world.GetRecordingRenderBackend();
+		MONA_ASSERT(backend != nullptr, "Headless world should use a recording backend");
+		MONA_ASSERT(backend->GetViewport() == glm::ivec4(0, 0, 640, 480), "Viewport should match the configured window size");
+
+		//La camara mira hacia +Y. Tres cubos con un material y dos con otro quedan frente a ella, y dos quedan detras.
+		auto unlitMaterial = world.CreateMaterial(Mona::MaterialType::UnlitFlat);
+		auto diffuseMaterial = world.CreateMaterial(Mona::MaterialType::DiffuseFlat);
+		world.CreateGameObject<Camera>();
+		world.CreateGameObject<Cube>(glm::vec3(0.0f, 15.0f, 0.0f), unlitMaterial);
+		world.CreateGameObject<Cube>(glm::vec3(0.0f, 5.0f, 0.0f), unlitMaterial);
+		world.CreateGameObject<Cube>(glm::vec3(2.0f, 10.0f, 0.0f), diffuseMaterial);
+		world.CreateGameObject<Cube>(glm::vec3(0.0f, 10.0f, 0.0f), unlitMaterial);
+		world.CreateGameObject<Cube>(glm::vec3(-2.0f, 10.0f, 0.0f), diffuseMaterial);
+		auto hiddenCube = world.CreateGameObject<Cube>(glm::vec3(0.0f, -10.0f, 0.0f), unlitMaterial);
+		world.CreateGameObject<Cube>(glm::vec3(0.0f, -20.0f, 0.0f), diffuseMaterial);
+		world.Update(1.0f / 60.0f);
+
+		const Mona::RenderQueueStatistics& queueStatistics = world.m_renderer.GetRenderQueueStatistics();
+		MONA_ASSERT(queueStatistics.submittedCount == 5, "Incorrect submitted count");
+		MONA_ASSERT(queueStatistics.culledCount == 2, "Incorrect culled count");
+
+		//Los llamados de un mismo programa deben quedar contiguos y cada cubo visible debe dibujarse una vez.
+		const std::vector<Mona::RecordedDrawCall>& drawCalls = backend->GetDrawCalls();
+		MONA_ASSERT(!drawCalls.empty(), "Nothing was drawn");
+		std::set<uint32_t> finishedPrograms;
+		uint32_t instanceCount = 0;
+		uint64_t triangleCount = 0;
+		for (size_t i = 0; i < drawCalls.size(); i++) {
+			const Mona::RecordedDrawCall& drawCall = drawCalls[i];
+			MONA_ASSERT(drawCall.mode == GL_TRIANGLES, "Unexpected primitive mode");
+			MONA_ASSERT(finishedPrograms.count(drawCall.program) == 0, "Draws should be sorted by program");
+			if (i + 1 < drawCalls.size() && drawCalls[i + 1].program != drawCall.program)
+				finishedPrograms.insert(drawCall.program);
+			instanceCount += drawCall.instanceCount;
+			triangleCount += static_cast<uint64_t>(drawCall.count / 3) * drawCall.instanceCount;
+		}
+		MONA_ASSERT(instanceCount == 5, "Each visible cube should be drawn once");
+		MONA_ASSERT(triangleCount == 5 * 12, "Incorrect triangle count");
+		const Mona::RecordingStatistics& statistics = backend->GetStatistics();
+		MONA_ASSERT(statistics.triangles == triangleCount && statistics.instances == instanceCount, "Statistics should match the recorded draws");
+		MONA_ASSERT(statistics.drawCalls <= 2, "Static cubes should be drawn with one multi draw per program");
+		MONA_ASSERT(statistics.bufferBytesUploaded > 0, "Per frame data should be uploaded");
+
+		//Los contadores del renderer deben coincidir con lo que recibio el backend.
+		const Mona::RenderStatistics& renderStatistics = world.GetRenderStatistics();
+		MONA_ASSERT(renderStatistics.drawCalls == statistics.drawCalls, "Incorrect draw call count");
+		MONA_ASSERT(renderStatistics.triangles == triangleCount && renderStatistics.instances == instanceCount, "Incorrect triangle or instance count");
+		MONA_ASSERT(renderStatistics.programBinds == statistics.programBinds, "Incorrect program bind count");
+		MONA_ASSERT(renderStatistics.vertexArrayBinds == statistics.vertexArrayBinds, "Incorrect vertex array bind count");
+		MONA_ASSERT(renderStatistics.uniformBytes == statistics.uniformBytesUploaded, "Incorrect uniform byte count");
+		MONA_ASSERT(renderStatistics.submittedCount == 5 && renderStatistics.frustumCulledCount == 2, "Incorrect object counts");
+		MONA_ASSERT(renderStatistics.pvsCulledCount == 0 && renderStatistics.occludedCount == 0 && renderStatistics.clusterCulledObjectCount == 0,
+			"Only frustum culling should reject objects");
+		MONA_ASSERT(renderStatistics.storageBufferBytes > 0 && renderStatistics.uniformBufferBytes > 0, "Buffer uploads should be counted");
+		MONA_ASSERT(renderStatistics.skinningPalettes == 0 && renderStatistics.skinningPaletteBytes == 0, "No skinning palettes should be uploaded");
+		MONA_ASSERT(renderStatistics.patchedStaticMeshCount == 7 && !renderStatistics.drawListsReused, "New meshes should be prepared");
+
+		//Al mover un cubo frente a la camara deja de descartarse, y los llamados del frame anterior se descartan.
+		hiddenCube->MoveTo(glm::vec3(0.0f, 20.0f, 0.0f));
+		world.Update(1.0f / 60.0f);
+		MONA_ASSERT(queueStatistics.submittedCount == 6 && queueStatistics.culledCount == 1, "Moved cube should be visible");
+		instanceCount = 0;
+		for (const Mona::RecordedDrawCall& drawCall : backend->GetDrawCalls())
+			instanceCount += drawCall.instanceCount;
+		MONA_ASSERT(instanceCount == 6, "Recorded draws should only contain the last frame");
+		MONA_ASSERT(renderStatistics.patchedStaticMeshCount == 1 && !renderStatistics.drawListsReused, "Only the moved cube should be patched");
+
+		//Sin cambios en la escena ni en la camara se reutiliza la cola del frame anterior y se emiten los mismos llamados.
+		const std::vector<Mona::RecordedDrawCall> previousDrawCalls = backend->GetDrawCalls();
+		world.Update(1.0f / 60.0f);
+		MONA_ASSERT(renderStatistics.drawListsReused && renderStatistics.patchedStaticMeshCount == 0, "Draw lists should be reused");
+		MONA_ASSERT(renderStatistics.submittedCount == 6 && renderStatistics.frustumCulledCount == 1, "Reused frames should keep culling results");
+		MONA_ASSERT(backend->GetDrawCalls().size() == previousDrawCalls.size(), "Reused frames should issue the same draws");
+		for (size_t i = 0; i < previousDrawCalls.size(); i++) {
+			const Mona::RecordedDrawCall& drawCall = backend->GetDrawCalls()[i];
+			MONA_ASSERT(drawCall.program == previousDrawCalls[i].program && drawCall.count == previousDrawCalls[i].count &&
+				drawCall.instanceCount == previousDrawCalls[i].instanceCount && drawCall.baseInstance == previousDrawCalls[i].baseInstance,
+				"Reused frames should issue the same draws");
+		}
+
+		//Al destruir un cubo la lista retenida se reconstruye.
+		world.DestroyGameObject(hiddenCube);
+		world.Update(1.0f / 60.0f);
+		MONA_ASSERT(!renderStatistics.drawListsReused && renderStatistics.submittedCount == 5, "Destroyed cube should not be drawn");
+		MONA_ASSERT(renderStatistics.materialCount == 2 && renderStatistics.mergedMaterialCount == 0, "Each material should have its own entry");
+
+		//Un material con los mismos parametros que otro comparte su entrada en la tabla de materiales.
+		auto duplicateMaterial = world.CreateMaterial(Mona::MaterialType::UnlitFlat);
+		world.CreateGameObject<Cube>(glm::vec3(0.0f, 12.0f, 2.0f), duplicateMaterial);
+		world.Update(1.0f / 60.0f);
+		MONA_ASSERT(renderStatistics.submittedCount == 6, "New cube should be drawn");
+		MONA_ASSERT(renderStatistics.materialCount == 2 && renderStatistics.mergedMaterialCount == 1, "Identical materials should be merged");
+		MONA_ASSERT(renderStatistics.drawCalls == 2, "Merged materials should be drawn together");
+
+		//Al cambiar sus parametros deja de compartir la entrada, pero los materiales sin texturas de un mismo programa se
+		//siguen dibujando con un unico llamado y sin actualizar uniformes.
+		std::static_pointer_cast<Mona::UnlitFlatMaterial>(duplicateMaterial)->SetColor(glm::vec3(1.0f, 0.0f, 0.0f));
+		world.Update(1.0f / 60.0f);
+		MONA_ASSERT(!renderStatistics.drawListsReused, "Material changes should rebuild the draw lists");
+		MONA_ASSERT(renderStatistics.materialCount == 3 && renderStatistics.mergedMaterialCount == 0, "Changed material should get its own entry");
+		MONA_ASSERT(renderStatistics.drawCalls == 2 && renderStatistics.instances == 6, "Flat materials of the same program should share a draw call");
+		MONA_ASSERT(renderStatistics.uniformUpdates == 0, "Material parameters should not be uploaded as uniforms");
+
+		//Cargar una malla que no cabe en los buffers compartidos los recrea y puede mover la geometria de los cubos, por lo
+		//que aunque la escena y la camara no cambien los llamados del frame anterior no se reutilizan.
+		world.Update(1.0f / 60.0f);
+		MONA_ASSERT(renderStatistics.drawListsReused, "Draw lists should be reused");
+		Mona::MeshManager& meshManager = Mona::MeshManager::GetInstance();
+		const uint32_t geometryVersion = meshManager.GetStaticGeometryVersion();
+		auto sphereMesh = meshManager.LoadMesh(Mona::Mesh::PrimitiveType::Sphere);
+		MONA_ASSERT(meshManager.GetStaticGeometryVersion() != geometryVersion, "Loading the sphere should reallocate the geometry buffers");
+		world.Update(1.0f / 60.0f);
+		MONA_ASSERT(!renderStatistics.drawListsReused, "Moved geometry should rebuild the draw lists");
+		MONA_ASSERT(renderStatistics.submittedCount == 6 && renderStatistics.instances == 6, "Every cube should still be drawn");
+
+		//Tres cubos estaticos con materiales equivalentes (mismo programa y parametros) se unen en un lote que se dibuja como
+		//un solo objeto.
+		auto batchMaterial = world.CreateMaterial(Mona::MaterialType::UnlitFlat);
+		std::static_pointer_cast<Mona::UnlitFlatMaterial>(batchMaterial)->SetColor(glm::vec3(0.0f, 1.0f, 0.0f));
+		auto equivalentBatchMaterial = world.CreateMaterial(Mona::MaterialType::UnlitFlat);
+		std::static_pointer_cast<Mona::UnlitFlatMaterial>(equivalentBatchMaterial)->SetColor(glm::vec3(0.0f, 1.0f, 0.0f));
+		auto firstBatchedCube = world.CreateGameObject<Cube>(glm::vec3(-4.0f, 30.0f, 0.0f), batchMaterial);
+		auto secondBatchedCube = world.CreateGameObject<Cube>(glm::vec3(0.0f, 30.0f, 0.0f), batchMaterial);
+		auto thirdBatchedCube = world.CreateGameObject<Cube>(glm::vec3(4.0f, 30.0f, 0.0f), equivalentBatchMaterial);
+		firstBatchedCube->SetStatic(true);
+		secondBatchedCube->SetStatic(true);
+		thirdBatchedCube->SetStatic(true);
+		MONA_ASSERT(world.BuildStaticBatches(100.0f) == 1, "Static cubes should be merged into one batch");
+		world.Update(1.0f / 60.0f);
+		MONA_ASSERT(renderStatistics.submittedCount == 7 && renderStatistics.triangles == 9 * 12, "The batch should draw every static cube");
+
+		//Al destruir un cubo del lote, el lote se reconstruye sin su geometria a partir de la copia en CPU de las mallas.
+		world.DestroyGameObject(firstBatchedCube);
+		world.Update(1.0f / 60.0f);
+		MONA_ASSERT(world.m_renderer.GetStaticBatchCount() == 1, "The batch should be rebuilt with the remaining cubes");
+		MONA_ASSERT(statistics.bufferReads == 0, "Rebuilding the batch should not read geometry back from the GPU");
+		MONA_ASSERT(renderStatistics.submittedCount == 7 && renderStatistics.triangles == 8 * 12, "Destroyed cube should leave the batch");
+
+		//Al mover un cubo del lote sale de el y se dibuja por separado. El lote con un unico cubo se elimina.
+		secondBatchedCube->MoveTo(glm::vec3(0.0f, 30.0f, 5.0f));
+		world.Update(1.0f / 60.0f);
+		MONA_ASSERT(world.m_renderer.GetStaticBatchCount() == 0, "A batch with a single cube should be removed");
+		MONA_ASSERT(renderStatistics.submittedCount == 8 && renderStatistics.triangles == 8 * 12, "Cubes leaving a batch should be drawn once");
+	}
+};
+}
+
+int main() {
+	Mona::MonaTest test;
+	test.Run();
+	MONA_LOG_INFO("All test passed!!!");
+	return 0;
+}
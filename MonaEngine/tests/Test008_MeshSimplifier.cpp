@@ -0,0 +1,111 @@
+#include "Core/Log.hpp"
+#include "Rendering/MeshSimplifier.hpp"
+#include <glm/glm.hpp>
+#include <array>
+#include <cstddef>
+#include <set>
+#include <vector>
+struct SimplifierVertex {
+	glm::vec3 position;
+	glm::vec3 normal;
+};
+
+//Cubo de lado dos con cada cara dividida en una grilla de n x n cuadrados. Cada cara tiene sus propios vertices con la normal
+//de la cara, por lo que las aristas del cubo son costuras de normales.
+void CreateHardEdgeCube(std::vector<SimplifierVertex>& vertices, std::vector<uint32_t>& indices, uint32_t n) {
+	vertices.clear();
+	indices.clear();
+	const std::array<glm::vec3, 6> normals = { glm::vec3(1.0f, 0.0f, 0.0f), glm::vec3(-1.0f, 0.0f, 0.0f), glm::vec3(0.0f, 1.0f, 0.0f),
+		glm::vec3(0.0f, -1.0f, 0.0f), glm::vec3(0.0f, 0.0f, 1.0f), glm::vec3(0.0f, 0.0f, -1.0f) };
+	for (const glm::vec3& normal : normals) {
+		const glm::vec3 u = normal.x != 0.0f ? glm::vec3(0.0f, 1.0f, 0.0f) : glm::vec3(1.0f, 0.0f, 0.0f);
+		const glm::vec3 v = glm::cross(normal, u);
+		const uint32_t base = static_cast<uint32_t>(vertices.size());
+		for (uint32_t i = 0; i <= n; i++) {
+			for (uint32_t j = 0; j <= n; j++) {
+				const float a = -1.0f + 2.0f * static_cast<float>(i) / static_cast<float>(n);
+				const float b = -1.0f + 2.0f * static_cast<float>(j) / static_cast<float>(n);
+				vertices.push_back({ normal + a * u + b * v, normal });
+			}
+		}
+		//Con v = normal x u, la base (u, v, normal) es derecha y los triangulos (a, c, d) y (a, d, b) miran hacia afuera.
+		for (uint32_t i = 0; i < n; i++) {
+			for (uint32_t j = 0; j < n; j++) {
+				const uint32_t a = base + i * (n + 1) + j;
+				const uint32_t b = a + 1;
+				const uint32_t c = a + n + 1;
+				const uint32_t d = c + 1;
+				indices.insert(indices.end(), { a, c, d, a, d, b });
+			}
+		}
+	}
+}
+
+glm::vec3 TriangleNormal(const std::vector<SimplifierVertex>& vertices, const uint32_t* triangle) {
+	return glm::normalize(glm::cross(vertices[triangle[1]].position - vertices[triangle[0]].position,
+		vertices[triangle[2]].position - vertices[triangle[0]].position));
+}
+
+//Cuenta las aristas dirigidas cuya opuesta (comparando posiciones) no existe, es decir, las grietas de la superficie.
+uint32_t CountOpenEdges(const std::vector<SimplifierVertex>& vertices, const std::vector<uint32_t>& indices) {
+	using Edge = std::array<float, 6>;
+	std::set<Edge> edges;
+	for (size_t t = 0; t < indices.size(); t += 3) {
+		for (uint32_t k = 0; k < 3; k++) {
+			const glm::vec3& a = vertices[indices[t + k]].position;
+			const glm::vec3& b = vertices[indices[t + (k + 1) % 3]].position;
+			edges.insert({ a.x, a.y, a.z, b.x, b.y, b.z });
+		}
+	}
+	uint32_t openEdgeCount = 0;
+	for (const Edge& edge : edges) {
+		if (edges.count({ edge[3], edge[4], edge[5], edge[0], edge[1], edge[2] }) == 0)
+			openEdgeCount++;
+	}
+	return openEdgeCount;
+}
+
+int main() {
+	std::vector<SimplifierVertex> vertices;
+	std::vector<uint32_t> indices;
+	CreateHardEdgeCube(vertices, indices, 8);
+	const uint32_t vertexCount = static_cast<uint32_t>(vertices.size());
+	MONA_ASSERT(glm::dot(TriangleNormal(vertices, &indices[0]), vertices[indices[0]].normal) > 0.0f, "Cube triangles should face outwards");
+	MONA_ASSERT(CountOpenEdges(vertices, indices) == 0, "Cube should be closed");
+
+	//Reducir a la mitad los triangulos no agrega error, ya que las caras son planas.
+	std::vector<uint32_t> simplifiedIndices;
+	float error = Mona::SimplifyMesh(simplifiedIndices, indices, vertices.data(), vertexCount, sizeof(SimplifierVertex),
+		static_cast<uint32_t>(offsetof(SimplifierVertex, position)), static_cast<uint32_t>(indices.size() / 2), 0.01f);
+	MONA_ASSERT(simplifiedIndices.size() <= indices.size() / 2, "Hard edge cube should be simplified");
+	MONA_ASSERT(error == 0.0f, "Simplifying flat faces should not add error");
+
+	//Las costuras se colapsan a lo largo de si mismas, por lo que la superficie sigue cerrada y cada triangulo conserva los
+	//vertices de su cara.
+	MONA_ASSERT(CountOpenEdges(vertices, simplifiedIndices) == 0, "Seams should not open");
+	for (size_t t = 0; t < simplifiedIndices.size(); t += 3) {
+		const glm::vec3 normal = TriangleNormal(vertices, &simplifiedIndices[t]);
+		for (uint32_t k = 0; k < 3; k++)
+			MONA_ASSERT(glm::dot(vertices[simplifiedIndices[t + k]].normal, normal) > 0.999f, "Triangles should keep the normals of their face");
+	}
+
+	//Sin limite de triangulos cada cara termina con sus dos triangulos minimos, las esquinas no pueden moverse.
+	error = Mona::SimplifyMesh(simplifiedIndices, indices, vertices.data(), vertexCount, sizeof(SimplifierVertex),
+		static_cast<uint32_t>(offsetof(SimplifierVertex, position)), 0, 0.01f);
+	MONA_ASSERT(simplifiedIndices.size() == 6 * 2 * 3, "Hard edge cube should be reduced to twelve triangles");
+	MONA_ASSERT(CountOpenEdges(vertices, simplifiedIndices) == 0, "Seams should not open");
+
+	//Al curvar una cara (sin mover sus bordes) el limite de error impide aplanarla por completo.
+	std::vector<SimplifierVertex> bentVertices = vertices;
+	for (SimplifierVertex& vertex : bentVertices) {
+		const glm::vec3& p = vertex.position;
+		if (vertex.normal.z > 0.5f)
+			vertex.position.z += 0.5f * (1.0f - p.x * p.x) * (1.0f - p.y * p.y);
+	}
+	error = Mona::SimplifyMesh(simplifiedIndices, indices, bentVertices.data(), vertexCount, sizeof(SimplifierVertex),
+		static_cast<uint32_t>(offsetof(SimplifierVertex, position)), 0, 0.01f);
+	MONA_ASSERT(error <= 0.01f, "Simplification should respect the maximum error");
+	MONA_ASSERT(simplifiedIndices.size() > 6 * 2 * 3, "Curved face should keep more triangles");
+	MONA_LOG_INFO("All test passed!!!");
+	return 0;
+}
@@ -0,0 +1,80 @@
+#include "Core/Log.hpp"
+#include "Rendering/RenderQueue.hpp"
+#include <algorithm>
+#include <random>
+#include <utility>
+#include <vector>
+
+//Llena la cola con elementos aleatorios cuyos campos toman pocos valores distintos, para que haya muchas llaves repetidas.
+//firstIndex guarda el orden de insercion de cada elemento.
+void FillQueue(Mona::RenderQueue& queue, std::mt19937& generator, uint32_t count, uint32_t shaderCount, uint32_t materialCount,
+	uint32_t meshCount, uint32_t depthCount) {
+	std::uniform_int_distribution<uint32_t> shaders(0, shaderCount - 1);
+	std::uniform_int_distribution<uint32_t> materials(0, materialCount - 1);
+	std::uniform_int_distribution<uint32_t> meshes(0, meshCount - 1);
+	std::uniform_int_distribution<uint32_t> depths(0, depthCount - 1);
+	queue.Clear();
+	for (uint32_t i = 0; i < count; i++) {
+		Mona::RenderItem item = {};
+		item.materialIndex = materials(generator);
+		//Identificadores de malla separados para que no quepan en el campo de 16 bits de la llave.
+		item.meshID = meshes(generator) * 70001;
+		item.firstIndex = i;
+		const float depth = depthCount == 1 ? 0.5f : static_cast<float>(depths(generator)) / static_cast<float>(depthCount - 1);
+		queue.Push(item, Mona::RenderPass::Opaque, static_cast<uint8_t>(shaders(generator)), depth);
+	}
+}
+
+//Compara el orden de la cola contra std::stable_sort sobre las mismas llaves en orden de insercion.
+void CheckSortedQueue(Mona::RenderQueue& queue) {
+	const uint32_t count = queue.GetCount();
+	std::vector<std::pair<uint64_t, uint32_t>> expected;
+	expected.reserve(count);
+	for (uint32_t i = 0; i < count; i++)
+		expected.push_back({ queue.GetSortedKey(i), queue.GetSortedItem(i).firstIndex });
+	std::sort(expected.begin(), expected.end(),
+		[](const auto& a, const auto& b) { return a.second < b.second; });
+	std::stable_sort(expected.begin(), expected.end(),
+		[](const auto& a, const auto& b) { return a.first < b.first; });
+	queue.Sort();
+	MONA_ASSERT(queue.GetCount() == count, "Sort should keep every item");
+	for (uint32_t i = 0; i < count; i++) {
+		MONA_ASSERT(queue.GetSortedKey(i) == expected[i].first, "Radix sort should order keys like std::sort");
+		MONA_ASSERT(queue.GetSortedItem(i).firstIndex == expected[i].second, "Radix sort should keep the push order of equal keys");
+	}
+}
+
+int main() {
+	std::mt19937 generator(12345);
+	Mona::RenderQueue queue;
+
+	//Todos los campos varian, se ejecutan todas las pasadas del radix sort.
+	FillQueue(queue, generator, 5000, 4, 300, 400, 1000);
+	CheckSortedQueue(queue);
+
+	//Solo varian la malla y el material, se omiten las pasadas de la profundidad y del shader.
+	FillQueue(queue, generator, 5000, 1, 8, 8, 1);
+	CheckSortedQueue(queue);
+
+	//Solo varia el shader, se ejecuta una unica pasada y el resultado queda en el buffer auxiliar.
+	FillQueue(queue, generator, 1000, 3, 1, 1, 1);
+	CheckSortedQueue(queue);
+
+	//Todas las llaves iguales, el orden debe ser el de insercion.
+	FillQueue(queue, generator, 1000, 1, 1, 1, 1);
+	CheckSortedQueue(queue);
+	for (uint32_t i = 0; i < queue.GetCount(); i++)
+		MONA_ASSERT(queue.GetSortedItem(i).firstIndex == i, "Equal keys should keep the push order");
+
+	//Mallas cuyos identificadores coinciden en los 16 bits inferiores no deben compartir llave.
+	queue.Clear();
+	Mona::RenderItem item = {};
+	item.meshID = 3;
+	queue.Push(item, Mona::RenderPass::Opaque, 0, 0.5f);
+	item.meshID = 3 + (1u << 16);
+	queue.Push(item, Mona::RenderPass::Opaque, 0, 0.5f);
+	queue.Sort();
+	MONA_ASSERT(queue.GetSortedKey(0) != queue.GetSortedKey(1), "Meshes with aliasing ids should have different keys");
+	MONA_LOG_INFO("All test passed!!!");
+	return 0;
+}
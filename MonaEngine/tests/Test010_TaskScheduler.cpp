@@ -0,0 +1,118 @@
+#include "Core/Log.hpp"
+#include "Tasks/Task.hpp"
+#include "Tasks/TaskScheduler.hpp"
+#include "World/GameObjectManager.hpp"
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+//Registra su numero en log cada vez que es reanudada.
+Mona::Task LogForever(std::vector<int>& log, int number) {
+	while (true) {
+		log.push_back(number);
+		co_await Mona::NextFrame();
+	}
+}
+
+//Detiene la tarea target la primera vez que es reanudada.
+Mona::Task StopOther(Mona::TaskScheduler& scheduler, const Mona::TaskID& target, std::vector<int>& log, int number) {
+	while (true) {
+		log.push_back(number);
+		scheduler.StopTask(target);
+		co_await Mona::NextFrame();
+	}
+}
+
+//Marca destroyed cuando el frame de la corrutina que lo contiene es destruido.
+struct DestroyFlag {
+	explicit DestroyFlag(bool& destroyed) : m_destroyed(destroyed) {}
+	~DestroyFlag() { m_destroyed = true; }
+	bool& m_destroyed;
+};
+
+Mona::Task WaitBackgroundJob(std::atomic<bool>& release, bool& resumed, bool& destroyed) {
+	DestroyFlag flag(destroyed);
+	co_await Mona::RunInBackground([&release]() {
+		while (!release.load())
+			std::this_thread::sleep_for(std::chrono::milliseconds(1));
+	});
+	resumed = true;
+}
+
+//Espera a que el trabajo en segundo plano termine, sin pasar por el scheduler.
+void WaitRelease(std::atomic<bool>& release) {
+	release = true;
+	std::this_thread::sleep_for(std::chrono::milliseconds(100));
+}
+
+int main() {
+	Mona::GameObjectManager objectManager;
+	Mona::TaskScheduler scheduler;
+	std::vector<int> log;
+
+	//Con presupuesto cero se reanuda una tarea por frame, en orden circular.
+	scheduler.StartUp(8, 0.0f);
+	for (int i = 0; i < 3; i++)
+		scheduler.StartTask(LogForever(log, i));
+	for (int frame = 0; frame < 7; frame++)
+		scheduler.Update(objectManager, 0.016f);
+	const std::vector<int> expectedRoundRobin = { 0, 1, 2, 0, 1, 2, 0 };
+	MONA_ASSERT(log == expectedRoundRobin, "Zero budget should resume one task per frame in round robin order");
+
+	//Con presupuesto suficiente cada frame reanuda todas las tareas, comenzando por la que quedo pendiente.
+	log.clear();
+	scheduler.SetBudgetMilliseconds(1000.0f);
+	scheduler.Update(objectManager, 0.016f);
+	const std::vector<int> expectedFullFrame = { 1, 2, 0 };
+	MONA_ASSERT(log == expectedFullFrame, "Full budget should resume every task starting from the pending one");
+	scheduler.ShutDown();
+
+	//Una tarea que detiene a otra durante la iteracion impide que esta se reanude, y la tarea detenida se elimina al final.
+	log.clear();
+	scheduler.StartUp(8, 1000.0f);
+	Mona::TaskID target;
+	scheduler.StartTask(StopOther(scheduler, target, log, 0));
+	target = scheduler.StartTask(LogForever(log, 1));
+	scheduler.StartTask(LogForever(log, 2));
+	MONA_ASSERT(scheduler.IsTaskRunning(target), "Started task should be running");
+	scheduler.Update(objectManager, 0.016f);
+	const std::vector<int> expectedStopped = { 0, 2 };
+	MONA_ASSERT(log == expectedStopped, "Task stopped during the iteration should not be resumed");
+	MONA_ASSERT(!scheduler.IsTaskRunning(target), "Stopped task should not be running");
+	MONA_ASSERT(scheduler.GetTaskCount() == 2, "Stopped task should be destroyed at the end of Update");
+	log.clear();
+	scheduler.Update(objectManager, 0.016f);
+	MONA_ASSERT(log.size() == 2, "Remaining tasks should keep running");
+	scheduler.ShutDown();
+
+	//Una tarea que espera un trabajo en segundo plano no bloquea Update y se reanuda cuando el trabajo termina.
+	scheduler.StartUp(8, 1000.0f);
+	std::atomic<bool> release = false;
+	bool resumed = false;
+	bool destroyed = false;
+	scheduler.StartTask(WaitBackgroundJob(release, resumed, destroyed));
+	for (int frame = 0; frame < 3; frame++)
+		scheduler.Update(objectManager, 0.016f);
+	MONA_ASSERT(!resumed && scheduler.GetTaskCount() == 1, "Task should wait for its background job");
+	WaitRelease(release);
+	scheduler.Update(objectManager, 0.016f);
+	MONA_ASSERT(resumed && destroyed, "Task should resume and finish once its background job is done");
+	MONA_ASSERT(scheduler.GetTaskCount() == 0, "Finished task should be destroyed");
+
+	//Detener una tarea que espera un trabajo en segundo plano no bloquea, su frame se destruye cuando el trabajo termina.
+	release = false;
+	resumed = false;
+	destroyed = false;
+	const Mona::TaskID backgroundTask = scheduler.StartTask(WaitBackgroundJob(release, resumed, destroyed));
+	scheduler.Update(objectManager, 0.016f);
+	scheduler.StopTask(backgroundTask);
+	scheduler.Update(objectManager, 0.016f);
+	MONA_ASSERT(scheduler.GetTaskCount() == 0 && !destroyed, "Stopped task should wait for its background job before being destroyed");
+	WaitRelease(release);
+	scheduler.Update(objectManager, 0.016f);
+	MONA_ASSERT(!resumed && destroyed, "Stopped task should be destroyed without resuming");
+	scheduler.ShutDown();
+	MONA_LOG_INFO("All test passed!!!");
+	return 0;
+}
@@ -0,0 +1,103 @@
+#include "Core/Log.hpp"
+#include "Core/FrameBudgetGovernor.hpp"
+#include <cstdint>
+
+//Tiempos sinteticos de un frame, el total es la suma de las etapas.
+Mona::FrameTimings MakeTimings(uint64_t frameIndex, float physics, float animation, float render) {
+	Mona::FrameTimings timings;
+	timings.frameIndex = frameIndex;
+	timings.timeStep = 1.0f / 60.0f;
+	timings.stageMilliseconds[static_cast<uint8_t>(Mona::FrameStage::Physics)] = physics;
+	timings.stageMilliseconds[static_cast<uint8_t>(Mona::FrameStage::Animation)] = animation;
+	timings.stageMilliseconds[static_cast<uint8_t>(Mona::FrameStage::Render)] = render;
+	timings.totalMilliseconds = physics + animation + render;
+	return timings;
+}
+
+//Entrega frames con los tiempos indicados hasta que el governor cambie algun nivel o se alcance maxFrames. Retorna la
+//cantidad de frames entregados, incluyendo el que produjo el cambio.
+uint32_t FeedUntilChange(Mona::FrameBudgetGovernor& governor, uint64_t& frameIndex, uint32_t maxFrames, float physics,
+	float animation, float render) {
+	for (uint32_t i = 1; i <= maxFrames; i++) {
+		if (governor.Update(MakeTimings(frameIndex++, physics, animation, render)))
+			return i;
+	}
+	return maxFrames + 1;
+}
+
+uint32_t GetTotalLevel(const Mona::FrameBudgetGovernor& governor) {
+	uint32_t total = 0;
+	for (uint8_t i = 0; i < Mona::GetQualityKnobCount(); i++)
+		total += governor.GetLevel(static_cast<Mona::QualityKnob>(i));
+	return total;
+}
+
+int main() {
+	//Objetivo de 10ms, se restaura bajo 7.5ms. Se requieren 15 frames sobre el objetivo para degradar, 120 bajo el umbral
+	//para restaurar y cada cambio es seguido por 30 frames sin cambios.
+	Mona::QualitySettings baseSettings;
+	baseSettings.physicsMaxSubSteps = 1;
+	baseSettings.audioVoiceLimit = 32;
+	Mona::FrameBudgetGovernor governor;
+	governor.StartUp(baseSettings);
+	governor.SetEnabled(true);
+	governor.SetTargetMilliseconds(10.0f);
+	uint64_t frameIndex = 0;
+
+	//Bajo el objetivo no se degrada nada.
+	MONA_ASSERT(FeedUntilChange(governor, frameIndex, 500, 2.0f, 2.0f, 5.0f) == 501, "Frames under budget should not degrade");
+	MONA_ASSERT(GetTotalLevel(governor) == 0, "Frames under budget should not degrade");
+
+	//Sobre el objetivo se degrada el parametro de la etapa mas costosa, pero solo luego de varios frames sobre el objetivo.
+	uint32_t frames = FeedUntilChange(governor, frameIndex, 500, 4.0f, 2.0f, 14.0f);
+	MONA_ASSERT(frames >= 15 && frames <= 500, "Degrading should require several frames over budget");
+	MONA_ASSERT(governor.GetLevel(Mona::QualityKnob::RenderLOD) == 1 && GetTotalLevel(governor) == 1, "Most expensive stage should be degraded");
+	MONA_ASSERT(governor.GetCurrentSettings().renderLODBias == 1.0f, "RenderLOD level should bias the LOD selection");
+
+	//Luego de cada cambio se espera el periodo de enfriamiento mas los frames requeridos antes del siguiente.
+	frames = FeedUntilChange(governor, frameIndex, 500, 4.0f, 2.0f, 14.0f);
+	MONA_ASSERT(frames >= 30 + 15 && frames <= 500, "Cooldown should delay the next degradation");
+	MONA_ASSERT(governor.GetLevel(Mona::QualityKnob::RenderLOD) == 2, "Most expensive stage should keep being degraded");
+
+	//Con physicsMaxSubSteps igual a uno PhysicsSubSteps no puede degradarse aunque la fisica sea la etapa mas costosa.
+	frames = FeedUntilChange(governor, frameIndex, 500, 14.0f, 4.0f, 2.0f);
+	MONA_ASSERT(frames <= 500, "Frames over budget should degrade");
+	MONA_ASSERT(governor.GetLevel(Mona::QualityKnob::PhysicsSubSteps) == 0, "A single physics step cannot be degraded");
+	MONA_ASSERT(governor.GetLevel(Mona::QualityKnob::AnimationRate) == 1, "Next most expensive stage should be degraded");
+	const uint32_t degradedLevel = GetTotalLevel(governor);
+
+	//Entre el umbral de restauracion y el objetivo no se degrada ni se restaura (histeresis). Los primeros frames permiten
+	//que el promedio baje desde el valor anterior.
+	for (uint32_t i = 0; i < 200; i++)
+		governor.Update(MakeTimings(frameIndex++, 2.0f, 2.0f, 5.0f));
+	const uint32_t bandLevel = GetTotalLevel(governor);
+	MONA_ASSERT(bandLevel == degradedLevel, "Averages over the restore threshold should not change levels");
+	MONA_ASSERT(FeedUntilChange(governor, frameIndex, 1000, 2.0f, 2.0f, 5.0f) == 1001, "Frames inside the hysteresis band should not change levels");
+	MONA_ASSERT(GetTotalLevel(governor) == bandLevel, "Frames inside the hysteresis band should not change levels");
+
+	//Bajo el umbral se restaura un nivel a la vez, comenzando por el ultimo degradado.
+	const uint8_t animationLevel = governor.GetLevel(Mona::QualityKnob::AnimationRate);
+	frames = FeedUntilChange(governor, frameIndex, 1000, 1.0f, 1.0f, 3.0f);
+	MONA_ASSERT(frames >= 120 && frames <= 1000, "Restoring should require many frames under the threshold");
+	MONA_ASSERT(GetTotalLevel(governor) == bandLevel - 1, "Restoring should lower a single level");
+	MONA_ASSERT(governor.GetLevel(Mona::QualityKnob::AnimationRate) == animationLevel - 1, "Last degraded knob should be restored first");
+	while (GetTotalLevel(governor) > 0) {
+		frames = FeedUntilChange(governor, frameIndex, 1000, 1.0f, 1.0f, 3.0f);
+		MONA_ASSERT(frames >= 30 + 120 && frames <= 1000, "Cooldown should delay the next restoration");
+	}
+	MONA_ASSERT(FeedUntilChange(governor, frameIndex, 1000, 1.0f, 1.0f, 3.0f) == 1001, "Nothing should change once fully restored");
+	MONA_ASSERT(governor.GetCurrentSettings().renderLODBias == 0.0f, "Fully restored settings should match the base settings");
+
+	//Con mas de un paso de fisica por frame PhysicsSubSteps si puede degradarse.
+	baseSettings.physicsMaxSubSteps = 4;
+	Mona::FrameBudgetGovernor physicsGovernor;
+	physicsGovernor.StartUp(baseSettings);
+	physicsGovernor.SetEnabled(true);
+	physicsGovernor.SetTargetMilliseconds(10.0f);
+	frameIndex = 0;
+	MONA_ASSERT(FeedUntilChange(physicsGovernor, frameIndex, 500, 14.0f, 4.0f, 2.0f) <= 500, "Frames over budget should degrade");
+	MONA_ASSERT(physicsGovernor.GetLevel(Mona::QualityKnob::PhysicsSubSteps) == 1, "Physics sub steps should be degraded");
+	MONA_ASSERT(physicsGovernor.GetCurrentSettings().physicsMaxSubSteps == 2, "Each level should halve the physics sub steps");
+	MONA_LOG_INFO("All test passed!!!");
+	return 0;
+}
@@ -0,0 +1,49 @@
+#include "Core/Log.hpp"
+#include "Platform/InputRecording.hpp"
+#include <filesystem>
+#include <fstream>
+
+int main() {
+	//Frames con teclas que se presionan y sueltan, botones, rueda y una posicion tardia del mouse distinta a la de la
+	//instantanea, como cuando el ajuste tardio de la camara recolecta eventos llegados durante el frame.
+	Mona::InputRecording recording;
+	std::bitset<Mona::InputSnapshot::NUM_KEYS> keys;
+	std::bitset<Mona::InputSnapshot::NUM_MOUSE_BUTTONS> mouseButtons;
+	for (uint32_t i = 0; i < 6; i++) {
+		keys.flip(MONA_KEY_W);
+		if (i % 2 == 0)
+			keys.flip(MONA_KEY_A + i);
+		mouseButtons.set(MONA_MOUSE_BUTTON_1, i % 3 == 0);
+		const glm::dvec2 mousePosition(100.0 + 10.0 * i, 50.0 - 2.5 * i);
+		const glm::dvec2 wheelOffset(0.0, i == 4 ? 1.0 : 0.0);
+		//El indice de frame no se guarda, al cargar se asigna segun la posicion del frame.
+		const Mona::InputSnapshot snapshot(keys, mouseButtons, mousePosition, wheelOffset, 0.016 * i, i + 1);
+		recording.AddFrame(1.0f / 60.0f + 0.001f * i, snapshot, mousePosition + glm::dvec2(3.25, -1.5 * i));
+	}
+
+	const std::filesystem::path filePath = std::filesystem::temp_directory_path() / "Test012_InputRecording.mirc";
+	MONA_ASSERT(recording.SaveToFile(filePath), "Recording should be saved");
+	Mona::InputRecording loadedRecording;
+	MONA_ASSERT(loadedRecording.LoadFromFile(filePath), "Recording should be loaded");
+	MONA_ASSERT(loadedRecording.GetFrameCount() == recording.GetFrameCount(), "Loaded recording should keep every frame");
+	for (size_t i = 0; i < recording.GetFrameCount(); i++) {
+		const Mona::InputRecording::Frame& frame = recording.GetFrame(i);
+		const Mona::InputRecording::Frame& loadedFrame = loadedRecording.GetFrame(i);
+		MONA_ASSERT(loadedFrame.timeStep == frame.timeStep, "Loaded frame should keep its time step");
+		MONA_ASSERT(loadedFrame.snapshot == frame.snapshot, "Loaded frame should keep its input snapshot");
+		MONA_ASSERT(loadedFrame.lateLatchedMousePosition == frame.lateLatchedMousePosition, "Loaded frame should keep its late latched mouse position");
+	}
+
+	//Un archivo truncado o con otro formato no modifica la grabacion.
+	std::filesystem::resize_file(filePath, std::filesystem::file_size(filePath) - 4);
+	MONA_ASSERT(!loadedRecording.LoadFromFile(filePath), "Truncated recording should not be loaded");
+	MONA_ASSERT(loadedRecording.GetFrameCount() == recording.GetFrameCount(), "Failed load should keep the previous frames");
+	{
+		std::ofstream out(filePath, std::ios::binary);
+		out << "Not a recording";
+	}
+	MONA_ASSERT(!loadedRecording.LoadFromFile(filePath), "Invalid recording should not be loaded");
+	std::filesystem::remove(filePath);
+	MONA_LOG_INFO("All test passed!!!");
+	return 0;
+}
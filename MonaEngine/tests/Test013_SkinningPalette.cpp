@@ -0,0 +1,103 @@
+#include "Core/Log.hpp"
+#include "Animation/JointPose.hpp"
+#include "Rendering/SkinningPalette.hpp"
+#include <glm/gtc/matrix_transform.hpp>
+#include <cmath>
+#include <vector>
+
+//Producto de referencia, tal como se calculaba la paleta antes de codificarla en otros formatos.
+glm::mat4 ReferenceSkinningMatrix(const Mona::JointPose& pose, const glm::mat4& invBindMatrix) {
+	const glm::mat4 translationMatrix = glm::translate(glm::mat4(1.0f), pose.m_translation);
+	const glm::mat4 rotationMatrix = glm::toMat4(pose.m_rotation);
+	const glm::mat4 scaleMatrix = glm::scale(glm::mat4(1.0f), pose.m_scale);
+	return translationMatrix * rotationMatrix * scaleMatrix * invBindMatrix;
+}
+
+bool NearlyEqual(float a, float b) {
+	return std::abs(a - b) <= 1e-4f * std::max(1.0f, std::abs(b));
+}
+
+bool NearlyEqual(const glm::vec3& a, const glm::vec3& b) {
+	return NearlyEqual(a.x, b.x) && NearlyEqual(a.y, b.y) && NearlyEqual(a.z, b.z);
+}
+
+//Reconstruye la matriz (traslacion * rotacion * escala uniforme) codificada en un cuaternion dual.
+glm::mat4 DecodeDualQuaternion(const float* encoded) {
+	const glm::fquat real(encoded[3], encoded[0], encoded[1], encoded[2]);
+	const glm::fquat dual(encoded[7], encoded[4], encoded[5], encoded[6]);
+	const float scale = glm::length(real);
+	const glm::fquat rotation = real / scale;
+	const glm::fquat translation = (dual / scale) * glm::conjugate(rotation) * 2.0f;
+	glm::mat4 matrix = glm::toMat4(rotation) * glm::scale(glm::mat4(1.0f), glm::vec3(scale));
+	matrix[3] = glm::vec4(translation.x, translation.y, translation.z, 1.0f);
+	return matrix;
+}
+
+int main() {
+	//Inversas de la bind pose con escala no uniforme. La segunda rotacion aplicada despues de la escala produce cizalle,
+	//que no se puede representar como escala, rotacion y traslacion.
+	const glm::mat4 firstBind = glm::translate(glm::mat4(1.0f), glm::vec3(0.0f, 1.0f, 0.0f)) *
+		glm::rotate(glm::mat4(1.0f), 0.3f, glm::vec3(0.0f, 0.0f, 1.0f)) * glm::scale(glm::mat4(1.0f), glm::vec3(1.0f, 2.0f, 0.5f));
+	const glm::mat4 secondBind = firstBind * glm::rotate(glm::mat4(1.0f), 0.7f, glm::normalize(glm::vec3(1.0f, 1.0f, 0.0f))) *
+		glm::translate(glm::mat4(1.0f), glm::vec3(0.5f, 0.0f, -1.0f));
+	const std::vector<glm::mat4> invBindMatrices = { glm::inverse(firstBind), glm::inverse(secondBind), glm::mat4(1.0f) };
+	const std::vector<Mona::JointPose> poses = {
+		Mona::JointPose(glm::angleAxis(0.4f, glm::vec3(0.0f, 1.0f, 0.0f)), glm::vec3(1.0f, 2.0f, 3.0f), glm::vec3(1.5f, 0.75f, 1.2f)),
+		Mona::JointPose(glm::angleAxis(-1.1f, glm::normalize(glm::vec3(1.0f, 0.0f, 1.0f))), glm::vec3(-2.0f, 0.5f, 0.0f), glm::vec3(0.5f, 2.0f, 1.0f)),
+		Mona::JointPose(glm::angleAxis(2.0f, glm::vec3(1.0f, 0.0f, 0.0f)), glm::vec3(0.0f, -3.0f, 1.0f), glm::vec3(2.0f))
+	};
+	const size_t jointCount = poses.size();
+
+	//La paleta se compone como JointPoseToMat4(pose) * inversa de la bind pose y coincide con el producto de referencia.
+	std::vector<glm::mat4> matrixPalette(jointCount);
+	std::vector<glm::mat4> referencePalette(jointCount);
+	for (size_t i = 0; i < jointCount; i++) {
+		matrixPalette[i] = Mona::JointPoseToMat4(poses[i]) * invBindMatrices[i];
+		referencePalette[i] = ReferenceSkinningMatrix(poses[i], invBindMatrices[i]);
+		for (int c = 0; c < 4; c++) {
+			for (int r = 0; r < 4; r++)
+				MONA_ASSERT(NearlyEqual(matrixPalette[i][c][r], referencePalette[i][c][r]), "Skinning matrix should match the reference product");
+		}
+	}
+
+	//Matrix4 guarda las columnas de la matriz completa.
+	std::vector<float> encoded(jointCount * 16);
+	Mona::EncodeSkinningPalette(Mona::SkinningPaletteFormat::Matrix4, matrixPalette.data(), jointCount, encoded.data());
+	for (size_t i = 0; i < jointCount; i++) {
+		for (int c = 0; c < 4; c++) {
+			for (int r = 0; r < 4; r++)
+				MONA_ASSERT(NearlyEqual(encoded[i * 16 + c * 4 + r], referencePalette[i][c][r]), "Matrix4 palette should match the reference product");
+		}
+	}
+
+	//Affine3x4 guarda las tres primeras filas, que junto a (0, 0, 0, 1) reconstruyen la matriz completa incluyendo el cizalle.
+	Mona::EncodeSkinningPalette(Mona::SkinningPaletteFormat::Affine3x4, matrixPalette.data(), jointCount, encoded.data());
+	for (size_t i = 0; i < jointCount; i++) {
+		for (int r = 0; r < 3; r++) {
+			for (int c = 0; c < 4; c++)
+				MONA_ASSERT(NearlyEqual(encoded[i * 12 + r * 4 + c], referencePalette[i][c][r]), "Affine3x4 palette should match the reference product");
+		}
+		MONA_ASSERT(referencePalette[i][0][3] == 0.0f && referencePalette[i][1][3] == 0.0f && referencePalette[i][2][3] == 0.0f &&
+			referencePalette[i][3][3] == 1.0f, "Skinning matrices should be affine");
+	}
+
+	//DualQuaternion es exacto para transformaciones con escala uniforme, como la tercera articulacion.
+	Mona::EncodeSkinningPalette(Mona::SkinningPaletteFormat::DualQuaternion, matrixPalette.data(), jointCount, encoded.data());
+	const glm::mat4 uniformMatrix = DecodeDualQuaternion(encoded.data() + 2 * 8);
+	for (int c = 0; c < 4; c++) {
+		for (int r = 0; r < 4; r++)
+			MONA_ASSERT(NearlyEqual(uniformMatrix[c][r], referencePalette[2][c][r]), "Dual quaternion should match a uniformly scaled reference");
+	}
+
+	//Con escala no uniforme o cizalle solo se aproxima: la traslacion se mantiene y la escala es el promedio del largo de
+	//las columnas de la matriz de referencia.
+	for (size_t i = 0; i < 2; i++) {
+		const glm::mat4 decodedMatrix = DecodeDualQuaternion(encoded.data() + i * 8);
+		MONA_ASSERT(NearlyEqual(glm::vec3(decodedMatrix[3]), glm::vec3(referencePalette[i][3])), "Dual quaternion should keep the translation");
+		const float meanScale = (glm::length(glm::vec3(referencePalette[i][0])) + glm::length(glm::vec3(referencePalette[i][1])) +
+			glm::length(glm::vec3(referencePalette[i][2]))) / 3.0f;
+		MONA_ASSERT(NearlyEqual(glm::length(glm::vec3(decodedMatrix[0])), meanScale), "Dual quaternion should keep the mean scale");
+	}
+	MONA_LOG_INFO("All test passed!!!");
+	return 0;
+}